@@ -0,0 +1,213 @@
+/**
+ * @file				RobotBench.c
+ * @brief			Microbenchmark harness shared by the bench programs
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * Each benchmark runs one operation over and over, in the spirit of Google
+ * Benchmark. The operations are timed in batches of about 2 us, so the
+ * clock costs little even for fast ones, and the spread of the batches
+ * gives the percentiles. The bench programs are linked with
+ * -Wl,--wrap=malloc and the like, so every heap allocation made by the
+ * code under test is counted, the cJSON hooks and arena blocks included.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "RobotBench.h"
+
+
+static unsigned long s_ulAllocs = 0;
+
+
+extern void *__real_malloc(size_t sz);
+extern void *__real_calloc(size_t nmemb, size_t sz);
+extern void *__real_realloc(void *ptr, size_t sz);
+
+void *__wrap_malloc(size_t sz)
+{
+    s_ulAllocs++;
+    return __real_malloc(sz);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t sz)
+{
+    s_ulAllocs++;
+    return __real_calloc(nmemb, sz);
+}
+
+void *__wrap_realloc(void *ptr, size_t sz)
+{
+    s_ulAllocs++;
+    return __real_realloc(ptr, sz);
+}
+
+static unsigned long long _RobotBenchNowNs(void)
+{
+    struct timespec stNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &stNow);
+    return (unsigned long long)stNow.tv_sec * 1000000000ULL + stNow.tv_nsec;
+}
+
+static int _RobotBenchCompare(const void *pA, const void *pB)
+{
+    double dA = *(const double *)pA;
+    double dB = *(const double *)pB;
+
+    return (dA > dB) - (dA < dB);
+}
+
+/**
+ * @brief:      RobotBenchAllocs
+ * @details:    Heap allocations made so far by the program
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     unsigned long
+ */
+unsigned long RobotBenchAllocs(void)
+{
+    return s_ulAllocs;
+}
+
+/**
+ * @brief:      RobotBenchHeader
+ * @details:    Print the column titles
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+void RobotBenchHeader(void)
+{
+    printf("%-44s %10s %10s %10s %10s %11s %10s %14s\n", "Benchmark", "ns/op", "p50", "p99", "stddev",
+            "Iterations", "allocs/op", "items/s");
+    printf("------------------------------------------------------------------------------"
+            "------------------------------------------------------\n");
+}
+
+/**
+ * @brief:      RobotBenchRun
+ * @details:    Measure an operation and print its line
+ * @param[in]   const char *pcName
+ * @param[in]   ROBOT_BENCH_FN pfnOp
+ * @param[in]   void *pArg           Given to pfnOp
+ * @param[in]   int iItemsPerOp      Items handled by an operation, 0 not to
+ *                                   print items/s
+ * @param[out]  ROBOT_BENCH_RESULT_T *pstResult   May be NULL
+ * @retval:     void
+ */
+void RobotBenchRun(const char *pcName, ROBOT_BENCH_FN pfnOp, void *pArg, int iItemsPerOp,
+        ROBOT_BENCH_RESULT_T *pstResult)
+{
+    ROBOT_BENCH_RESULT_T stResult;
+    double *pdSample;
+    double dSum = 0.0, dSquare = 0.0;
+    unsigned long long ullStart, ullNow, ullTotal = 0;
+    unsigned long ulAllocs, ulBatch = 0, i;
+    int iSample, iSampleNum;
+
+    pdSample = __real_malloc(ROBOT_BENCH_SAMPLE_NUM * sizeof(double));
+    if (NULL == pdSample)
+    {
+        return;
+    }
+
+    /* Warm up, and size the batches from it */
+    ullStart = _RobotBenchNowNs();
+    do
+    {
+        pfnOp(pArg);
+        ulBatch++;
+        ullNow = _RobotBenchNowNs();
+    }
+    while (ullNow - ullStart < 20000000ULL);
+    i = ROBOT_BENCH_BATCH_NS * ulBatch / (ullNow - ullStart);
+    ulBatch = (i < 1) ? 1 : i;
+
+    /* Slow operations stop at the time limit before all the samples */
+    iSampleNum = ROBOT_BENCH_SAMPLE_NUM;
+    ulAllocs = s_ulAllocs;
+    for (iSample = 0; iSample < iSampleNum; iSample++)
+    {
+        ullStart = _RobotBenchNowNs();
+        for (i = 0; i < ulBatch; i++)
+        {
+            pfnOp(pArg);
+        }
+        ullNow = _RobotBenchNowNs();
+        pdSample[iSample] = (double)(ullNow - ullStart) / ulBatch;
+        ullTotal += ullNow - ullStart;
+        if (ullTotal > ROBOT_BENCH_TIME_MS * 1000000ULL)
+        {
+            iSample++;
+            break;
+        }
+    }
+    iSampleNum = iSample;
+
+    memset(&stResult, 0, sizeof(stResult));
+    stResult.ulIterations = ulBatch * iSampleNum;
+    stResult.dAllocsPerOp = (double)(s_ulAllocs - ulAllocs) / stResult.ulIterations;
+    stResult.dNsPerOp = (double)ullTotal / stResult.ulIterations;
+    for (iSample = 0; iSample < iSampleNum; iSample++)
+    {
+        dSum += pdSample[iSample];
+        dSquare += pdSample[iSample] * pdSample[iSample];
+    }
+    dSum /= iSampleNum;
+    stResult.dStdDevNs = sqrt((dSquare / iSampleNum > dSum * dSum) ? dSquare / iSampleNum - dSum * dSum : 0.0);
+    qsort(pdSample, iSampleNum, sizeof(double), _RobotBenchCompare);
+    stResult.dP50Ns = pdSample[iSampleNum / 2];
+    stResult.dP99Ns = pdSample[(iSampleNum * 99) / 100];
+    free(pdSample);
+
+    printf("%-44s %10.1f %10.1f %10.1f %10.1f %11lu %10.2f", pcName, stResult.dNsPerOp, stResult.dP50Ns,
+            stResult.dP99Ns, stResult.dStdDevNs, stResult.ulIterations, stResult.dAllocsPerOp);
+    if (iItemsPerOp > 0)
+    {
+        printf(" %14.0f", iItemsPerOp * 1e9 / stResult.dNsPerOp);
+    }
+    printf("\n");
+    fflush(stdout);
+
+    if (NULL != pstResult)
+    {
+        *pstResult = stResult;
+    }
+}
+
+/**
+ * @brief:      RobotBenchReadFile
+ * @details:    Read a corpus file, ended by a NUL
+ * @param[in]   const char *pcPath
+ * @param[in]   int iBufLen
+ * @param[out]  char *pcBuf
+ * @retval:     Bytes read, -1 on error
+ */
+int RobotBenchReadFile(const char *pcPath, char *pcBuf, int iBufLen)
+{
+    FILE *fp;
+    int iLen;
+
+    fp = fopen(pcPath, "rb");
+    if (NULL == fp)
+    {
+        fprintf(stderr, "Cannot open %s\n", pcPath);
+        return -1;
+    }
+    iLen = fread(pcBuf, 1, iBufLen - 1, fp);
+    fclose(fp);
+    pcBuf[iLen] = '\0';
+
+    return iLen;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file				RobotBench.h
+ * @brief			RobotBench.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTBENCH_H__
+#define __ROBOTBENCH_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Time spent measuring one benchmark, in ms */
+#define ROBOT_BENCH_TIME_MS            (500)
+/* Timed samples of one benchmark, at most */
+#define ROBOT_BENCH_SAMPLE_NUM         (100000)
+/* Operations of a sample are batched up to this time, in ns */
+#define ROBOT_BENCH_BATCH_NS           (2000)
+/* Room for a message, as the biggest buffer of RobotApi.c */
+#define ROBOT_BENCH_MESSAGE_MAX_LEN    (4096)
+
+
+/* One operation of a benchmark */
+typedef void (*ROBOT_BENCH_FN)(void *pArg);
+
+typedef struct {
+    double dNsPerOp;                            /* Mean */
+    double dP50Ns;
+    double dP99Ns;
+    double dStdDevNs;                           /* Of the samples, per operation */
+    double dAllocsPerOp;                        /* malloc, calloc and realloc calls */
+    unsigned long ulIterations;
+} ROBOT_BENCH_RESULT_T;
+
+
+extern void RobotBenchHeader(void);
+extern void RobotBenchRun(const char *pcName, ROBOT_BENCH_FN pfnOp, void *pArg, int iItemsPerOp,
+        ROBOT_BENCH_RESULT_T *pstResult);
+extern unsigned long RobotBenchAllocs(void);
+extern int RobotBenchReadFile(const char *pcPath, char *pcBuf, int iBufLen);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTBENCH_H__ */
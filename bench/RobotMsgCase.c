@@ -0,0 +1,699 @@
+/**
+ * @file				RobotMsgCase.c
+ * @brief			Every message of RobotMsg.c with the arguments RobotApi.c gives it
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * One entry per ubtRobot_Msg_Encode_* / ubtRobot_Msg_Decode_* pair, shared
+ * by the benchmarks and the fuzz harnesses. The reply of each entry is the
+ * seed of its fuzzer and the input of its decode benchmark. The stubs,
+ * which return without touching the message, are left out: the encoders
+ * of SwarmInit, SwarmAllocID, SwarmActionStart and SwarmActionCancel, the
+ * decoders of ReportStatusToApp, SwarmInitAck, SwarmAllocIDAck,
+ * SwarmActionStartAck, SwarmActionCancelAck and SwarmActionGotoXYZAck.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "voice_datatypes.h"
+#include "robotlogstr.h"
+#include "RobotMsg.h"
+#include "RobotMsgCase.h"
+
+
+/* Arguments of the messages */
+#define MSG_CASE_PORT               (20001)
+#define MSG_CASE_ACCOUNT            "ubtedu"
+#define MSG_CASE_SEQ                (7)
+#define MSG_CASE_ID                 (3)
+#define MSG_CASE_ANGLE              "5a5a5a1e5a965a5a5a5a5a5a5a5a5a5a5a"
+/* Robots a swarm allocation can list */
+#define MSG_CASE_ROBOT_NUM          (16)
+
+
+static void _MsgCaseEncodeSWVersion(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SWVersion(pcStr_Msg_Param_Query_Version_RaspPi, MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSWVersion(char *pcRecvBuf)
+{
+    char acVersion[64];
+
+    return ubtRobot_Msg_Decode_SWVersion(pcRecvBuf, acVersion, sizeof(acVersion));
+}
+
+static void _MsgCaseEncodeRobotStatus(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_RobotStatus(pcStr_Msg_Cmd_Query, pcStr_Msg_Type_Battery, NULL, MSG_CASE_PORT,
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeRobotStatus(char *pcRecvBuf)
+{
+    UBTEDU_ROBOT_Battery_T stBattery;
+
+    return ubtRobot_Msg_Decode_RobotStatus(pcStr_Msg_Type_Battery, pcRecvBuf, &stBattery);
+}
+
+static void _MsgCaseEncodeCheckAPPStatus(char *pcSendBuf, int iBufLen)
+{
+    struct timeval stTime = {30, 0};
+
+    ubtRobot_Msg_Encode_CheckAPPStatus(pcStr_Msg_Cmd_Query_App, pcStr_Ret_Msg_Status, MSG_CASE_PORT, stTime,
+            "blockly", pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeCheckAPPStatus(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_CheckAPPStatus(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeDetectVoiceMsg(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_DetectVoiceMsg(MSG_CASE_PORT, "hello", pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeDetectVoiceMsg(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_DetectVoiceMsg(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeStopVoiceRecognition(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_StopVoiceRecognition(MSG_CASE_PORT, "hello", pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeReadRobotServo(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_ReadRobotServo(MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeReadRobotServoHold(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_ReadRobotServoHold(MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeReadRobotServo(char *pcRecvBuf)
+{
+    char acAngle[64];
+
+    return ubtRobot_Msg_Decode_ReadRobotServo(pcRecvBuf, acAngle, sizeof(acAngle));
+}
+
+static void _MsgCaseEncodeReadServoOffset(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_ReadServoOffset(MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeReadServoOffset(char *pcRecvBuf)
+{
+    char acOffset[128];
+
+    return ubtRobot_Msg_Decode_ReadServoOffset(pcRecvBuf, acOffset, sizeof(acOffset));
+}
+
+static void _MsgCaseEncodeSetRobotServo(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SetRobotServo(MSG_CASE_PORT, MSG_CASE_ANGLE, 20, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSetRobotServo(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_SetRobotServo(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeSetRobotVolume(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SetRobotVolume(MSG_CASE_PORT, 60, pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeSetRobotVolumePlus(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SetRobotVolume_Plus(MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeSetRobotVolumeMinus(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SetRobotVolume_Minus(MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSetRobotVolume(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_SetRobotVolume(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeSetRobotMotion(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SetRobotMotion(pcStr_Msg_Cmd_Set, "raise", MSG_CASE_PORT, 3, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSetRobotMotion(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_SetRobotMotion(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeReadSensorValue(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_ReadSensorValue(pcStr_Msg_Param_Query_Sensor_GYRO, MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeReadSensorValueByAddr(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_ReadSensorValueByAddr(pcStr_Msg_Param_Query_Sensor_Ultrasonic, 1, MSG_CASE_PORT,
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeReadSensorValue(char *pcRecvBuf)
+{
+    UBTEDU_ROBOTGYRO_SENSOR_T stGyro;
+
+    return ubtRobot_Msg_Decode_ReadSensorValue(pcRecvBuf, pcStr_Msg_Param_Query_Sensor_GYRO, &stGyro,
+            sizeof(stGyro));
+}
+
+static int _MsgCaseDecodeReadSensorValueByAddr(char *pcRecvBuf)
+{
+    UBTEDU_ROBOTULTRASONIC_SENSOR_T stUltrasonic;
+
+    return ubtRobot_Msg_Decode_ReadSensorValue(pcRecvBuf, pcStr_Msg_Param_Query_Sensor_Ultrasonic,
+            &stUltrasonic, sizeof(stUltrasonic));
+}
+
+static void _MsgCaseEncodeReadSensors(char *pcSendBuf, int iBufLen)
+{
+    char *apcSensorType[] = {pcStr_Msg_Param_Query_Sensor_GYRO, pcStr_Msg_Param_Query_Sensor_ENV};
+
+    ubtRobot_Msg_Encode_ReadSensors(apcSensorType, 2, MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeReadSensors(char *pcRecvBuf)
+{
+    char *apcSensorType[] = {pcStr_Msg_Param_Query_Sensor_GYRO, pcStr_Msg_Param_Query_Sensor_ENV};
+    UBTEDU_ROBOTGYRO_SENSOR_T stGyro;
+    UBTEDU_ROBOTENV_SENSOR_T stEnv;
+    void *apValue[] = {&stGyro, &stEnv};
+    int aiValueLen[] = {sizeof(stGyro), sizeof(stEnv)};
+    UBTEDU_RC_T aeResult[2];
+
+    return ubtRobot_Msg_Decode_ReadSensors(pcRecvBuf, apcSensorType, apValue, aiValueLen, aeResult, 2);
+}
+
+static void _MsgCaseEncodeSetRobotLED(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SetRobotLED(MSG_CASE_PORT, "button", "red", "breath", pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSetRobotLED(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_SetRobotLED(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeStartRobotAction(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_StartRobotAction(MSG_CASE_PORT, "raise", 1, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeStartRobotAction(char *pcRecvBuf)
+{
+    int iTime;
+
+    return ubtRobot_Msg_Decode_StartRobotAction(pcRecvBuf, &iTime);
+}
+
+static void _MsgCaseEncodeStopRobotAction(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_StopRobotAction(MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeStopRobotAction(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_StopRobotAction(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeControlRobotAction(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_ControlRobotAction(MSG_CASE_PORT, "pause", pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeControlRobotAction(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_ControlRobotAction(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeVoiceStart(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_VoiceStart(MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeVoiceStart(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_VoiceStart(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeVoiceStop(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_VoiceStop(MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeVoiceStop(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_VoiceStop(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeVoiceTTS(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_VoiceTTS(MSG_CASE_PORT, 1, "Hello, I am Yanshee", pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeVoiceTTS(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_VoiceTTS(pcRecvBuf);
+}
+
+static void _MsgCaseEncodePlayMusic(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_PlayMusic("music", MSG_CASE_PORT, "happy.mp3", pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodePlayMusic(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_PlayMusic(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeGetMusic(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_GetMusic(MSG_CASE_PORT, 0, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeGetMusic(char *pcRecvBuf)
+{
+    char acName[4][64];
+    char *apcName[] = {acName[0], acName[1], acName[2], acName[3]};
+    int iIndex = 0;
+
+    return ubtRobot_Msg_Decode_GetMusic(pcRecvBuf, apcName, sizeof(acName[0]), 4, &iIndex);
+}
+
+static void _MsgCaseEncodeTakePhotos(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_TakePhotos("photo_0001", MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeTakePhotos(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_TakePhotos(pcRecvBuf, 64);
+}
+
+static void _MsgCaseEncodeEventDetect(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_EventDetect("button", MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+/* The value is copied unbounded, the buffer is as long as a reply can be */
+static int _MsgCaseDecodeEventDetect(char *pcRecvBuf)
+{
+    static char s_acValue[ROBOT_MSG_CASE_REPLY_MAX_LEN];
+
+    return ubtRobot_Msg_Decode_EventDetect(pcRecvBuf, s_acValue);
+}
+
+static void _MsgCaseEncodeVisionDetect(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_VisionDetect(pcStr_Msg_Type_Vision_Face, MSG_CASE_PORT, pcSendBuf, iBufLen, 10);
+}
+
+static int _MsgCaseDecodeVisionDetect(char *pcRecvBuf)
+{
+    static char s_acValue[ROBOT_MSG_CASE_REPLY_MAX_LEN];
+
+    return ubtRobot_Msg_Decode_VisionDetect(pcRecvBuf, s_acValue);
+}
+
+static void _MsgCaseEncodeTransmitCMD(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_TransmitCMD(MSG_CASE_PORT, "uname -a", pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeTransmitCMD(char *pcRecvBuf)
+{
+    char acData[256];
+
+    return ubtRobot_Msg_Decode_TransmitCMD(pcRecvBuf, acData, sizeof(acData));
+}
+
+static void _MsgCaseEncodeReportStatusToApp(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_ReportStatusToApp("blockly", "running", pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeHeartbeat(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_Heartbeat(pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeRobotDiscovery(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_RobotDiscovery(MSG_CASE_ACCOUNT, MSG_CASE_PORT, "Yanshee_F0C5", pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeRobotDiscovery(char *pcRecvBuf)
+{
+    UBTEDU_ROBOTINFO_T stInfo;
+
+    return ubtRobot_Msg_Decode_RobotDiscovery(pcRecvBuf, &stInfo);
+}
+
+static void _MsgCaseEncodeConnectRobot(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_ConnectRobot(MSG_CASE_ACCOUNT, MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeConnectRobot(char *pcRecvBuf)
+{
+    char acName[UBTEDU_ROBOT_NAME_LEN];
+
+    return ubtRobot_Msg_Decode_ConnectRobot(pcRecvBuf, acName, sizeof(acName));
+}
+
+static void _MsgCaseEncodeDisconnectRobot(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_DisconnectRobot(MSG_CASE_ACCOUNT, MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeDisconnectRobot(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_DisconnectRobot(pcRecvBuf);
+}
+
+static int _MsgCaseDecodeSwarmInit(char *pcRecvBuf)
+{
+    char acTimezone[64];
+    double dGyroOffset;
+    int iSeq;
+
+    return ubtRobot_Msg_Decode_SwarmInit(pcRecvBuf, &iSeq, acTimezone, &dGyroOffset);
+}
+
+static void _MsgCaseEncodeSwarmInitAck(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SwarmInitAck(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, "b8:27:eb:5c:f0:c5",
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSwarmAllocID(char *pcRecvBuf)
+{
+    ROBOTAGENT_MAC_T astMac[MSG_CASE_ROBOT_NUM];
+    int aiId[MSG_CASE_ROBOT_NUM];
+    int iSeq, iCount;
+
+    return ubtRobot_Msg_Decode_SwarmAllocID(pcRecvBuf, &iSeq, aiId, &iCount, astMac, MSG_CASE_ROBOT_NUM);
+}
+
+static void _MsgCaseEncodeSwarmAllocIDAck(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SwarmAllocIDAck(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, "b8:27:eb:5c:f0:c5",
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSwarmActionStart(char *pcRecvBuf)
+{
+    char acName[64];
+    double dDelay;
+    int iSeq, iRepeat;
+
+    return ubtRobot_Msg_Decode_SwarmActionStart(pcRecvBuf, &iSeq, &iRepeat, &dDelay, acName, sizeof(acName));
+}
+
+static void _MsgCaseEncodeSwarmActionStartAck(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SwarmActionStartAck(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeSwarmActionEnd(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SwarmActionEnd(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, MSG_CASE_ID,
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSwarmActionEnd(char *pcRecvBuf)
+{
+    int iSeq, iId;
+
+    return ubtRobot_Msg_Decode_SwarmActionEnd(pcRecvBuf, &iSeq, &iId);
+}
+
+static void _MsgCaseEncodeSwarmActionEndAck(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SwarmActionEndAck(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, MSG_CASE_ID,
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSwarmActionEndAck(char *pcRecvBuf)
+{
+    int iSeq, iId;
+
+    return ubtRobot_Msg_Decode_SwarmActionEndAck(pcRecvBuf, &iSeq, &iId);
+}
+
+static int _MsgCaseDecodeSwarmActionCancel(char *pcRecvBuf)
+{
+    int iSeq;
+
+    return ubtRobot_Msg_Decode_SwarmActionCancel(pcRecvBuf, &iSeq);
+}
+
+static void _MsgCaseEncodeSwarmActionCancelAck(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SwarmActionCancelAck(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeSwarmGotoXYZ(char *pcSendBuf, int iBufLen)
+{
+    ROBOTAGENT_SC_COORDINATES_T stXYZ = {120, -45, 0, 2};
+
+    ubtRobot_Msg_Encode_SwarmGotoXYZ(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, MSG_CASE_ID, &stXYZ,
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSwarmGotoXYZ(char *pcRecvBuf)
+{
+    ROBOTAGENT_SC_COORDINATES_T stXYZ;
+    int iSeq, iId;
+
+    return ubtRobot_Msg_Decode_SwarmGotoXYZ(pcRecvBuf, &iId, &stXYZ, &iSeq);
+}
+
+static void _MsgCaseEncodeSwarmActionGotoXYZAck(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SwarmActionGotoXYZAck(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, MSG_CASE_ID,
+            pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeSwarmReachXYZ(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SwarmReachXYZ(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, MSG_CASE_ID,
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSwarmReachXYZ(char *pcRecvBuf)
+{
+    int iSeq, iId;
+
+    return ubtRobot_Msg_Decode_SwarmReachXYZ(pcRecvBuf, &iSeq, &iId);
+}
+
+static void _MsgCaseEncodeSwarmReachXYZAck(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SwarmReachXYZAck(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, MSG_CASE_ID,
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSwarmReachXYZAck(char *pcRecvBuf)
+{
+    int iSeq, iId;
+
+    return ubtRobot_Msg_Decode_SwarmReachXYZAck(pcRecvBuf, &iSeq, &iId);
+}
+
+static void _MsgCaseEncodeSwarmQueryXYZ(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SwarmQueryXYZ(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, MSG_CASE_ID,
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSwarmQueryXYZ(char *pcRecvBuf)
+{
+    int iSeq, iId;
+
+    return ubtRobot_Msg_Decode_SwarmQueryXYZ(pcRecvBuf, &iSeq, &iId);
+}
+
+static void _MsgCaseEncodeSwarmQueryXYZAck(char *pcSendBuf, int iBufLen)
+{
+    ROBOTAGENT_SC_COORDINATES_T stXYZ = {120, -45, 0, 2};
+
+    ubtRobot_Msg_Encode_SwarmQueryXYZAck(MSG_CASE_ACCOUNT, MSG_CASE_PORT, MSG_CASE_SEQ, MSG_CASE_ID, &stXYZ,
+            pcStr_Msg_Param_Swarm_Status_Done, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSwarmQueryXYZAck(char *pcRecvBuf)
+{
+    ROBOTAGENT_SC_COORDINATES_T stXYZ;
+    char acStatus[64];
+    int iSeq, iId;
+
+    return ubtRobot_Msg_Decode_SwarmQueryXYZAck(pcRecvBuf, &iSeq, &iId, &stXYZ, acStatus);
+}
+
+static void _MsgCaseEncodeSearchSensor(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SearchSensor(MSG_CASE_PORT, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSearchSensor(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_SearchSensor(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeModifySensorID(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_ModifySensorID(MSG_CASE_PORT, pcStr_Msg_Param_Query_Sensor_Ultrasonic, 1, 2,
+            pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeModifySensorID(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_ModifySensorID(pcRecvBuf);
+}
+
+static void _MsgCaseEncodeSensorFrequency(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SensorFrequency(MSG_CASE_PORT, pcStr_Msg_Param_Query_Sensor_GYRO, 50, pcSendBuf, iBufLen);
+}
+
+static void _MsgCaseEncodeSensorMode(char *pcSendBuf, int iBufLen)
+{
+    ubtRobot_Msg_Encode_SensorMode(MSG_CASE_PORT, pcStr_Msg_Param_Query_Sensor_GYRO,
+            pcStr_Msg_Param_Query_Sensor_Start, pcSendBuf, iBufLen);
+}
+
+static int _MsgCaseDecodeSensorConfig(char *pcRecvBuf)
+{
+    return ubtRobot_Msg_Decode_SensorConfig(pcRecvBuf, pcStr_Msg_Type_Sensor_FREQ);
+}
+
+static int _MsgCaseDecodeSensorType(char *pcRecvBuf)
+{
+    char *apcSensorType[] =
+    {
+        pcStr_Msg_Param_Query_Sensor_GYRO, pcStr_Msg_Param_Query_Sensor_ENV,
+        pcStr_Msg_Param_Query_Sensor_Ultrasonic, pcStr_Msg_Param_Query_Sensor_Infrared,
+    };
+    int iType;
+
+    return ubtRobot_Msg_Decode_SensorType(pcRecvBuf, apcSensorType, 4, &iType);
+}
+
+const ROBOT_MSG_CASE_T g_astRobotMsgCase[] =
+{
+    {"SWVersion", "SWVersion/raspberry.json", _MsgCaseEncodeSWVersion, _MsgCaseDecodeSWVersion, 0},
+    {"RobotStatus", "RobotStatus/battery.json", _MsgCaseEncodeRobotStatus, _MsgCaseDecodeRobotStatus, 1},
+    {"CheckAPPStatus", "CheckAPPStatus/ok.json", _MsgCaseEncodeCheckAPPStatus, _MsgCaseDecodeCheckAPPStatus, 0},
+    {"DetectVoiceMsg", "DetectVoiceMsg/ok.json", _MsgCaseEncodeDetectVoiceMsg, _MsgCaseDecodeDetectVoiceMsg, 0},
+    {"StopVoiceRecognition", NULL, _MsgCaseEncodeStopVoiceRecognition, NULL, 0},
+    {"ReadRobotServo", "ReadRobotServo/read.json", _MsgCaseEncodeReadRobotServo, _MsgCaseDecodeReadRobotServo, 0},
+    {"ReadRobotServoHold", "ReadRobotServo/read.json", _MsgCaseEncodeReadRobotServoHold,
+        _MsgCaseDecodeReadRobotServo, 0},
+    {"ReadServoOffset", "ReadServoOffset/offset.json", _MsgCaseEncodeReadServoOffset,
+        _MsgCaseDecodeReadServoOffset, 0},
+    {"SetRobotServo", "SetRobotServo/ok.json", _MsgCaseEncodeSetRobotServo, _MsgCaseDecodeSetRobotServo, 0},
+    {"SetRobotVolume", "SetRobotVolume/ok.json", _MsgCaseEncodeSetRobotVolume, _MsgCaseDecodeSetRobotVolume, 0},
+    {"SetRobotVolume_Plus", "SetRobotVolume/ok.json", _MsgCaseEncodeSetRobotVolumePlus,
+        _MsgCaseDecodeSetRobotVolume, 0},
+    {"SetRobotVolume_Minus", "SetRobotVolume/ok.json", _MsgCaseEncodeSetRobotVolumeMinus,
+        _MsgCaseDecodeSetRobotVolume, 0},
+    {"SetRobotMotion", "SetRobotMotion/ok.json", _MsgCaseEncodeSetRobotMotion, _MsgCaseDecodeSetRobotMotion, 0},
+    {"ReadSensorValue", "ReadSensorValue/gyro.json", _MsgCaseEncodeReadSensorValue,
+        _MsgCaseDecodeReadSensorValue, 0},
+    {"ReadSensorValueByAddr", "ReadSensorValue/ultrasonic.json", _MsgCaseEncodeReadSensorValueByAddr,
+        _MsgCaseDecodeReadSensorValueByAddr, 0},
+    {"ReadSensors", "ReadSensors/gyro_environment.json", _MsgCaseEncodeReadSensors, _MsgCaseDecodeReadSensors, 1},
+    {"SetRobotLED", "SetRobotLED/ok.json", _MsgCaseEncodeSetRobotLED, _MsgCaseDecodeSetRobotLED, 0},
+    {"StartRobotAction", "StartRobotAction/start.json", _MsgCaseEncodeStartRobotAction,
+        _MsgCaseDecodeStartRobotAction, 0},
+    {"StopRobotAction", "StopRobotAction/ok.json", _MsgCaseEncodeStopRobotAction,
+        _MsgCaseDecodeStopRobotAction, 0},
+    {"ControlRobotAction", "ControlRobotAction/ok.json", _MsgCaseEncodeControlRobotAction,
+        _MsgCaseDecodeControlRobotAction, 0},
+    {"VoiceStart", "VoiceStart/ok.json", _MsgCaseEncodeVoiceStart, _MsgCaseDecodeVoiceStart, 0},
+    {"VoiceStop", "VoiceStop/ok.json", _MsgCaseEncodeVoiceStop, _MsgCaseDecodeVoiceStop, 0},
+    {"VoiceTTS", "VoiceTTS/ok.json", _MsgCaseEncodeVoiceTTS, _MsgCaseDecodeVoiceTTS, 0},
+    {"PlayMusic", "PlayMusic/ok.json", _MsgCaseEncodePlayMusic, _MsgCaseDecodePlayMusic, 0},
+    {"GetMusic", "GetMusic/ok.json", _MsgCaseEncodeGetMusic, _MsgCaseDecodeGetMusic, 0},
+    {"TakePhotos", "TakePhotos/ok.json", _MsgCaseEncodeTakePhotos, _MsgCaseDecodeTakePhotos, 0},
+    {"EventDetect", "EventDetect/button.json", _MsgCaseEncodeEventDetect, _MsgCaseDecodeEventDetect, 0},
+    {"VisionDetect", "VisionDetect/face.json", _MsgCaseEncodeVisionDetect, _MsgCaseDecodeVisionDetect, 0},
+    {"TransmitCMD", "TransmitCMD/uname.json", _MsgCaseEncodeTransmitCMD, _MsgCaseDecodeTransmitCMD, 0},
+    {"ReportStatusToApp", NULL, _MsgCaseEncodeReportStatusToApp, NULL, 0},
+    {"Heartbeat", NULL, _MsgCaseEncodeHeartbeat, NULL, 0},
+    {"RobotDiscovery", "RobotDiscovery/idle.json", _MsgCaseEncodeRobotDiscovery, _MsgCaseDecodeRobotDiscovery, 1},
+    {"ConnectRobot", "ConnectRobot/ok.json", _MsgCaseEncodeConnectRobot, _MsgCaseDecodeConnectRobot, 0},
+    {"DisconnectRobot", "DisconnectRobot/ok.json", _MsgCaseEncodeDisconnectRobot, _MsgCaseDecodeDisconnectRobot, 0},
+    {"SwarmInit", "SwarmInit/init.json", NULL, _MsgCaseDecodeSwarmInit, 0},
+    {"SwarmInitAck", NULL, _MsgCaseEncodeSwarmInitAck, NULL, 0},
+    {"SwarmAllocID", "SwarmAllocID/three.json", NULL, _MsgCaseDecodeSwarmAllocID, 0},
+    {"SwarmAllocIDAck", NULL, _MsgCaseEncodeSwarmAllocIDAck, NULL, 0},
+    {"SwarmActionStart", "SwarmActionStart/start.json", NULL, _MsgCaseDecodeSwarmActionStart, 0},
+    {"SwarmActionStartAck", NULL, _MsgCaseEncodeSwarmActionStartAck, NULL, 0},
+    {"SwarmActionEnd", "SwarmActionEnd/end.json", _MsgCaseEncodeSwarmActionEnd, _MsgCaseDecodeSwarmActionEnd, 0},
+    {"SwarmActionEndAck", "SwarmActionEndAck/end.json", _MsgCaseEncodeSwarmActionEndAck,
+        _MsgCaseDecodeSwarmActionEndAck, 0},
+    {"SwarmActionCancel", "SwarmActionCancel/cancel.json", NULL, _MsgCaseDecodeSwarmActionCancel, 0},
+    {"SwarmActionCancelAck", NULL, _MsgCaseEncodeSwarmActionCancelAck, NULL, 0},
+    {"SwarmGotoXYZ", "SwarmGotoXYZ/goto.json", _MsgCaseEncodeSwarmGotoXYZ, _MsgCaseDecodeSwarmGotoXYZ, 0},
+    {"SwarmActionGotoXYZAck", NULL, _MsgCaseEncodeSwarmActionGotoXYZAck, NULL, 0},
+    {"SwarmReachXYZ", "SwarmReachXYZ/reach.json", _MsgCaseEncodeSwarmReachXYZ, _MsgCaseDecodeSwarmReachXYZ, 0},
+    {"SwarmReachXYZAck", "SwarmReachXYZAck/reach.json", _MsgCaseEncodeSwarmReachXYZAck,
+        _MsgCaseDecodeSwarmReachXYZAck, 0},
+    {"SwarmQueryXYZ", "SwarmQueryXYZ/query.json", _MsgCaseEncodeSwarmQueryXYZ, _MsgCaseDecodeSwarmQueryXYZ, 0},
+    {"SwarmQueryXYZAck", "SwarmQueryXYZAck/done.json", _MsgCaseEncodeSwarmQueryXYZAck,
+        _MsgCaseDecodeSwarmQueryXYZAck, 0},
+    {"SearchSensor", "SearchSensor/ok.json", _MsgCaseEncodeSearchSensor, _MsgCaseDecodeSearchSensor, 0},
+    {"ModifySensorID", "ModifySensorID/ok.json", _MsgCaseEncodeModifySensorID, _MsgCaseDecodeModifySensorID, 0},
+    {"SensorFrequency", "SensorConfig/frequency.json", _MsgCaseEncodeSensorFrequency, _MsgCaseDecodeSensorConfig, 0},
+    {"SensorMode", NULL, _MsgCaseEncodeSensorMode, NULL, 0},
+    {"SensorType", "ReadSensorValue/environment.json", NULL, _MsgCaseDecodeSensorType, 0},
+};
+
+const int g_iRobotMsgCaseNum = sizeof(g_astRobotMsgCase)/sizeof(g_astRobotMsgCase[0]);
+
+/**
+ * @brief:      RobotMsgCaseFind
+ * @details:    Find a message by its name
+ * @param[in]   const char *pcName
+ * @param[out]  None
+ * @retval:     NULL when there is none
+ */
+const ROBOT_MSG_CASE_T *RobotMsgCaseFind(const char *pcName)
+{
+    int i;
+
+    for (i = 0; i < g_iRobotMsgCaseNum; i++)
+    {
+        if (!strcmp(g_astRobotMsgCase[i].pcName, pcName))
+        {
+            return &g_astRobotMsgCase[i];
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file				RobotMsgCase.h
+ * @brief			RobotMsgCase.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTMSGCASE_H__
+#define __ROBOTMSGCASE_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Longest reply a decoder is given, with its terminating NUL */
+#define ROBOT_MSG_CASE_REPLY_MAX_LEN   (4096)
+
+/* Encode a message into pcSendBuf */
+typedef void (*ROBOT_MSG_ENCODE_FN)(char *pcSendBuf, int iBufLen);
+/* Decode a reply, the result of the decoder */
+typedef int (*ROBOT_MSG_DECODE_FN)(char *pcRecvBuf);
+
+typedef struct {
+    const char *pcName;                 /* The message, as in ubtRobot_Msg_Encode_<name> */
+    const char *pcReply;                /* Corpus file of the reply, under the corpus directory */
+    ROBOT_MSG_ENCODE_FN pfnEncode;      /* NULL when the message is only received */
+    ROBOT_MSG_DECODE_FN pfnDecode;      /* NULL when nothing comes back */
+    int iLeaks;                         /* The decoder loses memory outside of an arena cycle */
+} ROBOT_MSG_CASE_T;
+
+
+extern const ROBOT_MSG_CASE_T g_astRobotMsgCase[];
+extern const int g_iRobotMsgCaseNum;
+
+extern const ROBOT_MSG_CASE_T *RobotMsgCaseFind(const char *pcName);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTMSGCASE_H__ */
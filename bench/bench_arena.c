@@ -0,0 +1,113 @@
+/**
+ * @file				bench_arena.c
+ * @brief			Heap allocations and latency of the codec with and without the arena
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * A "malloc" run decodes like a thread which never begins a cycle, an
+ * "arena" run wraps each decode in a cycle as RobotApi.c does. The
+ * encode runs are only measured in a cycle: outside of one the buffer of
+ * cJSON_Print() is never freed.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "voice_datatypes.h"
+#include "robotlogstr.h"
+#include "RobotMsg.h"
+#include "RobotMsgArena.h"
+#include "RobotBench.h"
+
+
+typedef struct {
+    char acReply[ROBOT_BENCH_MESSAGE_MAX_LEN];
+    int iArena;
+} BENCH_ARENA_ARG_T;
+
+
+static void _BenchDecodeVersion(void *pArg)
+{
+    BENCH_ARENA_ARG_T *pstArg = pArg;
+    char acVersion[64];
+
+    if (pstArg->iArena)
+    {
+        RobotMessageArenaBegin();
+    }
+    ubtRobot_Msg_Decode_SWVersion(pstArg->acReply, acVersion, sizeof(acVersion));
+    if (pstArg->iArena)
+    {
+        RobotMessageArenaEnd();
+    }
+}
+
+static void _BenchDecodeAction(void *pArg)
+{
+    BENCH_ARENA_ARG_T *pstArg = pArg;
+    int iTime;
+
+    if (pstArg->iArena)
+    {
+        RobotMessageArenaBegin();
+    }
+    ubtRobot_Msg_Decode_StartRobotAction(pstArg->acReply, &iTime);
+    if (pstArg->iArena)
+    {
+        RobotMessageArenaEnd();
+    }
+}
+
+static void _BenchVersionCycle(void *pArg)
+{
+    BENCH_ARENA_ARG_T *pstArg = pArg;
+    char acSendBuf[ROBOT_BENCH_MESSAGE_MAX_LEN];
+    char acVersion[64];
+
+    RobotMessageArenaBegin();
+    ubtRobot_Msg_Encode_SWVersion(pcStr_Msg_Param_Query_Version_RaspPi, 20001, acSendBuf, sizeof(acSendBuf));
+    ubtRobot_Msg_Decode_SWVersion(pstArg->acReply, acVersion, sizeof(acVersion));
+    RobotMessageArenaEnd();
+}
+
+int main(int argc, char *argv[])
+{
+    const char *pcCorpus = (argc > 1) ? argv[1] : "../corpus";
+    BENCH_ARENA_ARG_T stVersion, stAction;
+    char acPath[256];
+
+    snprintf(acPath, sizeof(acPath), "%s/SWVersion/raspberry.json", pcCorpus);
+    if (RobotBenchReadFile(acPath, stVersion.acReply, sizeof(stVersion.acReply)) < 0)
+    {
+        return 1;
+    }
+    snprintf(acPath, sizeof(acPath), "%s/StartRobotAction/start.json", pcCorpus);
+    if (RobotBenchReadFile(acPath, stAction.acReply, sizeof(stAction.acReply)) < 0)
+    {
+        return 1;
+    }
+
+    /* The hooks are installed by the first cycle */
+    RobotMessageArenaBegin();
+    RobotMessageArenaEnd();
+
+    RobotBenchHeader();
+    stVersion.iArena = 0;
+    RobotBenchRun("BM_DecodeSWVersion/malloc", _BenchDecodeVersion, &stVersion, 0, NULL);
+    stVersion.iArena = 1;
+    RobotBenchRun("BM_DecodeSWVersion/arena", _BenchDecodeVersion, &stVersion, 0, NULL);
+    stAction.iArena = 0;
+    RobotBenchRun("BM_DecodeStartRobotAction/malloc", _BenchDecodeAction, &stAction, 0, NULL);
+    stAction.iArena = 1;
+    RobotBenchRun("BM_DecodeStartRobotAction/arena", _BenchDecodeAction, &stAction, 0, NULL);
+    RobotBenchRun("BM_SWVersionCycle/arena", _BenchVersionCycle, &stVersion, 0, NULL);
+
+    return 0;
+}
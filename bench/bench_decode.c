@@ -0,0 +1,159 @@
+/**
+ * @file				bench_decode.c
+ * @brief			Decode of the polled replies, structural index against cJSON
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * The servo angles and the gyro, environment and board sensors are decoded
+ * from the structural index of RobotMsgScan.c, the other sensors go to
+ * cJSON. Each reply of the corpus is decoded as RobotApi.c does, in an
+ * arena cycle, next to a bare cJSON_Parse() of it for reference. Before
+ * measuring, the numbers decoded by the index are checked against the
+ * cJSON tree of the same reply: both go through cJSON_ParseNumber() and
+ * must agree to the bit.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "voice_datatypes.h"
+#include "robotlogstr.h"
+#include "cJSON.h"
+#include "RobotMsg.h"
+#include "RobotMsgArena.h"
+#include "RobotBench.h"
+
+
+typedef struct {
+    const char *pcName;             /* Corpus file, also the sensor type */
+    int iValueLen;
+    char acReply[ROBOT_BENCH_MESSAGE_MAX_LEN];
+} BENCH_DECODE_ARG_T;
+
+static BENCH_DECODE_ARG_T s_astSensor[] =
+{
+    {"gyro", sizeof(UBTEDU_ROBOTGYRO_SENSOR_T)},
+    {"environment", sizeof(UBTEDU_ROBOTENV_SENSOR_T)},
+    {"board", sizeof(UBTEDU_ROBOTRASPBOARD_SENSOR_T)},
+    {"ultrasonic", sizeof(UBTEDU_ROBOTULTRASONIC_SENSOR_T)},
+    {"infrared", sizeof(UBTEDU_ROBOTINFRARED_SENSOR_T)},
+    {"touch", sizeof(UBTEDU_ROBOTTOUCH_SENSOR_T)},
+    {"color", sizeof(UBTEDU_ROBOTCOLOR_SENSOR_T)},
+    {"pressure", sizeof(UBTEDU_ROBOTPRESSURE_SENSOR_T)},
+};
+
+static BENCH_DECODE_ARG_T s_stServo = {"read", 0};
+
+
+static void _BenchDecodeSensor(void *pArg)
+{
+    BENCH_DECODE_ARG_T *pstArg = pArg;
+    UBTEDU_ROBOTGYRO_SENSOR_T stValue;
+
+    RobotMessageArenaBegin();
+    ubtRobot_Msg_Decode_ReadSensorValue(pstArg->acReply, (char *)pstArg->pcName, &stValue, pstArg->iValueLen);
+    RobotMessageArenaEnd();
+}
+
+static void _BenchDecodeServo(void *pArg)
+{
+    BENCH_DECODE_ARG_T *pstArg = pArg;
+    char acAngle[64];
+
+    RobotMessageArenaBegin();
+    ubtRobot_Msg_Decode_ReadRobotServo(pstArg->acReply, acAngle, sizeof(acAngle));
+    RobotMessageArenaEnd();
+}
+
+static void _BenchParse(void *pArg)
+{
+    BENCH_DECODE_ARG_T *pstArg = pArg;
+
+    RobotMessageArenaBegin();
+    cJSON_Delete(cJSON_Parse(pstArg->acReply));
+    RobotMessageArenaEnd();
+}
+
+/* The gyro members are in the order of the keys of the reply */
+static int _BenchCheckGyro(BENCH_DECODE_ARG_T *pstArg)
+{
+    UBTEDU_ROBOTGYRO_SENSOR_T stValue;
+    double *pdValue = (double *)&stValue;
+    cJSON *pJson, *pNode;
+    int iRet = 0;
+    int i = 0;
+
+    memset(&stValue, 0, sizeof(stValue));
+    if (UBTEDU_RC_SUCCESS != ubtRobot_Msg_Decode_ReadSensorValue(pstArg->acReply, (char *)pstArg->pcName,
+            &stValue, sizeof(stValue)))
+    {
+        fprintf(stderr, "%s: decode failed\n", pstArg->pcName);
+        return -1;
+    }
+
+    pJson = cJSON_Parse(pstArg->acReply);
+    pNode = cJSON_GetObjectItem(pJson, pcStr_Msg_Param_Query_Sensor_GYRO);
+    for (pNode = (NULL != pNode) ? pNode->child : NULL; NULL != pNode; pNode = pNode->next, i++)
+    {
+        if (memcmp(&pdValue[i], &pNode->valuedouble, sizeof(double)))
+        {
+            fprintf(stderr, "%s: %s decoded as %.17g, cJSON gives %.17g\n", pstArg->pcName, pNode->string,
+                    pdValue[i], pNode->valuedouble);
+            iRet = -1;
+        }
+    }
+    cJSON_Delete(pJson);
+
+    return iRet;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *pcCorpus = (argc > 1) ? argv[1] : "../corpus";
+    char acPath[256];
+    char acName[64];
+    int i;
+
+    for (i = 0; i < sizeof(s_astSensor)/sizeof(s_astSensor[0]); i++)
+    {
+        snprintf(acPath, sizeof(acPath), "%s/ReadSensorValue/%s.json", pcCorpus, s_astSensor[i].pcName);
+        if (RobotBenchReadFile(acPath, s_astSensor[i].acReply, sizeof(s_astSensor[i].acReply)) < 0)
+        {
+            return 1;
+        }
+    }
+    snprintf(acPath, sizeof(acPath), "%s/ReadRobotServo/%s.json", pcCorpus, s_stServo.pcName);
+    if (RobotBenchReadFile(acPath, s_stServo.acReply, sizeof(s_stServo.acReply)) < 0)
+    {
+        return 1;
+    }
+
+    if (_BenchCheckGyro(&s_astSensor[0]))
+    {
+        return 1;
+    }
+
+    /* The hooks are installed by the first cycle */
+    RobotMessageArenaBegin();
+    RobotMessageArenaEnd();
+
+    RobotBenchHeader();
+    RobotBenchRun("BM_DecodeReadRobotServo/read", _BenchDecodeServo, &s_stServo, 1, NULL);
+    RobotBenchRun("BM_cJSONParse/read", _BenchParse, &s_stServo, 1, NULL);
+    for (i = 0; i < sizeof(s_astSensor)/sizeof(s_astSensor[0]); i++)
+    {
+        snprintf(acName, sizeof(acName), "BM_DecodeReadSensorValue/%s", s_astSensor[i].pcName);
+        RobotBenchRun(acName, _BenchDecodeSensor, &s_astSensor[i], 1, NULL);
+        snprintf(acName, sizeof(acName), "BM_cJSONParse/%s", s_astSensor[i].pcName);
+        RobotBenchRun(acName, _BenchParse, &s_astSensor[i], 1, NULL);
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file				bench_kinematics.c
+ * @brief			Poses per second of the limb kinematics of RobotKinematics.c
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * The poses are the standing pose with every servo moved by up to 20
+ * degrees. "Forward" computes the end of a chain for one pose, as
+ * ubtGetLimbPose() does, "ForwardBatch" for BENCH_KIN_POSE_NUM poses at
+ * once, as ubtComputeLimbPoses() does over a capture. "Update" refreshes
+ * the poses of all the chains for the next pose, as a servo read does.
+ * "Solve" finds the servos which reach the end of another pose, starting
+ * from the standing pose each time.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+#include "RobotKinematics.h"
+#include "RobotBench.h"
+
+
+/* Poses of a batch */
+#define BENCH_KIN_POSE_NUM          (64)
+
+
+typedef struct {
+    ROBOT_KIN_CHAIN_e eChain;
+    ROBOT_KIN_T stKin;
+    ROBOT_KIN_POSE_T astPose[BENCH_KIN_POSE_NUM];
+    float afTarget[3];
+    int iNext;
+} BENCH_KIN_ARG_T;
+
+/* Standing, the arms hanging */
+static const unsigned char s_aucStand[MAX_SERVO_NUM] =
+    {90, 180, 90, 90, 1, 90, 90, 58, 74, 110, 89, 90, 120, 104, 69, 89, 90};
+static unsigned char s_aucPose[BENCH_KIN_POSE_NUM][MAX_SERVO_NUM];
+
+
+static void _BenchKinForward(void *pArg)
+{
+    BENCH_KIN_ARG_T *pstArg = pArg;
+
+    RobotKinForwardBatch(pstArg->eChain, s_aucPose[pstArg->iNext], 1, &pstArg->astPose[0]);
+    pstArg->iNext = (pstArg->iNext + 1) % BENCH_KIN_POSE_NUM;
+}
+
+static void _BenchKinForwardBatch(void *pArg)
+{
+    BENCH_KIN_ARG_T *pstArg = pArg;
+
+    RobotKinForwardBatch(pstArg->eChain, s_aucPose[0], BENCH_KIN_POSE_NUM, pstArg->astPose);
+}
+
+static void _BenchKinUpdate(void *pArg)
+{
+    BENCH_KIN_ARG_T *pstArg = pArg;
+
+    RobotKinUpdate(&pstArg->stKin, s_aucPose[pstArg->iNext]);
+    pstArg->iNext = (pstArg->iNext + 1) % BENCH_KIN_POSE_NUM;
+}
+
+static void _BenchKinSolve(void *pArg)
+{
+    BENCH_KIN_ARG_T *pstArg = pArg;
+    unsigned char aucAngle[MAX_SERVO_NUM];
+    float fError;
+
+    memcpy(aucAngle, s_aucStand, sizeof(aucAngle));
+    RobotKinSolve(pstArg->eChain, pstArg->afTarget, aucAngle, &fError);
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *apcChain[] = {"left_arm", "right_arm", "left_leg", "right_leg", "head"};
+    BENCH_KIN_ARG_T stArg;
+    char acName[64];
+    int i, j, iAngle;
+
+    /* Each servo walks through -20 ~ +20 degrees at its own pace */
+    for (i = 0; i < BENCH_KIN_POSE_NUM; i++)
+    {
+        for (j = 0; j < MAX_SERVO_NUM; j++)
+        {
+            iAngle = s_aucStand[j] + (i * (j + 3)) % 41 - 20;
+            s_aucPose[i][j] = (iAngle < ROBOT_KIN_MIN_ANGLE) ? ROBOT_KIN_MIN_ANGLE
+                              : ((iAngle > ROBOT_KIN_MAX_ANGLE) ? ROBOT_KIN_MAX_ANGLE : iAngle);
+        }
+    }
+
+    RobotBenchHeader();
+    for (i = ROBOT_KIN_CHAIN_LEFT_ARM; i < ROBOT_KIN_CHAIN_INVALID; i++)
+    {
+        memset(&stArg, 0, sizeof(stArg));
+        stArg.eChain = (ROBOT_KIN_CHAIN_e)i;
+
+        snprintf(acName, sizeof(acName), "BM_KinForward/%s", apcChain[i]);
+        RobotBenchRun(acName, _BenchKinForward, &stArg, 1, NULL);
+        snprintf(acName, sizeof(acName), "BM_KinForwardBatch/%s", apcChain[i]);
+        RobotBenchRun(acName, _BenchKinForwardBatch, &stArg, BENCH_KIN_POSE_NUM, NULL);
+
+        /* The head only turns, there is nothing to reach */
+        if (ROBOT_KIN_CHAIN_HEAD == i)
+        {
+            continue;
+        }
+        RobotKinForwardBatch(stArg.eChain, s_aucPose[BENCH_KIN_POSE_NUM / 2], 1, &stArg.astPose[0]);
+        memcpy(stArg.afTarget, stArg.astPose[0].afPos, sizeof(stArg.afTarget));
+        snprintf(acName, sizeof(acName), "BM_KinSolve/%s", apcChain[i]);
+        RobotBenchRun(acName, _BenchKinSolve, &stArg, 1, NULL);
+    }
+
+    memset(&stArg, 0, sizeof(stArg));
+    RobotKinInit(&stArg.stKin);
+    RobotBenchRun("BM_KinUpdate", _BenchKinUpdate, &stArg, 1, NULL);
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file				bench_msg.c
+ * @brief			Encode and decode of every message of RobotMsg.c
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * The messages are the ones of RobotMsgCase.c. Each is encoded in an arena
+ * cycle, as RobotApi.c does: outside of one, the text of cJSON_Print() is
+ * lost by the encoders. Its reply of the corpus is decoded in an arena
+ * cycle and with plain malloc(), but for the decoders which lose memory.
+ * A second argument only runs the messages of that name.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "RobotMsgArena.h"
+#include "RobotBench.h"
+#include "RobotMsgCase.h"
+
+
+typedef struct {
+    const ROBOT_MSG_CASE_T *pstCase;
+    char acBuf[ROBOT_BENCH_MESSAGE_MAX_LEN];
+} BENCH_MSG_ARG_T;
+
+
+static void _BenchEncode(void *pArg)
+{
+    BENCH_MSG_ARG_T *pstArg = pArg;
+
+    RobotMessageArenaBegin();
+    pstArg->pstCase->pfnEncode(pstArg->acBuf, sizeof(pstArg->acBuf));
+    RobotMessageArenaEnd();
+}
+
+static void _BenchDecodeArena(void *pArg)
+{
+    BENCH_MSG_ARG_T *pstArg = pArg;
+
+    RobotMessageArenaBegin();
+    pstArg->pstCase->pfnDecode(pstArg->acBuf);
+    RobotMessageArenaEnd();
+}
+
+static void _BenchDecodeMalloc(void *pArg)
+{
+    BENCH_MSG_ARG_T *pstArg = pArg;
+
+    pstArg->pstCase->pfnDecode(pstArg->acBuf);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *pcCorpus = (argc > 1) ? argv[1] : "../corpus";
+    const char *pcOnly = (argc > 2) ? argv[2] : NULL;
+    static BENCH_MSG_ARG_T stArg;
+    const ROBOT_MSG_CASE_T *pstCase;
+    char acPath[256];
+    char acName[96];
+    int iRet;
+    int i;
+
+    /* The hooks are installed by the first cycle */
+    RobotMessageArenaBegin();
+    RobotMessageArenaEnd();
+
+    RobotBenchHeader();
+    for (i = 0; i < g_iRobotMsgCaseNum; i++)
+    {
+        pstCase = &g_astRobotMsgCase[i];
+        if ((NULL != pcOnly) && strcmp(pcOnly, pstCase->pcName))
+        {
+            continue;
+        }
+        stArg.pstCase = pstCase;
+
+        if (NULL != pstCase->pfnEncode)
+        {
+            snprintf(acName, sizeof(acName), "BM_Encode_%s/arena", pstCase->pcName);
+            RobotBenchRun(acName, _BenchEncode, &stArg, 1, NULL);
+        }
+
+        if (NULL == pstCase->pfnDecode)
+        {
+            continue;
+        }
+        snprintf(acPath, sizeof(acPath), "%s/%s", pcCorpus, pstCase->pcReply);
+        if (RobotBenchReadFile(acPath, stArg.acBuf, sizeof(stArg.acBuf)) < 0)
+        {
+            return 1;
+        }
+        /* A reply the decoder refuses would only measure its error path */
+        RobotMessageArenaBegin();
+        iRet = pstCase->pfnDecode(stArg.acBuf);
+        RobotMessageArenaEnd();
+        if (0 != iRet)
+        {
+            fprintf(stderr, "%s: %s is refused with %d\n", pstCase->pcName, acPath, iRet);
+            return 1;
+        }
+
+        snprintf(acName, sizeof(acName), "BM_Decode_%s/arena", pstCase->pcName);
+        RobotBenchRun(acName, _BenchDecodeArena, &stArg, 1, NULL);
+        if (!pstCase->iLeaks)
+        {
+            snprintf(acName, sizeof(acName), "BM_Decode_%s/malloc", pstCase->pcName);
+            RobotBenchRun(acName, _BenchDecodeMalloc, &stArg, 1, NULL);
+        }
+    }
+
+    return 0;
+}
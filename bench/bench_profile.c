@@ -0,0 +1,115 @@
+/**
+ * @file				bench_profile.c
+ * @brief			Trajectories per second of the motion profiles of RobotProfile.c
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * A trajectory moves all MAX_SERVO_NUM servos from the standing pose to a
+ * bow, in the shortest time the default limits allow. "Plan" only plans
+ * it, "Sample" gets the angles of one instant of it, "Hts" plans it and
+ * samples it into a safety checked HTS action of 60 ms frames, as
+ * ubtServoProfileExport() does before writing the file.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+#include "RobotHts.h"
+#include "RobotProfile.h"
+#include "RobotBench.h"
+
+
+/* Frame time of the HTS actions built */
+#define BENCH_PROFILE_FRAME_MS      (60)
+
+
+typedef struct {
+    ROBOT_PROFILE_TYPE_e eType;
+    ROBOT_PROFILE_LIMIT_T stLimit;
+    ROBOT_PROFILE_T stProfile;
+    float fTimeMs;
+} BENCH_PROFILE_ARG_T;
+
+/* Standing, then bowing with the arms forward */
+static const unsigned char s_aucFrom[MAX_SERVO_NUM] =
+    {90, 90, 90, 90, 90, 90, 90, 60, 76, 110, 90, 90, 120, 104, 70, 90, 90};
+static const unsigned char s_aucTo[MAX_SERVO_NUM] =
+    {90, 30, 40, 90, 150, 140, 90, 60, 50, 150, 100, 90, 120, 130, 30, 80, 90};
+
+
+static void _BenchProfilePlan(void *pArg)
+{
+    BENCH_PROFILE_ARG_T *pstArg = pArg;
+
+    RobotProfilePlan(&pstArg->stProfile, pstArg->eType, &pstArg->stLimit, s_aucFrom, s_aucTo, 0.0f);
+}
+
+static void _BenchProfileSample(void *pArg)
+{
+    BENCH_PROFILE_ARG_T *pstArg = pArg;
+    unsigned char aucAngle[MAX_SERVO_NUM];
+
+    RobotProfileSample(&pstArg->stProfile, pstArg->fTimeMs, aucAngle);
+    /* Walk through the move, so the trapezoid takes each of its phases */
+    pstArg->fTimeMs += BENCH_PROFILE_FRAME_MS;
+    if (pstArg->fTimeMs > pstArg->stProfile.fDuration)
+    {
+        pstArg->fTimeMs = 0.0f;
+    }
+}
+
+static void _BenchProfileHts(void *pArg)
+{
+    BENCH_PROFILE_ARG_T *pstArg = pArg;
+    ROBOT_HTS_T stHts;
+
+    RobotProfilePlan(&pstArg->stProfile, pstArg->eType, &pstArg->stLimit, s_aucFrom, s_aucTo, 0.0f);
+    if (UBTEDU_RC_SUCCESS == RobotProfileBuildHts(&pstArg->stProfile, BENCH_PROFILE_FRAME_MS, &stHts))
+    {
+        RobotHtsDestroy(&stHts);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *apcType[] = {"minjerk", "trapezoid"};
+    BENCH_PROFILE_ARG_T stArg;
+    ROBOT_HTS_T stHts;
+    char acName[64];
+    int i;
+
+    RobotBenchHeader();
+    for (i = ROBOT_PROFILE_MINJERK; i < ROBOT_PROFILE_INVALID; i++)
+    {
+        memset(&stArg, 0, sizeof(stArg));
+        stArg.eType = (ROBOT_PROFILE_TYPE_e)i;
+        RobotProfileLimitInit(&stArg.stLimit);
+
+        /* A move the safety check refuses would only measure the refusal */
+        _BenchProfilePlan(&stArg);
+        if (UBTEDU_RC_SUCCESS != RobotProfileBuildHts(&stArg.stProfile, BENCH_PROFILE_FRAME_MS, &stHts))
+        {
+            fprintf(stderr, "The %s move is refused\n", apcType[i]);
+            return 1;
+        }
+        RobotHtsDestroy(&stHts);
+
+        snprintf(acName, sizeof(acName), "BM_ProfilePlan/%s", apcType[i]);
+        RobotBenchRun(acName, _BenchProfilePlan, &stArg, 1, NULL);
+        snprintf(acName, sizeof(acName), "BM_ProfileSample/%s", apcType[i]);
+        RobotBenchRun(acName, _BenchProfileSample, &stArg, 1, NULL);
+        snprintf(acName, sizeof(acName), "BM_ProfileHts/%s", apcType[i]);
+        RobotBenchRun(acName, _BenchProfileHts, &stArg, 1, NULL);
+    }
+
+    return 0;
+}
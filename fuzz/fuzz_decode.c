@@ -0,0 +1,95 @@
+/**
+ * @file				fuzz_decode.c
+ * @brief			libFuzzer harness of the decoders of RobotMsg.c
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * Built with -DROBOT_FUZZ_CASE=\"<name>\", it gives libFuzzer one decoder of
+ * RobotMsgCase.c: "make fuzz_<name>" in this directory. The input is handed
+ * over as a received reply would be, NUL terminated and cut to the longest
+ * reply. The decoders run with plain malloc(), so AddressSanitizer sees
+ * each cJSON allocation on its own, but the ones which lose memory, which
+ * run in an arena cycle as RobotApi.c does.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "RobotMsgArena.h"
+#include "RobotMsgCase.h"
+#include "fuzz_decode.h"
+
+
+/**
+ * @brief:      RobotFuzzDecode
+ * @details:    Decode some bytes with the decoder of a message
+ * @param[in]   const ROBOT_MSG_CASE_T *pstCase
+ * @param[in]   const uint8_t *pucData
+ * @param[in]   size_t ulSize
+ * @param[out]  None
+ * @retval:     The result of the decoder
+ */
+int RobotFuzzDecode(const ROBOT_MSG_CASE_T *pstCase, const uint8_t *pucData, size_t ulSize)
+{
+    char *pcReply;
+    int iRet;
+
+    /* Exactly as long as the input, a read past its end is caught */
+    if (ulSize > ROBOT_MSG_CASE_REPLY_MAX_LEN - 1)
+    {
+        ulSize = ROBOT_MSG_CASE_REPLY_MAX_LEN - 1;
+    }
+    pcReply = malloc(ulSize + 1);
+    if (NULL == pcReply)
+    {
+        return -1;
+    }
+    memcpy(pcReply, pucData, ulSize);
+    pcReply[ulSize] = '\0';
+
+    if (pstCase->iLeaks)
+    {
+        RobotMessageArenaBegin();
+    }
+    iRet = pstCase->pfnDecode(pcReply);
+    if (pstCase->iLeaks)
+    {
+        RobotMessageArenaEnd();
+    }
+    free(pcReply);
+
+    return iRet;
+}
+
+#ifdef ROBOT_FUZZ_CASE
+static const ROBOT_MSG_CASE_T *s_pstCase = NULL;
+
+int LLVMFuzzerInitialize(int *argc, char ***argv)
+{
+    s_pstCase = RobotMsgCaseFind(ROBOT_FUZZ_CASE);
+    if ((NULL == s_pstCase) || (NULL == s_pstCase->pfnDecode))
+    {
+        fprintf(stderr, "No decoder for %s\n", ROBOT_FUZZ_CASE);
+        exit(1);
+    }
+    /* The decoders print what they refuse */
+    freopen("/dev/null", "w", stdout);
+
+    return 0;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *pucData, size_t ulSize)
+{
+    RobotFuzzDecode(s_pstCase, pucData, ulSize);
+
+    return 0;
+}
+#endif
@@ -0,0 +1,39 @@
+/**
+ * @file				fuzz_decode.h
+ * @brief			fuzz_decode.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __FUZZ_DECODE_H__
+#define __FUZZ_DECODE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "RobotMsgCase.h"
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+extern int RobotFuzzDecode(const ROBOT_MSG_CASE_T *pstCase, const uint8_t *pucData, size_t ulSize);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __FUZZ_DECODE_H__ */
@@ -0,0 +1,194 @@
+/**
+ * @file				fuzz_replay.c
+ * @brief			Replay of the corpus through every decoder, without libFuzzer
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * For the machines without clang, "make replay" builds this with gcc and
+ * AddressSanitizer. Every decoder is given every reply of the corpus, then
+ * its own reply cut at each byte and with each byte deleted or replaced by
+ * a JSON delimiter, a digit or a letter. Files given on the command line,
+ * such as the crashes kept by libFuzzer, are decoded by all the decoders
+ * instead.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <dirent.h>
+
+#include "RobotMsgCase.h"
+#include "fuzz_decode.h"
+
+
+/* Room for the replies of the corpus */
+#define FUZZ_REPLAY_FILE_NUM        (128)
+
+typedef struct {
+    char acPath[256];
+    uint8_t aucData[ROBOT_MSG_CASE_REPLY_MAX_LEN];
+    size_t ulSize;
+} FUZZ_REPLAY_FILE_T;
+
+static FUZZ_REPLAY_FILE_T s_astFile[FUZZ_REPLAY_FILE_NUM];
+static int s_iFileNum = 0;
+
+/* What a byte of a reply is replaced with */
+static const char s_acMutation[] = "{}[],:\"\\-.0e9x";
+
+
+static int _FuzzReplayRead(const char *pcPath)
+{
+    FUZZ_REPLAY_FILE_T *pstFile;
+    FILE *fp;
+
+    if (s_iFileNum >= FUZZ_REPLAY_FILE_NUM)
+    {
+        fprintf(stderr, "More than %d files, %s is left out\n", FUZZ_REPLAY_FILE_NUM, pcPath);
+        return -1;
+    }
+    fp = fopen(pcPath, "rb");
+    if (NULL == fp)
+    {
+        fprintf(stderr, "Cannot open %s\n", pcPath);
+        return -1;
+    }
+    pstFile = &s_astFile[s_iFileNum++];
+    snprintf(pstFile->acPath, sizeof(pstFile->acPath), "%s", pcPath);
+    pstFile->ulSize = fread(pstFile->aucData, 1, sizeof(pstFile->aucData) - 1, fp);
+    fclose(fp);
+
+    return 0;
+}
+
+/* The corpus has a directory of replies per message */
+static int _FuzzReplayReadCorpus(const char *pcCorpus)
+{
+    char acPath[256];
+    struct dirent *pstMsg, *pstReply;
+    DIR *pstMsgDir, *pstReplyDir;
+
+    pstMsgDir = opendir(pcCorpus);
+    if (NULL == pstMsgDir)
+    {
+        fprintf(stderr, "Cannot open %s\n", pcCorpus);
+        return -1;
+    }
+    while (NULL != (pstMsg = readdir(pstMsgDir)))
+    {
+        if ('.' == pstMsg->d_name[0])
+        {
+            continue;
+        }
+        snprintf(acPath, sizeof(acPath), "%s/%s", pcCorpus, pstMsg->d_name);
+        pstReplyDir = opendir(acPath);
+        if (NULL == pstReplyDir)
+        {
+            continue;
+        }
+        while (NULL != (pstReply = readdir(pstReplyDir)))
+        {
+            if ('.' == pstReply->d_name[0])
+            {
+                continue;
+            }
+            snprintf(acPath, sizeof(acPath), "%s/%s/%s", pcCorpus, pstMsg->d_name, pstReply->d_name);
+            _FuzzReplayRead(acPath);
+        }
+        closedir(pstReplyDir);
+    }
+    closedir(pstMsgDir);
+
+    return 0;
+}
+
+static unsigned long _FuzzReplayMutate(const ROBOT_MSG_CASE_T *pstCase, const FUZZ_REPLAY_FILE_T *pstFile)
+{
+    static uint8_t s_aucData[ROBOT_MSG_CASE_REPLY_MAX_LEN];
+    unsigned long ulRuns = 0;
+    size_t i, j;
+
+    for (i = 0; i < pstFile->ulSize; i++)
+    {
+        /* Cut */
+        RobotFuzzDecode(pstCase, pstFile->aucData, i);
+
+        /* Deleted */
+        memcpy(s_aucData, pstFile->aucData, i);
+        memcpy(s_aucData + i, pstFile->aucData + i + 1, pstFile->ulSize - i - 1);
+        RobotFuzzDecode(pstCase, s_aucData, pstFile->ulSize - 1);
+
+        /* Replaced */
+        memcpy(s_aucData, pstFile->aucData, pstFile->ulSize);
+        for (j = 0; j < sizeof(s_acMutation) - 1; j++)
+        {
+            s_aucData[i] = s_acMutation[j];
+            RobotFuzzDecode(pstCase, s_aucData, pstFile->ulSize);
+        }
+        ulRuns += sizeof(s_acMutation) + 1;
+    }
+
+    return ulRuns;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *pcCorpus = "../corpus";
+    const ROBOT_MSG_CASE_T *pstCase;
+    unsigned long ulRuns = 0;
+    int iMutate = 1;
+    int i, j;
+
+    if ((argc > 2) && !strcmp(argv[1], "-corpus"))
+    {
+        pcCorpus = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc > 1)
+    {
+        iMutate = 0;
+        for (i = 1; i < argc; i++)
+        {
+            if (_FuzzReplayRead(argv[i]) < 0)
+            {
+                return 1;
+            }
+        }
+    }
+    else if (_FuzzReplayReadCorpus(pcCorpus) < 0)
+    {
+        return 1;
+    }
+
+    /* The decoders print what they refuse */
+    freopen("/dev/null", "w", stdout);
+
+    for (i = 0; i < g_iRobotMsgCaseNum; i++)
+    {
+        pstCase = &g_astRobotMsgCase[i];
+        if (NULL == pstCase->pfnDecode)
+        {
+            continue;
+        }
+        for (j = 0; j < s_iFileNum; j++)
+        {
+            RobotFuzzDecode(pstCase, s_astFile[j].aucData, s_astFile[j].ulSize);
+            ulRuns++;
+            if (iMutate && (NULL != strstr(s_astFile[j].acPath, pstCase->pcReply)))
+            {
+                ulRuns += _FuzzReplayMutate(pstCase, &s_astFile[j]);
+            }
+        }
+    }
+    fprintf(stderr, "%lu decodes of %d files, no error\n", ulRuns, s_iFileNum);
+
+    return 0;
+}
@@ -71,6 +71,8 @@ extern char  *cJSON_Print(cJSON *item);
 extern char  *cJSON_PrintUnformatted(cJSON *item);
 /* Render a cJSON entity to text using a buffered strategy. prebuffer is a guess at the final size. guessing well reduces reallocation. fmt=0 gives unformatted, =1 gives formatted */
 extern char *cJSON_PrintBuffered(cJSON *item,int prebuffer,int fmt);
+/* Free the text returned by the Print functions with the hooks it was allocated with. */
+extern void cJSON_FreeBuffer(char *out);
 /* Delete a cJSON entity and all subentities. */
 extern void   cJSON_Delete(cJSON *c);
 
@@ -130,6 +132,9 @@ extern cJSON *cJSON_ParseWithOpts(const char *value,const char **return_parse_en
 
 extern void cJSON_Minify(char *json);
 
+/* ParseNumber reads the JSON number at num into *value exactly as cJSON_Parse does, and returns the end of the number (0 on failure). */
+extern const char *cJSON_ParseNumber(const char *num,double *value);
+
 /* Macros for creating things quickly. */
 #define cJSON_AddNullToObject(object,name)		cJSON_AddItemToObject(object, name, cJSON_CreateNull())
 #define cJSON_AddTrueToObject(object,name)		cJSON_AddItemToObject(object, name, cJSON_CreateTrue())
@@ -238,6 +238,42 @@ typedef struct _RobotPressureSensor
     int iValue;         /**<    The Pressure via Pressure sensor */
 } UBTEDU_ROBOTPRESSURE_SENSOR_T;
 
+/**
+ * @brief   Sensors which can be subscribed to
+*/
+typedef enum
+{
+    UBTEDU_SENSOR_GYRO = 0,         /**< UBTEDU_ROBOTGYRO_SENSOR_T */
+    UBTEDU_SENSOR_ENV,              /**< UBTEDU_ROBOTENV_SENSOR_T */
+    UBTEDU_SENSOR_BOARD,            /**< UBTEDU_ROBOTRASPBOARD_SENSOR_T */
+    UBTEDU_SENSOR_ULTRASONIC,       /**< UBTEDU_ROBOTULTRASONIC_SENSOR_T */
+    UBTEDU_SENSOR_INFRARED,         /**< UBTEDU_ROBOTINFRARED_SENSOR_T */
+    UBTEDU_SENSOR_TOUCH,            /**< UBTEDU_ROBOTTOUCH_SENSOR_T */
+    UBTEDU_SENSOR_COLOR,            /**< UBTEDU_ROBOTCOLOR_SENSOR_T */
+    UBTEDU_SENSOR_PRESSURE,         /**< UBTEDU_ROBOTPRESSURE_SENSOR_T */
+    UBTEDU_SENSOR_INVALID           /**< Invalid value */
+} UBTEDU_SENSOR_TYPE_e;
+
+/**
+ * @brief   One sample of a subscribed sensor
+*/
+typedef struct _SensorSample
+{
+    UBTEDU_SENSOR_TYPE_e eType;     /**< Which member of uValue is set */
+    unsigned long long ullTimeUs;   /**< Monotonic time the sample was received */
+    union
+    {
+        UBTEDU_ROBOTGYRO_SENSOR_T stGyro;
+        UBTEDU_ROBOTENV_SENSOR_T stEnv;
+        UBTEDU_ROBOTRASPBOARD_SENSOR_T stBoard;
+        UBTEDU_ROBOTULTRASONIC_SENSOR_T stUltrasonic;
+        UBTEDU_ROBOTINFRARED_SENSOR_T stInfrared;
+        UBTEDU_ROBOTTOUCH_SENSOR_T stTouch;
+        UBTEDU_ROBOTCOLOR_SENSOR_T stColor;
+        UBTEDU_ROBOTPRESSURE_SENSOR_T stPressure;
+    } uValue;
+} UBTEDU_SENSOR_SAMPLE_T;
+
 /**
  * @brief   Battery data
 */
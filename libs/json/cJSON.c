@@ -30,6 +30,7 @@
 #include <float.h>
 #include <limits.h>
 #include <ctype.h>
+#include <locale.h>
 #include "cJSON.h"
 
 static const char *ep;
@@ -97,20 +98,38 @@ void cJSON_Delete(cJSON *c)
     }
 }
 
-/* Parse the input text to generate a number, and populate the result into item. */
-static const char *parse_number(cJSON *item,const char *num)
-{
-    double n=0,sign=1,scale=0;
-    int subscale=0,signsubscale=1;
+/* Powers of ten which are exact in a double. */
+static const double pow10_exact[]={1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+    1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
 
-    if (*num=='-') sign=-1,num++;   /* Has sign? */
+/* Parse the input text to generate a number. */
+static const char *parse_number_value(const char *num,double *value)
+{
+    const char *start=num;
+    unsigned long long mant=0;
+    double n;
+    int neg=0,digits=0,exact=1,scale=0,subscale=0,signsubscale=1,len,pointlen;
+    char buf[64],*copy;
+    const char *point;
+
+    if (*num=='-') neg=1,num++;     /* Has sign? */
     if (*num=='0') num++;           /* is zero */
-    if (*num>='1' && *num<='9') do  n=(n*10.0)+(*num++ -'0');
-        while (*num>='0' && *num<='9'); /* Number? */
+    if (*num>='1' && *num<='9') do  /* Number? Up to 19 digits fit in mant. */
+        {
+            if (digits<19) mant=mant*10+(*num-'0'),digits++;
+            else scale++,exact&=(*num=='0');
+            num++;
+        }
+        while (*num>='0' && *num<='9');
     if (*num=='.' && num[1]>='0' && num[1]<='9')
     {
         num++;           /* Fractional part? */
-        do  n=(n*10.0)+(*num++ -'0'),scale--;
+        do
+        {
+            if (digits<19) mant=mant*10+(*num-'0'),digits+=(mant!=0),scale--;
+            else exact&=(*num=='0');
+            num++;
+        }
         while (*num>='0' && *num<='9');
     }
     if (*num=='e' || *num=='E')     /* Exponent? */
@@ -118,11 +137,56 @@ static const char *parse_number(cJSON *item,const char *num)
         num++;
         if (*num=='+') num++;
         else if (*num=='-') signsubscale=-1,num++;      /* With sign? */
-        while (*num>='0' && *num<='9') subscale=(subscale*10)+(*num++ - '0');   /* Number? */
+        while (*num>='0' && *num<='9')                  /* Number? */
+        {
+            if (subscale<100000) subscale=(subscale*10)+(*num-'0');
+            num++;
+        }
     }
+    scale+=subscale*signsubscale;
+
+    if (exact && mant<=(1ULL<<53) && scale>=-22 && scale<=22)
+    {
+        /* Both operands are exact, so the one IEEE operation rounds correctly. */
+        n=(double)mant;
+        n=(scale<0)?n/pow10_exact[-scale]:n*pow10_exact[scale];
+        if (neg) n=-n;
+    }
+    else
+    {
+        /* Rare long or huge numbers, let the C library round them. strtod()
+           reads the decimal point of the locale, so the copy is written in it. */
+        point=localeconv()->decimal_point;
+        if (!point || !point[0]) point=".";
+        pointlen=strlen(point);
+        copy=(num-start+pointlen<(int)sizeof(buf))?buf:(char*)cJSON_malloc(num-start+pointlen);
+        if (!copy) return 0;
+        for (len=0;start<num;start++)
+        {
+            if (*start=='.') memcpy(copy+len,point,pointlen),len+=pointlen;
+            else copy[len++]=*start;
+        }
+        copy[len]=0;
+        n=strtod(copy,0);
+        if (copy!=buf) cJSON_free(copy);
+    }
+
+    *value=n;
+    return num;
+}
 
-    n=sign*n*pow(10.0,(scale+subscale*signsubscale));   /* number = +/- number.fraction * 10^+/- exponent */
+const char *cJSON_ParseNumber(const char *num,double *value)
+{
+    return parse_number_value(num,value);
+}
+
+/* Parse the input text to generate a number, and populate the result into item. */
+static const char *parse_number(cJSON *item,const char *num)
+{
+    double n;
 
+    num=parse_number_value(num,&n);
+    if (!num) return 0;
     item->valuedouble=n;
     item->valueint=(int)n;
     item->type=cJSON_Number;
@@ -178,6 +242,249 @@ static int update(printbuffer *p)
     return p->offset+strlen(str);
 }
 
+/* Render an int into str without going through sprintf. */
+static void print_int(char *str,int i)
+{
+    char tmp[12];
+    unsigned int u=(i<0)?0u-(unsigned int)i:(unsigned int)i;
+    int len=0;
+
+    do tmp[len++]=(char)('0'+u%10),u/=10;
+    while (u);
+    if (i<0) *str++='-';
+    while (len) *str++=tmp[--len];
+    *str=0;
+}
+
+/* Shortest digits of a double, Grisu2 of Florian Loitsch ("Printing
+   Floating-Point Numbers Quickly and Accurately with Integers", PLDI 2010).
+   The digits always read back to the same double. Grisu2 alone gives the
+   shortest such digits for about 99.9% of the doubles, grisu_shorten()
+   finds them for the others. No locale is involved. A diyfp is f*2^e with a 64 bit f. */
+typedef struct {unsigned long long f;int e;} diyfp;
+
+/* 10^k rounded to 64 bits, normalised, for k=-348,-340,...,340. */
+static const unsigned long long grisu_pow_f[]={
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL};
+static const short grisu_pow_e[]={
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+    -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+    -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+    1013, 1039, 1066};
+
+static const unsigned long long grisu_pow10[]={1ULL,10ULL,100ULL,1000ULL,10000ULL,100000ULL,1000000ULL,
+    10000000ULL,100000000ULL,1000000000ULL,10000000000ULL,100000000000ULL,1000000000000ULL,
+    10000000000000ULL,100000000000000ULL,1000000000000000ULL,10000000000000000ULL,
+    100000000000000000ULL,1000000000000000000ULL,10000000000000000000ULL};
+
+/* Upper 64 bits of the product, rounded. */
+static diyfp diyfp_mul(diyfp x,diyfp y)
+{
+    unsigned long long a=x.f>>32,b=x.f&0xFFFFFFFFULL,c=y.f>>32,d=y.f&0xFFFFFFFFULL;
+    unsigned long long ac=a*c,bc=b*c,ad=a*d,bd=b*d,tmp;
+    diyfp r;
+
+    tmp=(bd>>32)+(ad&0xFFFFFFFFULL)+(bc&0xFFFFFFFFULL)+(1ULL<<31);
+    r.f=ac+(ad>>32)+(bc>>32)+(tmp>>32);
+    r.e=x.e+y.e+64;
+    return r;
+}
+
+static diyfp diyfp_normalize(diyfp x)
+{
+    while (!(x.f&(1ULL<<63))) x.f<<=1,x.e--;
+    return x;
+}
+
+/* Step the last digit down while the result gets closer to the value. */
+static void grisu_round(char *buffer,int len,unsigned long long delta,unsigned long long rest,
+    unsigned long long ten_kappa,unsigned long long wp_w)
+{
+    while (rest<wp_w && delta-rest>=ten_kappa && (rest+ten_kappa<wp_w || wp_w-rest>rest+ten_kappa-wp_w))
+        buffer[len-1]--,rest+=ten_kappa;
+}
+
+/* Digits of mp, as few as keep them within delta of it. */
+static int grisu_digits(diyfp w,diyfp mp,unsigned long long delta,char *buffer,int *k)
+{
+    unsigned long long one=1ULL<<-mp.e,wp_w=mp.f-w.f,p2=mp.f&(one-1),tmp;
+    unsigned int p1=(unsigned int)(mp.f>>-mp.e),d;
+    int kappa=10,len=0;
+
+    while (kappa>1 && p1<grisu_pow10[kappa-1]) kappa--;
+    while (kappa>0)
+    {
+        d=p1/(unsigned int)grisu_pow10[kappa-1];
+        p1%=(unsigned int)grisu_pow10[kappa-1];
+        if (d || len) buffer[len++]=(char)('0'+d);
+        kappa--;
+        tmp=((unsigned long long)p1<<-mp.e)+p2;
+        if (tmp<=delta)
+        {
+            *k+=kappa;
+            grisu_round(buffer,len,delta,tmp,grisu_pow10[kappa]<<-mp.e,wp_w);
+            return len;
+        }
+    }
+    for (;;)
+    {
+        p2*=10,delta*=10;
+        d=(unsigned int)(p2>>-mp.e);
+        if (d || len) buffer[len++]=(char)('0'+d);
+        p2&=one-1;
+        kappa--;
+        if (p2<delta)
+        {
+            *k+=kappa;
+            grisu_round(buffer,len,delta,p2,one,(-kappa<20)?wp_w*grisu_pow10[-kappa]:0);
+            return len;
+        }
+    }
+}
+
+/* Shortest digits of d>0 into buffer, d is digits*10^k. Returns the digit count. */
+static int grisu2(double d,char *buffer,int *k)
+{
+    unsigned long long bits;
+    diyfp v,mp,mm,c;
+    double dk;
+    int ki,index;
+
+    memcpy(&bits,&d,sizeof(bits));
+    v.f=bits&0x000FFFFFFFFFFFFFULL;
+    v.e=(int)((bits>>52)&0x7FF);
+    if (v.e) v.f+=0x0010000000000000ULL,v.e-=1075;
+    else v.e=-1074;
+
+    /* The boundaries halfway to the neighbouring doubles, mm on mp's exponent. */
+    mp.f=(v.f<<1)+1,mp.e=v.e-1;
+    mp=diyfp_normalize(mp);
+    if (v.f==0x0010000000000000ULL) mm.f=(v.f<<2)-1,mm.e=v.e-2;
+    else mm.f=(v.f<<1)-1,mm.e=v.e-1;
+    mm.f<<=mm.e-mp.e,mm.e=mp.e;
+
+    /* A cached power brings the exponent of mp into [-60,-32]. */
+    dk=(-61-mp.e)*0.30102999566398114+347;
+    ki=(int)dk;
+    if (dk-ki>0.0) ki++;
+    index=(ki>>3)+1;
+    *k=-(-348+(index<<3));
+    c.f=grisu_pow_f[index],c.e=grisu_pow_e[index];
+
+    v=diyfp_mul(diyfp_normalize(v),c);
+    mp=diyfp_mul(mp,c),mm=diyfp_mul(mm,c);
+    mp.f--,mm.f++;
+    return grisu_digits(v,mp,mp.f-mm.f,buffer,k);
+}
+
+/* Grisu2 misses the shortest digits when they lie in the margin it keeps
+   for its own rounding, and then goes on to 16 or 17 digits. Those are
+   tried one digit shorter, rounded, or one unit either way of it, and kept
+   while one of them reads back to d. */
+static int grisu_shorten(double d,char *digits,int len,int *k)
+{
+    unsigned long long base,cand;
+    char text[40];
+    double back;
+    int n,i,c,clen,ck,found;
+
+    while (len>1)
+    {
+        n=len-1,found=0;
+        for (base=0,i=0;i<n;i++) base=base*10+(digits[i]-'0');
+        base+=(digits[n]>='5');
+        for (c=0;c<3 && !found;c++)
+        {
+            cand=(c==0)?base:(c==1)?base-1:base+1;
+            if (!cand) continue;
+            ck=*k+len-n;
+            while (cand%10==0) cand/=10,ck++;
+            clen=sprintf(text,"%llu",cand);
+            text[clen]='e';
+            print_int(text+clen+1,ck);
+            if (parse_number_value(text,&back) && back==d)
+            {
+                memcpy(digits,text,clen);
+                len=clen,*k=ck,found=1;
+            }
+        }
+        if (!found) break;
+    }
+    return len;
+}
+
+/* Lay out digits*10^k like JavaScript does: plain up to 21 integer digits
+   or 6 leading zeros, exponent form past that. */
+static void grisu_format(char *str,double d)
+{
+    char digits[20];
+    int len,k,point,i;
+
+    if (d<0) *str++='-',d=-d;
+    len=grisu2(d,digits,&k);
+    if (len>=16) len=grisu_shorten(d,digits,len,&k);
+    point=len+k;                    /* 10^(point-1) <= d < 10^point */
+    if (len<=point && point<=21)
+    {
+        memcpy(str,digits,len);
+        for (i=len;i<point;i++) str[i]='0';
+        str[point]=0;
+    }
+    else if (0<point && point<=21)
+    {
+        memcpy(str,digits,point);
+        str[point]='.';
+        memcpy(str+point+1,digits+point,len-point);
+        str[len+1]=0;
+    }
+    else if (-6<point && point<=0)
+    {
+        str[0]='0',str[1]='.';
+        for (i=0;i<-point;i++) str[2+i]='0';
+        memcpy(str+2-point,digits,len);
+        str[2-point+len]=0;
+    }
+    else
+    {
+        *str++=digits[0];
+        if (len>1) *str++='.',memcpy(str,digits+1,len-1),str+=len-1;
+        *str++='e';
+        print_int(str,point-1);
+    }
+}
+
 /* Render the number nicely from the given item into a string. */
 static char *print_number(cJSON *item,printbuffer *p)
 {
@@ -189,11 +496,11 @@ static char *print_number(cJSON *item,printbuffer *p)
         else    str=(char*)cJSON_malloc(2); /* special case for 0. */
         if (str) strcpy(str,"0");
     }
-    else if (fabs(((double)item->valueint)-d)<=DBL_EPSILON && d<=INT_MAX && d>=INT_MIN)
+    else if (((double)item->valueint)==d && d<=INT_MAX && d>=INT_MIN)
     {
         if (p)  str=ensure(p,21);
         else    str=(char*)cJSON_malloc(21);    /* 2^64+1 can be represented in 21 chars. */
-        if (str)    sprintf(str,"%d",item->valueint);
+        if (str)    print_int(str,item->valueint);
     }
     else
     {
@@ -201,9 +508,8 @@ static char *print_number(cJSON *item,printbuffer *p)
         else    str=(char*)cJSON_malloc(64);    /* This is a nice tradeoff. */
         if (str)
         {
-            if (fabs(floor(d)-d)<=DBL_EPSILON && fabs(d)<1.0e60)sprintf(str,"%.0f",d);
-            else if (fabs(d)<1.0e-6 || fabs(d)>1.0e9)           sprintf(str,"%e",d);
-            else                                                sprintf(str,"%f",d);
+            if (d!=d || d-d!=0) strcpy(str,"null");     /* NaN and infinity are not JSON. */
+            else grisu_format(str,d);
         }
     }
     return str;
@@ -252,7 +558,7 @@ static const char *parse_string(cJSON *item,const char *str)
         return 0;
     }
 
-    while (*ptr!='\"' && *ptr && ++len) if (*ptr++ == '\\') ptr++;  /* Skip escaped quotes. */
+    while (*ptr!='\"' && *ptr && ++len) if (*ptr++ == '\\' && *ptr) ptr++;  /* Skip escaped quotes. */
 
     out=(char*)cJSON_malloc(len+1); /* This is how long we need for the string, roughly. */
     if (!out) return 0;
@@ -265,6 +571,7 @@ static const char *parse_string(cJSON *item,const char *str)
         else
         {
             ptr++;
+            if (!*ptr) break;    /* escape cut by the end of the text. */
             switch (*ptr)
             {
                 case 'b':
@@ -284,16 +591,15 @@ static const char *parse_string(cJSON *item,const char *str)
                     break;
                 case 'u':    /* transcode utf16 to utf8. */
                     uc=parse_hex4(ptr+1);
-                    ptr+=4;    /* get the unicode char. */
-
                     if ((uc>=0xDC00 && uc<=0xDFFF) || uc==0)    break;  /* check for invalid.   */
+                    ptr+=4;    /* get the unicode char. */
 
                     if (uc>=0xD800 && uc<=0xDBFF)   /* UTF16 surrogate pairs.   */
                     {
                         if (ptr[1]!='\\' || ptr[2]!='u')    break;  /* missing second-half of surrogate.    */
                         uc2=parse_hex4(ptr+3);
-                        ptr+=6;
                         if (uc2<0xDC00 || uc2>0xDFFF)       break;  /* invalid second-half of surrogate.    */
+                        ptr+=6;
                         uc=0x10000 + (((uc&0x3FF)<<10) | (uc2&0x3FF));
                     }
 
@@ -495,6 +801,11 @@ char *cJSON_PrintBuffered(cJSON *item,int prebuffer,int fmt)
     return p.buffer;
 }
 
+void cJSON_FreeBuffer(char *out)
+{
+    cJSON_free(out);
+}
+
 
 /* Parser core - when encountering text, process appropriately. */
 static const char *parse_value(cJSON *item,const char *value)
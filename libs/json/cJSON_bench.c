@@ -0,0 +1,163 @@
+/*
+  Throughput of the cJSON number parser and printer.
+
+  Arrays of 1000 numbers are printed with cJSON_PrintUnformatted() and
+  parsed back with cJSON_Parse(), next to the sprintf()/strtod() loop
+  print_number used before, on integers, sensor readings with 6 decimals
+  and doubles of any bits. The gyro reply of the corpus gives the figure
+  for a whole message. "make bench" runs it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "cJSON.h"
+
+#define BENCH_COUNT     1000
+#define BENCH_NS        300000000ULL
+
+static unsigned long long rng_state=88172645463325252ULL;
+static double values[BENCH_COUNT];
+static char text[BENCH_COUNT*32];
+static char gyro[4096];
+
+static unsigned long long rng(void)
+{
+    rng_state^=rng_state<<13;
+    rng_state^=rng_state>>7;
+    rng_state^=rng_state<<17;
+    return rng_state;
+}
+
+static unsigned long long now_ns(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC,&t);
+    return (unsigned long long)t.tv_sec*1000000000ULL+t.tv_nsec;
+}
+
+static void print_cjson(void)
+{
+    cJSON *array=cJSON_CreateDoubleArray(values,BENCH_COUNT);
+    free(cJSON_PrintUnformatted(array));
+    cJSON_Delete(array);
+}
+
+/* print_number before the Grisu2 change */
+static void print_sprintf(void)
+{
+    char buf[64];
+    int i,prec;
+
+    for (i=0;i<BENCH_COUNT;i++)
+    {
+        for (prec=15;prec<17;prec++)
+        {
+            sprintf(buf,"%.*g",prec,values[i]);
+            if (strtod(buf,0)==values[i]) break;
+        }
+        if (prec==17) sprintf(buf,"%.17g",values[i]);
+    }
+}
+
+static void parse_cjson(void)
+{
+    cJSON_Delete(cJSON_Parse(text));
+}
+
+static void parse_strtod(void)
+{
+    char *p=text+1;
+    volatile double d;
+
+    while (*p && *p!=']') d=strtod(p,&p),p++;
+    (void)d;
+}
+
+static void print_gyro(void)
+{
+    static cJSON *tree;
+
+    if (!tree) tree=cJSON_Parse(gyro);
+    free(cJSON_Print(tree));
+}
+
+static void parse_gyro(void)
+{
+    cJSON_Delete(cJSON_Parse(gyro));
+}
+
+static void run(const char *name,void (*op)(void),int items,int bytes)
+{
+    unsigned long long start=now_ns(),ns;
+    unsigned long n=0;
+
+    do op(),n++;
+    while ((ns=now_ns()-start)<BENCH_NS);
+    printf("%-28s %10.1f ns/op %12.0f items/s",name,(double)ns/n,(double)items*n*1e9/ns);
+    if (bytes) printf(" %8.1f MB/s",(double)bytes*n*1e3/ns);
+    printf("\n");
+}
+
+static void dataset(const char *name,int kind)
+{
+    char label[64];
+    cJSON *array;
+    char *out;
+    int i;
+
+    for (i=0;i<BENCH_COUNT;i++)
+    {
+        unsigned long long bits=rng();
+        switch (kind)
+        {
+            case 0: values[i]=(double)((int)(bits%200001)-100000); break;
+            case 1: values[i]=(double)((long long)(bits%360000001ULL)-180000000LL)/1e6; break;
+            default:
+                memcpy(&values[i],&bits,sizeof(double));
+                if (values[i]!=values[i] || values[i]-values[i]!=0) values[i]=1.0;
+                break;
+        }
+    }
+    array=cJSON_CreateDoubleArray(values,BENCH_COUNT);
+    out=cJSON_PrintUnformatted(array);
+    strcpy(text,out);
+    free(out);
+    cJSON_Delete(array);
+
+    sprintf(label,"print/%s/cJSON",name);
+    run(label,print_cjson,BENCH_COUNT,0);
+    sprintf(label,"print/%s/sprintf",name);
+    run(label,print_sprintf,BENCH_COUNT,0);
+    sprintf(label,"parse/%s/cJSON",name);
+    run(label,parse_cjson,BENCH_COUNT,strlen(text));
+    sprintf(label,"parse/%s/strtod",name);
+    run(label,parse_strtod,BENCH_COUNT,strlen(text));
+}
+
+int main(int argc,char *argv[])
+{
+    const char *path=(argc>1)?argv[1]:"../../corpus/ReadSensorValue/gyro.json";
+    FILE *fp;
+    int len;
+
+    dataset("int",0);
+    dataset("sensor",1);
+    dataset("double",2);
+
+    fp=fopen(path,"rb");
+    if (!fp)
+    {
+        fprintf(stderr,"Cannot open %s\n",path);
+        return 1;
+    }
+    len=fread(gyro,1,sizeof(gyro)-1,fp);
+    gyro[len]=0;
+    fclose(fp);
+    run("print/gyro reply",print_gyro,1,len);
+    run("parse/gyro reply",parse_gyro,1,len);
+
+    return 0;
+}
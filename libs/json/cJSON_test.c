@@ -0,0 +1,148 @@
+/*
+  Conformance of the cJSON number parser and printer.
+
+  Every double printed by cJSON must read back to the same bits, through
+  strtod() and through cJSON itself, in the fewest digits which do. The
+  reference for those is the shortest %.Ng of the C library.
+  Decimal text, as the robot sends it, must parse to the double strtod()
+  gives. "make test" runs it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "cJSON.h"
+
+static unsigned long long rng_state=88172645463325252ULL;
+
+static unsigned long long rng(void)
+{
+    rng_state^=rng_state<<13;
+    rng_state^=rng_state>>7;
+    rng_state^=rng_state<<17;
+    return rng_state;
+}
+
+static char *print_double(double d)
+{
+    cJSON *item=cJSON_CreateNumber(d);
+    char *out=cJSON_PrintUnformatted(item);
+
+    cJSON_Delete(item);
+    return out;
+}
+
+static int same(double a,double b)
+{
+    return !memcmp(&a,&b,sizeof(double));
+}
+
+/* Fewest %g digits which read back to d. */
+static int shortest_len(double d,char *buf)
+{
+    int prec;
+
+    for (prec=1;prec<17;prec++)
+    {
+        sprintf(buf,"%.*g",prec,d);
+        if (strtod(buf,0)==d) break;
+    }
+    if (prec==17) sprintf(buf,"%.17g",d);
+    return prec;
+}
+
+static int digit_count(const char *s)
+{
+    int n=0,lead=1,zeros=0;
+
+    for (;*s && *s!='e';s++)
+    {
+        if (*s<'0' || *s>'9') continue;
+        if (lead && *s=='0') continue;
+        lead=0;
+        if (*s=='0') zeros++;
+        else n+=zeros+1,zeros=0;
+    }
+    return n;
+}
+
+static int check_print(double d)
+{
+    char ref[64],*out=print_double(d);
+    const char *end;
+    double back;
+    int ok=1,len,best;
+
+    if (!out) return 0;
+    back=strtod(out,0);
+    end=cJSON_ParseNumber(out,&back);
+    if (!same(strtod(out,0),d) || !end || *end || !same(back,d)) ok=0;
+    len=digit_count(out),best=shortest_len(d,ref);
+    if (len!=best) ok=0;
+    if (!ok) printf("FAIL print %.17g -> %s (shortest %s)\n",d,out,ref);
+    free(out);
+    return ok;
+}
+
+static int check_parse(const char *text)
+{
+    double mine=0,ref=strtod(text,0);
+
+    if (cJSON_ParseNumber(text,&mine) && same(mine,ref)) return 1;
+    printf("FAIL parse %s -> %.17g, strtod %.17g\n",text,mine,ref);
+    return 0;
+}
+
+static const struct {double d;const char *text;} fixed[]={
+    {0.0,"0"},{1.0,"1"},{-1.0,"-1"},{0.1,"0.1"},{-0.061035,"-0.061035"},{178.45,"178.45"},
+    {2147483648.0,"2147483648"},{-2147483649.0,"-2147483649"},{1e21,"1e21"},{1e20,"100000000000000000000"},
+    {1e-6,"0.000001"},{1e-7,"1e-7"},{1.5e-7,"1.5e-7"},{5e-324,"5e-324"},
+    {1.7976931348623157e308,"1.7976931348623157e308"},{2.2250738585072014e-308,"2.2250738585072014e-308"},
+    {0.30000000000000004,"0.30000000000000004"},{123456.789,"123456.789"},
+};
+
+int main(void)
+{
+    char text[64],*out;
+    int i,n,len,point,fail=0;
+    unsigned long long bits;
+    double d;
+
+    for (i=0;i<(int)(sizeof(fixed)/sizeof(fixed[0]));i++)
+    {
+        out=print_double(fixed[i].d);
+        if (!out || strcmp(out,fixed[i].text))
+            printf("FAIL print %.17g -> %s, expected %s\n",fixed[i].d,out?out:"(null)",fixed[i].text),fail++;
+        free(out);
+    }
+
+    /* Any double, by its bits */
+    for (n=0;n<300000;n++)
+    {
+        bits=rng();
+        memcpy(&d,&bits,sizeof(d));
+        if (d!=d || d-d!=0 || d==0) continue;
+        fail+=!check_print(d);
+    }
+    /* Sensor readings, 6 decimals as the robot prints them */
+    for (n=0;n<300000;n++)
+    {
+        sprintf(text,"%.6f",(double)(long long)(rng()%2000000001ULL-1000000000LL)/1000.0);
+        fail+=!check_parse(text);
+        fail+=!check_print(strtod(text,0));
+    }
+    /* Decimal text of every length and exponent */
+    for (n=0;n<300000;n++)
+    {
+        len=sprintf(text,"%s%llu",(rng()&1)?"-":"",rng()>>(rng()%64));
+        point=1+(int)(rng()%len);
+        if (point<len && text[point-1]!='-')
+            memmove(text+point+1,text+point,len-point+1),text[point]='.';
+        if (rng()&1) sprintf(text+strlen(text),"e%d",(int)(rng()%700)-350);
+        fail+=!check_parse(text);
+    }
+
+    printf("%s: %d failures\n",fail?"FAIL":"PASS",fail);
+    return fail!=0;
+}
@@ -16,6 +16,7 @@
 #include <string.h>
 #include <pthread.h>
 #include <errno.h>
+#include <math.h>
 #include <signal.h>
 #include <sys/socket.h>
 #include <sys/time.h>
@@ -26,6 +27,8 @@
 #include <linux/sockios.h>
 #include <dirent.h>
 #include <sys/un.h>
+#include <sys/eventfd.h>
+#include <poll.h>
 
 #include "cJSON.h"
 #include "robotlogstr.h"
@@ -34,6 +37,18 @@
 
 #include "RobotApi.h"
 #include "RobotMsg.h"
+#include "RobotMsgArena.h"
+#include "RobotHts.h"
+#include "RobotProfile.h"
+#include "RobotTrajectory.h"
+#include "RobotMotionLib.h"
+#include "RobotSimplify.h"
+#include "RobotCapture.h"
+#include "RobotKinematics.h"
+#include "RobotSafety.h"
+#include "RobotGait.h"
+#include "RobotBalance.h"
+#include "RobotSensor.h"
 
 
 #define MOTION_TYPE_TURNAROUND          "turn around"
@@ -43,6 +58,36 @@
 #define MOTION_DIRECTION_BOTHHAND_STR   "both"
 #define MOTION_DIRECTION_FRONT_STR      "front"
 #define MOTION_DIRECTION_BACK_STR       "back"
+/* Generated motion files */
+#define MOTION_HTS_DIR                  "/mnt/1xrobot/tmp"
+/* Max length of an action name kept for the completion event */
+#define ACTION_NAME_MAX_LEN             (64)
+/* Play status polling period once an action should be over, in ms */
+#define ACTION_POLL_PERIOD_MS           (100)
+/* Max actions waiting in the action queue */
+#define ACTION_QUEUE_MAX_LEN            (32)
+/* Frame period of the profiled HTS actions */
+#define SERVO_PROFILE_FRAME_MS          (60)
+/* Limb poses computed at once by ubtComputeLimbPoses() */
+#define LIMB_POSE_BATCH                 (64)
+/* Frame period of the walking gait, streamed or in an HTS action */
+#define SERVO_GAIT_FRAME_MS             (40)
+/* Wait for the servo offsets while connecting, in s, and the largest
+   offset taken as a calibration, in degree */
+#define SERVO_OFFSET_TIMEOUT_S          (1)
+#define SERVO_OFFSET_MAX                (30)
+#define SERVO_OFFSET_UNSUPPORTED_NUM    (8)
+/* Wait for the robot to answer a sensor configuration, in ms, longest
+   wait of the subscription thread so it stops in time, and the samples
+   kept in the subscription ring, in seconds */
+#define SENSOR_SUB_TIMEOUT_MS           (1000)
+#define SENSOR_SUB_WAIT_MS              (100)
+#define SENSOR_SUB_RING_SECONDS         (4)
+/* Max samples per second of a subscribed sensor */
+#define SENSOR_SUB_MAX_HZ               (100)
+/* Max sensors read at once by ubtReadSensors(), and room for their answer */
+#define SENSOR_BATCH_MAX_NUM            (16)
+#define SENSOR_BATCH_MESSAGE_MAX_LEN    (4096)
 
 
 /* define all servo index */
@@ -101,6 +146,12 @@ typedef enum
     SERVO_MOVE_SPEED_LAST_INVALID  /**< Invalid value */
 } SERVO_MOVE_SPEED_e;
 
+typedef struct {
+    int iId;
+    int iRepeat;
+    char acName[ACTION_NAME_MAX_LEN];
+} ACTION_QUEUE_ITEM_T;
+
 
 /* Socket to robot */
 #define SDK_REMOTE_SOCKET_PORT      20001
@@ -130,6 +181,138 @@ UBTEDU_ROBOTINFO_T g_stConnectedRobotInfo;
 static pthread_mutex_t stMutex;
 /* SDK connecting status */
 static int g_iConnectingStatus = 0;
+/* Last servo angles acknowledged by the robot, 0 is unknown */
+static unsigned char g_aucServoShadow[MAX_SERVO_NUM];
+/* Monotonic time in us from which each shadow angle holds */
+static unsigned long long g_aullServoShadowUs[MAX_SERVO_NUM];
+/* Cached servo reads */
+static UBTEDU_SERVO_SHADOW_STATS_T g_stServoShadowStats;
+/* Mutex for the servo shadow */
+static pthread_mutex_t g_stServoShadowMutex = PTHREAD_MUTEX_INITIALIZER;
+/* Calibration offsets of the connected robot, read once per connection and
+   guarded by the shadow mutex. They are added to the angles on the wire,
+   everything above works in calibrated angles. */
+static signed char g_acServoOffset[MAX_SERVO_NUM];
+static int g_iServoOffsetValid = 0;
+static int g_iServoOffsetEnable = 1;
+/* Robots, by name or by IP address, which did not give their offsets.
+   They are not asked again, old firmware never answers. */
+static char g_aacServoOffsetUnsupported[SERVO_OFFSET_UNSUPPORTED_NUM][UBTEDU_ROBOT_NAME_LEN];
+static int g_iServoOffsetUnsupportedNext = 0;
+/* Servo shadow refresh thread and its period, 0 when it is stopped */
+static pthread_t g_stServoRefreshThread;
+static volatile int g_iServoRefreshPeriodMs = 0;
+/* Keyframes of the servo stream */
+static ROBOT_TRAJ_T g_stServoStreamTraj;
+/* Statistics of the servo stream */
+static UBTEDU_SERVO_STREAM_STATS_T g_stServoStreamStats;
+/* Sum of the wake up delays, for uiJitterAvgUs */
+static unsigned long long g_ullServoStreamJitterSumUs = 0;
+/* Mutex for the servo stream keyframes and statistics */
+static pthread_mutex_t g_stServoStreamMutex = PTHREAD_MUTEX_INITIALIZER;
+/* Servo stream control thread */
+static pthread_t g_stServoStreamThread;
+/* Servo stream control period */
+static int g_iServoStreamPeriodUs = 0;
+/* Servo stream start time, origin of the keyframe clock */
+static struct timespec g_stServoStreamStart;
+/* Servo stream status, only written by the caller's thread */
+static volatile int g_iServoStreamRunning = 0;
+/* Servo limits of the profiled motions */
+static ROBOT_PROFILE_LIMIT_T g_stServoLimit;
+/* Limb poses of the last servo angles */
+static ROBOT_KIN_T g_stKinematics;
+static pthread_mutex_t g_stKinematicsMutex = PTHREAD_MUTEX_INITIALIZER;
+/* Last inverse kinematics solution of each limb, the next search starts there */
+static unsigned char g_aucKinSolved[MAX_SERVO_NUM];
+/* Walking gait fed to the servo stream */
+static ROBOT_GAIT_T g_stGait;
+static pthread_mutex_t g_stGaitMutex = PTHREAD_MUTEX_INITIALIZER;
+/* Gait thread, it stops once the feet are together when g_iGaitStopping is set */
+static pthread_t g_stGaitThread;
+static volatile int g_iGaitRunning = 0;
+static volatile int g_iGaitStopping = 0;
+/* Balance controller and its statistics */
+static ROBOT_BALANCE_T g_stBalance;
+static UBTEDU_BALANCE_STATS_T g_stBalanceStats;
+static unsigned long long g_ullBalanceLatencySumUs = 0;
+static pthread_mutex_t g_stBalanceMutex = PTHREAD_MUTEX_INITIALIZER;
+/* Balance thread and its period */
+static pthread_t g_stBalanceThread;
+static int g_iBalancePeriodUs = 0;
+/* Balance status, only written by the caller's thread */
+static volatile int g_iBalanceRunning = 0;
+/* Captured servo samples, swapped under the mutex while
+   ubtCaptureExport() may read them */
+static ROBOT_CAPTURE_T g_stCapture;
+static pthread_mutex_t g_stCaptureMutex = PTHREAD_MUTEX_INITIALIZER;
+/* Servo capture thread */
+static pthread_t g_stCaptureThread;
+/* Servo capture period */
+static int g_iCapturePeriodUs = 0;
+/* Servo reads which failed during the capture */
+static unsigned int g_uiCaptureFailed = 0;
+/* Servo capture status, only written by the caller's thread */
+static volatile int g_iCaptureRunning = 0;
+/* Samples of the subscribed sensors, swapped under the mutex while
+   ubtReadSensorSamples() may read them */
+static ROBOT_SENSOR_RING_T g_stSensorRing;
+static pthread_mutex_t g_stSensorRingMutex = PTHREAD_MUTEX_INITIALIZER;
+/* Last samples of each sensor, from the subscription and the reads */
+static ROBOT_SENSOR_HISTORY_T g_astSensorHistory[UBTEDU_SENSOR_INVALID];
+/* Subscribed sensors, and the ones polled as the robot does not push
+   them, bit per UBTEDU_SENSOR_TYPE_e */
+static unsigned int g_uiSensorSubMask = 0;
+static unsigned int g_uiSensorPollMask = 0;
+/* Socket and port the robot sends the samples to */
+static int g_iSensorSubFd = -1;
+static int g_iSensorSubPort = -1;
+/* Poll period */
+static int g_iSensorSubPeriodUs = 0;
+/* Sample callback */
+static UBTEDU_SENSOR_CB g_pfnSensorSample = NULL;
+static void *g_pSensorSampleArg = NULL;
+/* Samples received and polls not answered */
+static unsigned int g_uiSensorSubReceived = 0;
+static unsigned int g_uiSensorSubFailed = 0;
+/* Sensor subscription thread, its status only written by the caller's thread */
+static pthread_t g_stSensorSubThread;
+static volatile int g_iSensorSubRunning = 0;
+/* Action started by ubtStartRobotActionAsync() */
+static char g_acActionName[ACTION_NAME_MAX_LEN];
+/* Action completion is checked again at this time */
+static struct timespec g_stActionDeadline;
+/* 1 while an action waits for its completion event */
+static int g_iActionPending = 0;
+/* 1 when the pending action has a known end, an infinite one only ends
+   when the robot says so */
+static int g_iActionFinite = 0;
+/* Changed each time an action is started or stopped */
+static unsigned int g_uiActionSeq = 0;
+/* Completion callback */
+static UBTEDU_ACTION_DONE_CB g_pfnActionDone = NULL;
+static void *g_pActionDoneArg = NULL;
+/* eventfd counting the completed actions */
+static int g_iActionEventFd = -1;
+/* Mutex and condition for the action state above */
+static pthread_mutex_t g_stActionMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_stActionCond;
+static pthread_once_t g_stActionOnce = PTHREAD_ONCE_INIT;
+/* Action completion thread */
+static pthread_t g_stActionThread;
+static int g_iActionThreadRunning = 0;
+/* 1 when the action and the queue are paused */
+static int g_iActionPaused = 0;
+/* Time left of the paused action, in ms */
+static long g_lActionRemainMs = 0;
+/* Actions being started outside the queue, which waits for them */
+static int g_iActionHold = 0;
+/* Actions waiting to be played after the pending one */
+static ACTION_QUEUE_ITEM_T g_astActionQueue[ACTION_QUEUE_MAX_LEN];
+static int g_iActionQueueLen = 0;
+static int g_iActionQueueNextId = 1;
+/* Half the round trip of the last start, a queued action is sent this early */
+static long g_lActionLeadMs = 0;
 
 #define UNIX_PATH_PREVIEW  "preview.d"
 
@@ -443,8 +626,8 @@ static void * _ubtTimerTimeout()
 {
     char acIPAddr[UBTEDU_ROBOT_IP_ADDR_LEN];    /**< Robot's IP address */
     int     iPort = 0;
-    cJSON *pJsonRoot = NULL;
-    char *pcSendBuf = NULL;
+    char acSendBuf[SDK_MESSAGE_MAX_LEN];
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
 
     acIPAddr[0] = '\0';
 
@@ -454,31 +637,26 @@ static void * _ubtTimerTimeout()
         return NULL;
     }
 
-    pJsonRoot = cJSON_CreateObject();
-    if (pJsonRoot == NULL)
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_Heartbeat(acSendBuf, sizeof(acSendBuf));
+    RobotMessageArenaEnd();
+    if (UBTEDU_RC_SUCCESS != ubtRet)
     {
         printf("Failed to create json message!\r\n");
         return NULL ;
     }
 
-    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Cmd, pcStr_Msg_Cmd_Heartbeat);
-    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Account, "sdk");
-    pcSendBuf = cJSON_Print(pJsonRoot);
-
     /* g_iConnectingStatus only read in this timer pthread and written in the main pthread */
     while ( 1 == g_iConnectingStatus )
     {
         pthread_mutex_lock(&stMutex);
         strncpy(acIPAddr, g_stConnectedRobotInfo.acIPAddr, sizeof(acIPAddr));
         iPort = g_iSDK2RobotPort;
-        _ubtMsgSend2Robot(g_iSDK2Robot, acIPAddr, iPort, pcSendBuf, strlen(pcSendBuf));
+        _ubtMsgSend2Robot(g_iSDK2Robot, acIPAddr, iPort, acSendBuf, strlen(acSendBuf));
         pthread_mutex_unlock(&stMutex);
         sleep(5);
     }
 
-    free(pcSendBuf);
-    cJSON_Delete(pJsonRoot);
-
     return NULL ;
     /* TODO: Should receive heart beat message from robot */
     /* Start the heart beat timer every 5 seconds */
@@ -556,6 +734,400 @@ static int _ubt_getAngle(char *pcAllAngle, int iAngleID)
     return iValue;
 }
 
+/**
+ * @brief:      _ubtNowUs
+ * @details:    Monotonic time in microseconds
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     unsigned long long
+ */
+static unsigned long long _ubtNowUs(void)
+{
+    struct timespec stNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &stNow);
+    return (unsigned long long)stNow.tv_sec * 1000000ULL + stNow.tv_nsec / 1000;
+}
+
+/**
+ * @brief:      _ubtServoShadowUpdate
+ * @details:    Remember the servo angles which the robot acknowledged.
+ *              Servos given as "FF" keep their last known angle. A written
+ *              angle only holds once the servo has had iTime to get there.
+ * @param[in]   char *pcAllAngle  MAX_SERVO_NUM hex angles
+ * @param[in]   int iTime         Move time in 50ms units, 0 for a read
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtServoShadowUpdate(const char *pcAllAngle, int iTime)
+{
+    unsigned long long ullValidUs;
+    int i, iHigh, iLow;
+
+    ullValidUs = _ubtNowUs() + ((iTime > 0) ? (unsigned long long)iTime * 50000ULL : 0);
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    for (i = 0; (i < MAX_SERVO_NUM) && pcAllAngle[i*2] && pcAllAngle[i*2+1]; i++)
+    {
+        iHigh = _ubtTranslat(pcAllAngle[i*2]);
+        iLow = _ubtTranslat(pcAllAngle[i*2+1]);
+        if ((iHigh < 0) || (iLow < 0) || (iHigh*16 + iLow > 180))
+        {
+            continue;
+        }
+        g_aucServoShadow[i] = iHigh*16 + iLow;
+        g_aullServoShadowUs[i] = ullValidUs;
+    }
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+}
+
+/**
+ * @brief:      _ubtServoShadowReset
+ * @details:    Forget the acknowledged servo angles. Called whenever the
+ *              servos may be moved by something else than a servo message.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtServoShadowReset(void)
+{
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    memset(g_aucServoShadow, 0, sizeof(g_aucServoShadow));
+    memset(g_aullServoShadowUs, 0, sizeof(g_aullServoShadowUs));
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+}
+
+/**
+ * @brief:      _ubtServoOffsetSync
+ * @details:    Hand the offsets in use to the generated HTS files
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtServoOffsetSync(void)
+{
+    signed char acOffset[MAX_SERVO_NUM];
+    int iApply;
+
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    iApply = g_iServoOffsetValid && g_iServoOffsetEnable;
+    memcpy(acOffset, g_acServoOffset, sizeof(acOffset));
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+
+    RobotHtsSetOffset(iApply ? acOffset : NULL);
+}
+
+/**
+ * @brief:      _ubtServoOffsetReset
+ * @details:    Forget the offsets of the robot which was connected
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtServoOffsetReset(void)
+{
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    memset(g_acServoOffset, 0, sizeof(g_acServoOffset));
+    g_iServoOffsetValid = 0;
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+    _ubtServoOffsetSync();
+}
+
+/**
+ * @brief:      _ubtServoOffsetUnsupported
+ * @details:    Find a robot among the ones which did not give their offsets,
+ *              or add it
+ * @param[in]   char *pcRobot   Name of the robot, or its IP address
+ * @param[in]   int iAdd
+ * @param[out]  None
+ * @retval:     int   1 when it was found
+ */
+static int _ubtServoOffsetUnsupported(const char *pcRobot, int iAdd)
+{
+    int i, iFound = 0;
+
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    for (i = 0; (i < SERVO_OFFSET_UNSUPPORTED_NUM) && !iFound; i++)
+    {
+        iFound = !strcmp(g_aacServoOffsetUnsupported[i], pcRobot);
+    }
+    if (!iFound && iAdd)
+    {
+        snprintf(g_aacServoOffsetUnsupported[g_iServoOffsetUnsupportedNext], UBTEDU_ROBOT_NAME_LEN, "%s", pcRobot);
+        g_iServoOffsetUnsupportedNext = (g_iServoOffsetUnsupportedNext + 1) % SERVO_OFFSET_UNSUPPORTED_NUM;
+    }
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+
+    return iFound;
+}
+
+/**
+ * @brief:      _ubtServoOffsetFetch
+ * @details:    Read the calibration offsets of the connected robot. A robot
+ *              which does not give them is driven without offsets, and is
+ *              not asked again when it is connected again.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtServoOffsetFetch(void)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    char acAllOffset[MAX_SERVO_NUM*2+1];
+    char acRobot[UBTEDU_ROBOT_NAME_LEN];
+    signed char acOffset[MAX_SERVO_NUM];
+    int i, iHigh, iLow;
+
+    pthread_mutex_lock(&stMutex);
+    snprintf(acRobot, sizeof(acRobot), "%s", ('\0' != g_stConnectedRobotInfo.acName[0])
+             ? g_stConnectedRobotInfo.acName : g_stConnectedRobotInfo.acIPAddr);
+    pthread_mutex_unlock(&stMutex);
+    if (_ubtServoOffsetUnsupported(acRobot, 0))
+    {
+        _ubtServoOffsetReset();
+        return;
+    }
+
+    acSocketBuffer[0] = '\0';
+    acAllOffset[0] = '\0';
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_ReadServoOffset(g_iRobot2SDKPort, acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer),
+                                   SERVO_OFFSET_TIMEOUT_S);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_ReadServoOffset(acSocketBuffer, acAllOffset, sizeof(acAllOffset));
+    }
+    RobotMessageArenaEnd();
+
+    if ((UBTEDU_RC_SUCCESS == ubtRet) && (strlen(acAllOffset) < MAX_SERVO_NUM*2))
+    {
+        ubtRet = UBTEDU_RC_SOCKET_DECODE_ERROR;
+    }
+    for (i = 0; (UBTEDU_RC_SUCCESS == ubtRet) && (i < MAX_SERVO_NUM); i++)
+    {
+        iHigh = _ubtTranslat(acAllOffset[i*2]);
+        iLow = _ubtTranslat(acAllOffset[i*2+1]);
+        acOffset[i] = (signed char)(iHigh*16 + iLow);
+        if ((iHigh < 0) || (iLow < 0) || (abs(acOffset[i]) > SERVO_OFFSET_MAX))
+        {
+            ubtRet = UBTEDU_RC_SOCKET_DECODE_ERROR;
+        }
+    }
+
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        printf("No servo offsets from the robot, servos are not calibrated!\r\n");
+        _ubtServoOffsetReset();
+        if ((UBTEDU_RC_SOCKET_FAILED != ubtRet) && (UBTEDU_RC_SOCKET_SENDERROR != ubtRet))
+        {
+            _ubtServoOffsetUnsupported(acRobot, 1);
+        }
+        return;
+    }
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    memcpy(g_acServoOffset, acOffset, sizeof(g_acServoOffset));
+    g_iServoOffsetValid = 1;
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+    _ubtServoOffsetSync();
+}
+
+/**
+ * @brief:      _ubtServoOffsetConvert
+ * @details:    Convert hex angles between calibrated angles and the angles
+ *              on the wire. Servos given as "FF" are left alone.
+ * @param[in]   char *pcIn     MAX_SERVO_NUM hex angles
+ * @param[in]   int iSign      1 to add the offsets before sending, -1 to
+ *                             take them off a read
+ * @param[out]  char *pcOut    May be pcIn
+ * @retval:     void
+ */
+static void _ubtServoOffsetConvert(const char *pcIn, char *pcOut, int iSign)
+{
+    signed char acOffset[MAX_SERVO_NUM];
+    char acAngle[4];
+    int i, iHigh, iLow, iAngle, iApply;
+
+    if (pcOut != pcIn)
+    {
+        strcpy(pcOut, pcIn);
+    }
+
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    iApply = g_iServoOffsetValid && g_iServoOffsetEnable;
+    memcpy(acOffset, g_acServoOffset, sizeof(acOffset));
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+    if (!iApply)
+    {
+        return;
+    }
+
+    for (i = 0; (i < MAX_SERVO_NUM) && pcOut[i*2] && pcOut[i*2+1]; i++)
+    {
+        iHigh = _ubtTranslat(pcOut[i*2]);
+        iLow = _ubtTranslat(pcOut[i*2+1]);
+        if ((0 == acOffset[i]) || (iHigh < 0) || (iLow < 0) || (iHigh*16 + iLow > 180))
+        {
+            continue;
+        }
+        iAngle = iHigh*16 + iLow + iSign * acOffset[i];
+        iAngle = (iAngle < 0) ? 0 : ((iAngle > 180) ? 180 : iAngle);
+        snprintf(acAngle, sizeof(acAngle), "%02x", iAngle);
+        pcOut[i*2] = acAngle[0];
+        pcOut[i*2+1] = acAngle[1];
+    }
+}
+
+/**
+ * @brief:      _ubtServoFrameCheck
+ * @details:    Check the servo angles of a frame before it is sent. Angles
+ *              out of the servo range are clamped in the frame, the servos
+ *              given as "FF" are taken at their shadow angle.
+ * @param[in]   char *pcAllAngle  MAX_SERVO_NUM hex angles
+ * @param[out]  char *pcAllAngle  Clamped angles
+ * @retval:     UBTEDU_RC_FAILED when the pose would collide
+ */
+static UBTEDU_RC_T _ubtServoFrameCheck(char *pcAllAngle)
+{
+    unsigned char aucAngle[MAX_SERVO_NUM];
+    unsigned char aucCurrent[MAX_SERVO_NUM];
+    ROBOT_SAFETY_RESULT_e eResult;
+    char acAngle[4];
+    int i, iHigh, iLow;
+
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        iHigh = _ubtTranslat(pcAllAngle[i*2]);
+        iLow = _ubtTranslat(pcAllAngle[i*2+1]);
+        aucAngle[i] = ((iHigh < 0) || (iLow < 0) || (iHigh*16 + iLow > 180)) ? 0 : iHigh*16 + iLow;
+    }
+
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    memcpy(aucCurrent, g_aucServoShadow, sizeof(aucCurrent));
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+
+    eResult = RobotSafetyCheck(aucAngle, aucCurrent);
+    if (ROBOT_SAFETY_COLLISION == eResult)
+    {
+        return UBTEDU_RC_FAILED;
+    }
+    if (ROBOT_SAFETY_CLAMPED == eResult)
+    {
+        for (i = 0; i < MAX_SERVO_NUM; i++)
+        {
+            if (0 != aucAngle[i])
+            {
+                snprintf(acAngle, sizeof(acAngle), "%02x", aucAngle[i]);
+                pcAllAngle[i*2] = acAngle[0];
+                pcAllAngle[i*2+1] = acAngle[1];
+            }
+        }
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      _ubtSetServoStruct
+ * @details:    Copy MAX_SERVO_NUM angles to a servo struct
+ * @param[in]   unsigned char *pucAngle
+ * @param[out]  UBTEDU_ROBOTSERVO_T *pstServo
+ * @retval:     void
+ */
+static void _ubtSetServoStruct(const unsigned char *pucAngle, UBTEDU_ROBOTSERVO_T *pstServo)
+{
+    pstServo->SERVO1_ANGLE = pucAngle[0];
+    pstServo->SERVO2_ANGLE = pucAngle[1];
+    pstServo->SERVO3_ANGLE = pucAngle[2];
+    pstServo->SERVO4_ANGLE = pucAngle[3];
+    pstServo->SERVO5_ANGLE = pucAngle[4];
+    pstServo->SERVO6_ANGLE = pucAngle[5];
+    pstServo->SERVO7_ANGLE = pucAngle[6];
+    pstServo->SERVO8_ANGLE = pucAngle[7];
+    pstServo->SERVO9_ANGLE = pucAngle[8];
+    pstServo->SERVO10_ANGLE = pucAngle[9];
+    pstServo->SERVO11_ANGLE = pucAngle[10];
+    pstServo->SERVO12_ANGLE = pucAngle[11];
+    pstServo->SERVO13_ANGLE = pucAngle[12];
+    pstServo->SERVO14_ANGLE = pucAngle[13];
+    pstServo->SERVO15_ANGLE = pucAngle[14];
+    pstServo->SERVO16_ANGLE = pucAngle[15];
+    pstServo->SERVO17_ANGLE = pucAngle[16];
+}
+
+/**
+ * @brief:      _ubtGetServoStruct
+ * @details:    Copy a servo struct to MAX_SERVO_NUM angles
+ * @param[in]   UBTEDU_ROBOTSERVO_T *pstServo
+ * @param[out]  unsigned char *pucAngle
+ * @retval:     void
+ */
+static void _ubtGetServoStruct(const UBTEDU_ROBOTSERVO_T *pstServo, unsigned char *pucAngle)
+{
+    pucAngle[0] = pstServo->SERVO1_ANGLE;
+    pucAngle[1] = pstServo->SERVO2_ANGLE;
+    pucAngle[2] = pstServo->SERVO3_ANGLE;
+    pucAngle[3] = pstServo->SERVO4_ANGLE;
+    pucAngle[4] = pstServo->SERVO5_ANGLE;
+    pucAngle[5] = pstServo->SERVO6_ANGLE;
+    pucAngle[6] = pstServo->SERVO7_ANGLE;
+    pucAngle[7] = pstServo->SERVO8_ANGLE;
+    pucAngle[8] = pstServo->SERVO9_ANGLE;
+    pucAngle[9] = pstServo->SERVO10_ANGLE;
+    pucAngle[10] = pstServo->SERVO11_ANGLE;
+    pucAngle[11] = pstServo->SERVO12_ANGLE;
+    pucAngle[12] = pstServo->SERVO13_ANGLE;
+    pucAngle[13] = pstServo->SERVO14_ANGLE;
+    pucAngle[14] = pstServo->SERVO15_ANGLE;
+    pucAngle[15] = pstServo->SERVO16_ANGLE;
+    pucAngle[16] = pstServo->SERVO17_ANGLE;
+}
+
+/**
+ * @brief:      _ubtServoSend
+ * @details:    Check a frame, add the calibration offsets and send it. The
+ *              shadow takes the angles once the robot acknowledges them.
+ * @param[in]   char *pcAllAngle  MAX_SERVO_NUM hex angles, "FF" is not moved
+ * @param[in]   int iTime
+ * @param[out]  char *pcAllAngle  Clamped angles
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _ubtServoSend(char *pcAllAngle, int iTime)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    char acWireAngle[MAX_SERVO_NUM*2 + 1];
+
+    if (UBTEDU_RC_SUCCESS != _ubtServoFrameCheck(pcAllAngle))
+    {
+        return UBTEDU_RC_FAILED;
+    }
+
+    _ubtServoOffsetConvert(pcAllAngle, acWireAngle, 1);
+    acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_SetRobotServo(g_iRobot2SDKPort, acWireAngle, iTime,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_SetRobotServo(acSocketBuffer);
+    }
+    RobotMessageArenaEnd();
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        _ubtServoShadowUpdate(pcAllAngle, iTime);
+    }
+
+    return ubtRet;
+}
+
 /**
  * @brief:      ubtSetRobotServo
  * @details:    Set the servo's acAngle with speed
@@ -567,8 +1139,6 @@ static int _ubt_getAngle(char *pcAllAngle, int iAngleID)
  */
 UBTEDU_RC_T _ubtSetRobotServo(int iIndexMask, char *pcAngle, int iTime)
 {
-    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
-    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
     char acAllAngle[MAX_SERVO_NUM*2 + 1];
     int i;
 
@@ -591,24 +1161,7 @@ UBTEDU_RC_T _ubtSetRobotServo(int iIndexMask, char *pcAngle, int iTime)
         }
     }
 
-    acSocketBuffer[0] = '\0';
-    ubtRet = ubtRobot_Msg_Encode_SetRobotServo(g_iRobot2SDKPort, acAllAngle, iTime,
-             acSocketBuffer, sizeof(acSocketBuffer));
-
-    if (UBTEDU_RC_SUCCESS != ubtRet)
-    {
-        return ubtRet;
-    }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
-    {
-        return ubtRet;
-    }
-
-    ubtRet = ubtRobot_Msg_Decode_SetRobotServo(acSocketBuffer);
-
-    return ubtRet;
+    return _ubtServoSend(acAllAngle, iTime);
 }
 
 /**
@@ -641,70 +1194,6 @@ static int _ubtSetServoAngle(char *pcAllAngle, int iAngle, int iServoID)
     return 0;
 }
 
-/**
- * @brief:      _ubt_CreateMotionFrame
- * @details:    create motion frame for hts file
- * @param[in]   char *pcFrame   Created frame data
- * @param[in]   char *pcAngle   Angle data buffer
- * @param[in]   int iServoMask  to be control servo
- * @param[in]   int iSeqFram    current seq in hts file
- * @param[in]   int iTotalFram  total frame in hts file
- * @param[in]   FILE *fd   hts file fd
- * @param[out]  none
- * @retval:     void
- */
-static void _ubt_CreateMotionFrame(char *pcFrame,const char *pcAngle,int iServoMask,int iSeqFram,int iTotalFram,FILE *fd)
-{
-    char acServo[3];
-    int i,offset=0,sum=0;
-
-    acServo[2]='\0';
-    for (i = 0; i < 20; i++) // 20Bytes angle Value
-    {
-        if ((iServoMask >> i) & 0x01)
-        {
-            acServo[0] = *(pcAngle + offset);
-            acServo[1] = *(pcAngle + offset + 1);
-            offset += 2;
-            if(offset > strlen(pcAngle))
-            {
-                printf("ERR: Servo angle buffer not match\r\n");
-                pcFrame[8+i]=0xFF;
-            }
-            else
-            {
-                pcFrame[8+i] = (char)strtol(acServo,NULL,16);
-            }
-        }
-        else
-        {
-            pcFrame[8+i]=0xFF;
-        }
-    }
-
-    // frame status
-    if(1 == iSeqFram)
-        pcFrame[3]= 0x01;//start frame
-    else if( iTotalFram > iSeqFram)
-        pcFrame[3]= 0x02;// middle frame
-    else
-        pcFrame[3]= 0x03; // end frame
-
-    //total frame
-    pcFrame[4] = iTotalFram&0xff;
-    pcFrame[5] = (iTotalFram>>8)&0xff;
-
-    //frame sequence
-    pcFrame[6] = iSeqFram&0xff;
-    pcFrame[7] = (iSeqFram>>8)&0xff;
-
-    for(i=2; i<=30; i++)
-        sum += pcFrame[i];
-    pcFrame[31] = sum&0xff;
-
-    fwrite(pcFrame,33,1,fd);
-}
-
 /**
  * @brief:      _ubtSendUNIXMsg
  * @details:    send UNIX message
@@ -799,22 +1288,20 @@ UBTEDU_RC_T ubtGetSWVersion(UBTEDU_ROBOT_SOFTVERSION_TYPE_e eType, char *pcVersi
     }
 
 
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_SWVersion(pcParam,
                                            g_iRobot2SDKPort,
                                            acSocketBuffer,
                                            sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_SWVersion(acSocketBuffer, pcVersion, iVersionLen);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_SWVersion(acSocketBuffer, pcVersion, iVersionLen);
+    RobotMessageArenaEnd();
 
     return ubtRet;
 }
@@ -878,24 +1365,22 @@ UBTEDU_RC_T ubtGetRobotStatus(UBTEDU_ROBOT_STATUS_TYPE_e eType, void *pStatus)
             printf("GetRobotStatus eType:%d not surport!\r\n", eType);
             return UBTEDU_RC_WRONG_PARAM;
     }
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_RobotStatus(pcStr_Msg_Cmd_Query,
              pcType,
              pcParam,
              g_iRobot2SDKPort,
              acSocketBuffer,
              sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_RobotStatus(pcType, acSocketBuffer, pStatus);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_RobotStatus(pcType, acSocketBuffer, pStatus);
+    RobotMessageArenaEnd();
 
     return ubtRet;
 }
@@ -922,22 +1407,19 @@ UBTEDU_RC_T ubtCheckAPPStatus(char *pcBuf, int iWaitTime)
     }
 
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_CheckAPPStatus(pcStr_Msg_Cmd_Query_App, pcStr_Ret_Msg_Status,
              g_iRobot2SDKPort, tsock,
              pcBuf, acSocketBuffer, sizeof(acSocketBuffer));
-
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_CheckAPPStatus(acSocketBuffer);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_CheckAPPStatus(acSocketBuffer);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -966,20 +1448,18 @@ UBTEDU_RC_T ubtDetectVoiceMsg(char *pcBuf, int iTimeout)
     }
     acSocketBuffer[0] = '\0';
 
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_DetectVoiceMsg(g_iRobot2SDKPort, pcBuf,
              acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_DetectVoiceMsg(acSocketBuffer);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_DetectVoiceMsg(acSocketBuffer);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -997,23 +1477,25 @@ UBTEDU_RC_T ubtRecordMotion(UBTEDU_ROBOTSERVO_T *servoAngle)
     char ucAllAngle[MAX_SERVO_NUM*2+1];
 
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_ReadRobotServo(g_iRobot2SDKPort, acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_ReadRobotServo(acSocketBuffer, ucAllAngle, sizeof(ucAllAngle));
     }
-
-    ubtRet = ubtRobot_Msg_Decode_ReadRobotServo(acSocketBuffer, ucAllAngle, sizeof(ucAllAngle));
+    RobotMessageArenaEnd();
+    /* The read releases the servos to be moved by hand, so whatever was
+       acknowledged no longer holds, even when the answer was lost */
+    _ubtServoShadowReset();
     if(UBTEDU_RC_SUCCESS != ubtRet )
     {
         return ubtRet;
     }
+    _ubtServoOffsetConvert(ucAllAngle, ucAllAngle, -1);
 
     servoAngle->SERVO1_ANGLE = _ubt_getAngle(ucAllAngle,1);
     servoAngle->SERVO2_ANGLE = _ubt_getAngle(ucAllAngle,2);
@@ -1050,23 +1532,23 @@ UBTEDU_RC_T ubtGetRobotServo(UBTEDU_ROBOTSERVO_T *servoAngle)
     char ucAllAngle[MAX_SERVO_NUM*2+1];
 
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_ReadRobotServoHold(g_iRobot2SDKPort, acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_ReadRobotServo(acSocketBuffer, ucAllAngle, sizeof(ucAllAngle));
     }
-
-    ubtRet = ubtRobot_Msg_Decode_ReadRobotServo(acSocketBuffer, ucAllAngle, sizeof(ucAllAngle));
+    RobotMessageArenaEnd();
     if(UBTEDU_RC_SUCCESS != ubtRet )
     {
         return ubtRet;
     }
+    _ubtServoOffsetConvert(ucAllAngle, ucAllAngle, -1);
+    _ubtServoShadowUpdate(ucAllAngle, 0);
 
     servoAngle->SERVO1_ANGLE = _ubt_getAngle(ucAllAngle,1);
     servoAngle->SERVO2_ANGLE = _ubt_getAngle(ucAllAngle,2);
@@ -1091,825 +1573,3517 @@ UBTEDU_RC_T ubtGetRobotServo(UBTEDU_ROBOTSERVO_T *servoAngle)
 
 
 /**
- * @brief:      ubtSetRobotServo
- * @details:    Set servo's acAngle with speed
- * @param[in]   UBTEDU_ROBOTSERVO_T *servoAngle
- * @param[in]   int iTime   It is the time for servo, the value is smaller, the speed is faster.
- * @param[out]  None
+ * @brief:      ubtGetRobotServoCached
+ * @details:    Read all servo's angle from the local shadow when every
+ *              angle is known and not older than iMaxAgeMs. Otherwise they
+ *              are read from the robot like ubtGetRobotServo(). An angle
+ *              written with a move time only counts once the move is over.
+ * @param[in]   int iMaxAgeMs   0 always reads from the robot
+ * @param[out]  UBTEDU_ROBOTSERVO_T *servoAngle
  * @retval: UBTEDU_RC_T
  */
-UBTEDU_RC_T ubtSetRobotServo(UBTEDU_ROBOTSERVO_T *servoAngle, int iTime)
+UBTEDU_RC_T ubtGetRobotServoCached(UBTEDU_ROBOTSERVO_T *servoAngle, int iMaxAgeMs)
 {
-    UBTEDU_RC_T ubtRet = UBTEDU_RC_WRONG_PARAM;
-    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
-    char acAllAngle[MAX_SERVO_NUM*2+1];
-
-    memset(acAllAngle, 'F', sizeof(acAllAngle)); // null is "FF"
-    acAllAngle[MAX_SERVO_NUM*2] = '\0';
+    unsigned char aucAngle[MAX_SERVO_NUM];
+    unsigned long long ullNowUs, ullMaxAgeUs;
+    int i;
 
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO1_ANGLE,1) < 0 )
-    {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO2_ANGLE,2) < 0 )
-    {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO3_ANGLE,3) < 0 )
-    {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO4_ANGLE,4) < 0 )
+    if ((NULL == servoAngle) || (iMaxAgeMs < 0))
     {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO5_ANGLE,5) < 0 )
-    {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO6_ANGLE,6) < 0 )
-    {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO7_ANGLE,7) < 0 )
-    {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO8_ANGLE,8) < 0 )
-    {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO9_ANGLE,9) < 0 )
-    {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO10_ANGLE,10) < 0 )
-    {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO11_ANGLE,11) < 0 )
-    {
-        return ubtRet;
-    }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO12_ANGLE,12) < 0 )
-    {
-        return ubtRet;
+        return UBTEDU_RC_WRONG_PARAM;
     }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO13_ANGLE,13) < 0 )
+
+    ullNowUs = _ubtNowUs();
+    ullMaxAgeUs = (unsigned long long)iMaxAgeMs * 1000ULL;
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    for (i = 0; i < MAX_SERVO_NUM; i++)
     {
-        return ubtRet;
+        if ((0 == g_aucServoShadow[i]) || (g_aullServoShadowUs[i] > ullNowUs)
+            || (ullNowUs - g_aullServoShadowUs[i] > ullMaxAgeUs))
+        {
+            break;
+        }
     }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO14_ANGLE,14) < 0 )
+    if ((iMaxAgeMs > 0) && (MAX_SERVO_NUM == i))
     {
-        return ubtRet;
+        memcpy(aucAngle, g_aucServoShadow, sizeof(aucAngle));
+        g_stServoShadowStats.uiHits++;
+        pthread_mutex_unlock(&g_stServoShadowMutex);
+        _ubtSetServoStruct(aucAngle, servoAngle);
+        return UBTEDU_RC_SUCCESS;
     }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO15_ANGLE,15) < 0 )
+    g_stServoShadowStats.uiMisses++;
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+
+    return ubtGetRobotServo(servoAngle);
+}
+
+/**
+ * @brief:      ubtServoShadowGetStats
+ * @details:    Get the hits and misses of ubtGetRobotServoCached()
+ * @param[in]   None
+ * @param[out]  UBTEDU_SERVO_SHADOW_STATS_T *pstStats
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoShadowGetStats(UBTEDU_SERVO_SHADOW_STATS_T *pstStats)
+{
+    if (NULL == pstStats)
     {
-        return ubtRet;
+        return UBTEDU_RC_WRONG_PARAM;
     }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO16_ANGLE,16) < 0 )
+
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    *pstStats = g_stServoShadowStats;
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      _ubtServoRefreshThread
+ * @details:    Read the servos from the robot on a fixed period, so cached
+ *              reads find a fresh shadow
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void *
+ */
+static void *_ubtServoRefreshThread(void *arg)
+{
+    UBTEDU_ROBOTSERVO_T stServo;
+    int iPeriodMs;
+
+    while ((iPeriodMs = g_iServoRefreshPeriodMs) > 0)
     {
-        return ubtRet;
+        ubtGetRobotServo(&stServo);
+        usleep(iPeriodMs * 1000);
     }
-    if(_ubtSetServoAngle(acAllAngle,servoAngle->SERVO17_ANGLE,17) < 0 )
+
+    return NULL;
+}
+
+/**
+ * @brief:      ubtServoShadowSetRefresh
+ * @details:    Start, change or stop reading the servos in the background
+ * @param[in]   int iPeriodMs   10 ~ 10000, 0 stops it
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoShadowSetRefresh(int iPeriodMs)
+{
+    int iRunning = (g_iServoRefreshPeriodMs > 0);
+
+    if ((0 != iPeriodMs) && ((iPeriodMs < 10) || (iPeriodMs > 10000)))
     {
-        return ubtRet;
+        return UBTEDU_RC_WRONG_PARAM;
     }
 
-    ubtRet = UBTEDU_RC_FAILED;
-    acSocketBuffer[0] = '\0';
-    ubtRet = ubtRobot_Msg_Encode_SetRobotServo(g_iRobot2SDKPort, acAllAngle, iTime,
-             acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    g_iServoRefreshPeriodMs = iPeriodMs;
+    if ((0 == iPeriodMs) && iRunning)
     {
-        return ubtRet;
+        pthread_join(g_stServoRefreshThread, NULL);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    else if ((iPeriodMs > 0) && !iRunning)
     {
-        return ubtRet;
+        if (0 != pthread_create(&g_stServoRefreshThread, NULL, _ubtServoRefreshThread, NULL))
+        {
+            printf("pthread_create failed \n");
+            g_iServoRefreshPeriodMs = 0;
+            return UBTEDU_RC_FAILED;
+        }
     }
 
-    ubtRet = ubtRobot_Msg_Decode_SetRobotServo(acSocketBuffer);
-
-    return ubtRet;
+    return UBTEDU_RC_SUCCESS;
 }
 
-
 /**
- * @brief:      ubtSetRobotVolume
- * @details:    Set the volume for the Robot
- * @param[in]   int iVolume  [0-100] Volume percent
+ * @brief:      ubtSetRobotServo
+ * @details:    Set servo's acAngle with speed. Like ubtSetServos(), the
+ *              servos already at their angle are not sent again.
+ * @param[in]   UBTEDU_ROBOTSERVO_T *servoAngle
+ * @param[in]   int iTime   It is the time for servo, the value is smaller, the speed is faster.
  * @param[out]  None
  * @retval: UBTEDU_RC_T
  */
-UBTEDU_RC_T ubtSetRobotVolume(int iVolume)
+UBTEDU_RC_T ubtSetRobotServo(UBTEDU_ROBOTSERVO_T *servoAngle, int iTime)
 {
-    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
-    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    unsigned char aucAngle[MAX_SERVO_NUM];
+    const int *piAngle = (const int *)servoAngle;
+    int i;
 
-    acSocketBuffer[0] = '\0';
-    ubtRet = ubtRobot_Msg_Encode_SetRobotVolume(g_iRobot2SDKPort, iVolume,
-             acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (NULL == servoAngle)
     {
-        return ubtRet;
+        return UBTEDU_RC_WRONG_PARAM;
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    /* The struct is MAX_SERVO_NUM ints in servo order, checked before
+       they are narrowed to angles */
+    for (i = 0; i < MAX_SERVO_NUM; i++)
     {
-        return ubtRet;
+        if ((piAngle[i] < 0) || (piAngle[i] > 180))
+        {
+            printf("ERR: Servo %d value is out of range! \r\n", i + 1);
+            return UBTEDU_RC_WRONG_PARAM;
+        }
     }
+    _ubtGetServoStruct(servoAngle, aucAngle);
 
-    ubtRet = ubtRobot_Msg_Decode_SetRobotVolume(acSocketBuffer);
-
-    return ubtRet;
+    return ubtSetServos(aucAngle, (1u << MAX_SERVO_NUM) - 1, iTime);
 }
 
 /**
- * @brief:      ubtSetRobotMotion
- * @details:    Set the robot's action
- * @param[in]   char *pcType    crouch
-  *                             raise
-  *                             stretch
-  *                             come on
-  *                             wave
-  *                             bend
-  *                             walk
-  *                             turn around
-  *                             bow
- * @param[in]   char *pcDirect  left
-  *                             right
-  *                             both
-  *                             front
-  *                             back
- * @param[in]   int iSpeed      1/2/3/4/5  The default value is 3
- * @param[in]   int iRepeat     Repeat times. 0 means infinite
+ * @brief:      ubtSetServos
+ * @details:    Set the angles of any subset of the servos. Only the servos
+ *              whose angle differs from the last one acknowledged by the
+ *              robot are sent, the others are left as "FF". Nothing is sent
+ *              when no servo changes.
+ * @param[in]   uint8_t angles[]  MAX_SERVO_NUM angles(range:0~180), angles[0] is servo 1
+ * @param[in]   uint32_t mask     bit0 - 16 Servo's index
+ * @param[in]   int time   It is the time for servo, the value is smaller, the speed is faster.
  * @param[out]  None
  * @retval: UBTEDU_RC_T
  */
-UBTEDU_RC_T ubtSetRobotMotion(char *pcType, char *pcDirect, int iSpeed, int iRepeat)
+UBTEDU_RC_T ubtSetServos(const uint8_t angles[MAX_SERVO_NUM], uint32_t mask, int time)
 {
-    FILE *fd = NULL;
-    char acFullName[64]= "\0";
-    char acFrame[33];
-    int i, speed, iTotalTime;
-    int iTotalFrame,iLoop;
-    struct timeval tpstart;
-    char acAngle[3];
+    char acAllAngle[MAX_SERVO_NUM*2+1];
+    int i, iChanged = 0;
 
-    if (pcType == NULL)
+    if ((NULL == angles) || (mask >> MAX_SERVO_NUM))
     {
-        printf("SetRobotMotion pcType is null!\r\n");
         return UBTEDU_RC_WRONG_PARAM;
     }
 
-    if(iSpeed<=0 || iSpeed >6)
+    memset(acAllAngle, 'F', sizeof(acAllAngle)); // null is "FF"
+    acAllAngle[MAX_SERVO_NUM*2] = '\0';
+
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    for (i = 0; i < MAX_SERVO_NUM; i++)
     {
-        printf("SetRobotMotion iSpeed is outrange(1~6)\r\n");
-        return UBTEDU_RC_WRONG_PARAM;
+        if (!((mask >> i) & 0x01) || (angles[i] == g_aucServoShadow[i]))
+        {
+            continue;
+        }
+        if (_ubtSetServoAngle(acAllAngle, angles[i], i + 1) < 0)
+        {
+            pthread_mutex_unlock(&g_stServoShadowMutex);
+            return UBTEDU_RC_WRONG_PARAM;
+        }
+        iChanged += (angles[i] != 0);
     }
-    speed = SERVO_MAX_LOW_SPEED/iSpeed;
+    pthread_mutex_unlock(&g_stServoShadowMutex);
 
-    gettimeofday(&tpstart,NULL);
-    srand(tpstart.tv_usec);
-    snprintf(acFullName,sizeof(acFullName),"/mnt/1xrobot/tmp/motion%d.hts", (int)(50.0*rand()/(RAND_MAX+1.0)));
-    if((fd = fopen(acFullName, "wb+")) == NULL)
+    if (0 == iChanged)
     {
-        printf("SetRobotMotion create file failed!\r\n");
-        return UBTEDU_RC_NORESOURCE;
+        return UBTEDU_RC_SUCCESS;
     }
 
-    memset(acFrame,0,sizeof(acFrame));
-    fwrite(acFrame,sizeof(acFrame),1,fd);
+    return _ubtServoSend(acAllAngle, time);
+}
+
+
+/**
+ * @brief:      _ubtBalanceApply
+ * @details:    Add the balance corrections to the driven servos of a frame
+ * @param[in]   unsigned char *pucAngle   MAX_SERVO_NUM angles, 0 is not driven
+ * @param[out]  unsigned char *pucAngle
+ * @retval:     void
+ */
+static void _ubtBalanceApply(unsigned char *pucAngle)
+{
+    int i, iAngle;
 
-    acFrame[0]=0xFB;//LEAD1
-    acFrame[1]=0xBF;//LEAD2
-    acFrame[2]=0x01;//reserve
-    acFrame[28]=speed;//run time
-    acFrame[29]=0x00; //time high byte
-    acFrame[30]=speed;//time low byte
-    acFrame[32]=0xED;//END
-    if (!strcmp(pcType, "crouch"))
+    if (!g_iBalanceRunning)
     {
-        iLoop = 3;
-        iTotalFrame = iRepeat*iLoop;
-        for(i=0; i< iRepeat; i++)
-        {
-            _ubt_CreateMotionFrame(acFrame,"5A3A4A6E595A78684559",SERVO_RANG_INDEX(7,16),i*iLoop+1,iTotalFrame,fd);
-            _ubt_CreateMotionFrame(acFrame,"5E2E00A5555C86B40E5A",SERVO_RANG_INDEX(7,16),i*iLoop+2,iTotalFrame,fd);
-            _ubt_CreateMotionFrame(acFrame,"5A3A4A6E595A78684559",SERVO_RANG_INDEX(7,16),i*iLoop+3,iTotalFrame,fd);
-        }
+        return;
     }
-    else if (!strcmp(pcType, "raise"))
+
+    pthread_mutex_lock(&g_stBalanceMutex);
+    for (i = 0; i < MAX_SERVO_NUM; i++)
     {
-        iLoop = 3;
-        iTotalFrame = iRepeat*iLoop;
-        if (!strcmp(pcDirect, "left"))
-        {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"5b5a5a",SERVO_RANG_INDEX(4,6),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5bad5a",SERVO_RANG_INDEX(4,6),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5b5a5a",SERVO_RANG_INDEX(4,6),i*iLoop+3,iTotalFrame,fd);
-            }
-        }
-        else if (!strcmp(pcDirect, "right"))
-        {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"5b5a5a",SERVO_RANG_INDEX(1,3),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5b075a",SERVO_RANG_INDEX(1,3),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5b5a5a",SERVO_RANG_INDEX(1,3),i*iLoop+3,iTotalFrame,fd);
-            }
-        }
-        else if (!strcmp(pcDirect, "both"))
-        {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"5b5a5a5a5859",SERVO_RANG_INDEX(1,6),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5b075a5aaf5e",SERVO_RANG_INDEX(1,6),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5b5a5a5a5859",SERVO_RANG_INDEX(1,6),i*iLoop+3,iTotalFrame,fd);
-            }
-        }
-        else
+        if (0 != pucAngle[i])
         {
-            printf("raise direct[%s]  error\r\n", pcDirect);
-            goto ERR;
+            iAngle = pucAngle[i] + (int)lrintf(g_stBalance.afOffset[i]);
+            pucAngle[i] = (iAngle < 1) ? 1 : ((iAngle > 180) ? 180 : iAngle);
         }
     }
-    else if (!strcmp(pcType, "stretch"))
+    pthread_mutex_unlock(&g_stBalanceMutex);
+}
+
+/**
+ * @brief:      _ubtServoStreamElapsedMs
+ * @details:    Time on the keyframe clock of the servo stream
+ * @param[in]   struct timespec *pstNow
+ * @param[out]  None
+ * @retval:     unsigned int
+ */
+static unsigned int _ubtServoStreamElapsedMs(struct timespec *pstNow)
+{
+    return (unsigned int)((pstNow->tv_sec - g_stServoStreamStart.tv_sec) * 1000
+                          + (pstNow->tv_nsec - g_stServoStreamStart.tv_nsec) / 1000000);
+}
+
+/**
+ * @brief:      _ubtServoStreamThread
+ * @details:    Control thread of the servo stream. It wakes up on a fixed
+ *              period, samples the keyframes and sends the servos which
+ *              changed through one socket kept for the whole stream. The
+ *              robot's acks arrive on that socket and are counted, they are
+ *              never waited for.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void *
+ */
+static void *_ubtServoStreamThread(void *arg)
+{
+    char acIPAddr[UBTEDU_ROBOT_IP_ADDR_LEN];
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    char acAllAngle[MAX_SERVO_NUM*2+1];
+    char acWireAngle[MAX_SERVO_NUM*2+1];
+    unsigned char aucAngle[MAX_SERVO_NUM];
+    unsigned char aucSent[MAX_SERVO_NUM];
+    struct sockaddr_in stAddr;
+    struct timespec stNext, stNow;
+    long lLateUs, lMissed;
+    int iFd, iPort, iTime, iLen, i, iChanged;
+
+    iFd = _udpServerInit(&iPort, 1);
+    if (iFd < 0)
+    {
+        printf("Create servo stream socket failed!\r\n");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&stMutex);
+    strncpy(acIPAddr, g_stConnectedRobotInfo.acIPAddr, sizeof(acIPAddr));
+    acIPAddr[sizeof(acIPAddr) - 1] = '\0';
+    memset(&stAddr, 0, sizeof(stAddr));
+    stAddr.sin_family = AF_INET;
+    stAddr.sin_port = htons(g_iSDK2RobotPort);
+    stAddr.sin_addr.s_addr = inet_addr(acIPAddr);
+    pthread_mutex_unlock(&stMutex);
+
+    /* The servo time is in 50ms units, cover at least one period */
+    iTime = (g_iServoStreamPeriodUs + 49999) / 50000;
+    memset(aucSent, 0, sizeof(aucSent));
+    stNext = g_stServoStreamStart;
+
+    while (g_iServoStreamRunning)
     {
-        iLoop = 3;
-        iTotalFrame = iRepeat*iLoop;
-        if (!strcmp(pcDirect, "left"))
+        stNext.tv_nsec += g_iServoStreamPeriodUs * 1000L;
+        while (stNext.tv_nsec >= 1000000000L)
         {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"59585a",SERVO_RANG_INDEX(4,6),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"b30059",SERVO_RANG_INDEX(4,6),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"59585a",SERVO_RANG_INDEX(4,6),i*iLoop+3,iTotalFrame,fd);
-            }
+            stNext.tv_nsec -= 1000000000L;
+            stNext.tv_sec++;
         }
-        else if (!strcmp(pcDirect, "right"))
+        while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &stNext, NULL));
+        clock_gettime(CLOCK_MONOTONIC, &stNow);
+
+        lLateUs = (stNow.tv_sec - stNext.tv_sec) * 1000000L + (stNow.tv_nsec - stNext.tv_nsec) / 1000;
+        if (lLateUs < 0)
         {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"5b5a5a",SERVO_RANG_INDEX(1,3),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"00b45a",SERVO_RANG_INDEX(1,3),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5b5a5a",SERVO_RANG_INDEX(1,3),i*iLoop+3,iTotalFrame,fd);
-            }
+            lLateUs = 0;
         }
-        else if (!strcmp(pcDirect, "both"))
+        lMissed = lLateUs / g_iServoStreamPeriodUs;
+        if (lMissed > 0)
         {
-            for(i=0; i< iRepeat; i++)
+            /* Skip the periods which are already over instead of bursting */
+            stNext.tv_sec += (lMissed * g_iServoStreamPeriodUs) / 1000000L;
+            stNext.tv_nsec += ((lMissed * g_iServoStreamPeriodUs) % 1000000L) * 1000L;
+            while (stNext.tv_nsec >= 1000000000L)
             {
-                _ubt_CreateMotionFrame(acFrame,"595a5a5a5959",SERVO_RANG_INDEX(1,6),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"00b45ab30059",SERVO_RANG_INDEX(1,6),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"595a5a5a5959",SERVO_RANG_INDEX(1,6),i*iLoop+3,iTotalFrame,fd);
+                stNext.tv_nsec -= 1000000000L;
+                stNext.tv_sec++;
             }
         }
-        else
-        {
-            printf("stretch direct:%s error\r\n", pcDirect);
-            goto ERR;
-        }
-    }
-    else if (!strcmp(pcType, "come on"))
-    {
-        iLoop = 6;
-        iTotalFrame = iRepeat*iLoop;
-        if (!strcmp(pcDirect, "left"))
+
+        /* Count the acks of the previous frames */
+        RobotMessageArenaBegin();
+        while ((iLen = recv(iFd, acSocketBuffer, sizeof(acSocketBuffer) - 1, MSG_DONTWAIT)) > 0)
         {
-            for(i=0; i< iRepeat; i++)
+            acSocketBuffer[iLen] = '\0';
+            if (UBTEDU_RC_SUCCESS == ubtRobot_Msg_Decode_SetRobotServo(acSocketBuffer))
             {
-                _ubt_CreateMotionFrame(acFrame,"59585a",SERVO_RANG_INDEX(4,6),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"ae0016",SERVO_RANG_INDEX(4,6),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"ae005c",SERVO_RANG_INDEX(4,6),i*iLoop+3,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"ad000a",SERVO_RANG_INDEX(4,6),i*iLoop+4,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"ad005e",SERVO_RANG_INDEX(4,6),i*iLoop+5,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"59585a",SERVO_RANG_INDEX(4,6),i*iLoop+6,iTotalFrame,fd);
+                pthread_mutex_lock(&g_stServoStreamMutex);
+                g_stServoStreamStats.uiAcks++;
+                pthread_mutex_unlock(&g_stServoStreamMutex);
             }
         }
-        else if (!strcmp(pcDirect, "right"))
+        RobotMessageArenaEnd();
+
+        pthread_mutex_lock(&g_stServoStreamMutex);
+        RobotTrajectorySample(&g_stServoStreamTraj, _ubtServoStreamElapsedMs(&stNow), aucAngle);
+        g_stServoStreamStats.uiTicks++;
+        g_stServoStreamStats.uiMissed += lMissed;
+        if (lLateUs > g_stServoStreamStats.uiJitterMaxUs)
         {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"585a5a",SERVO_RANG_INDEX(1,3),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"00b4ae",SERVO_RANG_INDEX(1,3),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"00b45e",SERVO_RANG_INDEX(1,3),i*iLoop+3,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"00b4a8",SERVO_RANG_INDEX(1,3),i*iLoop+4,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"00b45c",SERVO_RANG_INDEX(1,3),i*iLoop+5,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"585a5a",SERVO_RANG_INDEX(1,3),i*iLoop+6,iTotalFrame,fd);
-            }
+            g_stServoStreamStats.uiJitterMaxUs = lLateUs;
         }
-        else if (!strcmp(pcDirect, "both"))
+        g_ullServoStreamJitterSumUs += lLateUs;
+        g_stServoStreamStats.uiJitterAvgUs = g_ullServoStreamJitterSumUs / g_stServoStreamStats.uiTicks;
+        pthread_mutex_unlock(&g_stServoStreamMutex);
+        _ubtBalanceApply(aucAngle);
+
+        memset(acAllAngle, 'F', sizeof(acAllAngle)); // null is "FF"
+        acAllAngle[MAX_SERVO_NUM*2] = '\0';
+        iChanged = 0;
+        for (i = 0; i < MAX_SERVO_NUM; i++)
         {
-            for(i=0; i< iRepeat; i++)
+            if ((0 != aucAngle[i]) && (aucAngle[i] != aucSent[i]))
             {
-                _ubt_CreateMotionFrame(acFrame,"585a5a59585a",SERVO_RANG_INDEX(1,6),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"00b4aeae0016",SERVO_RANG_INDEX(1,6),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"00b45eae005c",SERVO_RANG_INDEX(1,6),i*iLoop+3,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"00b4a8ad000a",SERVO_RANG_INDEX(1,6),i*iLoop+4,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"00b45cad005e",SERVO_RANG_INDEX(1,6),i*iLoop+5,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"585a5a59585a",SERVO_RANG_INDEX(1,6),i*iLoop+6,iTotalFrame,fd);
+                _ubtSetServoAngle(acAllAngle, aucAngle[i], i + 1);
+                iChanged++;
             }
         }
-        else
-        {
-            printf("come on direct:%s error\r\n", pcDirect);
-            goto ERR;
-        }
-    }
-    else if (!strcmp(pcType, "wave"))
-    {
-        iLoop = 6;
-        iTotalFrame = iRepeat*iLoop;
-        if (!strcmp(pcDirect, "left"))
+        /* A colliding frame is dropped, the next one is checked again */
+        if ((0 == iChanged) || (UBTEDU_RC_SUCCESS != _ubtServoFrameCheck(acAllAngle)))
         {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"595859",SERVO_RANG_INDEX(4,6),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"591e59",SERVO_RANG_INDEX(4,6),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"59825a",SERVO_RANG_INDEX(4,6),i*iLoop+3,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"591d59",SERVO_RANG_INDEX(4,6),i*iLoop+4,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"59865a",SERVO_RANG_INDEX(4,6),i*iLoop+5,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"595859",SERVO_RANG_INDEX(4,6),i*iLoop+6,iTotalFrame,fd);
-            }
+            continue;
         }
-        else if (!strcmp(pcDirect, "right"))
+        for (i = 0; i < MAX_SERVO_NUM; i++)
         {
-            for(i=0; i< iRepeat; i++)
+            if (0 != aucAngle[i])
             {
-                _ubt_CreateMotionFrame(acFrame,"585a5a",SERVO_RANG_INDEX(1,3),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"58985a",SERVO_RANG_INDEX(1,3),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"58315a",SERVO_RANG_INDEX(1,3),i*iLoop+3,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"588f5a",SERVO_RANG_INDEX(1,3),i*iLoop+4,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"58335a",SERVO_RANG_INDEX(1,3),i*iLoop+5,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"585a5a",SERVO_RANG_INDEX(1,3),i*iLoop+6,iTotalFrame,fd);
+                aucSent[i] = aucAngle[i];
             }
         }
-        else if (!strcmp(pcDirect, "both"))
+
+        _ubtServoOffsetConvert(acAllAngle, acWireAngle, 1);
+        RobotMessageArenaBegin();
+        if (UBTEDU_RC_SUCCESS == ubtRobot_Msg_Encode_SetRobotServo(iPort, acWireAngle, iTime,
+                acSocketBuffer, sizeof(acSocketBuffer)))
         {
-            for(i=0; i< iRepeat; i++)
+            if (sendto(iFd, acSocketBuffer, strlen(acSocketBuffer), 0,
+                       (struct sockaddr *)&stAddr, sizeof(stAddr)) > 0)
             {
-                _ubt_CreateMotionFrame(acFrame,"585a5a595859",SERVO_RANG_INDEX(1,6),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"58985a591e59",SERVO_RANG_INDEX(1,6),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"58315a59825a",SERVO_RANG_INDEX(1,6),i*iLoop+3,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"588f5a591d59",SERVO_RANG_INDEX(1,6),i*iLoop+4,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"58335a59865a",SERVO_RANG_INDEX(1,6),i*iLoop+5,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"585a5a595859",SERVO_RANG_INDEX(1,6),i*iLoop+6,iTotalFrame,fd);
+                pthread_mutex_lock(&g_stServoStreamMutex);
+                g_stServoStreamStats.uiFramesSent++;
+                pthread_mutex_unlock(&g_stServoStreamMutex);
             }
         }
-        else
-        {
-            printf("wave direct %s error\r\n", pcDirect);
-            goto ERR;
-        }
+        RobotMessageArenaEnd();
     }
-    else if (!strcmp(pcType, "bend"))
+
+    close(iFd);
+
+    return NULL;
+}
+
+/**
+ * @brief:      ubtServoStreamStart
+ * @details:    Start the servo stream control thread
+ * @param[in]   int iRateHz     Control rate, 1 ~ 100
+ * @param[in]   UBTEDU_SERVO_INTERP_e eInterp
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoStreamStart(int iRateHz, UBTEDU_SERVO_INTERP_e eInterp)
+{
+    static const ROBOT_TRAJ_INTERP_e aeInterp[UBTEDU_SERVO_INTERP_INVALID] = {
+        ROBOT_TRAJ_INTERP_LINEAR, ROBOT_TRAJ_INTERP_CUBIC,
+        ROBOT_TRAJ_INTERP_MINJERK, ROBOT_TRAJ_INTERP_TRAPEZOID};
+
+    if ((iRateHz < 1) || (iRateHz > 100)
+        || (eInterp < UBTEDU_SERVO_INTERP_LINEAR) || (eInterp >= UBTEDU_SERVO_INTERP_INVALID))
     {
-        iLoop = 3;
-        iTotalFrame = iRepeat*iLoop;
-        if (!strcmp(pcDirect, "left"))
-        {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"597769445a",SERVO_RANG_INDEX(12,16),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"6788973661",SERVO_RANG_INDEX(12,16),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"597769445a",SERVO_RANG_INDEX(12,16),i*iLoop+3,iTotalFrame,fd);
-            }
-        }
-        else if (!strcmp(pcDirect, "right"))
-        {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"5a3a4a6e59",SERVO_RANG_INDEX(7,11),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5830317252",SERVO_RANG_INDEX(7,11),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5a3a4a6e59",SERVO_RANG_INDEX(7,11),i*iLoop+3,iTotalFrame,fd);
-            }
-        }
-        else
-        {
-            printf("bend direct %s error\r\n", pcDirect);
-            goto ERR;
-        }
+        return UBTEDU_RC_WRONG_PARAM;
     }
-    else if (!strcmp(pcType, "walk"))
+    if (g_iServoStreamRunning)
     {
+        return UBTEDU_RC_FAILED;
+    }
 
-        if(!strcmp(pcDirect, "front"))
-        {
-            iLoop = 6;
-            iTotalFrame = iRepeat*iLoop;
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"602724815565a3904650",SERVO_RANG_INDEX(7,16),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"4932159c664f9a9d3460",SERVO_RANG_INDEX(7,16),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"49160c8962508c8f3367",SERVO_RANG_INDEX(7,16),i*iLoop+3,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"4c11207464528c8f3364",SERVO_RANG_INDEX(7,16),i*iLoop+4,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"601d247a51667c8e224a",SERVO_RANG_INDEX(7,16),i*iLoop+5,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"602724814e699aac264f",SERVO_RANG_INDEX(7,16),i*iLoop+6,iTotalFrame,fd);
-            }
-        }
-        else if (!strcmp(pcDirect, "back"))
-        {
-            iLoop = 6;
-            iTotalFrame = iRepeat*iLoop;
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"602a1d8d50649a973b4d",SERVO_RANG_INDEX(7,16),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"602a1d8d506683b10f55",SERVO_RANG_INDEX(7,16),i*iLoop+2,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"612a1d8d5066779a164e",SERVO_RANG_INDEX(7,16),i*iLoop+3,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"4e1b1d7a67528e962d66",SERVO_RANG_INDEX(7,16),i*iLoop+4,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"4f230c9861528e962d66",SERVO_RANG_INDEX(7,16),i*iLoop+5,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"4c371c9967528e962d66",SERVO_RANG_INDEX(7,16),i*iLoop+6,iTotalFrame,fd);
-            }
-        }
-        else if (!strcmp(pcDirect, "left"))
-        {
-            iLoop = 2;
-            iTotalFrame = iRepeat*iLoop;
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"5a271b8c595c8e9b2855",SERVO_RANG_INDEX(7,16),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"42271b8e67598e9b2855",SERVO_RANG_INDEX(7,16),i*iLoop+2,iTotalFrame,fd);
-            }
-        }
-        else if (!strcmp(pcDirect, "right"))
-        {
-            iLoop = 2;
-            iTotalFrame = iRepeat*iLoop;
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"5a271d875e5a8b972b5d",SERVO_RANG_INDEX(7,16),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5c271d875c708b972b51",SERVO_RANG_INDEX(7,16),i*iLoop+2,iTotalFrame,fd);
-            }
-        }
-        else
-        {
-            printf("work direct:%s error\r\n", pcDirect);
-            goto ERR;
-        }
+    pthread_mutex_lock(&g_stServoStreamMutex);
+    RobotTrajectoryInit(&g_stServoStreamTraj, aeInterp[eInterp]);
+    g_stServoStreamTraj.stLimit = g_stServoLimit;
+    memset(&g_stServoStreamStats, 0, sizeof(g_stServoStreamStats));
+    g_ullServoStreamJitterSumUs = 0;
+    pthread_mutex_unlock(&g_stServoStreamMutex);
+
+    /* The stream moves the servos behind the acknowledged angles */
+    _ubtServoShadowReset();
+    g_iServoStreamPeriodUs = 1000000 / iRateHz;
+    clock_gettime(CLOCK_MONOTONIC, &g_stServoStreamStart);
+    g_iServoStreamRunning = 1;
+    if (0 != pthread_create(&g_stServoStreamThread, NULL, _ubtServoStreamThread, NULL))
+    {
+        printf("pthread_create failed \n");
+        g_iServoStreamRunning = 0;
+        return UBTEDU_RC_FAILED;
     }
-    else if (!strcmp(pcType, MOTION_TYPE_TURNAROUND))
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtServoStreamPush
+ * @details:    Queue a keyframe on the servo stream
+ * @param[in]   uint8_t angles[]  MAX_SERVO_NUM angles(range:0~180), 0 is not driven
+ * @param[in]   int iTimeMs   Time to reach it after the previous keyframe
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoStreamPush(const uint8_t angles[MAX_SERVO_NUM], int iTimeMs)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    struct timespec stNow;
+
+    if ((NULL == angles) || (iTimeMs <= 0))
     {
-        iLoop = 2;
-        iTotalFrame = iRepeat*iLoop;
-        speed += 5;
-        acFrame[28]=speed; //run time
-        acFrame[29]=0x00; //time high byte
-        acFrame[30]=speed; //time low byte
-        if (!strcmp(pcDirect, MOTION_DIRECTION_LEFT_STR))
-        {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"4f10306068636e8e1453",SERVO_RANG_INDEX(7,16),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5a281d895e5c8a972a5a",SERVO_RANG_INDEX(7,16),i*iLoop+2,iTotalFrame,fd);
-            }
-        }
-        else if (!strcmp(pcDirect, MOTION_DIRECTION_RIGHT_STR))
-        {
-            for(i=0; i< iRepeat; i++)
-            {
-                _ubt_CreateMotionFrame(acFrame,"54532e9f6369a08a554d",SERVO_RANG_INDEX(7,16),i*iLoop+1,iTotalFrame,fd);
-                _ubt_CreateMotionFrame(acFrame,"5b281d875a5a89972a5a",SERVO_RANG_INDEX(7,16),i*iLoop+2,iTotalFrame,fd);
-            }
-        }
-        else
-        {
-            printf("turn round direct %s error\r\n", pcDirect);
-            goto ERR;
-        }
+        return UBTEDU_RC_WRONG_PARAM;
     }
-    else if (!strcmp(pcType, MOTION_TYPE_HEAD_STR))
+    if (!g_iServoStreamRunning)
     {
-        if(fd != NULL)  fclose(fd);
-        acAngle[2]='\0';
-        if (!strcmp(pcDirect, MOTION_DIRECTION_LEFT_STR))
-        {
-            acAngle[0]='2';
-            acAngle[1]='8';
-            return _ubtSetRobotServo(SERVO_HEAD_INDEX, acAngle, iSpeed);
-        }
-        else if (!strcmp(pcDirect, MOTION_DIRECTION_RIGHT_STR))
-        {
-            acAngle[0]='7';
-            acAngle[1]='8';
-            return _ubtSetRobotServo(SERVO_HEAD_INDEX, acAngle, iSpeed);
-        }
-        else if (!strcmp(pcDirect, MOTION_DIRECTION_FRONT_STR))
-        {
-            acAngle[0]='5';
-            acAngle[1]='A';
-            return _ubtSetRobotServo(SERVO_HEAD_INDEX, acAngle, iSpeed);
-        }
-        else
-        {
-            printf("head direct:%s error\r\n", pcDirect);
-            return UBTEDU_RC_WRONG_PARAM;
-        }
+        return UBTEDU_RC_FAILED;
     }
-    else if (!strcmp(pcType, "bow"))
+
+    clock_gettime(CLOCK_MONOTONIC, &stNow);
+    pthread_mutex_lock(&g_stServoStreamMutex);
+    ubtRet = RobotTrajectoryPush(&g_stServoStreamTraj, _ubtServoStreamElapsedMs(&stNow), angles, iTimeMs);
+    pthread_mutex_unlock(&g_stServoStreamMutex);
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      ubtServoStreamStop
+ * @details:    Stop the servo stream control thread
+ * @param[in]   None
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoStreamStop(void)
+{
+    if (!g_iServoStreamRunning)
     {
-        iLoop = 5;
-        iTotalFrame = iRepeat*iLoop;
-        for(i=0; i< iRepeat; i++)
-        {
-            _ubt_CreateMotionFrame(acFrame,"595a5b59585b5a3a4a6e595977674459",SERVO_RANG_INDEX(1,16),i*iLoop+1,iTotalFrame,fd);
-            _ubt_CreateMotionFrame(acFrame,"59b45b59005b5a179e3159589d19845b",SERVO_RANG_INDEX(1,16),i*iLoop+2,iTotalFrame,fd);
-            _ubt_CreateMotionFrame(acFrame,"59b45b59005a5a179e3259589d18825a",SERVO_RANG_INDEX(1,16),i*iLoop+3,iTotalFrame,fd);
-            _ubt_CreateMotionFrame(acFrame,"59b45b59005a5c679e485a5b49186b5a",SERVO_RANG_INDEX(1,16),i*iLoop+4,iTotalFrame,fd);
-            _ubt_CreateMotionFrame(acFrame,"595a5b59585b5a3a4a6e595977674459",SERVO_RANG_INDEX(1,16),i*iLoop+5,iTotalFrame,fd);
-        }
+        return UBTEDU_RC_SUCCESS;
     }
-    else
+
+    g_iServoStreamRunning = 0;
+    pthread_join(g_stServoStreamThread, NULL);
+    _ubtServoShadowReset();
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtServoStreamGetStats
+ * @details:    Get the servo stream statistics
+ * @param[in]   None
+ * @param[out]  UBTEDU_SERVO_STREAM_STATS_T *pstStats
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoStreamGetStats(UBTEDU_SERVO_STREAM_STATS_T *pstStats)
+{
+    if (NULL == pstStats)
     {
-        printf("The Type[%s] motion is unsurpport!\r\n", pcType);
-        goto ERR;
+        return UBTEDU_RC_WRONG_PARAM;
     }
 
-    memset(acFrame,0,sizeof(acFrame));
-    iTotalTime = iTotalFrame*speed*20;
-    acFrame[29]= iTotalTime&0xff;
-    acFrame[30]= (iTotalTime>>8)&0xff;
-    acFrame[31]= (iTotalTime>>16)&0xff;
-    acFrame[32]= (iTotalTime>>24)&0xff;
-    fwrite(acFrame,sizeof(acFrame),1,fd);
-    if(fd != NULL)  fclose(fd);
-    return ubtStartRobotAction(acFullName,1);
+    pthread_mutex_lock(&g_stServoStreamMutex);
+    memcpy(pstStats, &g_stServoStreamStats, sizeof(UBTEDU_SERVO_STREAM_STATS_T));
+    pthread_mutex_unlock(&g_stServoStreamMutex);
 
-ERR:
-    if(fd != NULL)  fclose(fd);
-    return UBTEDU_RC_WRONG_PARAM;
+    return UBTEDU_RC_SUCCESS;
 }
 
 
 /**
- * @brief:      ubtReadSensorValue
- * @details:    Read the sensor's value
- * @param[in]   char *pcSensorType  The sensor's type.
- *                                  gyro
- *                                  environment
- *                                  board
- *                                  infrared
- *                                  ultrasonic
- *                                  touch
- *                                  color
- *                                  pressure
- *                                  gas
- * @param[out]  void *pValue        The sensor value. More details please see the defination as below variable type
- *                                  UBTEDU_ROBOTGYRO_SENSOR_T
- *                                  UBTEDU_ROBOTENV_SENSOR_T
- *                                  UBTEDU_ROBOTRASPBOARD_SENSOR_T
- *                                  UBTEDU_ROBOTINFRARED_SENSOR_T
- *                                  UBTEDU_ROBOTULTRASONIC_SENSOR_T
- *                                  UBTEDU_ROBOTTOUCH_SENSOR_T
- *                                  UBTEDU_ROBOTCOLOR_SENSOR_T
- *                                  UBTEDU_ROBOTPRESSURE_SENSOR_T
- *                                  UBTEDU_ROBOTGAS_SENSOR_T
- * @param[in]   int iValueLen       The max length of pValue
+ * @brief:      ubtServoSetLimit
+ * @details:    Set the speed and acceleration limits of the profiled motions
+ * @param[in]   int iServo     1 ~ MAX_SERVO_NUM, 0 for all
+ * @param[in]   int iMaxVel    In degree/s
+ * @param[in]   int iMaxAcc    In degree/s^2
+ * @param[out]  None
  * @retval: UBTEDU_RC_T
  */
-UBTEDU_RC_T ubtReadSensorValue(char *pcSensorType, void *pValue, int iValueLen)
+UBTEDU_RC_T ubtServoSetLimit(int iServo, int iMaxVel, int iMaxAcc)
+{
+    ROBOT_PROFILE_LIMIT_T stLimit;
+    int i;
+
+    if ((iServo < 0) || (iServo > MAX_SERVO_NUM) || (iMaxVel <= 0) || (iMaxAcc <= 0))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    stLimit = g_stServoLimit;
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        if ((0 == iServo) || (iServo - 1 == i))
+        {
+            RobotProfileSetLimit(&stLimit, i, (float)iMaxVel, (float)iMaxAcc);
+        }
+    }
+
+    pthread_mutex_lock(&g_stServoStreamMutex);
+    g_stServoLimit = stLimit;
+    g_stServoStreamTraj.stLimit = stLimit;
+    pthread_mutex_unlock(&g_stServoStreamMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtServoProfileExport
+ * @details:    Save a profiled move between two poses as an HTS action file
+ * @param[in]   uint8_t from[]  MAX_SERVO_NUM angles(range:0~180), 0 is not driven
+ * @param[in]   uint8_t to[]    MAX_SERVO_NUM angles(range:0~180), 0 is not driven
+ * @param[in]   UBTEDU_SERVO_INTERP_e eInterp   MINJERK or TRAPEZOID
+ * @param[in]   int iTimeMs     Made longer when a servo would pass its limits
+ * @param[in]   char *pcPath    The action file's path
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoProfileExport(const uint8_t from[MAX_SERVO_NUM], const uint8_t to[MAX_SERVO_NUM],
+                                  UBTEDU_SERVO_INTERP_e eInterp, int iTimeMs, char *pcPath)
 {
     UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
-    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    ROBOT_PROFILE_LIMIT_T stLimit;
+    ROBOT_PROFILE_T stProfile;
+    ROBOT_HTS_T stHts;
+    int i;
 
-    if ((NULL == pcSensorType) || (NULL == pValue))
+    if ((NULL == from) || (NULL == to) || (NULL == pcPath) || (iTimeMs < 0)
+        || ((UBTEDU_SERVO_INTERP_MINJERK != eInterp) && (UBTEDU_SERVO_INTERP_TRAPEZOID != eInterp)))
     {
         return UBTEDU_RC_WRONG_PARAM;
     }
-    acSocketBuffer[0] = '\0';
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        if ((from[i] > 180) || (to[i] > 180))
+        {
+            return UBTEDU_RC_WRONG_PARAM;
+        }
+    }
 
-    ubtRet = ubtRobot_Msg_Encode_ReadSensorValue(pcSensorType, g_iRobot2SDKPort,
-             acSocketBuffer, sizeof(acSocketBuffer));
+    pthread_mutex_lock(&g_stServoStreamMutex);
+    stLimit = g_stServoLimit;
+    pthread_mutex_unlock(&g_stServoStreamMutex);
 
+    ubtRet = RobotProfilePlan(&stProfile, (UBTEDU_SERVO_INTERP_MINJERK == eInterp) ?
+                              ROBOT_PROFILE_MINJERK : ROBOT_PROFILE_TRAPEZOID,
+                              &stLimit, from, to, (float)iTimeMs);
     if (UBTEDU_RC_SUCCESS != ubtRet)
     {
         return ubtRet;
     }
+    ubtRet = RobotProfileBuildHts(&stProfile, SERVO_PROFILE_FRAME_MS, &stHts);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    ubtRet = RobotHtsWrite(&stHts, pcPath);
+    RobotHtsDestroy(&stHts);
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtCaptureRead
+ * @details:    Read all servo's angle like ubtRecordMotion()
+ * @param[in]   None
+ * @param[out]  unsigned char *pucAngle   MAX_SERVO_NUM angles, 0 when unknown
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _ubtCaptureRead(unsigned char *pucAngle)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    char acAllAngle[MAX_SERVO_NUM*2+1];
+    int i, iValue;
 
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_ReadRobotServo(g_iRobot2SDKPort, acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_ReadRobotServo(acSocketBuffer, acAllAngle, sizeof(acAllAngle));
+    }
+    RobotMessageArenaEnd();
+    /* Like ubtRecordMotion(), the read releases the servos, which are moved
+       by hand while capturing */
+    _ubtServoShadowReset();
     if (UBTEDU_RC_SUCCESS != ubtRet)
     {
         return ubtRet;
     }
+    _ubtServoOffsetConvert(acAllAngle, acAllAngle, -1);
 
-    ubtRet = ubtRobot_Msg_Decode_ReadSensorValue(acSocketBuffer, pcSensorType, pValue, iValueLen);
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        iValue = _ubt_getAngle(acAllAngle, i + 1);
+        pucAngle[i] = ((iValue < 1) || (iValue > 180)) ? 0 : iValue;
+    }
 
-    return ubtRet;
+    return UBTEDU_RC_SUCCESS;
 }
 
 /**
- * @brief:      ubtReadSensorValueByAddr
- * @details:    Read the sensor's value by it's type and address
- * @param[in]   char *pcSensorType  The sensor's type.
- *                                  gryo
- *                                  environment
- *                                  board
- *                                  infrared
- *                                  ultrasonic
- *                                  touch
- *                                  color
- *                                  pressure
- *                                  gas
- * @param[in]   int iAddr             The sensor's 7bit I2C address
- * @param[out]  void *pValue      The sensor value. More details please see the defination as below variable type
- *                                  UBTEDU_ROBOTGYRO_SENSOR_T
- *                                  UBTEDU_ROBOTENV_SENSOR_T
- *                                  UBTEDU_ROBOTRASPBOARD_SENSOR_T
- *                                  UBTEDU_ROBOTINFRARED_SENSOR_T
- *                                  UBTEDU_ROBOTULTRASONIC_SENSOR_T
- *                                  UBTEDU_ROBOTTOUCH_SENSOR_T
- *                                  UBTEDU_ROBOTCOLOR_SENSOR_T
- *                                  UBTEDU_ROBOTPRESSURE_SENSOR_T
- *                                  UBTEDU_ROBOTGAS_SENSOR_T
- * @param[in]   int iValueLen       The max length of pValue
+ * @brief:      _ubtCaptureThread
+ * @details:    Sample the servos on a fixed period into the capture ring.
+ *              A sample is stamped in the middle of its read.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void *
+ */
+static void *_ubtCaptureThread(void *arg)
+{
+    ROBOT_CAPTURE_SAMPLE_T stSample;
+    struct timespec stNext;
+    unsigned long long ullStartUs;
+    long lPeriodNs = g_iCapturePeriodUs * 1000L;
+
+    clock_gettime(CLOCK_MONOTONIC, &stNext);
+    while (g_iCaptureRunning)
+    {
+        ullStartUs = _ubtNowUs();
+        if (UBTEDU_RC_SUCCESS == _ubtCaptureRead(stSample.aucAngle))
+        {
+            stSample.ullTimeUs = (ullStartUs + _ubtNowUs()) / 2;
+            RobotCapturePush(&g_stCapture, &stSample);
+        }
+        else
+        {
+            __atomic_add_fetch(&g_uiCaptureFailed, 1, __ATOMIC_RELAXED);
+        }
+
+        /* Keep the period, skip the ones a slow read already used up */
+        do
+        {
+            stNext.tv_nsec += lPeriodNs;
+            while (stNext.tv_nsec >= 1000000000L)
+            {
+                stNext.tv_nsec -= 1000000000L;
+                stNext.tv_sec++;
+            }
+        }
+        while ((unsigned long long)stNext.tv_sec * 1000000ULL + stNext.tv_nsec / 1000 < _ubtNowUs());
+        while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &stNext, NULL));
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief:      ubtCaptureStart
+ * @details:    Start sampling the servos in the background. The servos are
+ *              read like ubtRecordMotion(), so they can be posed by hand.
+ *              Samples of an earlier capture are dropped, an export taking
+ *              them meanwhile gets them or none.
+ * @param[in]   int iRateHz       Sample rate, 1 ~ 50
+ * @param[in]   int iMaxSeconds   Capture length kept in memory, 1 ~ 600
+ * @param[out]  None
  * @retval: UBTEDU_RC_T
  */
-UBTEDU_RC_T ubtReadSensorValueByAddr(char *pcSensorType, int iAddr, void *pValue, int iValueLen)
+UBTEDU_RC_T ubtCaptureStart(int iRateHz, int iMaxSeconds)
 {
     UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
-    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    ROBOT_CAPTURE_T stCapture, stOldCapture;
 
-    if ((NULL == pcSensorType) || (NULL == pValue))
+    if ((iRateHz < 1) || (iRateHz > 50) || (iMaxSeconds < 1) || (iMaxSeconds > 600))
     {
         return UBTEDU_RC_WRONG_PARAM;
     }
-    acSocketBuffer[0] = '\0';
+    if (g_iCaptureRunning)
+    {
+        return UBTEDU_RC_FAILED;
+    }
+
+    ubtRet = RobotCaptureCreate(&stCapture, iRateHz * iMaxSeconds);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    pthread_mutex_lock(&g_stCaptureMutex);
+    stOldCapture = g_stCapture;
+    g_stCapture = stCapture;
+    pthread_mutex_unlock(&g_stCaptureMutex);
+    RobotCaptureDestroy(&stOldCapture);
+    g_uiCaptureFailed = 0;
+    g_iCapturePeriodUs = 1000000 / iRateHz;
+
+    g_iCaptureRunning = 1;
+    if (0 != pthread_create(&g_stCaptureThread, NULL, _ubtCaptureThread, NULL))
+    {
+        printf("pthread_create failed \n");
+        g_iCaptureRunning = 0;
+        return UBTEDU_RC_FAILED;
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtCaptureStop
+ * @details:    Stop sampling the servos. The samples are kept for export.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtCaptureStop(void)
+{
+    if (!g_iCaptureRunning)
+    {
+        return UBTEDU_RC_SUCCESS;
+    }
+
+    g_iCaptureRunning = 0;
+    pthread_join(g_stCaptureThread, NULL);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtCaptureGetStats
+ * @details:    Get the capture statistics
+ * @param[in]   None
+ * @param[out]  UBTEDU_CAPTURE_STATS_T *pstStats
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtCaptureGetStats(UBTEDU_CAPTURE_STATS_T *pstStats)
+{
+    if (NULL == pstStats)
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pthread_mutex_lock(&g_stCaptureMutex);
+    pstStats->uiSamples = __atomic_load_n(&g_stCapture.uiHead, __ATOMIC_ACQUIRE)
+                          - __atomic_load_n(&g_stCapture.uiTail, __ATOMIC_ACQUIRE);
+    pstStats->uiDropped = __atomic_load_n(&g_stCapture.uiDropped, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&g_stCaptureMutex);
+    pstStats->uiFailed = __atomic_load_n(&g_uiCaptureFailed, __ATOMIC_RELAXED);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      _ubtSetCompressStats
+ * @details:    Fill the compression result for the caller
+ * @param[in]   ROBOT_SIMPLIFY_STATS_T *pstSimplify
+ * @param[out]  UBTEDU_COMPRESS_STATS_T *pstStats
+ * @retval:     void
+ */
+static void _ubtSetCompressStats(const ROBOT_SIMPLIFY_STATS_T *pstSimplify, UBTEDU_COMPRESS_STATS_T *pstStats)
+{
+    pstStats->iFramesIn = pstSimplify->iFramesIn;
+    pstStats->iFramesOut = pstSimplify->iFramesOut;
+    pstStats->fRatio = (float)pstSimplify->iFramesIn / pstSimplify->iFramesOut;
+    pstStats->fMaxError = pstSimplify->fMaxError;
+}
+
+/**
+ * @brief:      ubtCaptureExport
+ * @details:    Save the samples captured since the last export as an HTS
+ *              action file. It may be called while the capture runs.
+ * @param[in]   char *pcPath       The action file's path
+ * @param[in]   int iTolerance     Degrees a dropped sample may be off the
+ *                                 servos' way, 0 keeps every sample
+ * @param[out]  UBTEDU_COMPRESS_STATS_T *pstStats   May be NULL
+ * @retval: UBTEDU_RC_T   UBTEDU_RC_NOT_FOUND when nothing was captured
+ */
+UBTEDU_RC_T ubtCaptureExport(char *pcPath, int iTolerance, UBTEDU_COMPRESS_STATS_T *pstStats)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    ROBOT_CAPTURE_SAMPLE_T *pstSample;
+    ROBOT_SIMPLIFY_STATS_T stSimplify;
+    ROBOT_HTS_T stHts;
+    int iNum;
+
+    if ((NULL == pcPath) || (iTolerance < 0) || (iTolerance > 180))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    pthread_mutex_lock(&g_stCaptureMutex);
+    if (NULL == g_stCapture.pstSample)
+    {
+        pthread_mutex_unlock(&g_stCaptureMutex);
+        return UBTEDU_RC_NOT_FOUND;
+    }
+    pstSample = malloc(g_stCapture.uiSize * sizeof(ROBOT_CAPTURE_SAMPLE_T));
+    if (NULL == pstSample)
+    {
+        pthread_mutex_unlock(&g_stCaptureMutex);
+        return UBTEDU_RC_NORESOURCE;
+    }
+    iNum = RobotCaptureRead(&g_stCapture, pstSample, g_stCapture.uiSize);
+    pthread_mutex_unlock(&g_stCaptureMutex);
+    if (0 == iNum)
+    {
+        free(pstSample);
+        return UBTEDU_RC_NOT_FOUND;
+    }
+
+    ubtRet = RobotCaptureBuildHts(pstSample, iNum, iTolerance, &stHts, &stSimplify);
+    free(pstSample);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    ubtRet = RobotHtsWrite(&stHts, pcPath);
+    RobotHtsDestroy(&stHts);
+    if ((UBTEDU_RC_SUCCESS == ubtRet) && (NULL != pstStats))
+    {
+        _ubtSetCompressStats(&stSimplify, pstStats);
+    }
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtKinToPose
+ * @details:    Convert a chain's end to a limb pose, with roll, pitch and
+ *              yaw applied in the z, y, x order
+ * @param[in]   ROBOT_KIN_POSE_T *pstKin
+ * @param[out]  UBTEDU_LIMB_POSE_T *pstPose
+ * @retval:     void
+ */
+static void _ubtKinToPose(const ROBOT_KIN_POSE_T *pstKin, UBTEDU_LIMB_POSE_T *pstPose)
+{
+    const float *pfRot = pstKin->afRot;
+    float fSinPitch = -pfRot[6];
+
+    fSinPitch = (fSinPitch > 1.0f) ? 1.0f : ((fSinPitch < -1.0f) ? -1.0f : fSinPitch);
+    pstPose->fX = pstKin->afPos[0];
+    pstPose->fY = pstKin->afPos[1];
+    pstPose->fZ = pstKin->afPos[2];
+    pstPose->fRoll = atan2f(pfRot[7], pfRot[8]) * 180.0f / M_PI;
+    pstPose->fPitch = asinf(fSinPitch) * 180.0f / M_PI;
+    pstPose->fYaw = atan2f(pfRot[3], pfRot[0]) * 180.0f / M_PI;
+}
+
+/**
+ * @brief:      ubtGetLimbPose
+ * @details:    Get where the end of a limb is. Only the limbs whose servos
+ *              moved since the last call are computed again.
+ * @param[in]   UBTEDU_ROBOT_LIMB_e eLimb
+ * @param[in]   int iMaxAgeMs   Passed to ubtGetRobotServoCached()
+ * @param[out]  UBTEDU_LIMB_POSE_T *pstPose
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGetLimbPose(UBTEDU_ROBOT_LIMB_e eLimb, int iMaxAgeMs, UBTEDU_LIMB_POSE_T *pstPose)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    UBTEDU_ROBOTSERVO_T stServo;
+    unsigned char aucAngle[MAX_SERVO_NUM];
+
+    if ((eLimb < UBTEDU_ROBOT_LIMB_LEFT_ARM) || (eLimb >= UBTEDU_ROBOT_LIMB_INVALID) || (NULL == pstPose))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    ubtRet = ubtGetRobotServoCached(&stServo, iMaxAgeMs);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    _ubtGetServoStruct(&stServo, aucAngle);
+
+    pthread_mutex_lock(&g_stKinematicsMutex);
+    RobotKinUpdate(&g_stKinematics, aucAngle);
+    _ubtKinToPose(RobotKinGetPose(&g_stKinematics, (ROBOT_KIN_CHAIN_e)eLimb), pstPose);
+    pthread_mutex_unlock(&g_stKinematicsMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtComputeLimbPoses
+ * @details:    Get where the end of a limb is for many servo poses
+ * @param[in]   UBTEDU_ROBOT_LIMB_e eLimb
+ * @param[in]   uint8_t *angles   iNum sets of MAX_SERVO_NUM angles
+ * @param[in]   int iNum
+ * @param[out]  UBTEDU_LIMB_POSE_T *pstPose   iNum poses
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtComputeLimbPoses(UBTEDU_ROBOT_LIMB_e eLimb, const uint8_t *angles, int iNum,
+                                UBTEDU_LIMB_POSE_T *pstPose)
+{
+    ROBOT_KIN_POSE_T astKin[LIMB_POSE_BATCH];
+    int i, iDone, iBatch;
+
+    if ((eLimb < UBTEDU_ROBOT_LIMB_LEFT_ARM) || (eLimb >= UBTEDU_ROBOT_LIMB_INVALID)
+        || (NULL == angles) || (iNum < 0) || (NULL == pstPose))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    for (iDone = 0; iDone < iNum; iDone += iBatch)
+    {
+        iBatch = (iNum - iDone < LIMB_POSE_BATCH) ? iNum - iDone : LIMB_POSE_BATCH;
+        RobotKinForwardBatch((ROBOT_KIN_CHAIN_e)eLimb, angles + iDone * MAX_SERVO_NUM, iBatch, astKin);
+        for (i = 0; i < iBatch; i++)
+        {
+            _ubtKinToPose(&astKin[i], &pstPose[iDone + i]);
+        }
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtSolveLimbIK
+ * @details:    Get the servo angles which put the end of a limb at a point
+ * @param[in]   UBTEDU_ROBOT_LIMB_e eLimb
+ * @param[in]   float fX, fY, fZ    The target in the body frame, in mm
+ * @param[in]   uint8_t angles[]    Start of the search, 0 starts from the last solution
+ * @param[out]  uint8_t angles[]    The limb's servos are set to the solution
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSolveLimbIK(UBTEDU_ROBOT_LIMB_e eLimb, float fX, float fY, float fZ,
+                           uint8_t angles[MAX_SERVO_NUM])
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    const ROBOT_KIN_CHAIN_T *pstChain;
+    float afTarget[3];
+    int k, iServo;
+
+    pstChain = RobotKinGetChain((ROBOT_KIN_CHAIN_e)eLimb);
+    if ((NULL == pstChain) || (NULL == angles))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    afTarget[0] = fX;
+    afTarget[1] = fY;
+    afTarget[2] = fZ;
+    pthread_mutex_lock(&g_stKinematicsMutex);
+    for (k = 0; k < pstChain->iJointNum; k++)
+    {
+        iServo = pstChain->astJoint[k].iServo;
+        if ((0 == angles[iServo]) || (angles[iServo] > 180))
+        {
+            angles[iServo] = g_aucKinSolved[iServo];
+        }
+    }
+    ubtRet = RobotKinSolve((ROBOT_KIN_CHAIN_e)eLimb, afTarget, angles, NULL);
+    for (k = 0; k < pstChain->iJointNum; k++)
+    {
+        iServo = pstChain->astJoint[k].iServo;
+        g_aucKinSolved[iServo] = angles[iServo];
+    }
+    pthread_mutex_unlock(&g_stKinematicsMutex);
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      ubtSetServoRange
+ * @details:    Set the angles a servo may be sent to
+ * @param[in]   int iServo    1 ~ MAX_SERVO_NUM
+ * @param[in]   int iMin      0 ~ iMax
+ * @param[in]   int iMax      iMin ~ 180
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetServoRange(int iServo, int iMin, int iMax)
+{
+    return RobotSafetySetRange(iServo - 1, iMin, iMax);
+}
+
+/**
+ * @brief:      ubtSetCollisionCheck
+ * @details:    Turn the self collision check of the servo frames on or off
+ * @param[in]   int iEnable   0 to turn it off
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetCollisionCheck(int iEnable)
+{
+    RobotSafetySetCollision(iEnable);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtGetSafetyStats
+ * @details:    Get the servo frames checked, clamped and rejected
+ * @param[in]   None
+ * @param[out]  UBTEDU_SAFETY_STATS_T *pstStats
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGetSafetyStats(UBTEDU_SAFETY_STATS_T *pstStats)
+{
+    ROBOT_SAFETY_STATS_T stStats;
+
+    if (NULL == pstStats)
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    RobotSafetyGetStats(&stStats);
+    pstStats->uiChecked = stStats.uiChecked;
+    pstStats->uiClamped = stStats.uiClamped;
+    pstStats->uiRejected = stStats.uiRejected;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtGetServoOffsets
+ * @details:    Get the calibration offsets read from the robot when it was
+ *              connected
+ * @param[in]   None
+ * @param[out]  int8_t offsets[]  MAX_SERVO_NUM offsets in degree, offsets[0] is servo 1
+ * @retval: UBTEDU_RC_T   UBTEDU_RC_NOT_FOUND when the robot gave none
+ */
+UBTEDU_RC_T ubtGetServoOffsets(int8_t offsets[MAX_SERVO_NUM])
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_NOT_FOUND;
+
+    if (NULL == offsets)
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    if (g_iServoOffsetValid)
+    {
+        memcpy(offsets, g_acServoOffset, sizeof(g_acServoOffset));
+        ubtRet = UBTEDU_RC_SUCCESS;
+    }
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      ubtSetServoOffsetEnable
+ * @details:    Turn the calibration offsets on or off, for programs which
+ *              apply offsets themselves
+ * @param[in]   int iEnable   0 to send and read the raw servo angles
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetServoOffsetEnable(int iEnable)
+{
+    pthread_mutex_lock(&g_stServoShadowMutex);
+    g_iServoOffsetEnable = (0 != iEnable);
+    pthread_mutex_unlock(&g_stServoShadowMutex);
+    _ubtServoOffsetSync();
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      _ubtGaitParam
+ * @details:    Check the gait parameters and convert them
+ * @param[in]   UBTEDU_GAIT_PARAM_T *pstParam
+ * @param[out]  ROBOT_GAIT_PARAM_T *pstGaitParam
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _ubtGaitParam(const UBTEDU_GAIT_PARAM_T *pstParam, ROBOT_GAIT_PARAM_T *pstGaitParam)
+{
+    if ((NULL == pstParam) || (pstParam->iCadence <= 0))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pstGaitParam->fStepLength = (float)pstParam->iStepLength;
+    pstGaitParam->fTurn = (float)pstParam->iTurnRate;
+    pstGaitParam->fStepMs = 60000.0f / pstParam->iCadence;
+    if ((fabsf(pstGaitParam->fStepLength) > ROBOT_GAIT_MAX_STEP) || (fabsf(pstGaitParam->fTurn) > ROBOT_GAIT_MAX_TURN)
+        || (pstGaitParam->fStepMs < ROBOT_GAIT_MIN_STEP_MS) || (pstGaitParam->fStepMs > ROBOT_GAIT_MAX_STEP_MS))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      _ubtGaitThread
+ * @details:    Feed the gait to the servo stream, one frame every
+ *              SERVO_GAIT_FRAME_MS, one frame ahead of the stream
+ * @param[in]   void *arg
+ * @param[out]  None
+ * @retval:     void *
+ */
+static void *_ubtGaitThread(void *arg)
+{
+    unsigned char aucAngle[MAX_SERVO_NUM];
+    struct timespec stNext;
+    int iStanding, iFirst = 1;
+
+    memset(aucAngle, 0, sizeof(aucAngle));
+    clock_gettime(CLOCK_MONOTONIC, &stNext);
+    while (g_iGaitRunning)
+    {
+        pthread_mutex_lock(&g_stGaitMutex);
+        RobotGaitNext(&g_stGait, iFirst ? 0.0f : (float)SERVO_GAIT_FRAME_MS, aucAngle);
+        iStanding = RobotGaitIsStanding(&g_stGait);
+        pthread_mutex_unlock(&g_stGaitMutex);
+
+        if ((iFirst && (UBTEDU_RC_SUCCESS != ubtServoStreamPush(aucAngle, SERVO_GAIT_FRAME_MS)))
+            || (UBTEDU_RC_SUCCESS != ubtServoStreamPush(aucAngle, SERVO_GAIT_FRAME_MS))
+            || (g_iGaitStopping && iStanding))
+        {
+            break;
+        }
+        iFirst = 0;
+
+        stNext.tv_nsec += SERVO_GAIT_FRAME_MS * 1000000L;
+        while (stNext.tv_nsec >= 1000000000L)
+        {
+            stNext.tv_nsec -= 1000000000L;
+            stNext.tv_sec++;
+        }
+        while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &stNext, NULL));
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief:      ubtGaitStart
+ * @details:    Start walking on the servo stream, from standing
+ * @param[in]   UBTEDU_GAIT_PARAM_T *pstParam
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGaitStart(const UBTEDU_GAIT_PARAM_T *pstParam)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    ROBOT_GAIT_PARAM_T stParam;
+
+    ubtRet = _ubtGaitParam(pstParam, &stParam);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    if (g_iGaitRunning || !g_iServoStreamRunning)
+    {
+        return UBTEDU_RC_FAILED;
+    }
+
+    pthread_mutex_lock(&g_stGaitMutex);
+    RobotGaitInit(&g_stGait);
+    RobotGaitSetParam(&g_stGait, &stParam);
+    pthread_mutex_unlock(&g_stGaitMutex);
+
+    g_iGaitStopping = 0;
+    g_iGaitRunning = 1;
+    if (0 != pthread_create(&g_stGaitThread, NULL, _ubtGaitThread, NULL))
+    {
+        printf("pthread_create failed \n");
+        g_iGaitRunning = 0;
+        return UBTEDU_RC_FAILED;
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtGaitSetParam
+ * @details:    Change the gait, from the next step on
+ * @param[in]   UBTEDU_GAIT_PARAM_T *pstParam
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGaitSetParam(const UBTEDU_GAIT_PARAM_T *pstParam)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    ROBOT_GAIT_PARAM_T stParam;
+
+    ubtRet = _ubtGaitParam(pstParam, &stParam);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    if (!g_iGaitRunning)
+    {
+        return UBTEDU_RC_FAILED;
+    }
+
+    pthread_mutex_lock(&g_stGaitMutex);
+    ubtRet = RobotGaitSetParam(&g_stGait, &stParam);
+    pthread_mutex_unlock(&g_stGaitMutex);
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      ubtGaitStop
+ * @details:    Bring the feet together and stop walking. Returns once the
+ *              last step is queued on the servo stream.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGaitStop(void)
+{
+    ROBOT_GAIT_PARAM_T stParam;
+
+    if (!g_iGaitRunning)
+    {
+        return UBTEDU_RC_SUCCESS;
+    }
+
+    pthread_mutex_lock(&g_stGaitMutex);
+    stParam = g_stGait.stNext;
+    stParam.fStepLength = 0.0f;
+    stParam.fTurn = 0.0f;
+    RobotGaitSetParam(&g_stGait, &stParam);
+    pthread_mutex_unlock(&g_stGaitMutex);
+
+    g_iGaitStopping = 1;
+    pthread_join(g_stGaitThread, NULL);
+    g_iGaitRunning = 0;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtGaitExport
+ * @details:    Save iSteps steps of a gait as an HTS action file, from
+ *              standing and back to standing
+ * @param[in]   UBTEDU_GAIT_PARAM_T *pstParam   With a step length or a turn rate
+ * @param[in]   int iSteps      1 or more
+ * @param[in]   char *pcPath    The action file's path
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGaitExport(const UBTEDU_GAIT_PARAM_T *pstParam, int iSteps, char *pcPath)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    ROBOT_GAIT_PARAM_T stParam;
+    ROBOT_HTS_T stHts;
+
+    if (NULL == pcPath)
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    ubtRet = _ubtGaitParam(pstParam, &stParam);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    ubtRet = RobotGaitBuildHts(&stParam, iSteps, SERVO_GAIT_FRAME_MS, &stHts);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    ubtRet = RobotHtsWrite(&stHts, pcPath);
+    RobotHtsDestroy(&stHts);
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtBalanceReadImu
+ * @details:    Read the IMU through the balance socket, the answer must
+ *              come before ullDeadlineUs. An answer to an earlier request
+ *              which came too late is taken as well.
+ * @param[in]   int iFd           Balance socket
+ * @param[in]   int iPort         Its port
+ * @param[in]   struct sockaddr_in *pstAddr   The robot
+ * @param[in]   unsigned long long ullDeadlineUs
+ * @param[out]  ROBOT_BALANCE_IMU_T *pstImu
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _ubtBalanceReadImu(int iFd, int iPort, struct sockaddr_in *pstAddr,
+                                      unsigned long long ullDeadlineUs, ROBOT_BALANCE_IMU_T *pstImu)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    UBTEDU_ROBOTGYRO_SENSOR_T stGyro;
+    unsigned long long ullNowUs;
+    struct timeval stTimeout;
+    int iLen;
+
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_ReadSensorValue(pcStr_Msg_Param_Query_Sensor_GYRO, iPort,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    RobotMessageArenaEnd();
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    if (sendto(iFd, acSocketBuffer, strlen(acSocketBuffer), 0,
+               (struct sockaddr *)pstAddr, sizeof(struct sockaddr_in)) <= 0)
+    {
+        return UBTEDU_RC_SOCKET_SENDERROR;
+    }
+
+    ubtRet = UBTEDU_RC_SOCKET_TIMEOUT;
+    while ((ullNowUs = _ubtNowUs()) < ullDeadlineUs)
+    {
+        stTimeout.tv_sec = (ullDeadlineUs - ullNowUs) / 1000000ULL;
+        stTimeout.tv_usec = (ullDeadlineUs - ullNowUs) % 1000000ULL;
+        setsockopt(iFd, SOL_SOCKET, SO_RCVTIMEO, &stTimeout, sizeof(stTimeout));
+        iLen = recv(iFd, acSocketBuffer, sizeof(acSocketBuffer) - 1, 0);
+        if (iLen <= 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            break;
+        }
+        acSocketBuffer[iLen] = '\0';
+
+        memset(&stGyro, 0, sizeof(stGyro));
+        RobotMessageArenaBegin();
+        ubtRet = ubtRobot_Msg_Decode_ReadSensorValue(acSocketBuffer, pcStr_Msg_Param_Query_Sensor_GYRO,
+                 &stGyro, sizeof(stGyro));
+        RobotMessageArenaEnd();
+        if (UBTEDU_RC_SUCCESS == ubtRet)
+        {
+            pstImu->fPitch = (float)stGyro.dEuleryValue;
+            pstImu->fRoll = (float)stGyro.dEulerxValue;
+            pstImu->fPitchRate = (float)stGyro.dGyroyValue;
+            pstImu->fRollRate = (float)stGyro.dGyroxValue;
+            break;
+        }
+    }
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtBalanceThread
+ * @details:    Balance loop. It wakes up on a fixed period, reads the IMU
+ *              and updates the corrections which the servo stream adds to
+ *              its frames. A loop never
+ *              waits for the IMU past its period, the corrections are then
+ *              kept as they were.
+ * @param[in]   void *arg
+ * @param[out]  None
+ * @retval:     void *
+ */
+static void *_ubtBalanceThread(void *arg)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    ROBOT_BALANCE_IMU_T stImu;
+    struct sockaddr_in stAddr;
+    struct timespec stNext;
+    unsigned long long ullStartUs, ullLatencyUs;
+    long lPeriodNs = g_iBalancePeriodUs * 1000L;
+    unsigned int uiOverruns = 0;
+    int iFd = -1, iPort = 0;
+
+    iFd = _udpServerInit(&iPort, 1);
+    if (iFd < 0)
+    {
+        printf("Create balance socket failed!\r\n");
+        return NULL;
+    }
+    pthread_mutex_lock(&stMutex);
+    memset(&stAddr, 0, sizeof(stAddr));
+    stAddr.sin_family = AF_INET;
+    stAddr.sin_port = htons(g_iSDK2RobotPort);
+    stAddr.sin_addr.s_addr = inet_addr(g_stConnectedRobotInfo.acIPAddr);
+    pthread_mutex_unlock(&stMutex);
+
+    clock_gettime(CLOCK_MONOTONIC, &stNext);
+    while (g_iBalanceRunning)
+    {
+        ullStartUs = _ubtNowUs();
+        ubtRet = _ubtBalanceReadImu(iFd, iPort, &stAddr, ullStartUs + g_iBalancePeriodUs, &stImu);
+
+        pthread_mutex_lock(&g_stBalanceMutex);
+        g_stBalanceStats.uiOverruns += uiOverruns;
+        uiOverruns = 0;
+        if (UBTEDU_RC_SUCCESS == ubtRet)
+        {
+            RobotBalanceUpdate(&g_stBalance, &stImu);
+            ullLatencyUs = _ubtNowUs() - ullStartUs;
+            g_stBalanceStats.uiLoops++;
+            g_ullBalanceLatencySumUs += ullLatencyUs;
+            g_stBalanceStats.uiLatencyAvgUs = g_ullBalanceLatencySumUs / g_stBalanceStats.uiLoops;
+            if (ullLatencyUs > g_stBalanceStats.uiLatencyMaxUs)
+            {
+                g_stBalanceStats.uiLatencyMaxUs = ullLatencyUs;
+            }
+            g_stBalanceStats.fPitch = stImu.fPitch;
+            g_stBalanceStats.fRoll = stImu.fRoll;
+            g_stBalanceStats.fPitchCorrection = g_stBalance.fPitch;
+            g_stBalanceStats.fRollCorrection = g_stBalance.fRoll;
+        }
+        else
+        {
+            g_stBalanceStats.uiReadFailed++;
+        }
+        pthread_mutex_unlock(&g_stBalanceMutex);
+
+        /* Keep the period, count the ones a slow loop used up */
+        stNext.tv_nsec += lPeriodNs;
+        while (stNext.tv_nsec >= 1000000000L)
+        {
+            stNext.tv_nsec -= 1000000000L;
+            stNext.tv_sec++;
+        }
+        while ((unsigned long long)stNext.tv_sec * 1000000ULL + stNext.tv_nsec / 1000 < _ubtNowUs())
+        {
+            uiOverruns++;
+            stNext.tv_nsec += lPeriodNs;
+            while (stNext.tv_nsec >= 1000000000L)
+            {
+                stNext.tv_nsec -= 1000000000L;
+                stNext.tv_sec++;
+            }
+        }
+        while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &stNext, NULL));
+    }
+
+    close(iFd);
+
+    return NULL;
+}
+
+/**
+ * @brief:      ubtBalanceStart
+ * @details:    Start the balance controller
+ * @param[in]   UBTEDU_BALANCE_PARAM_T *pstParam
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtBalanceStart(const UBTEDU_BALANCE_PARAM_T *pstParam)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    ROBOT_BALANCE_GAIN_T stGain;
+
+    if ((NULL == pstParam) || (pstParam->iRateHz < 10) || (pstParam->iRateHz > 100))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    if (g_iBalanceRunning)
+    {
+        return UBTEDU_RC_FAILED;
+    }
+
+    stGain.fKp = pstParam->fKp;
+    stGain.fKd = pstParam->fKd;
+    stGain.fHipRatio = pstParam->fHipRatio;
+    stGain.fMaxCorrection = (float)pstParam->iMaxCorrection;
+    pthread_mutex_lock(&g_stBalanceMutex);
+    ubtRet = RobotBalanceInit(&g_stBalance, &stGain);
+    memset(&g_stBalanceStats, 0, sizeof(g_stBalanceStats));
+    g_ullBalanceLatencySumUs = 0;
+    pthread_mutex_unlock(&g_stBalanceMutex);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    g_iBalancePeriodUs = 1000000 / pstParam->iRateHz;
+    g_iBalanceRunning = 1;
+    if (0 != pthread_create(&g_stBalanceThread, NULL, _ubtBalanceThread, NULL))
+    {
+        printf("pthread_create failed \n");
+        g_iBalanceRunning = 0;
+        return UBTEDU_RC_FAILED;
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtBalanceStop
+ * @details:    Stop the balance controller, the servo stream goes on
+ *              without the corrections
+ * @param[in]   None
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtBalanceStop(void)
+{
+    if (!g_iBalanceRunning)
+    {
+        return UBTEDU_RC_SUCCESS;
+    }
+
+    g_iBalanceRunning = 0;
+    pthread_join(g_stBalanceThread, NULL);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtBalanceGetStats
+ * @details:    Get the balance controller statistics
+ * @param[in]   None
+ * @param[out]  UBTEDU_BALANCE_STATS_T *pstStats
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtBalanceGetStats(UBTEDU_BALANCE_STATS_T *pstStats)
+{
+    if (NULL == pstStats)
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pthread_mutex_lock(&g_stBalanceMutex);
+    memcpy(pstStats, &g_stBalanceStats, sizeof(UBTEDU_BALANCE_STATS_T));
+    pthread_mutex_unlock(&g_stBalanceMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtSetRobotVolume
+ * @details:    Set the volume for the Robot
+ * @param[in]   int iVolume  [0-100] Volume percent
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetRobotVolume(int iVolume)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+
+    acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_SetRobotVolume(g_iRobot2SDKPort, iVolume,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_SetRobotVolume(acSocketBuffer);
+    }
+    RobotMessageArenaEnd();
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      ubtSetRobotMotion
+ * @details:    Set the robot's action
+ * @param[in]   char *pcType    crouch
+  *                             raise
+  *                             stretch
+  *                             come on
+  *                             wave
+  *                             bend
+  *                             walk
+  *                             turn around
+  *                             bow
+ * @param[in]   char *pcDirect  left
+  *                             right
+  *                             both
+  *                             front
+  *                             back
+ * @param[in]   int iSpeed      1/2/3/4/5  The default value is 3
+ * @param[in]   int iRepeat     Repeat times, 1 or more. Ignored for the head
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetRobotMotion(char *pcType, char *pcDirect, int iSpeed, int iRepeat)
+{
+    ROBOT_HTS_T stHts;
+    const ROBOT_MOTION_T *pstMotion;
+    char acFullName[ROBOT_HTS_PATH_LEN]= "\0";
+    char acKey[ROBOT_HTS_CACHE_KEY_LEN];
+    char acAngle[3];
+    int speed;
+    UBTEDU_RC_T ubtRet;
+
+    if (pcType == NULL)
+    {
+        printf("SetRobotMotion pcType is null!\r\n");
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    if(iSpeed<=0 || iSpeed >6)
+    {
+        printf("SetRobotMotion iSpeed is outrange(1~6)\r\n");
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    speed = SERVO_MAX_LOW_SPEED/iSpeed;
+    _ubtServoShadowReset();
+
+    if (!strcmp(pcType, MOTION_TYPE_HEAD_STR))
+    {
+        acAngle[2]='\0';
+        if ((NULL != pcDirect) && !strcmp(pcDirect, MOTION_DIRECTION_LEFT_STR))
+        {
+            acAngle[0]='2';
+            acAngle[1]='8';
+            return _ubtSetRobotServo(SERVO_HEAD_INDEX, acAngle, iSpeed);
+        }
+        else if ((NULL != pcDirect) && !strcmp(pcDirect, MOTION_DIRECTION_RIGHT_STR))
+        {
+            acAngle[0]='7';
+            acAngle[1]='8';
+            return _ubtSetRobotServo(SERVO_HEAD_INDEX, acAngle, iSpeed);
+        }
+        else if ((NULL != pcDirect) && !strcmp(pcDirect, MOTION_DIRECTION_FRONT_STR))
+        {
+            acAngle[0]='5';
+            acAngle[1]='A';
+            return _ubtSetRobotServo(SERVO_HEAD_INDEX, acAngle, iSpeed);
+        }
+        else
+        {
+            printf("head direct:%s error\r\n", pcDirect);
+            return UBTEDU_RC_WRONG_PARAM;
+        }
+    }
+
+    /* The motion is written out frame by frame, so there is no endless repeat */
+    if (iRepeat < 1)
+    {
+        printf("SetRobotMotion iRepeat %d error\r\n", iRepeat);
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pstMotion = RobotMotionFind(pcType, pcDirect);
+    if (NULL == pstMotion)
+    {
+        printf("The Type[%s] direct[%s] motion is unsurpport!\r\n", pcType, pcDirect);
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    /* The same motion is only generated and written once */
+    snprintf(acKey, sizeof(acKey), "%s|%s|%d|%d", pcType, (NULL == pstMotion->pcDirect) ? "" : pcDirect,
+             iSpeed, iRepeat);
+    if (UBTEDU_RC_SUCCESS == RobotHtsCacheFind(acKey, acFullName, sizeof(acFullName)))
+    {
+        /* Played to the end when it returns, the file can go */
+        ubtRet = ubtStartRobotAction(acFullName,1);
+        RobotHtsCacheRelease(acFullName);
+        return ubtRet;
+    }
+
+    if (UBTEDU_RC_SUCCESS != RobotMotionBuild(pstMotion, iRepeat, speed, &stHts))
+    {
+        printf("SetRobotMotion iRepeat %d error\r\n", iRepeat);
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    if (UBTEDU_RC_SUCCESS != RobotHtsSave(&stHts, MOTION_HTS_DIR, acFullName, sizeof(acFullName)))
+    {
+        printf("SetRobotMotion create file failed!\r\n");
+        RobotHtsDestroy(&stHts);
+        return UBTEDU_RC_NORESOURCE;
+    }
+    RobotHtsDestroy(&stHts);
+    if (UBTEDU_RC_SUCCESS != RobotHtsCacheAdd(acKey, acFullName))
+    {
+        /* Not cached, nobody else knows the file */
+        ubtRet = ubtStartRobotAction(acFullName,1);
+        unlink(acFullName);
+        return ubtRet;
+    }
+    ubtRet = ubtStartRobotAction(acFullName,1);
+    RobotHtsCacheRelease(acFullName);
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtSensorHistoryAdd
+ * @details:    Keep a sensor value read now in the sensor's history
+ * @param[in]   char *pcSensorType
+ * @param[in]   void *pValue
+ * @param[in]   int iValueLen
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtSensorHistoryAdd(const char *pcSensorType, const void *pValue, int iValueLen)
+{
+    UBTEDU_SENSOR_SAMPLE_T stSample;
+    UBTEDU_SENSOR_TYPE_e eType = RobotSensorGetType(pcSensorType);
+
+    if ((UBTEDU_SENSOR_INVALID == eType) || (iValueLen < RobotSensorGetSize(eType)))
+    {
+        return;
+    }
+    memset(&stSample, 0, sizeof(stSample));
+    stSample.eType = eType;
+    stSample.ullTimeUs = _ubtNowUs();
+    memcpy(&stSample.uValue, pValue, RobotSensorGetSize(eType));
+    RobotSensorHistoryPush(&g_astSensorHistory[eType], &stSample);
+}
+
+
+/**
+ * @brief:      ubtReadSensorValue
+ * @details:    Read the sensor's value
+ * @param[in]   char *pcSensorType  The sensor's type.
+ *                                  gyro
+ *                                  environment
+ *                                  board
+ *                                  infrared
+ *                                  ultrasonic
+ *                                  touch
+ *                                  color
+ *                                  pressure
+ *                                  gas
+ * @param[out]  void *pValue        The sensor value. More details please see the defination as below variable type
+ *                                  UBTEDU_ROBOTGYRO_SENSOR_T
+ *                                  UBTEDU_ROBOTENV_SENSOR_T
+ *                                  UBTEDU_ROBOTRASPBOARD_SENSOR_T
+ *                                  UBTEDU_ROBOTINFRARED_SENSOR_T
+ *                                  UBTEDU_ROBOTULTRASONIC_SENSOR_T
+ *                                  UBTEDU_ROBOTTOUCH_SENSOR_T
+ *                                  UBTEDU_ROBOTCOLOR_SENSOR_T
+ *                                  UBTEDU_ROBOTPRESSURE_SENSOR_T
+ *                                  UBTEDU_ROBOTGAS_SENSOR_T
+ * @param[in]   int iValueLen       The max length of pValue
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtReadSensorValue(char *pcSensorType, void *pValue, int iValueLen)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+
+    if ((NULL == pcSensorType) || (NULL == pValue))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    acSocketBuffer[0] = '\0';
+
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_ReadSensorValue(pcSensorType, g_iRobot2SDKPort,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_ReadSensorValue(acSocketBuffer, pcSensorType, pValue, iValueLen);
+    }
+    RobotMessageArenaEnd();
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        _ubtSensorHistoryAdd(pcSensorType, pValue, iValueLen);
+    }
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      ubtReadSensorValueByAddr
+ * @details:    Read the sensor's value by it's type and address. The value
+ *              is not kept in the sensor's history, which holds one sensor
+ *              per type, and a second sensor of the type may be at iAddr.
+ * @param[in]   char *pcSensorType  The sensor's type.
+ *                                  gryo
+ *                                  environment
+ *                                  board
+ *                                  infrared
+ *                                  ultrasonic
+ *                                  touch
+ *                                  color
+ *                                  pressure
+ *                                  gas
+ * @param[in]   int iAddr             The sensor's 7bit I2C address
+ * @param[out]  void *pValue      The sensor value. More details please see the defination as below variable type
+ *                                  UBTEDU_ROBOTGYRO_SENSOR_T
+ *                                  UBTEDU_ROBOTENV_SENSOR_T
+ *                                  UBTEDU_ROBOTRASPBOARD_SENSOR_T
+ *                                  UBTEDU_ROBOTINFRARED_SENSOR_T
+ *                                  UBTEDU_ROBOTULTRASONIC_SENSOR_T
+ *                                  UBTEDU_ROBOTTOUCH_SENSOR_T
+ *                                  UBTEDU_ROBOTCOLOR_SENSOR_T
+ *                                  UBTEDU_ROBOTPRESSURE_SENSOR_T
+ *                                  UBTEDU_ROBOTGAS_SENSOR_T
+ * @param[in]   int iValueLen       The max length of pValue
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtReadSensorValueByAddr(char *pcSensorType, int iAddr, void *pValue, int iValueLen)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+
+    if ((NULL == pcSensorType) || (NULL == pValue))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    acSocketBuffer[0] = '\0';
+
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_ReadSensorValueByAddr(pcSensorType, iAddr, g_iRobot2SDKPort,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_ReadSensorValue(acSocketBuffer, pcSensorType, pValue, iValueLen);
+    }
+    RobotMessageArenaEnd();
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      ubtReadSensors
+ * @details:    Read several sensors in one round trip. A robot which does
+ *              not know the batched query answers none of them, they are
+ *              then read one by one like ubtReadSensorValue().
+ * @param[in]   const char *apcType[]   Sensor types, like ubtReadSensorValue()
+ * @param[in]   int iNum                1 ~ 16
+ * @param[out]  void *apValue[]         Value of each sensor, its
+ *                                      UBTEDU_ROBOT*_SENSOR_T
+ * @param[out]  UBTEDU_RC_T aeResult[]  Result of each sensor, may be NULL
+ * @retval: UBTEDU_RC_T  The result of the first sensor which failed
+ */
+UBTEDU_RC_T ubtReadSensors(const char *apcType[], void *apValue[], int iNum, UBTEDU_RC_T aeResult[])
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    UBTEDU_SENSOR_TYPE_e eType;
+    char acSocketBuffer[SENSOR_BATCH_MESSAGE_MAX_LEN];
+    char *apcQuery[SENSOR_BATCH_MAX_NUM];
+    void *apQueryValue[SENSOR_BATCH_MAX_NUM];
+    int aiQueryLen[SENSOR_BATCH_MAX_NUM];
+    int aiQuery[SENSOR_BATCH_MAX_NUM];
+    UBTEDU_RC_T aeQueryResult[SENSOR_BATCH_MAX_NUM];
+    UBTEDU_RC_T aeAll[SENSOR_BATCH_MAX_NUM];
+    int i, iQueryNum = 0, iFound = 0;
+
+    if ((NULL == apcType) || (NULL == apValue) || (iNum < 1) || (iNum > SENSOR_BATCH_MAX_NUM))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    for (i = 0; i < iNum; i++)
+    {
+        eType = RobotSensorGetType(apcType[i]);
+        if ((UBTEDU_SENSOR_INVALID == eType) || (NULL == apValue[i]))
+        {
+            aeAll[i] = UBTEDU_RC_WRONG_PARAM;
+            continue;
+        }
+        apcQuery[iQueryNum] = (char *)apcType[i];
+        apQueryValue[iQueryNum] = apValue[i];
+        aiQueryLen[iQueryNum] = RobotSensorGetSize(eType);
+        aiQuery[iQueryNum++] = i;
+    }
+
+    if (iQueryNum > 0)
+    {
+        acSocketBuffer[0] = '\0';
+        /* The answer is not always ended by the robot */
+        acSocketBuffer[sizeof(acSocketBuffer) - 1] = '\0';
+        RobotMessageArenaBegin();
+        ubtRet = ubtRobot_Msg_Encode_ReadSensors(apcQuery, iQueryNum, g_iRobot2SDKPort,
+                 acSocketBuffer, sizeof(acSocketBuffer) - 1);
+        if (UBTEDU_RC_SUCCESS == ubtRet)
+        {
+            ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer) - 1, 0);
+        }
+        if (UBTEDU_RC_SUCCESS == ubtRet)
+        {
+            ubtRet = ubtRobot_Msg_Decode_ReadSensors(acSocketBuffer, apcQuery, apQueryValue, aiQueryLen,
+                     aeQueryResult, iQueryNum);
+        }
+        RobotMessageArenaEnd();
+
+        for (i = 0; i < iQueryNum; i++)
+        {
+            if (UBTEDU_RC_SUCCESS != ubtRet)
+            {
+                aeQueryResult[i] = ubtRet;
+            }
+            iFound += (UBTEDU_RC_NOT_FOUND != aeQueryResult[i]);
+        }
+        for (i = 0; i < iQueryNum; i++)
+        {
+            if ((UBTEDU_RC_SUCCESS == ubtRet) && (0 == iFound))
+            {
+                aeQueryResult[i] = ubtReadSensorValue(apcQuery[i], apQueryValue[i], aiQueryLen[i]);
+            }
+            else if (UBTEDU_RC_SUCCESS == aeQueryResult[i])
+            {
+                _ubtSensorHistoryAdd(apcQuery[i], apQueryValue[i], aiQueryLen[i]);
+            }
+            aeAll[aiQuery[i]] = aeQueryResult[i];
+        }
+    }
+
+    ubtRet = UBTEDU_RC_SUCCESS;
+    for (i = 0; i < iNum; i++)
+    {
+        if (NULL != aeResult)
+        {
+            aeResult[i] = aeAll[i];
+        }
+        if ((UBTEDU_RC_SUCCESS == ubtRet) && (UBTEDU_RC_SUCCESS != aeAll[i]))
+        {
+            ubtRet = aeAll[i];
+        }
+    }
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtSensorSubSend
+ * @details:    Send a message to the robot from the subscription's port
+ * @param[in]   char *pcBuffer
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _ubtSensorSubSend(char *pcBuffer)
+{
+    int iPort;
+
+    pthread_mutex_lock(&stMutex);
+    iPort = g_iSDK2RobotPort;
+    pthread_mutex_unlock(&stMutex);
+
+    if (_ubtSendUDPMsg(g_stConnectedRobotInfo.acIPAddr, iPort, pcBuffer, strlen(pcBuffer)) < 0)
+    {
+        return UBTEDU_RC_SOCKET_SENDERROR;
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      _ubtSensorSubRequest
+ * @details:    Send a sensor configuration and wait for its answer. Samples
+ *              which come in meanwhile are dropped.
+ * @param[in]   char *pcBuffer       The configuration, then the answer
+ * @param[in]   int iBufLen
+ * @param[in]   char *pcConfigType   mode or frequency
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_SOCKET_TIMEOUT when the robot does not answer
+ */
+static UBTEDU_RC_T _ubtSensorSubRequest(char *pcBuffer, int iBufLen, char *pcConfigType)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    struct pollfd stPoll;
+    unsigned long long ullNowUs, ullDeadlineUs;
+    int iRet;
+
+    ubtRet = _ubtSensorSubSend(pcBuffer);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    stPoll.fd = g_iSensorSubFd;
+    stPoll.events = POLLIN;
+    ullDeadlineUs = _ubtNowUs() + SENSOR_SUB_TIMEOUT_MS * 1000ULL;
+    while ((ullNowUs = _ubtNowUs()) < ullDeadlineUs)
+    {
+        iRet = poll(&stPoll, 1, (int)((ullDeadlineUs - ullNowUs + 999) / 1000));
+        if (iRet <= 0)
+        {
+            if ((iRet < 0) && (EINTR == errno))
+            {
+                continue;
+            }
+            break;
+        }
+        iRet = recv(g_iSensorSubFd, pcBuffer, iBufLen - 1, 0);
+        if (iRet <= 0)
+        {
+            continue;
+        }
+        pcBuffer[iRet] = '\0';
+
+        RobotMessageArenaBegin();
+        ubtRet = ubtRobot_Msg_Decode_SensorConfig(pcBuffer, pcConfigType);
+        RobotMessageArenaEnd();
+        if ((UBTEDU_RC_SOCKET_DECODE_ERROR != ubtRet) && (UBTEDU_RC_SOCKET_DECODE_FAILED != ubtRet))
+        {
+            return ubtRet;
+        }
+    }
+
+    return UBTEDU_RC_SOCKET_TIMEOUT;
+}
+
+/**
+ * @brief:      _ubtSensorSubStart
+ * @details:    Ask the robot to push a sensor's samples at iRateHz
+ * @param[in]   UBTEDU_SENSOR_TYPE_e eType
+ * @param[in]   int iRateHz
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_SOCKET_TIMEOUT when the robot does not answer
+ */
+static UBTEDU_RC_T _ubtSensorSubStart(UBTEDU_SENSOR_TYPE_e eType, int iRateHz)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+
+    acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_SensorFrequency(g_iSensorSubPort, RobotSensorGetName(eType), iRateHz,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    RobotMessageArenaEnd();
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtSensorSubRequest(acSocketBuffer, sizeof(acSocketBuffer), pcStr_Msg_Type_Sensor_FREQ);
+    }
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_SensorMode(g_iSensorSubPort, RobotSensorGetName(eType),
+             pcStr_Msg_Param_Query_Sensor_Start, acSocketBuffer, sizeof(acSocketBuffer));
+    RobotMessageArenaEnd();
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtSensorSubRequest(acSocketBuffer, sizeof(acSocketBuffer), pcStr_Msg_Type_Sensor_MODE);
+    }
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtSensorSubClose
+ * @details:    Stop the pushed sensors and close the subscription's socket.
+ *              The robot's answers are not waited for.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtSensorSubClose(void)
+{
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    int i;
+
+    for (i = 0; i < UBTEDU_SENSOR_INVALID; i++)
+    {
+        if (!(g_uiSensorSubMask & ~g_uiSensorPollMask & (1u << i)))
+        {
+            continue;
+        }
+        acSocketBuffer[0] = '\0';
+        RobotMessageArenaBegin();
+        if (UBTEDU_RC_SUCCESS == ubtRobot_Msg_Encode_SensorMode(g_iSensorSubPort, RobotSensorGetName(i),
+                pcStr_Msg_Param_Query_Sensor_Stop, acSocketBuffer, sizeof(acSocketBuffer)))
+        {
+            _ubtSensorSubSend(acSocketBuffer);
+        }
+        RobotMessageArenaEnd();
+    }
+
+    close(g_iSensorSubFd);
+    g_iSensorSubFd = -1;
+    g_iSensorSubPort = -1;
+    g_uiSensorSubMask = 0;
+}
+
+/**
+ * @brief:      _ubtSensorSubPoll
+ * @details:    Query the polled sensors, their answers come in like the
+ *              pushed samples
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     unsigned int  Sensors queried
+ */
+static unsigned int _ubtSensorSubPoll(void)
+{
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    unsigned int uiSent = 0;
+    int i;
+
+    for (i = 0; i < UBTEDU_SENSOR_INVALID; i++)
+    {
+        if (!(g_uiSensorPollMask & (1u << i)))
+        {
+            continue;
+        }
+        acSocketBuffer[0] = '\0';
+        RobotMessageArenaBegin();
+        if ((UBTEDU_RC_SUCCESS == ubtRobot_Msg_Encode_ReadSensorValue(RobotSensorGetName(i), g_iSensorSubPort,
+                acSocketBuffer, sizeof(acSocketBuffer)))
+            && (UBTEDU_RC_SUCCESS == _ubtSensorSubSend(acSocketBuffer)))
+        {
+            uiSent |= 1u << i;
+        }
+        RobotMessageArenaEnd();
+    }
+
+    return uiSent;
+}
+
+/**
+ * @brief:      _ubtSensorSubThread
+ * @details:    Receive the samples of the subscribed sensors into the
+ *              ring, and poll the ones the robot does not push. A poll not
+ *              answered before the next one counts as failed.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void *
+ */
+static void *_ubtSensorSubThread(void *arg)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    UBTEDU_SENSOR_SAMPLE_T stSample;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    struct pollfd stPoll;
+    unsigned long long ullNowUs, ullNextUs;
+    unsigned int uiPending = 0;
+    int iRet, iWaitMs;
+
+    stPoll.fd = g_iSensorSubFd;
+    stPoll.events = POLLIN;
+    ullNextUs = _ubtNowUs();
+    while (g_iSensorSubRunning)
+    {
+        iWaitMs = SENSOR_SUB_WAIT_MS;
+        if (0 != g_uiSensorPollMask)
+        {
+            ullNowUs = _ubtNowUs();
+            if (ullNowUs >= ullNextUs)
+            {
+                __atomic_add_fetch(&g_uiSensorSubFailed, __builtin_popcount(uiPending), __ATOMIC_RELAXED);
+                uiPending = _ubtSensorSubPoll();
+                /* Skip the polls a late wake-up already missed */
+                do
+                {
+                    ullNextUs += g_iSensorSubPeriodUs;
+                }
+                while (ullNextUs <= ullNowUs);
+            }
+            if ((ullNextUs - ullNowUs) / 1000 < iWaitMs)
+            {
+                iWaitMs = (int)((ullNextUs - ullNowUs) / 1000);
+            }
+        }
+
+        iRet = poll(&stPoll, 1, iWaitMs);
+        if (iRet <= 0)
+        {
+            continue;
+        }
+        iRet = recv(g_iSensorSubFd, acSocketBuffer, sizeof(acSocketBuffer) - 1, 0);
+        if (iRet <= 0)
+        {
+            continue;
+        }
+        acSocketBuffer[iRet] = '\0';
+
+        RobotMessageArenaBegin();
+        ubtRet = RobotSensorDecode(acSocketBuffer, g_uiSensorSubMask, &stSample);
+        RobotMessageArenaEnd();
+        /* Late configuration answers and the like */
+        if (UBTEDU_RC_SUCCESS != ubtRet)
+        {
+            continue;
+        }
+        stSample.ullTimeUs = _ubtNowUs();
+        uiPending &= ~(1u << stSample.eType);
+
+        RobotSensorRingPush(&g_stSensorRing, &stSample);
+        RobotSensorHistoryPush(&g_astSensorHistory[stSample.eType], &stSample);
+        __atomic_add_fetch(&g_uiSensorSubReceived, 1, __ATOMIC_RELAXED);
+        if (NULL != g_pfnSensorSample)
+        {
+            g_pfnSensorSample(&stSample, g_pSensorSampleArg);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief:      ubtSubscribeSensors
+ * @details:    Receive the samples of several sensors at a fixed rate in
+ *              the background. The robot is asked to push them, sensors it
+ *              does not push are polled at the same rate instead. The
+ *              samples go to a ring read by ubtReadSensorSamples(), and to
+ *              the callback, on the subscription's thread. Samples of an
+ *              earlier subscription are dropped, a reader taking them
+ *              meanwhile gets them or none.
+ * @param[in]   char *apcType[]   Sensor types, like ubtReadSensorValue()
+ *                                gyro
+ *                                environment
+ *                                board
+ *                                ultrasonic
+ *                                infrared
+ *                                touch
+ *                                color
+ *                                pressure
+ * @param[in]   int iNum
+ * @param[in]   int iRateHz       Samples per second of each sensor, 1 ~ 100
+ * @param[in]   UBTEDU_SENSOR_CB pfnSample   May be NULL
+ * @param[in]   void *pArg        Given back to pfnSample
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSubscribeSensors(char *apcType[], int iNum, int iRateHz, UBTEDU_SENSOR_CB pfnSample, void *pArg)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    UBTEDU_SENSOR_TYPE_e eType;
+    ROBOT_SENSOR_RING_T stRing, stOldRing;
+    unsigned int uiMask = 0;
+    int i, iPort, iSocketFd, iPushed = 1;
+
+    if ((NULL == apcType) || (iNum < 1) || (iNum > UBTEDU_SENSOR_INVALID)
+        || (iRateHz < 1) || (iRateHz > SENSOR_SUB_MAX_HZ))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    for (i = 0; i < iNum; i++)
+    {
+        eType = RobotSensorGetType(apcType[i]);
+        if (UBTEDU_SENSOR_INVALID == eType)
+        {
+            return UBTEDU_RC_WRONG_PARAM;
+        }
+        uiMask |= 1u << eType;
+    }
+    if (g_iSensorSubRunning)
+    {
+        return UBTEDU_RC_FAILED;
+    }
+
+    ubtRet = RobotSensorRingCreate(&stRing, iRateHz * iNum * SENSOR_SUB_RING_SECONDS);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    pthread_mutex_lock(&g_stSensorRingMutex);
+    stOldRing = g_stSensorRing;
+    g_stSensorRing = stRing;
+    pthread_mutex_unlock(&g_stSensorRingMutex);
+    RobotSensorRingDestroy(&stOldRing);
+    iSocketFd = _udpServerInit(&iPort, 0);
+    if (iSocketFd < 0)
+    {
+        printf("Create robot to SDK socket failed!\r\n");
+        return UBTEDU_RC_SOCKET_FAILED;
+    }
+    g_iSensorSubFd = iSocketFd;
+    g_iSensorSubPort = iPort;
+    g_uiSensorSubMask = uiMask;
+    g_uiSensorPollMask = 0;
+    g_uiSensorSubReceived = 0;
+    g_uiSensorSubFailed = 0;
+    g_iSensorSubPeriodUs = 1000000 / iRateHz;
+    g_pfnSensorSample = pfnSample;
+    g_pSensorSampleArg = pArg;
+
+    /* A firmware without pushed sampling does not answer, it is only
+       waited for once */
+    for (i = 0; i < UBTEDU_SENSOR_INVALID; i++)
+    {
+        if (!(uiMask & (1u << i)))
+        {
+            continue;
+        }
+        ubtRet = iPushed ? _ubtSensorSubStart(i, iRateHz) : UBTEDU_RC_FAILED;
+        if (UBTEDU_RC_SOCKET_TIMEOUT == ubtRet)
+        {
+            iPushed = 0;
+        }
+        if (UBTEDU_RC_SUCCESS != ubtRet)
+        {
+            DebugTrace("Sensor %s is not pushed, it is polled\r\n", RobotSensorGetName(i));
+            g_uiSensorPollMask |= 1u << i;
+        }
+    }
+
+    g_iSensorSubRunning = 1;
+    if (0 != pthread_create(&g_stSensorSubThread, NULL, _ubtSensorSubThread, NULL))
+    {
+        printf("pthread_create failed \n");
+        g_iSensorSubRunning = 0;
+        _ubtSensorSubClose();
+        return UBTEDU_RC_FAILED;
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtUnsubscribeSensors
+ * @details:    Stop receiving the sensor samples. The samples are kept in
+ *              the ring. The sample callback may not call it, the
+ *              subscription's thread would wait for itself.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtUnsubscribeSensors(void)
+{
+    if (!g_iSensorSubRunning)
+    {
+        return UBTEDU_RC_SUCCESS;
+    }
+    if (pthread_equal(pthread_self(), g_stSensorSubThread))
+    {
+        return UBTEDU_RC_FAILED;
+    }
+
+    g_iSensorSubRunning = 0;
+    pthread_join(g_stSensorSubThread, NULL);
+    _ubtSensorSubClose();
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtReadSensorSamples
+ * @details:    Take the oldest samples of the subscribed sensors. Only one
+ *              thread may read them.
+ * @param[in]   int iMax
+ * @param[out]  UBTEDU_SENSOR_SAMPLE_T *pstSample   iMax samples
+ * @param[out]  int *piNum    Samples taken
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtReadSensorSamples(UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax, int *piNum)
+{
+    if ((NULL == pstSample) || (iMax < 1) || (NULL == piNum))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    pthread_mutex_lock(&g_stSensorRingMutex);
+    if (NULL == g_stSensorRing.pstSample)
+    {
+        pthread_mutex_unlock(&g_stSensorRingMutex);
+        return UBTEDU_RC_NOT_FOUND;
+    }
+    *piNum = RobotSensorRingRead(&g_stSensorRing, pstSample, iMax);
+    pthread_mutex_unlock(&g_stSensorRingMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtGetSensorSubStats
+ * @details:    Get the sensor subscription statistics
+ * @param[in]   None
+ * @param[out]  UBTEDU_SENSOR_SUB_STATS_T *pstStats
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGetSensorSubStats(UBTEDU_SENSOR_SUB_STATS_T *pstStats)
+{
+    if (NULL == pstStats)
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pstStats->uiReceived = __atomic_load_n(&g_uiSensorSubReceived, __ATOMIC_RELAXED);
+    pthread_mutex_lock(&g_stSensorRingMutex);
+    pstStats->uiDropped = __atomic_load_n(&g_stSensorRing.uiDropped, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&g_stSensorRingMutex);
+    pstStats->uiFailed = __atomic_load_n(&g_uiSensorSubFailed, __ATOMIC_RELAXED);
+    pstStats->uiPolledMask = g_uiSensorPollMask;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtGetSensorLatest
+ * @details:    Get the newest sample of a sensor, from the subscription or
+ *              the last read, without asking the robot. Any thread may call
+ *              it.
+ * @param[in]   char *pcSensorType   Sensor type, like ubtReadSensorValue()
+ * @param[out]  UBTEDU_SENSOR_SAMPLE_T *pstSample
+ * @retval: UBTEDU_RC_T  UBTEDU_RC_NOT_FOUND when the sensor has no sample yet
+ */
+UBTEDU_RC_T ubtGetSensorLatest(char *pcSensorType, UBTEDU_SENSOR_SAMPLE_T *pstSample)
+{
+    UBTEDU_SENSOR_TYPE_e eType = RobotSensorGetType(pcSensorType);
+
+    if ((UBTEDU_SENSOR_INVALID == eType) || (NULL == pstSample))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    return RobotSensorHistoryLatest(&g_astSensorHistory[eType], pstSample) ? UBTEDU_RC_SUCCESS : UBTEDU_RC_NOT_FOUND;
+}
+
+/**
+ * @brief:      ubtGetSensorHistory
+ * @details:    Get the samples of a sensor received in a time window,
+ *              without asking the robot. The last 256 samples of each
+ *              sensor are kept. Any thread may call it.
+ * @param[in]   char *pcSensorType   Sensor type, like ubtReadSensorValue()
+ * @param[in]   unsigned long long ullFromUs   CLOCK_MONOTONIC time, like ullTimeUs
+ * @param[in]   unsigned long long ullToUs
+ * @param[in]   int iMax
+ * @param[out]  UBTEDU_SENSOR_SAMPLE_T *pstSample   The newest iMax samples
+ *                                                  of the window, oldest first
+ * @param[out]  int *piNum
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGetSensorHistory(char *pcSensorType, unsigned long long ullFromUs, unsigned long long ullToUs,
+        UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax, int *piNum)
+{
+    UBTEDU_SENSOR_TYPE_e eType = RobotSensorGetType(pcSensorType);
+
+    if ((UBTEDU_SENSOR_INVALID == eType) || (ullFromUs > ullToUs) || (NULL == pstSample)
+        || (iMax < 1) || (NULL == piNum))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    *piNum = RobotSensorHistoryWindow(&g_astSensorHistory[eType], ullFromUs, ullToUs, pstSample, iMax);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtSetRobotLED
+ * @details:    Set the LED mode
+ * @param[in]   char *pcType
+ *                              botton
+ *                              camera
+ *                              mic
+ * @param[in]   char *pcColor
+ *                                  When pcType == "botton"
+ *                                  pcColor can be set as
+ *                                  white
+ *                                  red
+ *                                  green
+ *                                  blue
+ *                                  yellow
+ *                                  purple
+ *                                  cyan
+ *                                  When pcType == "camera"
+ *                                  pcColor can be set as
+ *                                  red
+ *                                  green
+ *                                  blue
+ *                                  When pcType == "mic"
+ *                                  pcColor can be set as
+ *                                  green
+ * @param[in]   char *pcMode
+ *                                  When pcType == "button"
+ *                                  pcMOde can be set as
+ *                                  off
+ *                                  on
+ *                                  blink
+ *                                  breath
+ *                                  colorful
+ *                                  When pcType == "camera"
+ *                                  pcMOde can be set as
+ *                                  on
+ *                                  off
+ *                                  When pcType == "mic"
+ *                                  pcMOde can be set as
+ *                                  on
+ *                                  off
+ *
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetRobotLED(char *pcType, char *pcColor, char *pcMode)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+
+    if ((NULL == pcColor) || (NULL == pcMode))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    if ((0 != strcmp(pcStr_Msg_Type_Recognition_Button, pcType)) &&
+        (0 != strcmp(pcStr_Msg_Param_Led_Type_Camera, pcType) ) &&
+        (0 != strcmp(pcStr_Msg_Param_Led_Type_Mic, pcType) ))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_SetRobotLED(g_iRobot2SDKPort, pcType, pcColor, pcMode,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_SetRobotLED(acSocketBuffer);
+    }
+    RobotMessageArenaEnd();
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtActionOnce
+ * @details:    Create the action condition on the monotonic clock
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtActionOnce(void)
+{
+    pthread_condattr_t stAttr;
+
+    pthread_condattr_init(&stAttr);
+    pthread_condattr_setclock(&stAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&g_stActionCond, &stAttr);
+    pthread_condattr_destroy(&stAttr);
+}
+
+/**
+ * @brief:      _ubtTimespecAddMs
+ * @details:    Move a monotonic time by lMs, which may be negative
+ * @param[in]   long lMs
+ * @param[out]  struct timespec *pstTime
+ * @retval:     void
+ */
+static void _ubtTimespecAddMs(struct timespec *pstTime, long lMs)
+{
+    pstTime->tv_sec += lMs / 1000;
+    pstTime->tv_nsec += (lMs % 1000) * 1000000L;
+    if (pstTime->tv_nsec >= 1000000000L)
+    {
+        pstTime->tv_nsec -= 1000000000L;
+        pstTime->tv_sec++;
+    }
+    else if (pstTime->tv_nsec < 0)
+    {
+        pstTime->tv_nsec += 1000000000L;
+        pstTime->tv_sec--;
+    }
+}
+
+/**
+ * @brief:      _ubtTimespecDiffMs
+ * @details:    Get pstTo - pstFrom in ms
+ * @param[in]   struct timespec *pstFrom
+ * @param[in]   struct timespec *pstTo
+ * @param[out]  None
+ * @retval:     long
+ */
+static long _ubtTimespecDiffMs(struct timespec *pstFrom, struct timespec *pstTo)
+{
+    return (pstTo->tv_sec - pstFrom->tv_sec) * 1000L + (pstTo->tv_nsec - pstFrom->tv_nsec) / 1000000L;
+}
+
+/**
+ * @brief:      _ubtActionSetDeadline
+ * @details:    Set the next completion check lMs from now
+ * @param[in]   long lMs
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtActionSetDeadline(long lMs)
+{
+    clock_gettime(CLOCK_MONOTONIC, &g_stActionDeadline);
+    _ubtTimespecAddMs(&g_stActionDeadline, lMs);
+}
+
+/**
+ * @brief:      _ubtActionReport
+ * @details:    Report a completed action to the callback and the eventfd.
+ *              Called with g_stActionMutex held, the callback runs without it.
+ * @param[in]   char *pcName
+ * @param[in]   UBTEDU_RC_T eResult
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtActionReport(const char *pcName, UBTEDU_RC_T eResult)
+{
+    char acName[ACTION_NAME_MAX_LEN];
+    UBTEDU_ACTION_DONE_CB pfnDone;
+    void *pArg;
+    uint64_t ullOne = 1;
+
+    strncpy(acName, pcName, sizeof(acName));
+    acName[sizeof(acName) - 1] = '\0';
+    pfnDone = g_pfnActionDone;
+    pArg = g_pActionDoneArg;
+
+    if (NULL != pfnDone)
+    {
+        pthread_mutex_unlock(&g_stActionMutex);
+        pfnDone(acName, eResult, pArg);
+        pthread_mutex_lock(&g_stActionMutex);
+    }
+    /* After the callback, so a poller sees what it did */
+    if (g_iActionEventFd >= 0)
+    {
+        if (write(g_iActionEventFd, &ullOne, sizeof(ullOne)) < 0)
+        {
+            printf("Action event write failed!\r\n");
+        }
+    }
+}
+
+/**
+ * @brief:      _ubtActionComplete
+ * @details:    Report the pending action as completed. Called with
+ *              g_stActionMutex held.
+ * @param[in]   UBTEDU_RC_T eResult
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtActionComplete(UBTEDU_RC_T eResult)
+{
+    char acName[ACTION_NAME_MAX_LEN];
+
+    if (!g_iActionPending)
+    {
+        return;
+    }
+    g_iActionPending = 0;
+    g_uiActionSeq++;
+    memcpy(acName, g_acActionName, sizeof(acName));
+    _ubtActionReport(acName, eResult);
+}
+
+/**
+ * @brief:      _ubtActionCancel
+ * @details:    Report the pending action as not played to the end, when
+ *              another action replaces it or it is stopped. A queued action
+ *              being started is reported the same way.
+ * @param[in]   int iClearQueue   1 to drop the queued actions too
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtActionCancel(int iClearQueue)
+{
+    pthread_mutex_lock(&g_stActionMutex);
+    g_uiActionSeq++;
+    if (iClearQueue)
+    {
+        g_iActionQueueLen = 0;
+        g_iActionPaused = 0;
+    }
+    _ubtActionComplete(UBTEDU_RC_FAILED);
+    pthread_cond_signal(&g_stActionCond);
+    pthread_mutex_unlock(&g_stActionMutex);
+}
+
+/**
+ * @brief:      _ubtActionHold
+ * @details:    Report the pending action as not played to the end and keep
+ *              the queue from starting its next action, until
+ *              _ubtActionUnhold(). Both are done under one lock, so the
+ *              completion thread cannot start a queued action over an
+ *              action being started outside the queue.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtActionHold(void)
+{
+    pthread_mutex_lock(&g_stActionMutex);
+    g_uiActionSeq++;
+    /* Before the report, which drops the lock for the callback */
+    g_iActionHold++;
+    _ubtActionComplete(UBTEDU_RC_FAILED);
+    pthread_cond_signal(&g_stActionCond);
+    pthread_mutex_unlock(&g_stActionMutex);
+}
+
+/**
+ * @brief:      _ubtActionUnhold
+ * @details:    Let the queue go on after _ubtActionHold(). Called with
+ *              g_stActionMutex held.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtActionUnhold(void)
+{
+    g_iActionHold--;
+    pthread_cond_signal(&g_stActionCond);
+}
+
+/**
+ * @brief:      _ubtActionSend
+ * @details:    Send the start message of an action and get its duration
+ * @param[in]   char *pcName
+ * @param[in]   int iRepeat
+ * @param[out]  int *piTime   Time of one play in ms
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _ubtActionSend(char *pcName, int iRepeat, int *piTime)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+
+    acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_StartRobotAction(g_iRobot2SDKPort, pcName, iRepeat,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_StartRobotAction(acSocketBuffer, piTime);
+    }
+    RobotMessageArenaEnd();
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtActionDispatch
+ * @details:    Start the first queued action. Called with g_stActionMutex
+ *              held, which is released while the robot is asked.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtActionDispatch(void)
+{
+    ACTION_QUEUE_ITEM_T stItem;
+    struct timespec stSend, stAck;
+    unsigned int uiSeq;
+    int iTime = 0;
+    long lRttMs;
+    UBTEDU_RC_T ubtRet;
+
+    stItem = g_astActionQueue[0];
+    g_iActionQueueLen--;
+    memmove(&g_astActionQueue[0], &g_astActionQueue[1], g_iActionQueueLen * sizeof(ACTION_QUEUE_ITEM_T));
+    uiSeq = ++g_uiActionSeq;
+    pthread_mutex_unlock(&g_stActionMutex);
+
+    _ubtServoShadowReset();
+    clock_gettime(CLOCK_MONOTONIC, &stSend);
+    ubtRet = _ubtActionSend(stItem.acName, stItem.iRepeat, &iTime);
+    clock_gettime(CLOCK_MONOTONIC, &stAck);
+
+    pthread_mutex_lock(&g_stActionMutex);
+    if ((UBTEDU_RC_SUCCESS != ubtRet) || (uiSeq != g_uiActionSeq))
+    {
+        /* Failed, or stopped or replaced while it was being started */
+        _ubtActionReport(stItem.acName, (UBTEDU_RC_SUCCESS != ubtRet) ? ubtRet : UBTEDU_RC_FAILED);
+        return;
+    }
+
+    /* The robot started it about half a round trip before the ack came back */
+    lRttMs = _ubtTimespecDiffMs(&stSend, &stAck);
+    g_lActionLeadMs = lRttMs / 2;
+    memcpy(g_acActionName, stItem.acName, sizeof(g_acActionName));
+    g_iActionPending = 1;
+    g_iActionFinite = 1;
+    g_stActionDeadline = stAck;
+    _ubtTimespecAddMs(&g_stActionDeadline, (long)iTime * stItem.iRepeat - g_lActionLeadMs);
+}
+
+/**
+ * @brief:      _ubtActionThread
+ * @details:    Wait until the pending action should be over. When another
+ *              action is queued after an action of known length it is
+ *              started right then, half a round trip early, so the two play
+ *              back to back. Otherwise the robot is asked for its play
+ *              status until it is no longer playing. A robot which does not
+ *              answer the status query is trusted to be done once the
+ *              action's duration is over, an infinite action is then asked
+ *              about again.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void *
+ */
+static void *_ubtActionThread(void *arg)
+{
+    struct timespec stNow, stWake;
+    unsigned int uiSeq;
+    int iStatus;
+    UBTEDU_RC_T ubtRet;
+
+    pthread_mutex_lock(&g_stActionMutex);
+    while (g_iActionThreadRunning)
+    {
+        if (g_iActionPaused || (g_iActionHold > 0) || (!g_iActionPending && (0 == g_iActionQueueLen)))
+        {
+            pthread_cond_wait(&g_stActionCond, &g_stActionMutex);
+            continue;
+        }
+        if (!g_iActionPending)
+        {
+            _ubtActionDispatch();
+            continue;
+        }
+
+        stWake = g_stActionDeadline;
+        if (g_iActionFinite && (g_iActionQueueLen > 0))
+        {
+            _ubtTimespecAddMs(&stWake, -g_lActionLeadMs);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &stNow);
+        if (_ubtTimespecDiffMs(&stNow, &stWake) > 0)
+        {
+            pthread_cond_timedwait(&g_stActionCond, &g_stActionMutex, &stWake);
+            continue;
+        }
+        if (g_iActionFinite && (g_iActionQueueLen > 0))
+        {
+            /* Trust the duration, the next action must not wait for a poll */
+            _ubtActionComplete(UBTEDU_RC_SUCCESS);
+            continue;
+        }
+
+        uiSeq = g_uiActionSeq;
+        pthread_mutex_unlock(&g_stActionMutex);
+        iStatus = UBTEDU_ROBOT_PLAY_STATUS_INVALID;
+        ubtRet = ubtGetRobotStatus(UBTEDU_ROBOT_STATUS_TYPE_PLAYACTION, &iStatus);
+        pthread_mutex_lock(&g_stActionMutex);
+        if ((uiSeq != g_uiActionSeq) || g_iActionPaused || (g_iActionHold > 0))
+        {
+            /* Replaced, stopped or paused meanwhile */
+            continue;
+        }
+
+        if (((UBTEDU_RC_SUCCESS != ubtRet) && !g_iActionFinite)
+            || ((UBTEDU_RC_SUCCESS == ubtRet)
+                && ((UBTEDU_ROBOT_PLAY_STATUS_PLAYING == iStatus) || (UBTEDU_ROBOT_PLAY_STATUS_PAUSED == iStatus))))
+        {
+            _ubtActionSetDeadline(ACTION_POLL_PERIOD_MS);
+            continue;
+        }
+        _ubtActionComplete(UBTEDU_RC_SUCCESS);
+    }
+    pthread_mutex_unlock(&g_stActionMutex);
+
+    return NULL;
+}
+
+/**
+ * @brief:      _ubtActionThreadStart
+ * @details:    Create the action eventfd and completion thread once
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _ubtActionThreadStart(void)
+{
+    pthread_once(&g_stActionOnce, _ubtActionOnce);
+
+    pthread_mutex_lock(&g_stActionMutex);
+    if (g_iActionEventFd < 0)
+    {
+        g_iActionEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+    if (!g_iActionThreadRunning)
+    {
+        g_iActionThreadRunning = 1;
+        if (0 != pthread_create(&g_stActionThread, NULL, _ubtActionThread, NULL))
+        {
+            printf("pthread_create failed \n");
+            g_iActionThreadRunning = 0;
+            pthread_mutex_unlock(&g_stActionMutex);
+            return UBTEDU_RC_FAILED;
+        }
+    }
+    pthread_mutex_unlock(&g_stActionMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtStartRobotAction
+ * @details:    Let the robot play an action. The action queue waits
+ *              until it is over.
+ * @param[in]   char *pcName  The action file's name For
+ *                              example: push up, bow
+ * @param[in]   int iRepeat   Repeat times. 0 means infinite
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtStartRobotAction(char *pcName, int iRepeat)
+{
+    int iTime = 0;
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+
+    if (NULL == pcName)
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    pthread_once(&g_stActionOnce, _ubtActionOnce);
+    /* The queue waits until this action is over */
+    _ubtActionHold();
+    _ubtServoShadowReset();
+    acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_StartRobotAction(g_iRobot2SDKPort, pcName, iRepeat,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_StartRobotAction(acSocketBuffer, &iTime);
+    }
+    RobotMessageArenaEnd();
+
+    while(iRepeat--)
+    {
+        sleep(iTime/1000);
+    }
+    sleep(1);
+    pthread_mutex_lock(&g_stActionMutex);
+    _ubtActionUnhold();
+    pthread_mutex_unlock(&g_stActionMutex);
+    return ubtRet;
+}
+
+
+/**
+ * @brief:      ubtStartRobotActionAsync
+ * @details:    Let the robot play an action and return at once. The
+ *              completion is reported to the callback set by
+ *              ubtSetActionCallback() and on the fd of ubtGetActionEventFd().
+ *              The action queue waits until it is over.
+ * @param[in]   char *pcName  The action file's name For
+ *                              example: push up, bow
+ * @param[in]   int iRepeat   Repeat times. 0 means infinite
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtStartRobotActionAsync(char *pcName, int iRepeat)
+{
+    int iTime = 0;
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+
+    if ((NULL == pcName) || (iRepeat < 0))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    ubtRet = _ubtActionThreadStart();
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    /* The queue waits until this action is pending, then for its end */
+    _ubtActionHold();
+    _ubtServoShadowReset();
+
+    ubtRet = _ubtActionSend(pcName, iRepeat, &iTime);
+    pthread_mutex_lock(&g_stActionMutex);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        _ubtActionUnhold();
+        pthread_mutex_unlock(&g_stActionMutex);
+        return ubtRet;
+    }
+
+    /* Another start which got its ack first is replaced by this one */
+    _ubtActionComplete(UBTEDU_RC_FAILED);
+    strncpy(g_acActionName, pcName, sizeof(g_acActionName));
+    g_acActionName[sizeof(g_acActionName) - 1] = '\0';
+    g_uiActionSeq++;
+    g_iActionPending = 1;
+    g_iActionFinite = (iRepeat > 0);
+    g_iActionPaused = 0;
+    /* An infinite action is only over when the robot says so */
+    _ubtActionSetDeadline((iRepeat > 0) ? (long)iTime * iRepeat : ACTION_POLL_PERIOD_MS);
+    _ubtActionUnhold();
+    pthread_mutex_unlock(&g_stActionMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtSetActionCallback
+ * @details:    Set the callback of ubtStartRobotActionAsync(). It is called
+ *              from an SDK thread, eResult is UBTEDU_RC_FAILED when the
+ *              action was stopped or replaced before its end.
+ * @param[in]   UBTEDU_ACTION_DONE_CB pfnDone   NULL to remove it
+ * @param[in]   void *pArg      Passed to pfnDone
+ * @param[out]  None
+ * @retval: UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetActionCallback(UBTEDU_ACTION_DONE_CB pfnDone, void *pArg)
+{
+    pthread_mutex_lock(&g_stActionMutex);
+    g_pfnActionDone = pfnDone;
+    g_pActionDoneArg = pArg;
+    pthread_mutex_unlock(&g_stActionMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtGetActionEventFd
+ * @details:    Get an fd which is readable when an action of
+ *              ubtStartRobotActionAsync() is completed. Reading 8 bytes
+ *              from it gives the number of completed actions and clears it.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     The fd, -1 when it can not be created
+ */
+int ubtGetActionEventFd(void)
+{
+    int iFd;
+
+    pthread_mutex_lock(&g_stActionMutex);
+    if (g_iActionEventFd < 0)
+    {
+        g_iActionEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+    iFd = g_iActionEventFd;
+    pthread_mutex_unlock(&g_stActionMutex);
+
+    return iFd;
+}
+
+/**
+ * @brief:      _ubtActionStop
+ * @details:    Stop the action completion thread
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtActionStop(void)
+{
+    pthread_mutex_lock(&g_stActionMutex);
+    if (!g_iActionThreadRunning)
+    {
+        pthread_mutex_unlock(&g_stActionMutex);
+        return;
+    }
+    g_iActionThreadRunning = 0;
+    g_iActionPending = 0;
+    g_iActionPaused = 0;
+    g_iActionQueueLen = 0;
+    pthread_cond_signal(&g_stActionCond);
+    pthread_mutex_unlock(&g_stActionMutex);
+    pthread_join(g_stActionThread, NULL);
+}
+
+
+/**
+  * @brief:     ubtStopRobotAction
+  * @details    Stop to run the robot action file
+  *
+  * @return  UBTEDU_RC_T
+  */
+UBTEDU_RC_T ubtStopRobotAction(void)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char  acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+
+    acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_StopRobotAction(g_iRobot2SDKPort,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_StopRobotAction(acSocketBuffer);
+    }
+    RobotMessageArenaEnd();
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        pthread_once(&g_stActionOnce, _ubtActionOnce);
+        _ubtActionCancel(1);
+    }
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtControlRobotAction
+ * @details:    Send pause, continue or reset for the playing action
+ * @param[in]   char *pcType
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _ubtControlRobotAction(char *pcType)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char  acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+
+    acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
+    ubtRet = ubtRobot_Msg_Encode_ControlRobotAction(g_iRobot2SDKPort, pcType,
+             acSocketBuffer, sizeof(acSocketBuffer));
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = ubtRobot_Msg_Decode_ControlRobotAction(acSocketBuffer);
+    }
+    RobotMessageArenaEnd();
+    return ubtRet;
+}
+
+/**
+ * @brief:      ubtPauseRobotAction
+ * @details:    Pause the playing action. The action queue waits too.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtPauseRobotAction(void)
+{
+    struct timespec stNow;
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+
+    ubtRet = _ubtControlRobotAction(pcStr_Msg_Type_Action_Pause);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    pthread_mutex_lock(&g_stActionMutex);
+    if (!g_iActionPaused)
+    {
+        g_iActionPaused = 1;
+        clock_gettime(CLOCK_MONOTONIC, &stNow);
+        g_lActionRemainMs = _ubtTimespecDiffMs(&stNow, &g_stActionDeadline);
+        if (g_lActionRemainMs < 0)
+        {
+            g_lActionRemainMs = 0;
+        }
+    }
+    pthread_mutex_unlock(&g_stActionMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtContinueRobotAction
+ * @details:    Continue the paused action and the action queue
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtContinueRobotAction(void)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+
+    ubtRet = _ubtControlRobotAction(pcStr_Msg_Type_Action_Continue);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    pthread_mutex_lock(&g_stActionMutex);
+    if (g_iActionPaused)
+    {
+        g_iActionPaused = 0;
+        _ubtActionSetDeadline(g_lActionRemainMs);
+        if (g_iActionThreadRunning)
+        {
+            pthread_cond_signal(&g_stActionCond);
+        }
+    }
+    pthread_mutex_unlock(&g_stActionMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtResetRobotAction
+ * @details:    Reset the robot's action player. The playing action is
+ *              reported as not completed and the action queue is emptied.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtResetRobotAction(void)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+
+    ubtRet = _ubtControlRobotAction(pcStr_Msg_Type_Action_Reset);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    pthread_once(&g_stActionOnce, _ubtActionOnce);
+    _ubtActionCancel(1);
+    _ubtServoShadowReset();
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      _ubtActionQueueFind
+ * @details:    Get the position of a queued action. Called with
+ *              g_stActionMutex held.
+ * @param[in]   int iId
+ * @param[out]  None
+ * @retval:     The position, -1 if it is not queued
+ */
+static int _ubtActionQueueFind(int iId)
+{
+    int i;
+
+    for (i = 0; i < g_iActionQueueLen; i++)
+    {
+        if (g_astActionQueue[i].iId == iId)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief:      ubtActionQueueAdd
+ * @details:    Queue an action. It starts right when the previous one
+ *              ends, or at once when nothing is playing. Completion is
+ *              reported like ubtStartRobotActionAsync.
+ * @param[in]   char *pcName  The action file's name
+ * @param[in]   int iRepeat   Repeat times, 1 ~ 65535
+ * @param[out]  int *piId     Id of the queued action, may be NULL
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtActionQueueAdd(char *pcName, int iRepeat, int *piId)
+{
+    ACTION_QUEUE_ITEM_T *pstItem;
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+
+    if ((NULL == pcName) || (strlen(pcName) >= ACTION_NAME_MAX_LEN) || (iRepeat < 1) || (iRepeat > 0xffff))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    ubtRet = _ubtActionThreadStart();
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    pthread_mutex_lock(&g_stActionMutex);
+    if (g_iActionQueueLen >= ACTION_QUEUE_MAX_LEN)
+    {
+        pthread_mutex_unlock(&g_stActionMutex);
+        return UBTEDU_RC_NORESOURCE;
+    }
+    pstItem = &g_astActionQueue[g_iActionQueueLen++];
+    pstItem->iId = g_iActionQueueNextId++;
+    pstItem->iRepeat = iRepeat;
+    strcpy(pstItem->acName, pcName);
+    if (g_iActionQueueNextId <= 0)
+    {
+        g_iActionQueueNextId = 1;
+    }
+    if (NULL != piId)
+    {
+        *piId = pstItem->iId;
+    }
+    pthread_cond_signal(&g_stActionCond);
+    pthread_mutex_unlock(&g_stActionMutex);
 
-    ubtRet = ubtRobot_Msg_Encode_ReadSensorValueByAddr(pcSensorType, iAddr, g_iRobot2SDKPort,
-             acSocketBuffer, sizeof(acSocketBuffer));
+    return UBTEDU_RC_SUCCESS;
+}
 
-    if (UBTEDU_RC_SUCCESS != ubtRet)
-    {
-        return ubtRet;
-    }
+/**
+ * @brief:      ubtActionQueueRemove
+ * @details:    Cancel a queued action which has not started yet
+ * @param[in]   int iId
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T   UBTEDU_RC_NOT_FOUND when it is not queued
+ */
+UBTEDU_RC_T ubtActionQueueRemove(int iId)
+{
+    int iPos;
 
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    pthread_mutex_lock(&g_stActionMutex);
+    iPos = _ubtActionQueueFind(iId);
+    if (iPos < 0)
     {
-        return ubtRet;
+        pthread_mutex_unlock(&g_stActionMutex);
+        return UBTEDU_RC_NOT_FOUND;
     }
+    g_iActionQueueLen--;
+    memmove(&g_astActionQueue[iPos], &g_astActionQueue[iPos + 1],
+            (g_iActionQueueLen - iPos) * sizeof(ACTION_QUEUE_ITEM_T));
+    pthread_mutex_unlock(&g_stActionMutex);
 
-    ubtRet = ubtRobot_Msg_Decode_ReadSensorValue(acSocketBuffer, pcSensorType, pValue, iValueLen);
-
-    return ubtRet;
+    return UBTEDU_RC_SUCCESS;
 }
 
 /**
- * @brief:      ubtSetRobotLED
- * @details:    Set the LED mode
- * @param[in]   char *pcType
- *                              botton
- *                              camera
- *                              mic
- * @param[in]   char *pcColor
- *                                  When pcType == "botton"
- *                                  pcColor can be set as
- *                                  white
- *                                  red
- *                                  green
- *                                  blue
- *                                  yellow
- *                                  purple
- *                                  cyan
- *                                  When pcType == "camera"
- *                                  pcColor can be set as
- *                                  red
- *                                  green
- *                                  blue
- *                                  When pcType == "mic"
- *                                  pcColor can be set as
- *                                  green
- * @param[in]   char *pcMode
- *                                  When pcType == "button"
- *                                  pcMOde can be set as
- *                                  off
- *                                  on
- *                                  blink
- *                                  breath
- *                                  colorful
- *                                  When pcType == "camera"
- *                                  pcMOde can be set as
- *                                  on
- *                                  off
- *                                  When pcType == "mic"
- *                                  pcMOde can be set as
- *                                  on
- *                                  off
- *
+ * @brief:      ubtActionQueueMove
+ * @details:    Move a queued action to another position
+ * @param[in]   int iId
+ * @param[in]   int iIndex    New position, 0 is played next
  * @param[out]  None
- * @retval: UBTEDU_RC_T
+ * @retval:     UBTEDU_RC_T   UBTEDU_RC_NOT_FOUND when it is not queued
  */
-UBTEDU_RC_T ubtSetRobotLED(char *pcType, char *pcColor, char *pcMode)
+UBTEDU_RC_T ubtActionQueueMove(int iId, int iIndex)
 {
-    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
-    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    ACTION_QUEUE_ITEM_T stItem;
+    int iPos;
 
-    if ((NULL == pcColor) || (NULL == pcMode))
+    pthread_mutex_lock(&g_stActionMutex);
+    iPos = _ubtActionQueueFind(iId);
+    if (iPos < 0)
     {
-        return UBTEDU_RC_WRONG_PARAM;
+        pthread_mutex_unlock(&g_stActionMutex);
+        return UBTEDU_RC_NOT_FOUND;
     }
-    if ((0 != strcmp(pcStr_Msg_Type_Recognition_Button, pcType)) &&
-        (0 != strcmp(pcStr_Msg_Param_Led_Type_Camera, pcType) ) &&
-        (0 != strcmp(pcStr_Msg_Param_Led_Type_Mic, pcType) ))
+    if ((iIndex < 0) || (iIndex >= g_iActionQueueLen))
     {
+        pthread_mutex_unlock(&g_stActionMutex);
         return UBTEDU_RC_WRONG_PARAM;
     }
 
-    acSocketBuffer[0] = '\0';
-    ubtRet = ubtRobot_Msg_Encode_SetRobotLED(g_iRobot2SDKPort, pcType, pcColor, pcMode,
-             acSocketBuffer, sizeof(acSocketBuffer));
-
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    stItem = g_astActionQueue[iPos];
+    if (iIndex < iPos)
     {
-        return ubtRet;
+        memmove(&g_astActionQueue[iIndex + 1], &g_astActionQueue[iIndex],
+                (iPos - iIndex) * sizeof(ACTION_QUEUE_ITEM_T));
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    else
     {
-        return ubtRet;
+        memmove(&g_astActionQueue[iPos], &g_astActionQueue[iPos + 1],
+                (iIndex - iPos) * sizeof(ACTION_QUEUE_ITEM_T));
     }
+    g_astActionQueue[iIndex] = stItem;
+    pthread_mutex_unlock(&g_stActionMutex);
 
-    ubtRet = ubtRobot_Msg_Decode_SetRobotLED(acSocketBuffer);
-    return ubtRet;
+    return UBTEDU_RC_SUCCESS;
 }
 
 /**
- * @brief:      ubtStartRobotAction
- * @details:    Let the robot play an action
- * @param[in]   char *pcName  The action file's name For
- *                              example: push up, bow
- * @param[in]   int iRepeat   Repeat times. 0 means infinite
+ * @brief:      ubtActionQueueClear
+ * @details:    Cancel all queued actions. The playing one goes on.
+ * @param[in]   None
  * @param[out]  None
- * @retval: UBTEDU_RC_T
+ * @retval:     UBTEDU_RC_T
  */
-UBTEDU_RC_T ubtStartRobotAction(char *pcName, int iRepeat)
+UBTEDU_RC_T ubtActionQueueClear(void)
 {
-    int iTime = 0;
-    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
-    char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    pthread_mutex_lock(&g_stActionMutex);
+    g_iActionQueueLen = 0;
+    pthread_mutex_unlock(&g_stActionMutex);
 
-    if (NULL == pcName)
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtActionQueueGetStatus
+ * @details:    Get the status of the action queue
+ * @param[in]   None
+ * @param[out]  UBTEDU_ACTION_QUEUE_STATUS_T *pstStatus
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtActionQueueGetStatus(UBTEDU_ACTION_QUEUE_STATUS_T *pstStatus)
+{
+    if (NULL == pstStatus)
     {
         return UBTEDU_RC_WRONG_PARAM;
     }
-    acSocketBuffer[0] = '\0';
-    ubtRet = ubtRobot_Msg_Encode_StartRobotAction(g_iRobot2SDKPort, pcName, iRepeat,
-             acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+
+    pthread_mutex_lock(&g_stActionMutex);
+    pstStatus->iPlaying = g_iActionPending;
+    pstStatus->iPaused = g_iActionPaused;
+    pstStatus->iQueued = g_iActionQueueLen;
+    pstStatus->iNextId = (g_iActionQueueLen > 0) ? g_astActionQueue[0].iId : 0;
+    pthread_mutex_unlock(&g_stActionMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtGetActionInfo
+ * @details:    Validate an HTS action file and get its figures. The file is
+ *              read locally, no message is sent to the robot.
+ * @param[in]   char *pcPath  The action file's path
+ * @param[out]  UBTEDU_ACTION_INFO_T *pstInfo
+ * @retval:     UBTEDU_RC_T   UBTEDU_RC_FAILED when the file is not a valid HTS file
+ */
+UBTEDU_RC_T ubtGetActionInfo(char *pcPath, UBTEDU_ACTION_INFO_T *pstInfo)
+{
+    unsigned char aucMin[ROBOT_HTS_ANGLE_NUM];
+    unsigned char aucMax[ROBOT_HTS_ANGLE_NUM];
+    ROBOT_HTS_FILE_T stFile;
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    int i;
+
+    if ((NULL == pcPath) || (NULL == pstInfo))
     {
-        return ubtRet;
+        return UBTEDU_RC_WRONG_PARAM;
     }
+    memset(pstInfo, 0, sizeof(UBTEDU_ACTION_INFO_T));
 
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    ubtRet = RobotHtsOpen(&stFile, pcPath);
+    if (UBTEDU_RC_FAILED == ubtRet)
+    {
+        printf("Action file %s is invalid at frame %d!\r\n", pcPath, stFile.iBadFrame);
+    }
     if (UBTEDU_RC_SUCCESS != ubtRet)
     {
+        RobotHtsClose(&stFile);
         return ubtRet;
     }
 
-    ubtRet = ubtRobot_Msg_Decode_StartRobotAction(acSocketBuffer, &iTime);
-
-    while(iRepeat--)
+    for (i = 0; i < ROBOT_HTS_ANGLE_NUM; i++)
     {
-        sleep(iTime/1000);
+        aucMin[i] = (stFile.uiServoMask & (1u << i)) ? stFile.aucMin[i] : 0;
+        aucMax[i] = (stFile.uiServoMask & (1u << i)) ? stFile.aucMax[i] : 0;
     }
-    sleep(1);
-    return ubtRet;
-}
+    pstInfo->iFrameNum = stFile.iFrameNum;
+    pstInfo->iTotalTime = stFile.iTotalTime;
+    _ubtSetServoStruct(aucMin, &pstInfo->stMinAngle);
+    _ubtSetServoStruct(aucMax, &pstInfo->stMaxAngle);
+    RobotHtsClose(&stFile);
 
+    return UBTEDU_RC_SUCCESS;
+}
 
 /**
-  * @brief:     ubtStopRobotAction
-  * @details    Stop to run the robot action file
-  *
-  * @return  UBTEDU_RC_T
-  */
-UBTEDU_RC_T ubtStopRobotAction(void)
+ * @brief:      ubtCompressAction
+ * @details:    Drop the frames of an action file which the servos pass
+ *              within iMaxError anyway, gliding between the frames kept.
+ *              The kept frames last until the next one, so the play time
+ *              does not change. pcIn and pcOut may be the same file.
+ * @param[in]   char *pcIn        The action file's path
+ * @param[in]   char *pcOut       The compressed file's path
+ * @param[in]   int iMaxError     Degrees a dropped frame may be off, 0 only
+ *                                drops frames right on the servos' way
+ * @param[out]  UBTEDU_COMPRESS_STATS_T *pstStats   May be NULL
+ * @retval:     UBTEDU_RC_T   UBTEDU_RC_FAILED when pcIn is not a valid HTS file
+ */
+UBTEDU_RC_T ubtCompressAction(char *pcIn, char *pcOut, int iMaxError, UBTEDU_COMPRESS_STATS_T *pstStats)
 {
+    ROBOT_SIMPLIFY_FRAME_T *pstFrame;
+    ROBOT_SIMPLIFY_STATS_T stSimplify;
+    ROBOT_HTS_FILE_T stFile;
+    ROBOT_HTS_T stHts;
     UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
-    char  acSocketBuffer[SDK_MESSAGE_MAX_LEN];
+    int iNum;
 
-    acSocketBuffer[0] = '\0';
-    ubtRet = ubtRobot_Msg_Encode_StopRobotAction(g_iRobot2SDKPort,
-             acSocketBuffer, sizeof(acSocketBuffer));
+    if ((NULL == pcIn) || (NULL == pcOut) || (iMaxError < 0) || (iMaxError > 180))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    ubtRet = RobotHtsOpen(&stFile, pcIn);
+    if (UBTEDU_RC_FAILED == ubtRet)
+    {
+        printf("Action file %s is invalid at frame %d!\r\n", pcIn, stFile.iBadFrame);
+    }
     if (UBTEDU_RC_SUCCESS != ubtRet)
     {
+        RobotHtsClose(&stFile);
         return ubtRet;
     }
+    iNum = stFile.iFrameNum;
+    pstFrame = malloc(iNum * sizeof(ROBOT_SIMPLIFY_FRAME_T));
+    if (NULL == pstFrame)
+    {
+        RobotHtsClose(&stFile);
+        return UBTEDU_RC_NORESOURCE;
+    }
+    ubtRet = RobotSimplifyFromHts(&stFile, pstFrame);
+    RobotHtsClose(&stFile);
 
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = RobotSimplifyBuildHts(pstFrame, iNum, (float)iMaxError, &stHts, &stSimplify);
+    }
+    free(pstFrame);
     if (UBTEDU_RC_SUCCESS != ubtRet)
     {
         return ubtRet;
     }
+    ubtRet = RobotHtsWrite(&stHts, pcOut);
+    RobotHtsDestroy(&stHts);
+    if ((UBTEDU_RC_SUCCESS == ubtRet) && (NULL != pstStats))
+    {
+        _ubtSetCompressStats(&stSimplify, pstStats);
+    }
 
-    ubtRet = ubtRobot_Msg_Decode_StopRobotAction(acSocketBuffer);
     return ubtRet;
 }
 
@@ -1926,20 +5100,18 @@ UBTEDU_RC_T ubtVoiceStart()
     char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
 
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_VoiceStart(g_iRobot2SDKPort,
                                             acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_VoiceStart(acSocketBuffer);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_VoiceStart(acSocketBuffer);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -1956,20 +5128,18 @@ UBTEDU_RC_T ubtVoiceStop()
     char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
 
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_VoiceStop(g_iRobot2SDKPort,
                                            acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_VoiceStop(acSocketBuffer);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_VoiceStop(acSocketBuffer);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -1995,20 +5165,18 @@ UBTEDU_RC_T ubtVoiceTTS(int isInterrputed, char *pcTTS)
         return UBTEDU_RC_WRONG_PARAM;
     }
 
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_VoiceTTS(g_iRobot2SDKPort, isInterrputed, pcTTS,
                                           acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_VoiceTTS(acSocketBuffer);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_VoiceTTS(acSocketBuffer);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -2032,20 +5200,18 @@ UBTEDU_RC_T ubtPlayMusic(char * pcPlayMusicType, char *pcName)
     {
         return UBTEDU_RC_WRONG_PARAM;
     }
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_PlayMusic(pcPlayMusicType, g_iRobot2SDKPort, pcName,
                                            acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_PlayMusic(acSocketBuffer);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_PlayMusic(acSocketBuffer);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -2070,21 +5236,19 @@ UBTEDU_RC_T ubtGetMusicList(char *pacMusicName[], int iEachMusicNameLen,
     {
         return UBTEDU_RC_WRONG_PARAM;
     }
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_GetMusic(g_iRobot2SDKPort, *piIndex,
                                           acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_GetMusic(acSocketBuffer, pacMusicName, iEachMusicNameLen,
+                                              iMusicNameNum, piIndex);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_GetMusic(acSocketBuffer, pacMusicName, iEachMusicNameLen,
-                                          iMusicNameNum, piIndex);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -2118,20 +5282,18 @@ UBTEDU_RC_T ubtEventDetect(char *pcEventType, char *pcValue, int iTimeout)
 
     acSocketBuffer[0] = '\0';
 
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_EventDetect(pcEventType, g_iRobot2SDKPort,
              acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_EventDetect(acSocketBuffer,  pcValue);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_EventDetect(acSocketBuffer,  pcValue);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -2163,20 +5325,18 @@ UBTEDU_RC_T ubtVisionDetect(char *pcVisionType, char *pcValue, int iTimeout)
     }
 
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_VisionDetect(pcVisionType, g_iRobot2SDKPort,
              acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), tsock.tv_sec);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_VisionDetect(acSocketBuffer,  pcValue);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_VisionDetect(acSocketBuffer,  pcValue);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -2195,20 +5355,18 @@ UBTEDU_RC_T ubtTakeAPhoto(char *pacPhotoName, int iPhotoNameLen)
     char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
 
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_TakePhotos(pacPhotoName, g_iRobot2SDKPort,
                                             acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_TakePhotos(acSocketBuffer,  iPhotoNameLen);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_TakePhotos(acSocketBuffer,  iPhotoNameLen);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -2231,20 +5389,18 @@ UBTEDU_RC_T ubtTransmitCMD(char *pcRemoteCmd, char *pcRemoteCmdRetData, int iRem
     {
         return UBTEDU_RC_WRONG_PARAM;
     }
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_TransmitCMD(g_iRobot2SDKPort, pcRemoteCmd,
              acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_TransmitCMD(acSocketBuffer, pcRemoteCmdRetData, iRemoteCmdRetDataLen);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_TransmitCMD(acSocketBuffer, pcRemoteCmdRetData, iRemoteCmdRetDataLen);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -2278,22 +5434,25 @@ UBTEDU_RC_T ubtReportStatusToApp(char* pcName, char *pcString)
         pStr = pcName;
     }
 
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_ReportStatusToApp(pStr, pcString,
              acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        pthread_mutex_lock(&stMutex);
+        iRet = _ubtMsgSend2Robot(g_iSDK2Robot, g_stConnectedRobotInfo.acIPAddr,
+                                 g_iRobot2SDKPort, acSocketBuffer, strlen(acSocketBuffer));
+        pthread_mutex_unlock(&stMutex);
+        if (iRet != strlen(acSocketBuffer))
+        {
+            ubtRet = UBTEDU_RC_SOCKET_SENDERROR;
+        }
     }
-    pthread_mutex_lock(&stMutex);
-    iRet = _ubtMsgSend2Robot(g_iSDK2Robot, g_stConnectedRobotInfo.acIPAddr,
-                             g_iRobot2SDKPort, acSocketBuffer, strlen(acSocketBuffer));
-    pthread_mutex_unlock(&stMutex);
-    if (iRet != strlen(acSocketBuffer))
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return UBTEDU_RC_SOCKET_SENDERROR;
+        ubtRet = ubtRobot_Msg_Decode_ReportStatusToApp(acSocketBuffer);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_ReportStatusToApp(acSocketBuffer);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -2331,8 +5490,10 @@ UBTEDU_RC_T ubtRobotDiscovery(char *pcAccount, int iMaxTimes, UBTEDU_ROBOTINFO_T
     }
 
 
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_RobotDiscovery(pcAccount, g_iRobot2SDKPort, pstRobotInfo->acName,
              acSocketBuffer, sizeof(acSocketBuffer));
+    RobotMessageArenaEnd();
     if (UBTEDU_RC_SUCCESS != ubtRet)
     {
         return ubtRet;
@@ -2423,18 +5584,21 @@ UBTEDU_RC_T ubtRobotConnect(char *pcAccount, char *pcVersion, char *pcIPAddr)
         return UBTEDU_RC_WRONG_PARAM;
     }
 
+    acRobotName[0] = '\0';
     if(!strcmp(pcIPAddr,SDK_LOCAL_IP))
     {
         ubtRet = UBTEDU_RC_SUCCESS;
         strncpy(g_stConnectedRobotInfo.acIPAddr, pcIPAddr, sizeof(g_stConnectedRobotInfo.acIPAddr));
         strncpy(g_stConnectedRobotInfo.acName, acRobotName, sizeof(g_stConnectedRobotInfo.acName));
+        _ubtServoOffsetFetch();
         return ubtRet;
     }
 
-    acRobotName[0] = '\0';
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_ConnectRobot(pcAccount, g_iRobot2SDKPort,
              acSocketBuffer, sizeof(acSocketBuffer));
+    RobotMessageArenaEnd();
 
     if (UBTEDU_RC_SUCCESS != ubtRet)
     {
@@ -2471,10 +5635,12 @@ UBTEDU_RC_T ubtRobotConnect(char *pcAccount, char *pcVersion, char *pcIPAddr)
     if (UBTEDU_RC_SUCCESS == ubtRet)
     {
         g_iConnectingStatus = 1;
+        _ubtServoShadowReset();
         pthread_mutex_lock(&stMutex);
         strncpy(g_stConnectedRobotInfo.acIPAddr, pcIPAddr, sizeof(g_stConnectedRobotInfo.acIPAddr));
         strncpy(g_stConnectedRobotInfo.acName, acRobotName, sizeof(g_stConnectedRobotInfo.acName));
         pthread_mutex_unlock(&stMutex);
+        _ubtServoOffsetFetch();
         pthread_attr_init(&attr);
         pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
         iRet = pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
@@ -2522,12 +5688,15 @@ UBTEDU_RC_T ubtRobotDisconnect(char *pcAccount, char *pcVersion, char *pcIPAddr)
         ubtRet = UBTEDU_RC_SUCCESS;
         g_stConnectedRobotInfo.acIPAddr[0] = '\0';
         g_stConnectedRobotInfo.acName[0] = '\0';
+        _ubtServoOffsetReset();
         return ubtRet;
     }
 
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_DisconnectRobot(pcAccount, g_iRobot2SDKPort,
              acSocketBuffer, sizeof(acSocketBuffer));
+    RobotMessageArenaEnd();
 
     if (UBTEDU_RC_SUCCESS != ubtRet)
     {
@@ -2555,6 +5724,8 @@ UBTEDU_RC_T ubtRobotDisconnect(char *pcAccount, char *pcVersion, char *pcIPAddr)
 
     if (UBTEDU_RC_SUCCESS == ubtRet)
     {
+        _ubtServoShadowReset();
+        _ubtServoOffsetReset();
         g_iConnectingStatus = 0;
         /* Stop the heart beat timer */
         g_stConnectedRobotInfo.acIPAddr[0] = '\0';
@@ -2925,19 +6096,17 @@ UBTEDU_RC_T ubtSearchExtendSensor(void)
     char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
 
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_SearchSensor(g_iRobot2SDKPort, acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 5);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 5);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_SearchSensor(acSocketBuffer);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_SearchSensor(acSocketBuffer);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -2955,19 +6124,17 @@ UBTEDU_RC_T ubtModifyExtendSensorID(char *pcType,int iCurrID,int iDstID)
     char acSocketBuffer[SDK_MESSAGE_MAX_LEN];
 
     acSocketBuffer[0] = '\0';
+    RobotMessageArenaBegin();
     ubtRet = ubtRobot_Msg_Encode_ModifySensorID(g_iRobot2SDKPort,pcType,iCurrID,iDstID,acSocketBuffer, sizeof(acSocketBuffer));
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
     }
-
-    ubtRet = _ubtCommWithRobot(g_stConnectedRobotInfo.acIPAddr, acSocketBuffer, sizeof(acSocketBuffer), 0);
-    if (UBTEDU_RC_SUCCESS != ubtRet)
+    if (UBTEDU_RC_SUCCESS == ubtRet)
     {
-        return ubtRet;
+        ubtRet = ubtRobot_Msg_Decode_ModifySensorID(acSocketBuffer);
     }
-
-    ubtRet = ubtRobot_Msg_Decode_ModifySensorID(acSocketBuffer);
+    RobotMessageArenaEnd();
     return ubtRet;
 }
 
@@ -3047,6 +6214,8 @@ UBTEDU_RC_T ubtRobotInitialize()
     pthread_mutex_unlock(&stMutex);
 
     memset(&g_stConnectedRobotInfo, 0, sizeof(g_stConnectedRobotInfo));
+    RobotProfileLimitInit(&g_stServoLimit);
+    RobotKinInit(&g_stKinematics);
 
     return ret;
 }
@@ -3060,6 +6229,26 @@ UBTEDU_RC_T ubtRobotInitialize()
  */
 void ubtRobotDeinitialize()
 {
+    ubtGaitStop();
+    ubtBalanceStop();
+    ubtServoStreamStop();
+    ubtServoShadowSetRefresh(0);
+    ubtCaptureStop();
+    pthread_mutex_lock(&g_stCaptureMutex);
+    RobotCaptureDestroy(&g_stCapture);
+    pthread_mutex_unlock(&g_stCaptureMutex);
+    ubtUnsubscribeSensors();
+    pthread_mutex_lock(&g_stSensorRingMutex);
+    RobotSensorRingDestroy(&g_stSensorRing);
+    pthread_mutex_unlock(&g_stSensorRingMutex);
+    _ubtActionStop();
+    pthread_mutex_lock(&g_stActionMutex);
+    if (g_iActionEventFd >= 0)
+    {
+        close(g_iActionEventFd);
+        g_iActionEventFd = -1;
+    }
+    pthread_mutex_unlock(&g_stActionMutex);
 
     if (-1 != g_iRobot2SDK)
     {
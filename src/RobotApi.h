@@ -17,6 +17,7 @@
 #ifndef _ROBOT_API_H_
 #define _ROBOT_API_H_
 
+#include <stdint.h>
 
 
 #define UBTEDU_SDK_SW_VER              "01" /**< SDK software version */
@@ -235,6 +236,58 @@ typedef struct _RobotPressureSensor
     int iValue;         /**<    The Pressure via Pressure sensor */
 } UBTEDU_ROBOTPRESSURE_SENSOR_T;
 
+/**
+ * @brief   Sensors which can be subscribed to
+*/
+typedef enum
+{
+    UBTEDU_SENSOR_GYRO = 0,         /**< UBTEDU_ROBOTGYRO_SENSOR_T */
+    UBTEDU_SENSOR_ENV,              /**< UBTEDU_ROBOTENV_SENSOR_T */
+    UBTEDU_SENSOR_BOARD,            /**< UBTEDU_ROBOTRASPBOARD_SENSOR_T */
+    UBTEDU_SENSOR_ULTRASONIC,       /**< UBTEDU_ROBOTULTRASONIC_SENSOR_T */
+    UBTEDU_SENSOR_INFRARED,         /**< UBTEDU_ROBOTINFRARED_SENSOR_T */
+    UBTEDU_SENSOR_TOUCH,            /**< UBTEDU_ROBOTTOUCH_SENSOR_T */
+    UBTEDU_SENSOR_COLOR,            /**< UBTEDU_ROBOTCOLOR_SENSOR_T */
+    UBTEDU_SENSOR_PRESSURE,         /**< UBTEDU_ROBOTPRESSURE_SENSOR_T */
+    UBTEDU_SENSOR_INVALID           /**< Invalid value */
+} UBTEDU_SENSOR_TYPE_e;
+
+/**
+ * @brief   One sample of a subscribed sensor
+*/
+typedef struct _SensorSample
+{
+    UBTEDU_SENSOR_TYPE_e eType;     /**< Which member of uValue is set */
+    unsigned long long ullTimeUs;   /**< Monotonic time the sample was received */
+    union
+    {
+        UBTEDU_ROBOTGYRO_SENSOR_T stGyro;
+        UBTEDU_ROBOTENV_SENSOR_T stEnv;
+        UBTEDU_ROBOTRASPBOARD_SENSOR_T stBoard;
+        UBTEDU_ROBOTULTRASONIC_SENSOR_T stUltrasonic;
+        UBTEDU_ROBOTINFRARED_SENSOR_T stInfrared;
+        UBTEDU_ROBOTTOUCH_SENSOR_T stTouch;
+        UBTEDU_ROBOTCOLOR_SENSOR_T stColor;
+        UBTEDU_ROBOTPRESSURE_SENSOR_T stPressure;
+    } uValue;
+} UBTEDU_SENSOR_SAMPLE_T;
+
+/**
+ * @brief   Called for each sample of the subscribed sensors
+*/
+typedef void (*UBTEDU_SENSOR_CB)(const UBTEDU_SENSOR_SAMPLE_T *pstSample, void *pArg);
+
+/**
+ * @brief   Sensor subscription statistics
+*/
+typedef struct _SensorSubStats
+{
+    unsigned int uiReceived;        /**< Samples received */
+    unsigned int uiDropped;         /**< Samples lost because nobody read them in time */
+    unsigned int uiFailed;          /**< Polls not answered before the next one */
+    unsigned int uiPolledMask;      /**< Sensors polled as the robot does not push them, bit per UBTEDU_SENSOR_TYPE_e */
+} UBTEDU_SENSOR_SUB_STATS_T;
+
 /**
  * @brief   Battery data
 */
@@ -253,6 +306,163 @@ typedef struct _RobotColorDetect
         int iValue;      /**<  value */ 
 } UBTEDU_COLOR_HSV_T;
 
+/**
+ * @brief   Interpolation between the keyframes of a servo stream
+*/
+typedef enum
+{
+    UBTEDU_SERVO_INTERP_LINEAR = 0,     /**< Straight line */
+    UBTEDU_SERVO_INTERP_CUBIC,          /**< Cubic spline through the keyframes */
+    UBTEDU_SERVO_INTERP_MINJERK,        /**< Minimum jerk, stops at each keyframe within the servo limits */
+    UBTEDU_SERVO_INTERP_TRAPEZOID,      /**< Trapezoidal speed, stops at each keyframe within the servo limits */
+    UBTEDU_SERVO_INTERP_INVALID         /**< Invalid value */
+} UBTEDU_SERVO_INTERP_e;
+
+/**
+ * @brief   Servo stream statistics
+*/
+typedef struct _ServoStreamStats
+{
+    unsigned int uiTicks;           /**< Control periods run */
+    unsigned int uiFramesSent;      /**< Servo messages sent */
+    unsigned int uiAcks;            /**< Servo acks received from the robot */
+    unsigned int uiMissed;          /**< Periods skipped because the thread woke up too late */
+    unsigned int uiJitterMaxUs;     /**< Max wake up delay in microseconds */
+    unsigned int uiJitterAvgUs;     /**< Mean wake up delay in microseconds */
+} UBTEDU_SERVO_STREAM_STATS_T;
+
+/**
+ * @brief   Cached servo read statistics
+*/
+typedef struct _ServoShadowStats
+{
+    unsigned int uiHits;            /**< Reads served from the local shadow */
+    unsigned int uiMisses;          /**< Reads which went to the robot */
+} UBTEDU_SERVO_SHADOW_STATS_T;
+
+/**
+ * @brief   Servo capture statistics
+*/
+typedef struct _CaptureStats
+{
+    unsigned int uiSamples;         /**< Samples waiting to be exported */
+    unsigned int uiDropped;         /**< Samples lost because the capture was full */
+    unsigned int uiFailed;          /**< Servo reads which failed */
+} UBTEDU_CAPTURE_STATS_T;
+
+/**
+ * @brief   Limbs of the robot
+*/
+typedef enum
+{
+    UBTEDU_ROBOT_LIMB_LEFT_ARM = 0,     /**< Left hand, servo 4 ~ 6 */
+    UBTEDU_ROBOT_LIMB_RIGHT_ARM,        /**< Right hand, servo 1 ~ 3 */
+    UBTEDU_ROBOT_LIMB_LEFT_LEG,         /**< Left foot, servo 12 ~ 16 */
+    UBTEDU_ROBOT_LIMB_RIGHT_LEG,        /**< Right foot, servo 7 ~ 11 */
+    UBTEDU_ROBOT_LIMB_HEAD,             /**< Head, servo 17 */
+    UBTEDU_ROBOT_LIMB_INVALID           /**< Invalid value */
+} UBTEDU_ROBOT_LIMB_e;
+
+/**
+ * @brief   Pose of a limb's end. The origin is between the hips, x is
+ *          forward, y is left and z is up.
+*/
+typedef struct _RobotLimbPose
+{
+    float fX;                       /**< Position, in mm */
+    float fY;
+    float fZ;
+    float fRoll;                    /**< Rotation around x, in degree */
+    float fPitch;                   /**< Rotation around y, in degree */
+    float fYaw;                     /**< Rotation around z, in degree */
+} UBTEDU_LIMB_POSE_T;
+
+/**
+ * @brief   Servo frame check statistics
+*/
+typedef struct _SafetyStats
+{
+    unsigned int uiChecked;         /**< Servo frames checked */
+    unsigned int uiClamped;         /**< Frames with an angle moved into its servo's range */
+    unsigned int uiRejected;        /**< Frames not sent because the robot would hit itself */
+} UBTEDU_SAFETY_STATS_T;
+
+/**
+ * @brief   Walking gait
+*/
+typedef struct _GaitParam
+{
+    int iStepLength;                /**< Stride of one step in mm, -60 ~ 60, negative walks back */
+    int iTurnRate;                  /**< Turn of one step in degree, -20 ~ 20, positive turns left */
+    int iCadence;                   /**< Steps per minute, 30 ~ 200 */
+} UBTEDU_GAIT_PARAM_T;
+
+/**
+ * @brief   Balance controller settings
+*/
+typedef struct _BalanceParam
+{
+    int iRateHz;                    /**< IMU reads per second, 10 ~ 100 */
+    float fKp;                      /**< Correction in degree per degree of tilt, about 1.5 */
+    float fKd;                      /**< Correction in degree per degree/s of tilt speed, about 0.2 */
+    float fHipRatio;                /**< Part of the correction made by the hips, 0 ~ 1, the rest by the ankles */
+    int iMaxCorrection;             /**< Max correction, in degree */
+} UBTEDU_BALANCE_PARAM_T;
+
+/**
+ * @brief   Balance controller statistics
+*/
+typedef struct _BalanceStats
+{
+    unsigned int uiLoops;           /**< IMU samples used */
+    unsigned int uiReadFailed;      /**< IMU reads not answered within the period */
+    unsigned int uiOverruns;        /**< Periods skipped because a loop took longer */
+    unsigned int uiLatencyAvgUs;    /**< From the IMU request to the corrections in place */
+    unsigned int uiLatencyMaxUs;
+    float fPitch;                   /**< Last tilt in degree, positive leans forward */
+    float fRoll;                    /**< Positive leans right */
+    float fPitchCorrection;         /**< Last leg corrections, in degree */
+    float fRollCorrection;
+} UBTEDU_BALANCE_STATS_T;
+
+/**
+ * @brief   Figures of an HTS action file
+*/
+typedef struct _ActionInfo
+{
+    int iFrameNum;                  /**< Motion frames */
+    int iTotalTime;                 /**< Play time in ms */
+    UBTEDU_ROBOTSERVO_T stMinAngle; /**< Min angle of each servo, 0 if the servo is not moved */
+    UBTEDU_ROBOTSERVO_T stMaxAngle; /**< Max angle of each servo, 0 if the servo is not moved */
+} UBTEDU_ACTION_INFO_T;
+
+/**
+ * @brief   Result of an action file compression
+*/
+typedef struct _CompressStats
+{
+    int iFramesIn;                  /**< Motion frames before */
+    int iFramesOut;                 /**< Motion frames kept */
+    float fRatio;                   /**< iFramesIn over iFramesOut */
+    float fMaxError;                /**< Largest angle error of a dropped frame, in degree */
+} UBTEDU_COMPRESS_STATS_T;
+
+/**
+ * @brief   Called when an action of ubtStartRobotActionAsync is completed
+*/
+typedef void (*UBTEDU_ACTION_DONE_CB)(char *pcName, UBTEDU_RC_T eResult, void *pArg);
+
+/**
+ * @brief   Action queue status
+*/
+typedef struct _ActionQueueStatus
+{
+    int iPlaying;       /**< 1 while an action is waiting for its completion */
+    int iPaused;        /**< 1 when paused by ubtPauseRobotAction */
+    int iQueued;        /**< Actions waiting in the queue */
+    int iNextId;        /**< Id of the action played next, 0 if none */
+} UBTEDU_ACTION_QUEUE_STATUS_T;
+
 
 /**
  * @brief      ubtGetSWVersion
@@ -332,16 +542,313 @@ UBTEDU_RC_T ubtRecordMotion(UBTEDU_ROBOTSERVO_T *servoAngle);
  */
 UBTEDU_RC_T ubtGetRobotServo(UBTEDU_ROBOTSERVO_T *pstServoAngle);
 
+/**
+ * @brief:      ubtGetRobotServoCached
+ * @details:    Read all servo's angle from the local shadow when all of them
+ *              are known and not older than iMaxAgeMs, otherwise from the robot
+ * @param[in]   pstServoAngle	The angle for the servos
+ * @param[in]   iMaxAgeMs	0 always reads from the robot
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGetRobotServoCached(UBTEDU_ROBOTSERVO_T *pstServoAngle, int iMaxAgeMs);
+
+/**
+ * @brief:      ubtServoShadowGetStats
+ * @details:    Get the hits and misses of ubtGetRobotServoCached
+ * @param[out]  pstStats
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoShadowGetStats(UBTEDU_SERVO_SHADOW_STATS_T *pstStats);
+
+/**
+ * @brief:      ubtServoShadowSetRefresh
+ * @details:    Read the servos in the background to keep the shadow fresh
+ * @param[in]   iPeriodMs	10 ~ 10000, 0 stops it
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoShadowSetRefresh(int iPeriodMs);
+
 
 /**
  * @brief:      ubtSetRobotServo
- * @details:    Set the servo's acAngle with speed
+ * @details:    Set the servo's acAngle with speed. Like ubtSetServos, the
+ *              servos already at their angle are not sent again.
  * @param[in]   pstServoAngle   The angle for the servos, details please see UBTEDU_ROBOTSERVO_T
  * @param[in]   iTime       It is the time for servo, the value is smaller, the speed is faster.
  * @retval		UBTEDU_RC_T
  */
 UBTEDU_RC_T ubtSetRobotServo(UBTEDU_ROBOTSERVO_T *pstServoAngle, int iTime);
 
+/**
+ * @brief:      ubtSetServos
+ * @details:    Set the angle of any subset of the servos with speed. Only
+ *              the servos which changed since the last acknowledged angle are
+ *              sent, and nothing is sent when none of them changed.
+ * @param[in]   angles      The angle for the 17 servos(range:0~180), angles[0] is the first servo.
+ *                  0 means the servo is not changed.
+ * @param[in]   mask        bit 0 - 16 selects the servos to set
+ * @param[in]   time        It is the time for servo, the value is smaller, the speed is faster.
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetServos(const uint8_t angles[17], uint32_t mask, int time);
+
+/**
+ * @brief:      ubtServoStreamStart
+ * @details:    Start the servo stream. A control thread samples the queued
+ *              keyframes at iRateHz and sends the servos which changed to the
+ *              robot, without waiting for each reply.
+ * @param[in]   iRateHz     Control rate, 1 ~ 100
+ * @param[in]   eInterp     Interpolation between keyframes, see UBTEDU_SERVO_INTERP_e
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoStreamStart(int iRateHz, UBTEDU_SERVO_INTERP_e eInterp);
+
+/**
+ * @brief:      ubtServoStreamPush
+ * @details:    Queue a keyframe on the servo stream
+ * @param[in]   angles      The angle for the 17 servos(range:0~180), angles[0] is the first servo.
+ *                  0 means the servo is not driven.
+ * @param[in]   iTimeMs     Time to reach the keyframe after the previous one, or after now
+ *                  when the stream is idle.
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoStreamPush(const uint8_t angles[17], int iTimeMs);
+
+/**
+ * @brief:      ubtServoStreamStop
+ * @details:    Stop the servo stream and drop the queued keyframes
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoStreamStop(void);
+
+/**
+ * @brief:      ubtServoStreamGetStats
+ * @details:    Get the timing statistics of the servo stream
+ * @param[out]  pstStats    Please see UBTEDU_SERVO_STREAM_STATS_T
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoStreamGetStats(UBTEDU_SERVO_STREAM_STATS_T *pstStats);
+
+/**
+ * @brief:      ubtServoSetLimit
+ * @details:    Set the speed and acceleration limits used by the
+ *              UBTEDU_SERVO_INTERP_MINJERK and UBTEDU_SERVO_INTERP_TRAPEZOID
+ *              motions. A keyframe which would pass them is reached later.
+ * @param[in]   iServo      1 ~ 17, 0 sets all the servos
+ * @param[in]   iMaxVel     Max speed, in degree/s
+ * @param[in]   iMaxAcc     Max acceleration, in degree/s^2
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoSetLimit(int iServo, int iMaxVel, int iMaxAcc);
+
+/**
+ * @brief:      ubtServoProfileExport
+ * @details:    Save a move between two poses as an HTS action file, with
+ *              a minimum jerk or trapezoidal profile within the servo limits
+ * @param[in]   from        The start angle of the 17 servos(range:0~180), 0 is not driven
+ * @param[in]   to          The end angle of the 17 servos(range:0~180), 0 is not driven
+ * @param[in]   eInterp     UBTEDU_SERVO_INTERP_MINJERK or UBTEDU_SERVO_INTERP_TRAPEZOID
+ * @param[in]   iTimeMs     Time of the move, made longer when a servo would pass its limits
+ * @param[in]   pcPath      The action file's path
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtServoProfileExport(const uint8_t from[17], const uint8_t to[17],
+                                  UBTEDU_SERVO_INTERP_e eInterp, int iTimeMs, char *pcPath);
+
+/**
+ * @brief      ubtCaptureStart
+ * @details    Start sampling the servos in the background. The servos are
+ *             read like ubtRecordMotion, so they can be posed by hand
+ * @param[in]   iRateHz       Sample rate, 1 ~ 50
+ * @param[in]   iMaxSeconds   Capture length kept in memory, 1 ~ 600
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtCaptureStart(int iRateHz, int iMaxSeconds);
+
+/**
+ * @brief      ubtCaptureStop
+ * @details    Stop sampling the servos, the samples are kept for export
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtCaptureStop(void);
+
+/**
+ * @brief      ubtCaptureGetStats
+ * @details    Get the capture statistics
+ * @param[out]  pstStats
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtCaptureGetStats(UBTEDU_CAPTURE_STATS_T *pstStats);
+
+/**
+ * @brief      ubtCaptureExport
+ * @details    Save the samples captured since the last export as an HTS
+ *             action file
+ * @param[in]   pcPath       The action file's path
+ * @param[in]   iTolerance   Degrees a dropped sample may be off the servos'
+ *                           way, 0 keeps every sample
+ * @param[out]  pstStats     Frames kept and error, may be NULL
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtCaptureExport(char *pcPath, int iTolerance, UBTEDU_COMPRESS_STATS_T *pstStats);
+
+/**
+ * @brief      ubtGetLimbPose
+ * @details    Get where the end of a limb is, from the servo angles
+ * @param[in]   eLimb       Please see UBTEDU_ROBOT_LIMB_e
+ * @param[in]   iMaxAgeMs   Oldest servo angles used, like ubtGetRobotServoCached
+ * @param[out]  pstPose
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGetLimbPose(UBTEDU_ROBOT_LIMB_e eLimb, int iMaxAgeMs, UBTEDU_LIMB_POSE_T *pstPose);
+
+/**
+ * @brief      ubtComputeLimbPoses
+ * @details    Get where the end of a limb is for many servo poses, e.g.
+ *             all the samples of a capture
+ * @param[in]   eLimb       Please see UBTEDU_ROBOT_LIMB_e
+ * @param[in]   angles      iNum sets of 17 servo angles, 0 is taken as the angle at which the limb hangs straight
+ * @param[in]   iNum
+ * @param[out]  pstPose     iNum poses
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtComputeLimbPoses(UBTEDU_ROBOT_LIMB_e eLimb, const uint8_t *angles, int iNum,
+                                UBTEDU_LIMB_POSE_T *pstPose);
+
+/**
+ * @brief      ubtSolveLimbIK
+ * @details    Get the servo angles which put the end of a limb at a point.
+ *             The search starts from the limb's angles in angles[], or from
+ *             the last solution for the limb when they are 0, so calling it
+ *             from a control loop is cheap. Angles stay within 1 ~ 180.
+ * @param[in]   eLimb       Please see UBTEDU_ROBOT_LIMB_e
+ * @param[in]   fX          The target, in mm, like UBTEDU_LIMB_POSE_T
+ * @param[in]   fY
+ * @param[in]   fZ
+ * @param[in,out]  angles   The angle for the 17 servos, only the limb's servos are changed
+ * @retval		UBTEDU_RC_T     UBTEDU_RC_FAILED when the point is out of reach,
+ *                  angles[] is then the closest pose found
+ */
+UBTEDU_RC_T ubtSolveLimbIK(UBTEDU_ROBOT_LIMB_e eLimb, float fX, float fY, float fZ, uint8_t angles[17]);
+
+/**
+ * @brief      ubtSetServoRange
+ * @details    Set the angles a servo may be sent to. Every servo frame sent
+ *             by the SDK and every action frame it builds is checked, angles
+ *             out of range are moved to the closest end of it.
+ * @param[in]   iServo      1 ~ 17
+ * @param[in]   iMin        0 ~ iMax
+ * @param[in]   iMax        iMin ~ 180
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetServoRange(int iServo, int iMin, int iMax);
+
+/**
+ * @brief      ubtSetCollisionCheck
+ * @details    Turn the self collision check of the servo frames on or off.
+ *             It is on by default, a frame in which the arms would hit the
+ *             body or each other, or the legs each other, is not sent and
+ *             the call fails with UBTEDU_RC_FAILED.
+ * @param[in]   iEnable     0 to turn it off
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetCollisionCheck(int iEnable);
+
+/**
+ * @brief      ubtGetSafetyStats
+ * @details    Get the servo frames checked, clamped and rejected
+ * @param[out]  pstStats    Please see UBTEDU_SAFETY_STATS_T
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGetSafetyStats(UBTEDU_SAFETY_STATS_T *pstStats);
+
+/**
+ * @brief      ubtGetServoOffsets
+ * @details    Get the calibration offsets read once from the robot while
+ *             connecting. They are added to every angle sent to the servos
+ *             and to the generated action files, and taken off the angles
+ *             read, so programs only see calibrated angles. A robot which
+ *             does not give them, such as one with an older firmware, is
+ *             only asked the first time it is connected.
+ * @param[out]  offsets    17 offsets in degree, offsets[0] is servo 1
+ * @retval		UBTEDU_RC_T   UBTEDU_RC_NOT_FOUND when the robot gave none
+ */
+UBTEDU_RC_T ubtGetServoOffsets(int8_t offsets[17]);
+
+/**
+ * @brief      ubtSetServoOffsetEnable
+ * @details    Turn the calibration offsets on or off, they are on by default
+ * @param[in]   iEnable    0 to send and read the raw servo angles
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetServoOffsetEnable(int iEnable);
+
+/**
+ * @brief      ubtGaitStart
+ * @details    Start walking. The leg servo frames are made on the fly and
+ *             queued on the servo stream, which must be started with
+ *             ubtServoStreamStart() first.
+ * @param[in]   pstParam    Please see UBTEDU_GAIT_PARAM_T
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGaitStart(const UBTEDU_GAIT_PARAM_T *pstParam);
+
+/**
+ * @brief      ubtGaitSetParam
+ * @details    Change the step length, turn rate or cadence of the walk. It
+ *             takes effect at the next step, a step length and turn rate of
+ *             0 stop the robot with its feet together.
+ * @param[in]   pstParam    Please see UBTEDU_GAIT_PARAM_T
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGaitSetParam(const UBTEDU_GAIT_PARAM_T *pstParam);
+
+/**
+ * @brief      ubtGaitStop
+ * @details    Finish the step going on, bring the feet together and stop
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGaitStop(void);
+
+/**
+ * @brief      ubtGaitExport
+ * @details    Save some steps of a walk as an action file, which starts and
+ *             ends standing
+ * @param[in]   pstParam    Please see UBTEDU_GAIT_PARAM_T
+ * @param[in]   iSteps      Steps before the one which brings the feet together
+ * @param[in]   pcPath      The action file's path
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGaitExport(const UBTEDU_GAIT_PARAM_T *pstParam, int iSteps, char *pcPath);
+
+/**
+ * @brief      ubtBalanceStart
+ * @details    Start the balance controller. It reads the IMU at a fixed
+ *             rate and corrects the ankles and hips on top of the frames
+ *             of the servo stream. The IMU euler-y is the pitch and
+ *             euler-x the roll, use negative gains if it is mounted the
+ *             other way. A read which is not answered within the period is
+ *             given up, so a loop never takes longer than one period.
+ * @param[in]   pstParam    Please see UBTEDU_BALANCE_PARAM_T
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtBalanceStart(const UBTEDU_BALANCE_PARAM_T *pstParam);
+
+/**
+ * @brief      ubtBalanceStop
+ * @details    Stop the balance controller
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtBalanceStop(void);
+
+/**
+ * @brief      ubtBalanceGetStats
+ * @details    Get the balance controller statistics
+ * @param[out]  pstStats    Please see UBTEDU_BALANCE_STATS_T
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtBalanceGetStats(UBTEDU_BALANCE_STATS_T *pstStats);
+
 /**
  * @brief      ubtSetRobotVolume
  * @details    Set the volume for the Robot
@@ -370,7 +877,7 @@ UBTEDU_RC_T ubtSetRobotVolume(int iVolume);
  *                             front
  *                             back
  * @param[in]   iSpeed      1/2/3/4/5  The default value is 3
- * @param[in]   iRepeat     Repeat times. 0 means infinite
+ * @param[in]   iRepeat     Repeat times, 1 or more. Ignored for the head
  * @retval		UBTEDU_RC_T
  */
 UBTEDU_RC_T ubtSetRobotMotion(char *pcType, char *pcDirect, int iSpeed, int iRepeat);
@@ -406,7 +913,9 @@ UBTEDU_RC_T ubtReadSensorValue(char *pcSensorType, void *pValue, int iValueLen);
 
 /**
  * @brief      ubtReadSensorValueByAddr
- * @details    Read the sensor's value by it's type and address
+ * @details    Read the sensor's value by it's type and address. It is not
+ *             kept for ubtGetSensorLatest and ubtGetSensorHistory, the
+ *             sensor at iAddr may be another one of the type.
  * @param[in]   pcSensorType  The sensor's type.
  *                                  gryo
  *                                  environment
@@ -433,6 +942,83 @@ UBTEDU_RC_T ubtReadSensorValue(char *pcSensorType, void *pValue, int iValueLen);
  */
 UBTEDU_RC_T ubtReadSensorValueByAddr(char *pcSensorType, int iAddr, void *pValue, int iValueLen);
 
+/**
+ * @brief      ubtReadSensors
+ * @details    Read several sensors in one round trip
+ * @param[in]   apcType     Sensor types, like ubtReadSensorValue
+ * @param[out]  apValue     Value of each sensor, its UBTEDU_ROBOT*_SENSOR_T
+ * @param[in]   iNum        1 ~ 16
+ * @param[out]  aeResult    Result of each sensor, may be NULL
+ * @retval		UBTEDU_RC_T  The result of the first sensor which failed
+ */
+UBTEDU_RC_T ubtReadSensors(const char *apcType[], void *apValue[], int iNum, UBTEDU_RC_T aeResult[]);
+
+/**
+ * @brief      ubtSubscribeSensors
+ * @details    Receive the samples of several sensors at a fixed rate in
+ *             the background. The robot pushes them, or they are polled
+ *             when its firmware does not.
+ * @param[in]   apcType     Sensor types, like ubtReadSensorValue
+ * @param[in]   iNum        Number of sensor types
+ * @param[in]   iRateHz     Samples per second of each sensor, 1 ~ 100
+ * @param[in]   pfnSample   Called for each sample on the subscription's thread, may be NULL
+ * @param[in]   pArg        Given back to pfnSample
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSubscribeSensors(char *apcType[], int iNum, int iRateHz, UBTEDU_SENSOR_CB pfnSample, void *pArg);
+
+/**
+ * @brief      ubtUnsubscribeSensors
+ * @details    Stop receiving the sensor samples, the samples are kept.
+ *             Not from the sample callback, it then fails.
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtUnsubscribeSensors(void);
+
+/**
+ * @brief      ubtReadSensorSamples
+ * @details    Take the oldest samples of the subscribed sensors, from one thread only
+ * @param[out]  pstSample   Room for iMax samples
+ * @param[in]   iMax
+ * @param[out]  piNum       Samples taken
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtReadSensorSamples(UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax, int *piNum);
+
+/**
+ * @brief      ubtGetSensorSubStats
+ * @details    Get the sensor subscription statistics
+ * @param[out]  pstStats    Please see UBTEDU_SENSOR_SUB_STATS_T
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGetSensorSubStats(UBTEDU_SENSOR_SUB_STATS_T *pstStats);
+
+/**
+ * @brief      ubtGetSensorLatest
+ * @details    Get the newest sample of a sensor, from the subscription or
+ *             the reads, without asking the robot. Any thread may call it.
+ * @param[in]   pcSensorType    Sensor type, like ubtReadSensorValue
+ * @param[out]  pstSample
+ * @retval		UBTEDU_RC_T  UBTEDU_RC_NOT_FOUND when there is no sample yet
+ */
+UBTEDU_RC_T ubtGetSensorLatest(char *pcSensorType, UBTEDU_SENSOR_SAMPLE_T *pstSample);
+
+/**
+ * @brief      ubtGetSensorHistory
+ * @details    Get the samples of a sensor received in a time window, from
+ *             the last 256 ones, without asking the robot. Any thread may
+ *             call it.
+ * @param[in]   pcSensorType    Sensor type, like ubtReadSensorValue
+ * @param[in]   ullFromUs       CLOCK_MONOTONIC time in us, like ullTimeUs
+ * @param[in]   ullToUs
+ * @param[out]  pstSample       The newest iMax samples of the window, oldest first
+ * @param[in]   iMax
+ * @param[out]  piNum           Samples given
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGetSensorHistory(char *pcSensorType, unsigned long long ullFromUs, unsigned long long ullToUs,
+        UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax, int *piNum);
+
 /**
  * @brief      ubtSetRobotLED
  * @details    Set the LED mode
@@ -489,6 +1075,103 @@ UBTEDU_RC_T ubtSetRobotLED(char *pcType, char *pcColor, char *pcMode);
  */
 UBTEDU_RC_T ubtStartRobotAction(char *pcName, int iRepeat);
 
+/**
+ * @brief      ubtStartRobotActionAsync
+ * @details    Let the robot play an action without waiting for its end.
+ *             The completion is reported to the callback of
+ *             ubtSetActionCallback and on the fd of ubtGetActionEventFd
+ * @param[in]   pcName  The action file's name For
+ *                              example: push up, bow
+ * @param[in]   iRepeat   Repeat times. 0 means infinite
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtStartRobotActionAsync(char *pcName, int iRepeat);
+
+/**
+ * @brief      ubtSetActionCallback
+ * @details    Set the completion callback of ubtStartRobotActionAsync. It is
+ *             called from an SDK thread, eResult is UBTEDU_RC_FAILED when
+ *             the action was stopped or replaced
+ * @param[in]   pfnDone  NULL to remove it
+ * @param[in]   pArg     Passed to pfnDone
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtSetActionCallback(UBTEDU_ACTION_DONE_CB pfnDone, void *pArg);
+
+/**
+ * @brief      ubtGetActionEventFd
+ * @details    Get an fd which becomes readable when an action of
+ *             ubtStartRobotActionAsync is completed. Reading 8 bytes gives
+ *             the number of completed actions
+ * @retval		The fd, -1 if failed
+ */
+int ubtGetActionEventFd(void);
+
+/**
+ * @brief      ubtPauseRobotAction
+ * @details    Pause the playing action, the action queue waits too
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtPauseRobotAction(void);
+
+/**
+ * @brief      ubtContinueRobotAction
+ * @details    Continue the paused action and the action queue
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtContinueRobotAction(void);
+
+/**
+ * @brief      ubtResetRobotAction
+ * @details    Reset the robot's action player and empty the action queue
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtResetRobotAction(void);
+
+/**
+ * @brief      ubtActionQueueAdd
+ * @details    Queue an action. It starts right when the previous one ends,
+ *             or at once when nothing is playing. Completion is reported
+ *             like ubtStartRobotActionAsync
+ * @param[in]   pcName  The action file's name
+ * @param[in]   iRepeat   Repeat times, 1 ~ 65535
+ * @param[out]  piId      Id of the queued action, may be NULL
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtActionQueueAdd(char *pcName, int iRepeat, int *piId);
+
+/**
+ * @brief      ubtActionQueueRemove
+ * @details    Cancel a queued action which has not started yet
+ * @param[in]   iId
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtActionQueueRemove(int iId);
+
+/**
+ * @brief      ubtActionQueueMove
+ * @details    Move a queued action to another position
+ * @param[in]   iId
+ * @param[in]   iIndex  New position, 0 is played next
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtActionQueueMove(int iId, int iIndex);
+
+/**
+ * @brief      ubtActionQueueClear
+ * @details    Cancel all queued actions, the playing one goes on
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtActionQueueClear(void);
+
+/**
+ * @brief      ubtActionQueueGetStatus
+ * @details    Get the status of the action queue
+ * @param[out]  pstStatus
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtActionQueueGetStatus(UBTEDU_ACTION_QUEUE_STATUS_T *pstStatus);
+
 /**
   * @brief      Stop to run the robot action file
   *
@@ -497,6 +1180,28 @@ UBTEDU_RC_T ubtStartRobotAction(char *pcName, int iRepeat);
   */
 UBTEDU_RC_T ubtStopRobotAction(void);
 
+/**
+ * @brief      ubtGetActionInfo
+ * @details    Validate an HTS action file and get its frames, play time
+ *             and the angle range of each servo
+ * @param[in]   pcPath  The action file's path
+ * @param[out]  pstInfo
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtGetActionInfo(char *pcPath, UBTEDU_ACTION_INFO_T *pstInfo);
+
+/**
+ * @brief      ubtCompressAction
+ * @details    Drop the frames of an action file which the servos pass
+ *             within iMaxError anyway, keeping the play time
+ * @param[in]   pcIn        The action file's path
+ * @param[in]   pcOut       The compressed file's path, may be pcIn
+ * @param[in]   iMaxError   Degrees a dropped frame may be off, 0 ~ 180
+ * @param[out]  pstStats    Frames kept and error, may be NULL
+ * @retval		UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtCompressAction(char *pcIn, char *pcOut, int iMaxError, UBTEDU_COMPRESS_STATS_T *pstStats);
+
 /**
  * @brief   Start voice recognition
  *
@@ -0,0 +1,54 @@
+#!/usr/bin/python
+# _*_ coding: utf-8 -*-
+
+import time
+import RobotApi
+
+RobotApi.ubtRobotInitialize()
+#------------------------------Connect----------------------------------------
+#127.0.0.1 talks to ubtBalanceAgent.py, use the robot IP for a real robot
+gIPAddr = "127.0.0.1"
+ret = RobotApi.ubtRobotConnect("SDK", "1", gIPAddr)
+if (0 != ret):
+	print ("Can not connect to robot %s" % gIPAddr)
+	exit(1)
+
+#--------------------------Stand and keep balance-----------------------------
+ret = RobotApi.ubtServoStreamStart(50, RobotApi.UBTEDU_SERVO_INTERP_CUBIC)
+if (0 != ret):
+	print ("Can not start the servo stream: %d" % ret)
+	exit(1)
+
+stand = [90, 90, 90, 90, 90, 90, 90, 58, 74, 110, 89, 90, 120, 104, 69, 89, 90]
+angles = RobotApi.uint8Array(17)
+for i in range(17):
+	angles[i] = stand[i]
+RobotApi.ubtServoStreamPush(angles.cast(), 500)
+time.sleep(1)
+
+param = RobotApi.UBTEDU_BALANCE_PARAM_T()
+param.iRateHz = 50
+param.fKp = 1.5
+param.fKd = 0.2
+param.fHipRatio = 0.5
+param.iMaxCorrection = 20
+ret = RobotApi.ubtBalanceStart(param)
+if (0 != ret):
+	print ("Can not start the balance controller: %d" % ret)
+	exit(1)
+
+stats = RobotApi.UBTEDU_BALANCE_STATS_T()
+for i in range(40):
+	time.sleep(0.25)
+	RobotApi.ubtBalanceGetStats(stats)
+	print ("pitch %5.1f roll %5.1f  correction %5.1f %5.1f" %
+		(stats.fPitch, stats.fRoll, stats.fPitchCorrection, stats.fRollCorrection))
+print ("loops %d, read failed %d, overruns %d, latency avg %d us, max %d us" %
+	(stats.uiLoops, stats.uiReadFailed, stats.uiOverruns,
+	stats.uiLatencyAvgUs, stats.uiLatencyMaxUs))
+RobotApi.ubtBalanceStop()
+RobotApi.ubtServoStreamStop()
+
+#--------------------------DisConnection---------------------------------
+RobotApi.ubtRobotDisconnect("SDK","1",gIPAddr)
+RobotApi.ubtRobotDeinitialize()
@@ -0,0 +1,114 @@
+#!/usr/bin/python
+# _*_ coding: utf-8 -*-
+
+# Stand-in for the robot side of the balance controller. The body is an
+# inverted pendulum per axis which the legs hold up: it acks the servo
+# stream, turns the hip and ankle angles it receives into the leg
+# correction, and answers the gyro reads with the tilt. Every PUSH_PERIOD
+# seconds the body is pushed, so the balance loop can be tried on any
+# machine:
+#   python ubtBalanceAgent.py [pitch push, deg/s] [roll push, deg/s] &
+#   python ubtBalance.py
+
+import json
+import socket
+import sys
+import time
+
+AGENT_PORT = 20001
+PUSH_PERIOD = 3.0
+
+# g over the height of the center of mass in 1/s^2, damping in 1/s,
+# servo lag and integration step in s
+OMEGA2 = 9810.0 / 150.0
+DAMPING = 1.0
+SERVO_LAG = 0.05
+STEP = 0.001
+
+# Leg servos (0 based) and the direction they turn the body, as in
+# utils/RobotKinematics.c: (hip roll, hip pitch, ankle pitch, ankle roll)
+LEGS = (((6, 1), (7, 1), (9, -1), (10, 1)),
+	((11, 1), (12, -1), (14, 1), (15, 1)))
+
+pushPitch = float(sys.argv[1]) if (len(sys.argv) > 1) else 40.0
+pushRoll = float(sys.argv[2]) if (len(sys.argv) > 2) else 0.0
+
+# pitch, roll, pitch rate, roll rate, and the correction the servos reached
+tilt = [0.0, 0.0, 0.0, 0.0]
+servo = [0.0, 0.0]
+# Servo angles, the first frame of the stream is taken as the uncorrected pose
+angles = [0] * 17
+rest = None
+
+def correction():
+	# The hips and the ankles share the correction, their sum is all of it
+	if (rest is None):
+		return (0.0, 0.0)
+	pitch = 0.0
+	roll = 0.0
+	for leg in LEGS:
+		for (i, sign) in (leg[1], leg[2]):
+			pitch += sign * (angles[i] - rest[i])
+		for (i, sign) in (leg[0], leg[3]):
+			roll += sign * (angles[i] - rest[i])
+	return (pitch / len(LEGS), roll / len(LEGS))
+
+def simulate(dt):
+	(pitch, roll) = correction()
+	while (dt > 0.0):
+		step = min(dt, STEP)
+		servo[0] += (pitch - servo[0]) * step / SERVO_LAG
+		servo[1] += (roll - servo[1]) * step / SERVO_LAG
+		# The body falls away from where the legs hold it
+		tilt[2] += (OMEGA2 * (tilt[0] - servo[0]) - DAMPING * tilt[2]) * step
+		tilt[3] += (OMEGA2 * (tilt[1] - servo[1]) - DAMPING * tilt[3]) * step
+		tilt[0] += tilt[2] * step
+		tilt[1] += tilt[3] * step
+		dt -= step
+
+sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+sock.bind(("0.0.0.0", AGENT_PORT))
+sock.settimeout(STEP * 10)
+print ("Balance agent listening on port %d, pushing %.0f/%.0f deg/s every %.0f s" %
+	(AGENT_PORT, pushPitch, pushRoll, PUSH_PERIOD))
+
+last = time.time()
+nextPush = last + PUSH_PERIOD
+while True:
+	try:
+		data, addr = sock.recvfrom(1024)
+	except socket.timeout:
+		data = None
+	now = time.time()
+	simulate(now - last)
+	last = now
+	if (now >= nextPush):
+		tilt[2] += pushPitch
+		tilt[3] += pushRoll
+		nextPush += PUSH_PERIOD
+		print ("push: pitch %.1f roll %.1f" % (tilt[0], tilt[1]))
+	if (data is None):
+		continue
+
+	try:
+		msg = json.loads(data)
+	except ValueError:
+		print ("Bad message from %s: %s" % (addr[0], data))
+		continue
+	if ((msg.get("cmd") == "servo") and (msg.get("type") == "write")):
+		angle = msg.get("angle", "")
+		for i in range(min(17, len(angle) // 2)):
+			if (angle[2 * i:2 * i + 2].upper() != "FF"):
+				angles[i] = int(angle[2 * i:2 * i + 2], 16)
+		if (rest is None):
+			rest = list(angles)
+		ack = {"cmd": "servo_ack", "type": "write", "status": "ok"}
+	elif ((msg.get("cmd") == "query") and (msg.get("para") == "gyro")):
+		ack = {"cmd": "query_ack", "type": "sensor", "status": "ok",
+			"gyro": {"gyro-x": tilt[3], "gyro-y": tilt[2], "gyro-z": 0.0,
+				"accel-x": 0.0, "accel-y": 0.0, "accel-z": 1.0,
+				"compass-x": 0.0, "compass-y": 0.0, "compass-z": 0.0,
+				"euler-x": tilt[1], "euler-y": tilt[0], "euler-z": 0.0}}
+	else:
+		ack = {"cmd": msg.get("cmd", "") + "_ack", "status": "ok"}
+	sock.sendto(json.dumps(ack).encode(), (addr[0], int(msg.get("port", addr[1]))))
@@ -0,0 +1,42 @@
+#!/usr/bin/python
+# _*_ coding: utf-8 -*-
+
+import time
+import RobotApi
+
+RobotApi.ubtRobotInitialize()
+#------------------------------Connect----------------------------------------
+#127.0.0.1 talks to ubtServoStreamAgent.py, use the robot IP for a real robot
+gIPAddr = "127.0.0.1"
+ret = RobotApi.ubtRobotConnect("SDK", "1", gIPAddr)
+if (0 != ret):
+	print ("Can not connect to robot %s" % gIPAddr)
+	exit(1)
+
+#--------------------------Wave the right arm---------------------------------
+ret = RobotApi.ubtServoStreamStart(50, RobotApi.UBTEDU_SERVO_INTERP_CUBIC)
+if (0 != ret):
+	print ("Can not start the servo stream: %d" % ret)
+	exit(1)
+
+angles = RobotApi.uint8Array(17)
+for i in range(17):
+	angles[i] = 0
+for i in range(4):
+	angles[0] = 90
+	angles[1] = 40
+	RobotApi.ubtServoStreamPush(angles.cast(), 500)
+	angles[1] = 140
+	RobotApi.ubtServoStreamPush(angles.cast(), 500)
+time.sleep(4.5)
+
+stats = RobotApi.UBTEDU_SERVO_STREAM_STATS_T()
+RobotApi.ubtServoStreamGetStats(stats)
+print ("ticks %d, frames %d, acks %d, missed %d, jitter avg %d us, max %d us" %
+	(stats.uiTicks, stats.uiFramesSent, stats.uiAcks, stats.uiMissed,
+	stats.uiJitterAvgUs, stats.uiJitterMaxUs))
+RobotApi.ubtServoStreamStop()
+
+#--------------------------DisConnection--------------------------------- 
+RobotApi.ubtRobotDisconnect("SDK","1",gIPAddr)
+RobotApi.ubtRobotDeinitialize()
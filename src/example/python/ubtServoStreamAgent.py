@@ -0,0 +1,46 @@
+#!/usr/bin/python
+# _*_ coding: utf-8 -*-
+
+# Stand-in for the robot side of the servo stream. It acks every servo
+# message like the robot does and prints the arrival rate and jitter, so
+# the stream can be tried on any machine:
+#   python ubtServoStreamAgent.py &
+#   python ubtServoStream.py
+
+import json
+import socket
+import time
+
+AGENT_PORT = 20001
+
+sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+sock.bind(("0.0.0.0", AGENT_PORT))
+print ("Servo stream agent listening on port %d" % AGENT_PORT)
+
+frames = 0
+last = None
+maxGap = 0.0
+sumGap = 0.0
+while True:
+	data, addr = sock.recvfrom(1024)
+	now = time.time()
+	try:
+		msg = json.loads(data)
+	except ValueError:
+		print ("Bad message from %s: %s" % (addr[0], data))
+		continue
+	if (msg.get("cmd") != "servo"):
+		continue
+
+	ack = {"cmd": "servo_ack", "status": "ok"}
+	sock.sendto(json.dumps(ack).encode(), (addr[0], int(msg.get("port", addr[1]))))
+
+	frames += 1
+	if (last is not None):
+		gap = now - last
+		maxGap = max(maxGap, gap)
+		sumGap += gap
+	last = now
+	if (frames % 50 == 0):
+		print ("frames %d  mean gap %.1f ms  max gap %.1f ms  angle %s" %
+			(frames, 1000.0 * sumGap / (frames - 1), 1000.0 * maxGap, msg.get("angle")))
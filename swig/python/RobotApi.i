@@ -1,5 +1,8 @@
 
 %module RobotApi
+%include "stdint.i"
+%include "carrays.i"
+%array_class(uint8_t, uint8Array);
 #define UBTEDU_SDK_SW_VER              "01"
 #define UBTEDU_ROBOT_NAME_LEN       (32)
 #define UBTEDU_ROBOT_IP_ADDR_LEN        (16)
@@ -156,6 +159,42 @@ typedef struct _RobotPressureSensor
 {
     int iValue;         /**<    The Pressure via Pressure sensor */
 } UBTEDU_ROBOTPRESSURE_SENSOR_T;
+typedef enum
+{
+    UBTEDU_SENSOR_GYRO = 0,         /**< UBTEDU_ROBOTGYRO_SENSOR_T */
+    UBTEDU_SENSOR_ENV,              /**< UBTEDU_ROBOTENV_SENSOR_T */
+    UBTEDU_SENSOR_BOARD,            /**< UBTEDU_ROBOTRASPBOARD_SENSOR_T */
+    UBTEDU_SENSOR_ULTRASONIC,       /**< UBTEDU_ROBOTULTRASONIC_SENSOR_T */
+    UBTEDU_SENSOR_INFRARED,         /**< UBTEDU_ROBOTINFRARED_SENSOR_T */
+    UBTEDU_SENSOR_TOUCH,            /**< UBTEDU_ROBOTTOUCH_SENSOR_T */
+    UBTEDU_SENSOR_COLOR,            /**< UBTEDU_ROBOTCOLOR_SENSOR_T */
+    UBTEDU_SENSOR_PRESSURE,         /**< UBTEDU_ROBOTPRESSURE_SENSOR_T */
+    UBTEDU_SENSOR_INVALID           /**< Invalid value */
+} UBTEDU_SENSOR_TYPE_e;
+typedef struct _SensorSample
+{
+    UBTEDU_SENSOR_TYPE_e eType;     /**< Which member of uValue is set */
+    unsigned long long ullTimeUs;   /**< Monotonic time the sample was received */
+    union
+    {
+        UBTEDU_ROBOTGYRO_SENSOR_T stGyro;
+        UBTEDU_ROBOTENV_SENSOR_T stEnv;
+        UBTEDU_ROBOTRASPBOARD_SENSOR_T stBoard;
+        UBTEDU_ROBOTULTRASONIC_SENSOR_T stUltrasonic;
+        UBTEDU_ROBOTINFRARED_SENSOR_T stInfrared;
+        UBTEDU_ROBOTTOUCH_SENSOR_T stTouch;
+        UBTEDU_ROBOTCOLOR_SENSOR_T stColor;
+        UBTEDU_ROBOTPRESSURE_SENSOR_T stPressure;
+    } uValue;
+} UBTEDU_SENSOR_SAMPLE_T;
+typedef void (*UBTEDU_SENSOR_CB)(const UBTEDU_SENSOR_SAMPLE_T *pstSample, void *pArg);
+typedef struct _SensorSubStats
+{
+    unsigned int uiReceived;        /**< Samples received */
+    unsigned int uiDropped;         /**< Samples lost because nobody read them in time */
+    unsigned int uiFailed;          /**< Polls not answered before the next one */
+    unsigned int uiPolledMask;      /**< Sensors polled as the robot does not push them, bit per UBTEDU_SENSOR_TYPE_e */
+} UBTEDU_SENSOR_SUB_STATS_T;
 typedef struct _RobotBatteryInfo
 {
     int iValue;      /**< battery value */
@@ -166,6 +205,107 @@ typedef struct _RobotColorDetect
         int iSaturation; /**<  Saturation value */
         int iValue;      /**<  value */ 
 } UBTEDU_COLOR_HSV_T;
+typedef enum
+{
+    UBTEDU_SERVO_INTERP_LINEAR = 0,     /**< Straight line */
+    UBTEDU_SERVO_INTERP_CUBIC,          /**< Cubic spline through the keyframes */
+    UBTEDU_SERVO_INTERP_MINJERK,        /**< Minimum jerk, stops at each keyframe within the servo limits */
+    UBTEDU_SERVO_INTERP_TRAPEZOID,      /**< Trapezoidal speed, stops at each keyframe within the servo limits */
+    UBTEDU_SERVO_INTERP_INVALID         /**< Invalid value */
+} UBTEDU_SERVO_INTERP_e;
+typedef struct _ServoStreamStats
+{
+    unsigned int uiTicks;           /**< Control periods run */
+    unsigned int uiFramesSent;      /**< Servo messages sent */
+    unsigned int uiAcks;            /**< Servo acks received from the robot */
+    unsigned int uiMissed;          /**< Periods skipped because the thread woke up too late */
+    unsigned int uiJitterMaxUs;     /**< Max wake up delay in microseconds */
+    unsigned int uiJitterAvgUs;     /**< Mean wake up delay in microseconds */
+} UBTEDU_SERVO_STREAM_STATS_T;
+typedef struct _ServoShadowStats
+{
+    unsigned int uiHits;            /**< Reads served from the local shadow */
+    unsigned int uiMisses;          /**< Reads which went to the robot */
+} UBTEDU_SERVO_SHADOW_STATS_T;
+typedef struct _CaptureStats
+{
+    unsigned int uiSamples;         /**< Samples waiting to be exported */
+    unsigned int uiDropped;         /**< Samples lost because the capture was full */
+    unsigned int uiFailed;          /**< Servo reads which failed */
+} UBTEDU_CAPTURE_STATS_T;
+typedef enum
+{
+    UBTEDU_ROBOT_LIMB_LEFT_ARM = 0,     /**< Left hand, servo 4 ~ 6 */
+    UBTEDU_ROBOT_LIMB_RIGHT_ARM,        /**< Right hand, servo 1 ~ 3 */
+    UBTEDU_ROBOT_LIMB_LEFT_LEG,         /**< Left foot, servo 12 ~ 16 */
+    UBTEDU_ROBOT_LIMB_RIGHT_LEG,        /**< Right foot, servo 7 ~ 11 */
+    UBTEDU_ROBOT_LIMB_HEAD,             /**< Head, servo 17 */
+    UBTEDU_ROBOT_LIMB_INVALID           /**< Invalid value */
+} UBTEDU_ROBOT_LIMB_e;
+
+typedef struct _RobotLimbPose
+{
+    float fX;                       /**< Position, in mm */
+    float fY;
+    float fZ;
+    float fRoll;                    /**< Rotation around x, in degree */
+    float fPitch;                   /**< Rotation around y, in degree */
+    float fYaw;                     /**< Rotation around z, in degree */
+} UBTEDU_LIMB_POSE_T;
+typedef struct _SafetyStats
+{
+    unsigned int uiChecked;         /**< Servo frames checked */
+    unsigned int uiClamped;         /**< Frames with an angle moved into its servo's range */
+    unsigned int uiRejected;        /**< Frames not sent because the robot would hit itself */
+} UBTEDU_SAFETY_STATS_T;
+typedef struct _GaitParam
+{
+    int iStepLength;                /**< Stride of one step in mm, -60 ~ 60, negative walks back */
+    int iTurnRate;                  /**< Turn of one step in degree, -20 ~ 20, positive turns left */
+    int iCadence;                   /**< Steps per minute, 30 ~ 200 */
+} UBTEDU_GAIT_PARAM_T;
+typedef struct _BalanceParam
+{
+    int iRateHz;                    /**< IMU reads per second, 10 ~ 100 */
+    float fKp;                      /**< Correction in degree per degree of tilt, about 1.5 */
+    float fKd;                      /**< Correction in degree per degree/s of tilt speed, about 0.2 */
+    float fHipRatio;                /**< Part of the correction made by the hips, 0 ~ 1, the rest by the ankles */
+    int iMaxCorrection;             /**< Max correction, in degree */
+} UBTEDU_BALANCE_PARAM_T;
+typedef struct _BalanceStats
+{
+    unsigned int uiLoops;           /**< IMU samples used */
+    unsigned int uiReadFailed;      /**< IMU reads not answered within the period */
+    unsigned int uiOverruns;        /**< Periods skipped because a loop took longer */
+    unsigned int uiLatencyAvgUs;    /**< From the IMU request to the corrections in place */
+    unsigned int uiLatencyMaxUs;
+    float fPitch;                   /**< Last tilt in degree, positive leans forward */
+    float fRoll;                    /**< Positive leans right */
+    float fPitchCorrection;         /**< Last leg corrections, in degree */
+    float fRollCorrection;
+} UBTEDU_BALANCE_STATS_T;
+typedef struct _ActionInfo
+{
+    int iFrameNum;                  /**< Motion frames */
+    int iTotalTime;                 /**< Play time in ms */
+    UBTEDU_ROBOTSERVO_T stMinAngle; /**< Min angle of each servo, 0 if the servo is not moved */
+    UBTEDU_ROBOTSERVO_T stMaxAngle; /**< Max angle of each servo, 0 if the servo is not moved */
+} UBTEDU_ACTION_INFO_T;
+typedef struct _CompressStats
+{
+    int iFramesIn;                  /**< Motion frames before */
+    int iFramesOut;                 /**< Motion frames kept */
+    float fRatio;                   /**< iFramesIn over iFramesOut */
+    float fMaxError;                /**< Largest angle error of a dropped frame, in degree */
+} UBTEDU_COMPRESS_STATS_T;
+typedef void (*UBTEDU_ACTION_DONE_CB)(char *pcName, UBTEDU_RC_T eResult, void *pArg);
+typedef struct _ActionQueueStatus
+{
+    int iPlaying;       /**< 1 while an action is waiting for its completion */
+    int iPaused;        /**< 1 when paused by ubtPauseRobotAction */
+    int iQueued;        /**< Actions waiting in the queue */
+    int iNextId;        /**< Id of the action played next, 0 if none */
+} UBTEDU_ACTION_QUEUE_STATUS_T;
 
 
 %{
@@ -178,14 +318,64 @@ extern UBTEDU_RC_T ubtCheckAPPStatus(char *pcBuf, int iWaitTime);
 extern UBTEDU_RC_T ubtDetectVoiceMsg(char *pcBuf, int iTimeout);
 extern UBTEDU_RC_T ubtRecordMotion(UBTEDU_ROBOTSERVO_T *servoAngle);
 extern UBTEDU_RC_T ubtGetRobotServo(UBTEDU_ROBOTSERVO_T *servoAngle);
+extern UBTEDU_RC_T ubtGetRobotServoCached(UBTEDU_ROBOTSERVO_T *servoAngle, int iMaxAgeMs);
+extern UBTEDU_RC_T ubtServoShadowGetStats(UBTEDU_SERVO_SHADOW_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtServoShadowSetRefresh(int iPeriodMs);
 extern UBTEDU_RC_T ubtSetRobotServo(UBTEDU_ROBOTSERVO_T *servoAngle, int iTime);
+extern UBTEDU_RC_T ubtSetServos(const uint8_t angles[17], uint32_t mask, int time);
+extern UBTEDU_RC_T ubtServoStreamStart(int iRateHz, UBTEDU_SERVO_INTERP_e eInterp);
+extern UBTEDU_RC_T ubtServoStreamPush(const uint8_t angles[17], int iTimeMs);
+extern UBTEDU_RC_T ubtServoStreamStop(void);
+extern UBTEDU_RC_T ubtServoStreamGetStats(UBTEDU_SERVO_STREAM_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtServoSetLimit(int iServo, int iMaxVel, int iMaxAcc);
+extern UBTEDU_RC_T ubtServoProfileExport(const uint8_t from[17], const uint8_t to[17], UBTEDU_SERVO_INTERP_e eInterp, int iTimeMs, char *pcPath);
+extern UBTEDU_RC_T ubtCaptureStart(int iRateHz, int iMaxSeconds);
+extern UBTEDU_RC_T ubtCaptureStop(void);
+extern UBTEDU_RC_T ubtCaptureGetStats(UBTEDU_CAPTURE_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtCaptureExport(char *pcPath, int iTolerance, UBTEDU_COMPRESS_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtGetLimbPose(UBTEDU_ROBOT_LIMB_e eLimb, int iMaxAgeMs, UBTEDU_LIMB_POSE_T *pstPose);
+extern UBTEDU_RC_T ubtComputeLimbPoses(UBTEDU_ROBOT_LIMB_e eLimb, const uint8_t *angles, int iNum, UBTEDU_LIMB_POSE_T *pstPose);
+extern UBTEDU_RC_T ubtSolveLimbIK(UBTEDU_ROBOT_LIMB_e eLimb, float fX, float fY, float fZ, uint8_t angles[17]);
+extern UBTEDU_RC_T ubtSetServoRange(int iServo, int iMin, int iMax);
+extern UBTEDU_RC_T ubtSetCollisionCheck(int iEnable);
+extern UBTEDU_RC_T ubtGetSafetyStats(UBTEDU_SAFETY_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtGetServoOffsets(int8_t offsets[17]);
+extern UBTEDU_RC_T ubtSetServoOffsetEnable(int iEnable);
+extern UBTEDU_RC_T ubtGaitStart(const UBTEDU_GAIT_PARAM_T *pstParam);
+extern UBTEDU_RC_T ubtGaitSetParam(const UBTEDU_GAIT_PARAM_T *pstParam);
+extern UBTEDU_RC_T ubtGaitStop(void);
+extern UBTEDU_RC_T ubtGaitExport(const UBTEDU_GAIT_PARAM_T *pstParam, int iSteps, char *pcPath);
+extern UBTEDU_RC_T ubtBalanceStart(const UBTEDU_BALANCE_PARAM_T *pstParam);
+extern UBTEDU_RC_T ubtBalanceStop(void);
+extern UBTEDU_RC_T ubtBalanceGetStats(UBTEDU_BALANCE_STATS_T *pstStats);
 extern UBTEDU_RC_T ubtSetRobotVolume(int iVolume);
 extern UBTEDU_RC_T ubtSetRobotMotion(char *pcType, char *pcDirect, int iSpeed, int iRepeat);
 extern UBTEDU_RC_T ubtReadSensorValue(char *pcSensorType, void *pValue, int iValueLen);
 extern UBTEDU_RC_T ubtReadSensorValueByAddr(char *pcSensorType, int iAddr, void *pValue, int iValueLen);
+extern UBTEDU_RC_T ubtReadSensors(const char *apcType[], void *apValue[], int iNum, UBTEDU_RC_T aeResult[]);
+extern UBTEDU_RC_T ubtSubscribeSensors(char *apcType[], int iNum, int iRateHz, UBTEDU_SENSOR_CB pfnSample, void *pArg);
+extern UBTEDU_RC_T ubtUnsubscribeSensors(void);
+extern UBTEDU_RC_T ubtReadSensorSamples(UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax, int *piNum);
+extern UBTEDU_RC_T ubtGetSensorSubStats(UBTEDU_SENSOR_SUB_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtGetSensorLatest(char *pcSensorType, UBTEDU_SENSOR_SAMPLE_T *pstSample);
+extern UBTEDU_RC_T ubtGetSensorHistory(char *pcSensorType, unsigned long long ullFromUs, unsigned long long ullToUs,
+        UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax, int *piNum);
 extern UBTEDU_RC_T ubtSetRobotLED(char *pcType, char *pcColor, char *pcMode);
 extern UBTEDU_RC_T ubtStartRobotAction(char *pcName, int iRepeat);
+extern UBTEDU_RC_T ubtStartRobotActionAsync(char *pcName, int iRepeat);
+extern UBTEDU_RC_T ubtSetActionCallback(UBTEDU_ACTION_DONE_CB pfnDone, void *pArg);
+extern int ubtGetActionEventFd(void);
 extern UBTEDU_RC_T ubtStopRobotAction(void);
+extern UBTEDU_RC_T ubtPauseRobotAction(void);
+extern UBTEDU_RC_T ubtContinueRobotAction(void);
+extern UBTEDU_RC_T ubtResetRobotAction(void);
+extern UBTEDU_RC_T ubtActionQueueAdd(char *pcName, int iRepeat, int *piId);
+extern UBTEDU_RC_T ubtActionQueueRemove(int iId);
+extern UBTEDU_RC_T ubtActionQueueMove(int iId, int iIndex);
+extern UBTEDU_RC_T ubtActionQueueClear(void);
+extern UBTEDU_RC_T ubtActionQueueGetStatus(UBTEDU_ACTION_QUEUE_STATUS_T *pstStatus);
+extern UBTEDU_RC_T ubtGetActionInfo(char *pcPath, UBTEDU_ACTION_INFO_T *pstInfo);
+extern UBTEDU_RC_T ubtCompressAction(char *pcIn, char *pcOut, int iMaxError, UBTEDU_COMPRESS_STATS_T *pstStats);
 extern UBTEDU_RC_T ubtVoiceStart();
 extern UBTEDU_RC_T ubtVoiceStop();
 extern UBTEDU_RC_T ubtVoiceTTS(int isInterrputed, char *pcTTS);
@@ -223,14 +413,64 @@ extern UBTEDU_RC_T ubtCheckAPPStatus(char *pcBuf, int iWaitTime);
 extern UBTEDU_RC_T ubtDetectVoiceMsg(char *pcBuf, int iTimeout);
 extern UBTEDU_RC_T ubtRecordMotion(UBTEDU_ROBOTSERVO_T *servoAngle);
 extern UBTEDU_RC_T ubtGetRobotServo(UBTEDU_ROBOTSERVO_T *servoAngle);
+extern UBTEDU_RC_T ubtGetRobotServoCached(UBTEDU_ROBOTSERVO_T *servoAngle, int iMaxAgeMs);
+extern UBTEDU_RC_T ubtServoShadowGetStats(UBTEDU_SERVO_SHADOW_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtServoShadowSetRefresh(int iPeriodMs);
 extern UBTEDU_RC_T ubtSetRobotServo(UBTEDU_ROBOTSERVO_T *servoAngle, int iTime);
+extern UBTEDU_RC_T ubtSetServos(const uint8_t angles[17], uint32_t mask, int time);
+extern UBTEDU_RC_T ubtServoStreamStart(int iRateHz, UBTEDU_SERVO_INTERP_e eInterp);
+extern UBTEDU_RC_T ubtServoStreamPush(const uint8_t angles[17], int iTimeMs);
+extern UBTEDU_RC_T ubtServoStreamStop(void);
+extern UBTEDU_RC_T ubtServoStreamGetStats(UBTEDU_SERVO_STREAM_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtServoSetLimit(int iServo, int iMaxVel, int iMaxAcc);
+extern UBTEDU_RC_T ubtServoProfileExport(const uint8_t from[17], const uint8_t to[17], UBTEDU_SERVO_INTERP_e eInterp, int iTimeMs, char *pcPath);
+extern UBTEDU_RC_T ubtCaptureStart(int iRateHz, int iMaxSeconds);
+extern UBTEDU_RC_T ubtCaptureStop(void);
+extern UBTEDU_RC_T ubtCaptureGetStats(UBTEDU_CAPTURE_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtCaptureExport(char *pcPath, int iTolerance, UBTEDU_COMPRESS_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtGetLimbPose(UBTEDU_ROBOT_LIMB_e eLimb, int iMaxAgeMs, UBTEDU_LIMB_POSE_T *pstPose);
+extern UBTEDU_RC_T ubtComputeLimbPoses(UBTEDU_ROBOT_LIMB_e eLimb, const uint8_t *angles, int iNum, UBTEDU_LIMB_POSE_T *pstPose);
+extern UBTEDU_RC_T ubtSolveLimbIK(UBTEDU_ROBOT_LIMB_e eLimb, float fX, float fY, float fZ, uint8_t angles[17]);
+extern UBTEDU_RC_T ubtSetServoRange(int iServo, int iMin, int iMax);
+extern UBTEDU_RC_T ubtSetCollisionCheck(int iEnable);
+extern UBTEDU_RC_T ubtGetSafetyStats(UBTEDU_SAFETY_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtGetServoOffsets(int8_t offsets[17]);
+extern UBTEDU_RC_T ubtSetServoOffsetEnable(int iEnable);
+extern UBTEDU_RC_T ubtGaitStart(const UBTEDU_GAIT_PARAM_T *pstParam);
+extern UBTEDU_RC_T ubtGaitSetParam(const UBTEDU_GAIT_PARAM_T *pstParam);
+extern UBTEDU_RC_T ubtGaitStop(void);
+extern UBTEDU_RC_T ubtGaitExport(const UBTEDU_GAIT_PARAM_T *pstParam, int iSteps, char *pcPath);
+extern UBTEDU_RC_T ubtBalanceStart(const UBTEDU_BALANCE_PARAM_T *pstParam);
+extern UBTEDU_RC_T ubtBalanceStop(void);
+extern UBTEDU_RC_T ubtBalanceGetStats(UBTEDU_BALANCE_STATS_T *pstStats);
 extern UBTEDU_RC_T ubtSetRobotVolume(int iVolume);
 extern UBTEDU_RC_T ubtSetRobotMotion(char *pcType, char *pcDirect, int iSpeed, int iRepeat);
 extern UBTEDU_RC_T ubtReadSensorValue(char *pcSensorType, void *pValue, int iValueLen);
 extern UBTEDU_RC_T ubtReadSensorValueByAddr(char *pcSensorType, int iAddr, void *pValue, int iValueLen);
+extern UBTEDU_RC_T ubtReadSensors(const char *apcType[], void *apValue[], int iNum, UBTEDU_RC_T aeResult[]);
+extern UBTEDU_RC_T ubtSubscribeSensors(char *apcType[], int iNum, int iRateHz, UBTEDU_SENSOR_CB pfnSample, void *pArg);
+extern UBTEDU_RC_T ubtUnsubscribeSensors(void);
+extern UBTEDU_RC_T ubtReadSensorSamples(UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax, int *piNum);
+extern UBTEDU_RC_T ubtGetSensorSubStats(UBTEDU_SENSOR_SUB_STATS_T *pstStats);
+extern UBTEDU_RC_T ubtGetSensorLatest(char *pcSensorType, UBTEDU_SENSOR_SAMPLE_T *pstSample);
+extern UBTEDU_RC_T ubtGetSensorHistory(char *pcSensorType, unsigned long long ullFromUs, unsigned long long ullToUs,
+        UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax, int *piNum);
 extern UBTEDU_RC_T ubtSetRobotLED(char *pcType, char *pcColor, char *pcMode);
 extern UBTEDU_RC_T ubtStartRobotAction(char *pcName, int iRepeat);
+extern UBTEDU_RC_T ubtStartRobotActionAsync(char *pcName, int iRepeat);
+extern UBTEDU_RC_T ubtSetActionCallback(UBTEDU_ACTION_DONE_CB pfnDone, void *pArg);
+extern int ubtGetActionEventFd(void);
 extern UBTEDU_RC_T ubtStopRobotAction(void);
+extern UBTEDU_RC_T ubtPauseRobotAction(void);
+extern UBTEDU_RC_T ubtContinueRobotAction(void);
+extern UBTEDU_RC_T ubtResetRobotAction(void);
+extern UBTEDU_RC_T ubtActionQueueAdd(char *pcName, int iRepeat, int *piId);
+extern UBTEDU_RC_T ubtActionQueueRemove(int iId);
+extern UBTEDU_RC_T ubtActionQueueMove(int iId, int iIndex);
+extern UBTEDU_RC_T ubtActionQueueClear(void);
+extern UBTEDU_RC_T ubtActionQueueGetStatus(UBTEDU_ACTION_QUEUE_STATUS_T *pstStatus);
+extern UBTEDU_RC_T ubtGetActionInfo(char *pcPath, UBTEDU_ACTION_INFO_T *pstInfo);
+extern UBTEDU_RC_T ubtCompressAction(char *pcIn, char *pcOut, int iMaxError, UBTEDU_COMPRESS_STATS_T *pstStats);
 extern UBTEDU_RC_T ubtVoiceStart();
 extern UBTEDU_RC_T ubtVoiceStop();
 extern UBTEDU_RC_T ubtVoiceTTS(int isInterrputed, char *pcTTS);
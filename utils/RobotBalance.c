@@ -0,0 +1,109 @@
+/**
+ * @file				RobotBalance.c
+ * @brief			Balance control of the legs from the IMU
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * With the feet flat on the ground, turning the leg joints by an angle
+ * turns the body back by the same angle. A PD law on the tilt and its
+ * speed gives that angle for each axis, which is shared between the
+ * ankles and the hips. The servo offsets follow the joint signs of
+ * RobotKinematics.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+
+#include "RobotKinematics.h"
+#include "RobotBalance.h"
+
+
+/* Leg joints, in the order of the kinematic chain */
+#define ROBOT_BALANCE_HIP_ROLL         (0)
+#define ROBOT_BALANCE_HIP_PITCH        (1)
+#define ROBOT_BALANCE_ANKLE_PITCH      (3)
+#define ROBOT_BALANCE_ANKLE_ROLL       (4)
+
+
+static float _RobotBalanceClamp(float fValue, float fMax)
+{
+    return (fValue > fMax) ? fMax : ((fValue < -fMax) ? -fMax : fValue);
+}
+
+/**
+ * @brief:      RobotBalanceInit
+ * @details:    Check the gains and start without correction
+ * @param[in]   ROBOT_BALANCE_GAIN_T *pstGain
+ * @param[out]  ROBOT_BALANCE_T *pstBalance
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotBalanceInit(ROBOT_BALANCE_T *pstBalance, const ROBOT_BALANCE_GAIN_T *pstGain)
+{
+    if ((NULL == pstBalance) || (NULL == pstGain)
+        || (fabsf(pstGain->fKp) > ROBOT_BALANCE_MAX_KP) || (fabsf(pstGain->fKd) > ROBOT_BALANCE_MAX_KD)
+        || (pstGain->fHipRatio < 0.0f) || (pstGain->fHipRatio > 1.0f)
+        || (pstGain->fMaxCorrection < 0.0f) || (pstGain->fMaxCorrection > 90.0f))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    memset(pstBalance, 0, sizeof(ROBOT_BALANCE_T));
+    pstBalance->stGain = *pstGain;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotBalanceUpdate
+ * @details:    Compute the corrections for a new IMU sample. A robot tilted
+ *              past ROBOT_BALANCE_MAX_TILT is left alone.
+ * @param[in]   ROBOT_BALANCE_IMU_T *pstImu
+ * @param[out]  ROBOT_BALANCE_T *pstBalance
+ * @retval:     void
+ */
+void RobotBalanceUpdate(ROBOT_BALANCE_T *pstBalance, const ROBOT_BALANCE_IMU_T *pstImu)
+{
+    const ROBOT_BALANCE_GAIN_T *pstGain = &pstBalance->stGain;
+    const ROBOT_KIN_CHAIN_T *pstChain;
+    const ROBOT_KIN_JOINT_T *pstJoint;
+    float fAnkle = 1.0f - pstGain->fHipRatio;
+    int i;
+
+    if ((fabsf(pstImu->fPitch) > ROBOT_BALANCE_MAX_TILT) || (fabsf(pstImu->fRoll) > ROBOT_BALANCE_MAX_TILT))
+    {
+        pstBalance->fPitch = 0.0f;
+        pstBalance->fRoll = 0.0f;
+    }
+    else
+    {
+        pstBalance->fPitch = _RobotBalanceClamp(pstGain->fKp * pstImu->fPitch + pstGain->fKd * pstImu->fPitchRate,
+                                                pstGain->fMaxCorrection);
+        pstBalance->fRoll = _RobotBalanceClamp(pstGain->fKp * pstImu->fRoll + pstGain->fKd * pstImu->fRollRate,
+                                               pstGain->fMaxCorrection);
+    }
+
+    for (i = ROBOT_KIN_CHAIN_LEFT_LEG; i <= ROBOT_KIN_CHAIN_RIGHT_LEG; i++)
+    {
+        pstChain = RobotKinGetChain(i);
+        pstJoint = pstChain->astJoint;
+        pstBalance->afOffset[pstJoint[ROBOT_BALANCE_HIP_PITCH].iServo] =
+            pstGain->fHipRatio * pstBalance->fPitch * pstJoint[ROBOT_BALANCE_HIP_PITCH].fSign;
+        pstBalance->afOffset[pstJoint[ROBOT_BALANCE_ANKLE_PITCH].iServo] =
+            fAnkle * pstBalance->fPitch * pstJoint[ROBOT_BALANCE_ANKLE_PITCH].fSign;
+        pstBalance->afOffset[pstJoint[ROBOT_BALANCE_HIP_ROLL].iServo] =
+            pstGain->fHipRatio * pstBalance->fRoll * pstJoint[ROBOT_BALANCE_HIP_ROLL].fSign;
+        pstBalance->afOffset[pstJoint[ROBOT_BALANCE_ANKLE_ROLL].iServo] =
+            fAnkle * pstBalance->fRoll * pstJoint[ROBOT_BALANCE_ANKLE_ROLL].fSign;
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * @file				RobotBalance.h
+ * @brief			RobotBalance.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTBALANCE_H__
+#define __ROBOTBALANCE_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Tilt from which the robot is taken as fallen and not corrected, in degree */
+#define ROBOT_BALANCE_MAX_TILT         (30.0f)
+/* Gain ranges */
+#define ROBOT_BALANCE_MAX_KP           (10.0f)
+#define ROBOT_BALANCE_MAX_KD           (1.0f)
+
+
+/* Body tilt, x forward, y left, z up. A positive pitch leans forward, a
+   positive roll leans right. */
+typedef struct {
+    float fPitch;                   /* In degree */
+    float fRoll;
+    float fPitchRate;               /* In degree/s */
+    float fRollRate;
+} ROBOT_BALANCE_IMU_T;
+
+typedef struct {
+    float fKp;                      /* Correction per degree of tilt */
+    float fKd;                      /* Correction per degree/s of tilt speed */
+    float fHipRatio;                /* Part of the correction made by the hips, the rest by the ankles */
+    float fMaxCorrection;           /* In degree */
+} ROBOT_BALANCE_GAIN_T;
+
+typedef struct {
+    ROBOT_BALANCE_GAIN_T stGain;
+    float fPitch;                   /* Leg rotation which brings the body back, in degree */
+    float fRoll;
+    float afOffset[MAX_SERVO_NUM];  /* Added to the commanded servo angles */
+} ROBOT_BALANCE_T;
+
+
+extern UBTEDU_RC_T RobotBalanceInit(ROBOT_BALANCE_T *pstBalance, const ROBOT_BALANCE_GAIN_T *pstGain);
+extern void RobotBalanceUpdate(ROBOT_BALANCE_T *pstBalance, const ROBOT_BALANCE_IMU_T *pstImu);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTBALANCE_H__ */
@@ -0,0 +1,176 @@
+/**
+ * @file				RobotCapture.c
+ * @brief			Servo angle capture ring and its export to HTS
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * The ring has one producer, the capture thread, and one consumer. Each
+ * side only writes its own index, published with release ordering, so
+ * neither side takes a lock. A full ring drops the new sample.
+ *
+ * Exported frames keep the capture's timing. With a tolerance, the
+ * samples the servos would pass within the tolerance while gliding
+ * between the kept ones are dropped, see RobotSimplify.c.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+
+#include "RobotHts.h"
+#include "RobotSimplify.h"
+#include "RobotCapture.h"
+
+
+/**
+ * @brief:      RobotCaptureCreate
+ * @details:    Allocate a ring of at least uiMinSize samples
+ * @param[in]   unsigned int uiMinSize
+ * @param[out]  ROBOT_CAPTURE_T *pstCapture
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotCaptureCreate(ROBOT_CAPTURE_T *pstCapture, unsigned int uiMinSize)
+{
+    unsigned int uiSize = 1;
+
+    if ((NULL == pstCapture) || (0 == uiMinSize) || (uiMinSize > 0x100000))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    while (uiSize < uiMinSize)
+    {
+        uiSize <<= 1;
+    }
+
+    memset(pstCapture, 0, sizeof(ROBOT_CAPTURE_T));
+    pstCapture->pstSample = calloc(uiSize, sizeof(ROBOT_CAPTURE_SAMPLE_T));
+    if (NULL == pstCapture->pstSample)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+    pstCapture->uiSize = uiSize;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotCaptureDestroy
+ * @details:    Release the ring
+ * @param[in]   ROBOT_CAPTURE_T *pstCapture
+ * @param[out]  None
+ * @retval:     void
+ */
+void RobotCaptureDestroy(ROBOT_CAPTURE_T *pstCapture)
+{
+    if (NULL == pstCapture)
+    {
+        return;
+    }
+    free(pstCapture->pstSample);
+    memset(pstCapture, 0, sizeof(ROBOT_CAPTURE_T));
+}
+
+/**
+ * @brief:      RobotCapturePush
+ * @details:    Add a sample, from the producer only
+ * @param[in]   ROBOT_CAPTURE_SAMPLE_T *pstSample
+ * @param[out]  ROBOT_CAPTURE_T *pstCapture
+ * @retval:     1 when it was added, 0 when the ring is full
+ */
+int RobotCapturePush(ROBOT_CAPTURE_T *pstCapture, const ROBOT_CAPTURE_SAMPLE_T *pstSample)
+{
+    unsigned int uiHead = pstCapture->uiHead;
+
+    if (uiHead - __atomic_load_n(&pstCapture->uiTail, __ATOMIC_ACQUIRE) >= pstCapture->uiSize)
+    {
+        __atomic_add_fetch(&pstCapture->uiDropped, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    pstCapture->pstSample[uiHead & (pstCapture->uiSize - 1)] = *pstSample;
+    __atomic_store_n(&pstCapture->uiHead, uiHead + 1, __ATOMIC_RELEASE);
+
+    return 1;
+}
+
+/**
+ * @brief:      RobotCaptureRead
+ * @details:    Take the oldest samples, from the consumer only
+ * @param[in]   int iMax
+ * @param[out]  ROBOT_CAPTURE_SAMPLE_T *pstSample
+ * @param[out]  ROBOT_CAPTURE_T *pstCapture
+ * @retval:     Number of samples taken
+ */
+int RobotCaptureRead(ROBOT_CAPTURE_T *pstCapture, ROBOT_CAPTURE_SAMPLE_T *pstSample, int iMax)
+{
+    unsigned int uiTail = pstCapture->uiTail;
+    unsigned int uiHead = __atomic_load_n(&pstCapture->uiHead, __ATOMIC_ACQUIRE);
+    int iNum = 0;
+
+    while ((uiTail != uiHead) && (iNum < iMax))
+    {
+        pstSample[iNum++] = pstCapture->pstSample[uiTail & (pstCapture->uiSize - 1)];
+        uiTail++;
+    }
+    __atomic_store_n(&pstCapture->uiTail, uiTail, __ATOMIC_RELEASE);
+
+    return iNum;
+}
+
+/**
+ * @brief:      RobotCaptureBuildHts
+ * @details:    Build the HTS file of captured samples, on the capture's
+ *              timing. Samples the servos would pass anyway on their way
+ *              between the kept ones are dropped.
+ * @param[in]   ROBOT_CAPTURE_SAMPLE_T *pstSample
+ * @param[in]   int iNum
+ * @param[in]   int iTolerance     Degrees a dropped sample may be off, 0 keeps every sample
+ * @param[out]  ROBOT_HTS_T *pstHts   Created here, released by the caller
+ * @param[out]  ROBOT_SIMPLIFY_STATS_T *pstStats   May be NULL
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotCaptureBuildHts(const ROBOT_CAPTURE_SAMPLE_T *pstSample, int iNum,
+        int iTolerance, ROBOT_HTS_T *pstHts, ROBOT_SIMPLIFY_STATS_T *pstStats)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    ROBOT_SIMPLIFY_FRAME_T *pstFrame;
+    int i, j;
+
+    if ((NULL == pstSample) || (iNum <= 0) || (iTolerance < 0) || (NULL == pstHts))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pstFrame = malloc(iNum * sizeof(ROBOT_SIMPLIFY_FRAME_T));
+    if (NULL == pstFrame)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+    for (i = 0; i < iNum; i++)
+    {
+        pstFrame[i].fTimeMs = ROBOT_CAPTURE_FIRST_TIME * ROBOT_HTS_TIME_UNIT
+                              + (pstSample[i].ullTimeUs - pstSample[0].ullTimeUs) / 1000.0f;
+        memset(pstFrame[i].aucAngle, 0xff, sizeof(pstFrame[i].aucAngle));
+        for (j = 0; j < MAX_SERVO_NUM; j++)
+        {
+            if (0 != pstSample[i].aucAngle[j])
+            {
+                pstFrame[i].aucAngle[j] = pstSample[i].aucAngle[j];
+            }
+        }
+    }
+
+    ubtRet = RobotSimplifyBuildHts(pstFrame, iNum, (0 == iTolerance) ? -1.0f : (float)iTolerance,
+                                   pstHts, pstStats);
+    free(pstFrame);
+
+    return ubtRet;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file				RobotCapture.h
+ * @brief			RobotCapture.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTCAPTURE_H__
+#define __ROBOTCAPTURE_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Time of the first exported frame, moving from any pose to the capture, in ROBOT_HTS_TIME_UNIT */
+#define ROBOT_CAPTURE_FIRST_TIME       (25)
+
+
+typedef struct {
+    unsigned long long ullTimeUs;               /* Monotonic time of the sample */
+    unsigned char aucAngle[MAX_SERVO_NUM];      /* 0 when the servo could not be read */
+} ROBOT_CAPTURE_SAMPLE_T;
+
+typedef struct {
+    ROBOT_CAPTURE_SAMPLE_T *pstSample;
+    unsigned int uiSize;                        /* Power of 2 */
+    unsigned int uiHead;                        /* Samples written, only by the producer */
+    unsigned int uiTail;                        /* Samples read, only by the consumer */
+    unsigned int uiDropped;                     /* Samples lost because the ring was full */
+} ROBOT_CAPTURE_T;
+
+
+extern UBTEDU_RC_T RobotCaptureCreate(ROBOT_CAPTURE_T *pstCapture, unsigned int uiMinSize);
+extern void RobotCaptureDestroy(ROBOT_CAPTURE_T *pstCapture);
+extern int RobotCapturePush(ROBOT_CAPTURE_T *pstCapture, const ROBOT_CAPTURE_SAMPLE_T *pstSample);
+extern int RobotCaptureRead(ROBOT_CAPTURE_T *pstCapture, ROBOT_CAPTURE_SAMPLE_T *pstSample, int iMax);
+extern UBTEDU_RC_T RobotCaptureBuildHts(const ROBOT_CAPTURE_SAMPLE_T *pstSample, int iNum,
+        int iTolerance, ROBOT_HTS_T *pstHts, ROBOT_SIMPLIFY_STATS_T *pstStats);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTCAPTURE_H__ */
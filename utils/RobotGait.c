@@ -0,0 +1,337 @@
+/**
+ * @file				RobotGait.c
+ * @brief			Parametric walking gait of the legs
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * The gait is planned as foot positions under the hips: the stance foot
+ * slides back at a constant speed, the swing foot is lifted and brought
+ * forward, and the body sways over the stance foot. There is no hip yaw,
+ * a turn makes the inner strides shorter than the outer ones. The leg
+ * servo angles come from the leg geometry of RobotKinematics, with the
+ * ankles keeping the feet flat.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+
+#include "RobotHts.h"
+#include "RobotKinematics.h"
+#include "RobotGait.h"
+
+
+#define ROBOT_GAIT_PI                  (3.14159265f)
+#define ROBOT_GAIT_RAD2DEG             (180.0f / ROBOT_GAIT_PI)
+/* Leg joints, in the order of the kinematic chain */
+#define ROBOT_GAIT_HIP_ROLL            (0)
+#define ROBOT_GAIT_HIP_PITCH           (1)
+#define ROBOT_GAIT_KNEE                (2)
+#define ROBOT_GAIT_ANKLE_PITCH         (3)
+#define ROBOT_GAIT_ANKLE_ROLL          (4)
+
+
+static const ROBOT_KIN_CHAIN_e g_aeGaitLeg[2] = {ROBOT_KIN_CHAIN_LEFT_LEG, ROBOT_KIN_CHAIN_RIGHT_LEG};
+
+
+/* Servo angle which turns a joint by fRad */
+static unsigned char _RobotGaitServo(const ROBOT_KIN_JOINT_T *pstJoint, float fRad)
+{
+    float fAngle = pstJoint->fZero + fRad * ROBOT_GAIT_RAD2DEG * pstJoint->fSign;
+
+    fAngle = (fAngle < ROBOT_KIN_MIN_ANGLE) ? ROBOT_KIN_MIN_ANGLE :
+             ((fAngle > ROBOT_KIN_MAX_ANGLE) ? ROBOT_KIN_MAX_ANGLE : fAngle);
+
+    return (unsigned char)(fAngle + 0.5f);
+}
+
+/* Leg servos which put the ankle at fX forward, fY left and fZ up of the hip */
+static void _RobotGaitLeg(ROBOT_KIN_CHAIN_e eChain, float fX, float fY, float fZ, unsigned char *pucAngle)
+{
+    const ROBOT_KIN_CHAIN_T *pstChain = RobotKinGetChain(eChain);
+    const ROBOT_KIN_JOINT_T *pstJoint = pstChain->astJoint;
+    float fThigh = -pstJoint[ROBOT_GAIT_HIP_PITCH].afLink[2];
+    float fShin = -pstJoint[ROBOT_GAIT_KNEE].afLink[2];
+    float fRoll, fHeight, fDist, fLean, fThighRad, fShinRad;
+
+    /* The roll tilts the plane of the leg, the pitch joints work in it */
+    fRoll = atan2f(fY, -fZ);
+    fHeight = sqrtf(fY * fY + fZ * fZ);
+    fDist = sqrtf(fX * fX + fHeight * fHeight);
+    if (fDist > fThigh + fShin - 1.0f)
+    {
+        fDist = fThigh + fShin - 1.0f;
+    }
+    fLean = atan2f(fX, fHeight);
+    fThighRad = acosf((fThigh * fThigh + fDist * fDist - fShin * fShin) / (2.0f * fThigh * fDist));
+    fShinRad = acosf((fShin * fShin + fDist * fDist - fThigh * fThigh) / (2.0f * fShin * fDist));
+
+    /* A turn around y which grows moves the foot back, the knee bends back */
+    pucAngle[pstJoint[ROBOT_GAIT_HIP_ROLL].iServo] = _RobotGaitServo(&pstJoint[ROBOT_GAIT_HIP_ROLL], fRoll);
+    pucAngle[pstJoint[ROBOT_GAIT_HIP_PITCH].iServo] =
+        _RobotGaitServo(&pstJoint[ROBOT_GAIT_HIP_PITCH], -(fLean + fThighRad));
+    pucAngle[pstJoint[ROBOT_GAIT_KNEE].iServo] = _RobotGaitServo(&pstJoint[ROBOT_GAIT_KNEE], fThighRad + fShinRad);
+    pucAngle[pstJoint[ROBOT_GAIT_ANKLE_PITCH].iServo] =
+        _RobotGaitServo(&pstJoint[ROBOT_GAIT_ANKLE_PITCH], fLean - fShinRad);
+    pucAngle[pstJoint[ROBOT_GAIT_ANKLE_ROLL].iServo] = _RobotGaitServo(&pstJoint[ROBOT_GAIT_ANKLE_ROLL], -fRoll);
+}
+
+/* Start the next step with the parameters waiting for it */
+static void _RobotGaitStep(ROBOT_GAIT_T *pstGait)
+{
+    const ROBOT_KIN_CHAIN_T *pstLeft = RobotKinGetChain(ROBOT_KIN_CHAIN_LEFT_LEG);
+    const ROBOT_KIN_CHAIN_T *pstRight = RobotKinGetChain(ROBOT_KIN_CHAIN_RIGHT_LEG);
+    float afStride[2], fTurn;
+    int iStance;
+
+    pstGait->stParam = pstGait->stNext;
+    pstGait->afStart[0] = pstGait->afEnd[0];
+    pstGait->afStart[1] = pstGait->afEnd[1];
+    pstGait->iSwing ^= 1;
+    iStance = pstGait->iSwing ^ 1;
+
+    /* Turning left, the left foot goes a shorter way than the right one */
+    fTurn = pstGait->stParam.fTurn / ROBOT_GAIT_RAD2DEG * (pstLeft->afBase[1] - pstRight->afBase[1]) / 2.0f;
+    afStride[0] = pstGait->stParam.fStepLength - fTurn;
+    afStride[1] = pstGait->stParam.fStepLength + fTurn;
+
+    /* The swing foot lands ahead of its hip, the stance foot ends behind */
+    pstGait->afEnd[pstGait->iSwing] = afStride[pstGait->iSwing] / 2.0f;
+    pstGait->afEnd[iStance] = -afStride[iStance] / 2.0f;
+    pstGait->iStanding = (0.0f == pstGait->afStart[0]) && (0.0f == pstGait->afStart[1])
+                         && (0.0f == pstGait->afEnd[0]) && (0.0f == pstGait->afEnd[1]);
+    pstGait->uiSteps += !pstGait->iStanding;
+}
+
+/**
+ * @brief:      RobotGaitInit
+ * @details:    Stand still, until RobotGaitSetParam() gives a stride or a turn
+ * @param[in]   None
+ * @param[out]  ROBOT_GAIT_T *pstGait
+ * @retval:     void
+ */
+void RobotGaitInit(ROBOT_GAIT_T *pstGait)
+{
+    memset(pstGait, 0, sizeof(ROBOT_GAIT_T));
+    pstGait->stParam.fStepMs = ROBOT_GAIT_MIN_STEP_MS * 2.0f;
+    pstGait->stNext = pstGait->stParam;
+    pstGait->iSwing = 1;
+    pstGait->iStanding = 1;
+}
+
+/**
+ * @brief:      RobotGaitSetParam
+ * @details:    Change the gait from the next step on. A stride and turn of
+ *              0 brings the feet together and stops.
+ * @param[in]   ROBOT_GAIT_PARAM_T *pstParam
+ * @param[out]  ROBOT_GAIT_T *pstGait
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotGaitSetParam(ROBOT_GAIT_T *pstGait, const ROBOT_GAIT_PARAM_T *pstParam)
+{
+    if ((NULL == pstGait) || (NULL == pstParam)
+        || (fabsf(pstParam->fStepLength) > ROBOT_GAIT_MAX_STEP) || (fabsf(pstParam->fTurn) > ROBOT_GAIT_MAX_TURN)
+        || (pstParam->fStepMs < ROBOT_GAIT_MIN_STEP_MS) || (pstParam->fStepMs > ROBOT_GAIT_MAX_STEP_MS))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pstGait->stNext = *pstParam;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotGaitNext
+ * @details:    Move the gait on by fDtMs and get the leg servos. A standing
+ *              gait starts its first step as soon as it is given a stride
+ *              or a turn.
+ * @param[in]   float fDtMs
+ * @param[out]  ROBOT_GAIT_T *pstGait
+ * @param[out]  unsigned char *pucAngle    MAX_SERVO_NUM angles, only the leg servos are set
+ * @retval:     void
+ */
+void RobotGaitNext(ROBOT_GAIT_T *pstGait, float fDtMs, unsigned char *pucAngle)
+{
+    float afX[2], afZ[2], fPhase, fSmooth, fSway;
+    int i, iStance;
+
+    if (pstGait->iStanding)
+    {
+        pstGait->fTimeMs = 0.0f;
+        if ((0.0f != pstGait->stNext.fStepLength) || (0.0f != pstGait->stNext.fTurn))
+        {
+            _RobotGaitStep(pstGait);
+        }
+    }
+    else
+    {
+        pstGait->fTimeMs += fDtMs;
+        while (pstGait->fTimeMs >= pstGait->stParam.fStepMs)
+        {
+            pstGait->fTimeMs -= pstGait->stParam.fStepMs;
+            _RobotGaitStep(pstGait);
+            if (pstGait->iStanding)
+            {
+                pstGait->fTimeMs = 0.0f;
+                break;
+            }
+        }
+    }
+
+    fPhase = pstGait->fTimeMs / pstGait->stParam.fStepMs;
+    fSmooth = (1.0f - cosf(ROBOT_GAIT_PI * fPhase)) / 2.0f;
+    iStance = pstGait->iSwing ^ 1;
+    afX[iStance] = pstGait->afStart[iStance] + (pstGait->afEnd[iStance] - pstGait->afStart[iStance]) * fPhase;
+    afX[pstGait->iSwing] = pstGait->afStart[pstGait->iSwing]
+                           + (pstGait->afEnd[pstGait->iSwing] - pstGait->afStart[pstGait->iSwing]) * fSmooth;
+    afZ[iStance] = -ROBOT_GAIT_HEIGHT;
+    afZ[pstGait->iSwing] = -ROBOT_GAIT_HEIGHT;
+    fSway = 0.0f;
+    if (!pstGait->iStanding)
+    {
+        afZ[pstGait->iSwing] += ROBOT_GAIT_LIFT * sinf(ROBOT_GAIT_PI * fPhase);
+        /* The body goes over the stance foot, which is left of it for the left leg */
+        fSway = ROBOT_GAIT_SWAY * sinf(ROBOT_GAIT_PI * fPhase) * ((0 == iStance) ? 1.0f : -1.0f);
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        _RobotGaitLeg(g_aeGaitLeg[i], afX[i], -fSway, afZ[i], pucAngle);
+    }
+}
+
+/**
+ * @brief:      RobotGaitIsStanding
+ * @details:    Whether the feet are together and no step is going on
+ * @param[in]   ROBOT_GAIT_T *pstGait
+ * @param[out]  None
+ * @retval:     int
+ */
+int RobotGaitIsStanding(const ROBOT_GAIT_T *pstGait)
+{
+    return pstGait->iStanding;
+}
+
+/**
+ * @brief:      _RobotGaitSampleHts
+ * @details:    Sample the steps from standing back to standing into the
+ *              frames of an HTS, or only count the frames without pstHts
+ * @param[in]   ROBOT_GAIT_PARAM_T *pstParam
+ * @param[in]   int iSteps
+ * @param[in]   int iFrameMs
+ * @param[in]   int iTotalFrame   Frames of pstHts
+ * @param[out]  ROBOT_HTS_T *pstHts   May be NULL
+ * @param[out]  int *piNum        Frames sampled
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _RobotGaitSampleHts(const ROBOT_GAIT_PARAM_T *pstParam, int iSteps, int iFrameMs,
+        ROBOT_HTS_T *pstHts, int iTotalFrame, int *piNum)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_SUCCESS;
+    ROBOT_GAIT_PARAM_T stStop;
+    ROBOT_GAIT_T stGait;
+    unsigned char aucSample[MAX_SERVO_NUM];
+    unsigned char aucAngle[ROBOT_HTS_ANGLE_NUM];
+    int i, iNum = 0;
+
+    stStop = *pstParam;
+    stStop.fStepLength = 0.0f;
+    stStop.fTurn = 0.0f;
+    RobotGaitInit(&stGait);
+    RobotGaitSetParam(&stGait, pstParam);
+    memset(aucSample, 0, sizeof(aucSample));
+    do
+    {
+        RobotGaitNext(&stGait, (0 == iNum) ? 0.0f : (float)iFrameMs, aucSample);
+        if (stGait.uiSteps >= (unsigned int)iSteps)
+        {
+            /* The last step brings the feet together */
+            RobotGaitSetParam(&stGait, &stStop);
+        }
+        iNum++;
+        if (NULL != pstHts)
+        {
+            memset(aucAngle, 0xff, sizeof(aucAngle));
+            for (i = 0; i < MAX_SERVO_NUM; i++)
+            {
+                if (0 != aucSample[i])
+                {
+                    aucAngle[i] = aucSample[i];
+                }
+            }
+            ubtRet = RobotHtsSetAngles(pstHts, iNum, iTotalFrame, aucAngle, iFrameMs / ROBOT_HTS_TIME_UNIT);
+        }
+    }
+    while ((UBTEDU_RC_SUCCESS == ubtRet) && !stGait.iStanding && (iNum < 0xffff));
+
+    *piNum = iNum;
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      RobotGaitBuildHts
+ * @details:    Sample iSteps steps into an HTS action, from standing and
+ *              with one more step to stand again, one frame every
+ *              iFrameMs. The HTS is created here and must be destroyed by
+ *              the caller.
+ * @param[in]   ROBOT_GAIT_PARAM_T *pstParam   With a stride or a turn
+ * @param[in]   int iSteps       1 or more
+ * @param[in]   int iFrameMs     A multiple of ROBOT_HTS_TIME_UNIT
+ * @param[out]  ROBOT_HTS_T *pstHts
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotGaitBuildHts(const ROBOT_GAIT_PARAM_T *pstParam, int iSteps, int iFrameMs, ROBOT_HTS_T *pstHts)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    ROBOT_GAIT_T stGait;
+    int iNum;
+
+    if ((NULL == pstParam) || (NULL == pstHts) || (iSteps < 1)
+        || (iFrameMs < ROBOT_HTS_TIME_UNIT) || (0 != iFrameMs % ROBOT_HTS_TIME_UNIT)
+        || ((0.0f == pstParam->fStepLength) && (0.0f == pstParam->fTurn)))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    RobotGaitInit(&stGait);
+    ubtRet = RobotGaitSetParam(&stGait, pstParam);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    _RobotGaitSampleHts(pstParam, iSteps, iFrameMs, NULL, 0, &iNum);
+    if (iNum >= 0xffff)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+
+    ubtRet = RobotHtsCreate(pstHts, iNum);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    ubtRet = _RobotGaitSampleHts(pstParam, iSteps, iFrameMs, pstHts, iNum, &iNum);
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = RobotHtsFinish(pstHts, iNum, iNum * iFrameMs);
+    }
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        RobotHtsDestroy(pstHts);
+    }
+
+    return ubtRet;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file				RobotGait.h
+ * @brief			RobotGait.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTGAIT_H__
+#define __ROBOTGAIT_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Parameter ranges */
+#define ROBOT_GAIT_MAX_STEP            (60.0f)     /* Stride of one step, in mm */
+#define ROBOT_GAIT_MAX_TURN            (20.0f)     /* Turn of one step, in degree */
+#define ROBOT_GAIT_MIN_STEP_MS         (300.0f)
+#define ROBOT_GAIT_MAX_STEP_MS         (2000.0f)
+/* Hip above ankle while walking, foot lift and body sway, in mm */
+#define ROBOT_GAIT_HEIGHT              (110.0f)
+#define ROBOT_GAIT_LIFT                (20.0f)
+#define ROBOT_GAIT_SWAY                (15.0f)
+
+
+typedef struct {
+    float fStepLength;              /* Forward stride of one step, in mm, negative walks back */
+    float fTurn;                    /* Turn of one step, in degree, positive turns left */
+    float fStepMs;                  /* Time of one step */
+} ROBOT_GAIT_PARAM_T;
+
+/* The legs take turns, each step swings one foot forward while the other
+   one pushes the body. New parameters are taken at the next step. */
+typedef struct {
+    ROBOT_GAIT_PARAM_T stParam;     /* Parameters of the current step */
+    ROBOT_GAIT_PARAM_T stNext;      /* Parameters of the next step */
+    float fTimeMs;                  /* Time into the current step */
+    int iSwing;                     /* Leg in the air, 0 left, 1 right */
+    int iStanding;                  /* Both feet down under the hips, no step */
+    unsigned int uiSteps;           /* Steps started */
+    float afStart[2];               /* Foot ahead of its hip at the step start, per leg */
+    float afEnd[2];                 /* And at the step end */
+} ROBOT_GAIT_T;
+
+
+extern void RobotGaitInit(ROBOT_GAIT_T *pstGait);
+extern UBTEDU_RC_T RobotGaitSetParam(ROBOT_GAIT_T *pstGait, const ROBOT_GAIT_PARAM_T *pstParam);
+extern void RobotGaitNext(ROBOT_GAIT_T *pstGait, float fDtMs, unsigned char *pucAngle);
+extern int RobotGaitIsStanding(const ROBOT_GAIT_T *pstGait);
+extern UBTEDU_RC_T RobotGaitBuildHts(const ROBOT_GAIT_PARAM_T *pstParam, int iSteps, int iFrameMs,
+        ROBOT_HTS_T *pstHts);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTGAIT_H__ */
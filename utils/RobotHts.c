@@ -0,0 +1,740 @@
+/**
+ * @file				RobotHts.c
+ * @brief			HTS action files built in memory and a cache of generated motions
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * An HTS file is a zero header frame, the 33 byte motion frames and an end
+ * frame carrying the total time. The whole file is built in one buffer and
+ * saved under a name derived from its content, so callers generating the
+ * same motion share one file and different motions never overwrite each
+ * other. The cache maps a caller's key to the saved file, so a repeated
+ * motion is neither rebuilt nor written again. A file handed out by the
+ * cache is held until the caller releases it: evicting its key or a change
+ * of the servo offsets only removes it from disk after that.
+ *
+ * Every motion frame stored goes through RobotSafetyCheck(), so no
+ * generated file can drive a servo out of range or a limb into the body.
+ * Frames are built in calibrated angles, the robot's servo offsets are
+ * only added when the file is finished.
+ *
+ * Existing files are read through mmap(). Opening one validates every
+ * frame and gathers the figures tools ask for, the frames themselves are
+ * read in place and never copied.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+
+#include "RobotHts.h"
+#include "RobotSafety.h"
+
+
+/* A generated file, removed once neither a key nor a caller uses it */
+typedef struct {
+    char acPath[ROBOT_HTS_PATH_LEN];
+    int iKeys;                  /* Cache entries mapping to it */
+    int iRefs;                  /* Callers playing it */
+} ROBOT_HTS_CACHE_FILE_T;
+
+typedef struct {
+    char acKey[ROBOT_HTS_CACHE_KEY_LEN];
+    ROBOT_HTS_CACHE_FILE_T *pstFile;    /* NULL when the entry is free */
+} ROBOT_HTS_CACHE_ENTRY_T;
+
+
+static ROBOT_HTS_CACHE_ENTRY_T g_astHtsCache[ROBOT_HTS_CACHE_SIZE];
+/* Evicted files still played stay here until released */
+static ROBOT_HTS_CACHE_FILE_T g_astHtsCacheFile[ROBOT_HTS_CACHE_FILE_NUM];
+/* Next entry to be replaced */
+static int g_iHtsCacheNext = 0;
+static pthread_mutex_t g_stHtsCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+/* Servo offsets added by RobotHtsFinish(), written while connecting */
+static signed char g_acHtsOffset[ROBOT_HTS_ANGLE_NUM];
+static pthread_mutex_t g_stHtsOffsetMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+/**
+ * @brief:      RobotHtsCreate
+ * @details:    Allocate a zeroed HTS file for up to iMaxFrame motion frames
+ * @param[in]   int iMaxFrame
+ * @param[out]  ROBOT_HTS_T *pstHts
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotHtsCreate(ROBOT_HTS_T *pstHts, int iMaxFrame)
+{
+    if ((NULL == pstHts) || (iMaxFrame <= 0) || (iMaxFrame > 0xffff))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    memset(pstHts, 0, sizeof(ROBOT_HTS_T));
+    pstHts->pucData = calloc(iMaxFrame + 2, ROBOT_HTS_FRAME_LEN);
+    if (NULL == pstHts->pucData)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+    pstHts->iMaxFrame = iMaxFrame;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotHtsDestroy
+ * @details:    Release the buffer of an HTS file
+ * @param[in]   ROBOT_HTS_T *pstHts
+ * @param[out]  None
+ * @retval:     void
+ */
+void RobotHtsDestroy(ROBOT_HTS_T *pstHts)
+{
+    if (NULL == pstHts)
+    {
+        return;
+    }
+    free(pstHts->pucData);
+    memset(pstHts, 0, sizeof(ROBOT_HTS_T));
+}
+
+/**
+ * @brief:      RobotHtsSetFrame
+ * @details:    Store a motion frame at its sequence number. Angles out of
+ *              range are clamped, a frame whose pose collides is refused.
+ *              The servos a frame leaves alone are taken from the frame
+ *              before it.
+ * @param[in]   int iSeq          1 ~ iMaxFrame
+ * @param[in]   char *pcFrame     ROBOT_HTS_FRAME_LEN bytes
+ * @param[out]  ROBOT_HTS_T *pstHts
+ * @retval:     UBTEDU_RC_T   UBTEDU_RC_FAILED for a colliding pose
+ */
+UBTEDU_RC_T RobotHtsSetFrame(ROBOT_HTS_T *pstHts, int iSeq, const char *pcFrame)
+{
+    unsigned char aucAngle[MAX_SERVO_NUM], aucPrev[MAX_SERVO_NUM];
+    unsigned char *pucFrame, *pucPrev;
+    unsigned int uiSum = 0;
+    int i;
+
+    if ((NULL == pstHts) || (NULL == pstHts->pucData) || (NULL == pcFrame)
+        || (iSeq < 1) || (iSeq > pstHts->iMaxFrame))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    /* 0 is an angle in a frame but "not moved" to the check, it is checked at 1 */
+    pucPrev = pstHts->pucData + (iSeq - 1) * ROBOT_HTS_FRAME_LEN;
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        aucAngle[i] = (0xFF == (unsigned char)pcFrame[8 + i]) ? 0 : pcFrame[8 + i];
+        aucAngle[i] = (0 == pcFrame[8 + i]) ? 1 : aucAngle[i];
+        aucPrev[i] = ((iSeq > 1) && (0xFF != pucPrev[8 + i])) ? pucPrev[8 + i] : 0;
+        aucPrev[i] = ((iSeq > 1) && (0 == pucPrev[8 + i])) ? 1 : aucPrev[i];
+    }
+    switch (RobotSafetyCheck(aucAngle, aucPrev))
+    {
+        case ROBOT_SAFETY_COLLISION:
+            return UBTEDU_RC_FAILED;
+        case ROBOT_SAFETY_CLAMPED:
+            pucFrame = pstHts->pucData + iSeq * ROBOT_HTS_FRAME_LEN;
+            memcpy(pucFrame, pcFrame, ROBOT_HTS_FRAME_LEN);
+            for (i = 0; i < MAX_SERVO_NUM; i++)
+            {
+                if ((0 != aucAngle[i]) && ((0 != pucFrame[8 + i]) || (1 != aucAngle[i])))
+                {
+                    pucFrame[8 + i] = aucAngle[i];
+                }
+            }
+            for (i = 2; i <= 30; i++)
+            {
+                uiSum += pucFrame[i];
+            }
+            pucFrame[31] = uiSum&0xff;
+            break;
+        default:
+            memcpy(pstHts->pucData + iSeq * ROBOT_HTS_FRAME_LEN, pcFrame, ROBOT_HTS_FRAME_LEN);
+            break;
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotHtsFinish
+ * @details:    Add the servo offsets to the motion frames and write the end
+ *              frame after the last one
+ * @param[in]   int iTotalFrame   Motion frames in the file
+ * @param[in]   int iTotalTime    Total play time in ms
+ * @param[out]  ROBOT_HTS_T *pstHts
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotHtsFinish(ROBOT_HTS_T *pstHts, int iTotalFrame, int iTotalTime)
+{
+    signed char acOffset[ROBOT_HTS_ANGLE_NUM];
+    unsigned char *pucFrame, *pucEnd;
+    unsigned int uiSum;
+    int i, iSeq, iAngle, iApply;
+
+    if ((NULL == pstHts) || (NULL == pstHts->pucData) || (iTotalFrame < 1) || (iTotalFrame > pstHts->iMaxFrame))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pthread_mutex_lock(&g_stHtsOffsetMutex);
+    memcpy(acOffset, g_acHtsOffset, sizeof(acOffset));
+    pthread_mutex_unlock(&g_stHtsOffsetMutex);
+    for (iApply = 0, i = 0; i < ROBOT_HTS_ANGLE_NUM; i++)
+    {
+        iApply |= (0 != acOffset[i]);
+    }
+    for (iSeq = 1; iApply && (iSeq <= iTotalFrame); iSeq++)
+    {
+        pucFrame = pstHts->pucData + iSeq * ROBOT_HTS_FRAME_LEN;
+        for (i = 0; i < ROBOT_HTS_ANGLE_NUM; i++)
+        {
+            if (0xFF != pucFrame[8 + i])
+            {
+                iAngle = pucFrame[8 + i] + acOffset[i];
+                pucFrame[8 + i] = (iAngle < 0) ? 0 : ((iAngle > 180) ? 180 : iAngle);
+            }
+        }
+        for (uiSum = 0, i = 2; i <= 30; i++)
+        {
+            uiSum += pucFrame[i];
+        }
+        pucFrame[31] = uiSum&0xff;
+    }
+
+    pucEnd = pstHts->pucData + (iTotalFrame + 1) * ROBOT_HTS_FRAME_LEN;
+    memset(pucEnd, 0, ROBOT_HTS_FRAME_LEN);
+    pucEnd[29] = iTotalTime&0xff;
+    pucEnd[30] = (iTotalTime>>8)&0xff;
+    pucEnd[31] = (iTotalTime>>16)&0xff;
+    pucEnd[32] = (iTotalTime>>24)&0xff;
+    pstHts->iLen = (iTotalFrame + 2) * ROBOT_HTS_FRAME_LEN;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotHtsSetAngles
+ * @details:    Build a motion frame from its angles and store it
+ * @param[in]   int iSeq          1 ~ iTotalFrame
+ * @param[in]   int iTotalFrame   Motion frames in the file
+ * @param[in]   unsigned char *pucAngle   ROBOT_HTS_ANGLE_NUM angles, 0xFF for servos not moved
+ * @param[in]   int iTime         Frame time in ROBOT_HTS_TIME_UNIT, 1 ~ 65535
+ * @param[out]  ROBOT_HTS_T *pstHts
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotHtsSetAngles(ROBOT_HTS_T *pstHts, int iSeq, int iTotalFrame,
+        const unsigned char *pucAngle, int iTime)
+{
+    unsigned char aucFrame[ROBOT_HTS_FRAME_LEN];
+    unsigned int uiSum = 0;
+    int i;
+
+    if ((NULL == pucAngle) || (iTotalFrame < iSeq) || (iTime < 1) || (iTime > 0xffff))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    memset(aucFrame, 0, sizeof(aucFrame));
+    aucFrame[0] = 0xFB;         //LEAD1
+    aucFrame[1] = 0xBF;         //LEAD2
+    aucFrame[2] = 0x01;         //reserve
+    aucFrame[3] = (1 == iSeq) ? 0x01 : ((iTotalFrame > iSeq) ? 0x02 : 0x03);
+    aucFrame[4] = iTotalFrame&0xff;
+    aucFrame[5] = (iTotalFrame>>8)&0xff;
+    aucFrame[6] = iSeq&0xff;
+    aucFrame[7] = (iSeq>>8)&0xff;
+    memcpy(&aucFrame[8], pucAngle, ROBOT_HTS_ANGLE_NUM);
+    aucFrame[28] = (iTime > 0xff) ? 0xff : iTime;   //run time
+    aucFrame[29] = (iTime>>8)&0xff;                 //time high byte
+    aucFrame[30] = iTime&0xff;                      //time low byte
+    for (i = 2; i <= 30; i++)
+    {
+        uiSum += aucFrame[i];
+    }
+    aucFrame[31] = uiSum&0xff;
+    aucFrame[32] = 0xED;        //END
+
+    return RobotHtsSetFrame(pstHts, iSeq, (char *)aucFrame);
+}
+
+/**
+ * @brief:      _RobotHtsWriteFile
+ * @details:    Write a finished HTS file under a private name and rename
+ *              it, so a reader never sees it half written
+ * @param[in]   ROBOT_HTS_T *pstHts
+ * @param[in]   char *pcPath
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _RobotHtsWriteFile(ROBOT_HTS_T *pstHts, const char *pcPath)
+{
+    char acTmpPath[ROBOT_HTS_PATH_LEN + 32];
+    FILE *fd;
+    int iLen;
+
+    iLen = snprintf(acTmpPath, sizeof(acTmpPath), "%s.%d.%lx", pcPath, (int)getpid(), (unsigned long)pthread_self());
+    if ((iLen < 0) || (iLen >= (int)sizeof(acTmpPath)))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    if ((fd = fopen(acTmpPath, "wb")) == NULL)
+    {
+        printf("Create hts file %s failed!\r\n", acTmpPath);
+        return UBTEDU_RC_NORESOURCE;
+    }
+    if (1 != fwrite(pstHts->pucData, pstHts->iLen, 1, fd))
+    {
+        fclose(fd);
+        unlink(acTmpPath);
+        return UBTEDU_RC_NORESOURCE;
+    }
+    fclose(fd);
+    if (0 != rename(acTmpPath, pcPath))
+    {
+        unlink(acTmpPath);
+        return UBTEDU_RC_NORESOURCE;
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotHtsWrite
+ * @details:    Save a finished HTS file as pcPath
+ * @param[in]   ROBOT_HTS_T *pstHts
+ * @param[in]   char *pcPath
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotHtsWrite(ROBOT_HTS_T *pstHts, const char *pcPath)
+{
+    if ((NULL == pstHts) || (pstHts->iLen <= 0) || (NULL == pcPath))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    return _RobotHtsWriteFile(pstHts, pcPath);
+}
+
+/**
+ * @brief:      RobotHtsSave
+ * @details:    Save a finished HTS file as <pcDir>/motion_<hash>.hts.
+ *              Nothing is written when the file already exists.
+ * @param[in]   ROBOT_HTS_T *pstHts
+ * @param[in]   char *pcDir
+ * @param[out]  char *pcPath      The saved file
+ * @param[in]   int iPathLen
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotHtsSave(ROBOT_HTS_T *pstHts, const char *pcDir, char *pcPath, int iPathLen)
+{
+    unsigned int uiHash = 2166136261u;
+    struct stat stStat;
+    int i, iLen;
+
+    if ((NULL == pstHts) || (pstHts->iLen <= 0) || (NULL == pcDir) || (NULL == pcPath))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    /* FNV-1a of the content */
+    for (i = 0; i < pstHts->iLen; i++)
+    {
+        uiHash = (uiHash ^ pstHts->pucData[i]) * 16777619u;
+    }
+    iLen = snprintf(pcPath, iPathLen, "%s/motion_%08x_%d.hts", pcDir, uiHash, pstHts->iLen);
+    if ((iLen < 0) || (iLen >= iPathLen))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    if ((0 == stat(pcPath, &stStat)) && (stStat.st_size == pstHts->iLen))
+    {
+        return UBTEDU_RC_SUCCESS;
+    }
+
+    return _RobotHtsWriteFile(pstHts, pcPath);
+}
+
+/**
+ * @brief:      RobotHtsOpen
+ * @details:    Map an HTS file and validate it. Every motion frame must have
+ *              the 0xFB 0xBF lead, the 0xED end, a right checksum in byte 31
+ *              and the right sequence and total number. The file stays
+ *              mapped for RobotHtsGetFrame() until RobotHtsClose(), also
+ *              when the validation failed.
+ * @param[in]   char *pcPath
+ * @param[out]  ROBOT_HTS_FILE_T *pstFile
+ * @retval:     UBTEDU_RC_T   UBTEDU_RC_FAILED when a frame is wrong, see iBadFrame
+ */
+UBTEDU_RC_T RobotHtsOpen(ROBOT_HTS_FILE_T *pstFile, const char *pcPath)
+{
+    const unsigned char *pucFrame, *pucEnd;
+    struct stat stStat;
+    void *pData;
+    unsigned int uiSum;
+    int fd, i, iSeq;
+
+    if ((NULL == pstFile) || (NULL == pcPath))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    memset(pstFile, 0, sizeof(ROBOT_HTS_FILE_T));
+
+    fd = open(pcPath, O_RDONLY);
+    if (fd < 0)
+    {
+        return UBTEDU_RC_NOT_FOUND;
+    }
+    if ((0 != fstat(fd, &stStat)) || (stStat.st_size < 3 * ROBOT_HTS_FRAME_LEN)
+        || (stStat.st_size % ROBOT_HTS_FRAME_LEN) || (stStat.st_size > (0xffff + 2) * ROBOT_HTS_FRAME_LEN))
+    {
+        close(fd);
+        return UBTEDU_RC_FAILED;
+    }
+    pData = mmap(NULL, stStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == pData)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+    madvise(pData, stStat.st_size, MADV_SEQUENTIAL);
+
+    pstFile->pucData = pData;
+    pstFile->iLen = stStat.st_size;
+    pstFile->iFrameNum = pstFile->iLen / ROBOT_HTS_FRAME_LEN - 2;
+    memset(pstFile->aucMin, 0xff, sizeof(pstFile->aucMin));
+
+    for (iSeq = 1; iSeq <= pstFile->iFrameNum; iSeq++)
+    {
+        pucFrame = pstFile->pucData + iSeq * ROBOT_HTS_FRAME_LEN;
+        for (uiSum = 0, i = 2; i <= 30; i++)
+        {
+            uiSum += pucFrame[i];
+        }
+        if ((0xFB != pucFrame[0]) || (0xBF != pucFrame[1]) || (0xED != pucFrame[32])
+            || ((uiSum & 0xff) != pucFrame[31])
+            || ((pucFrame[6] | (pucFrame[7] << 8)) != iSeq)
+            || ((pucFrame[4] | (pucFrame[5] << 8)) != pstFile->iFrameNum))
+        {
+            pstFile->iBadFrame = iSeq;
+            return UBTEDU_RC_FAILED;
+        }
+
+        pstFile->iFrameTime += ((pucFrame[29] << 8) | pucFrame[30]) * ROBOT_HTS_TIME_UNIT;
+        for (i = 0; i < ROBOT_HTS_ANGLE_NUM; i++)
+        {
+            if (0xff == pucFrame[8 + i])
+            {
+                continue;
+            }
+            pstFile->uiServoMask |= 1u << i;
+            if (pucFrame[8 + i] < pstFile->aucMin[i])
+            {
+                pstFile->aucMin[i] = pucFrame[8 + i];
+            }
+            if (pucFrame[8 + i] > pstFile->aucMax[i])
+            {
+                pstFile->aucMax[i] = pucFrame[8 + i];
+            }
+        }
+    }
+
+    pucEnd = pstFile->pucData + (pstFile->iFrameNum + 1) * ROBOT_HTS_FRAME_LEN;
+    pstFile->iTotalTime = pucEnd[29] | (pucEnd[30] << 8) | (pucEnd[31] << 16) | ((unsigned int)pucEnd[32] << 24);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotHtsClose
+ * @details:    Unmap a file opened by RobotHtsOpen()
+ * @param[in]   ROBOT_HTS_FILE_T *pstFile
+ * @param[out]  None
+ * @retval:     void
+ */
+void RobotHtsClose(ROBOT_HTS_FILE_T *pstFile)
+{
+    if ((NULL == pstFile) || (NULL == pstFile->pucData))
+    {
+        return;
+    }
+    munmap((void *)pstFile->pucData, pstFile->iLen);
+    memset(pstFile, 0, sizeof(ROBOT_HTS_FILE_T));
+}
+
+/**
+ * @brief:      RobotHtsGetFrame
+ * @details:    Get a motion frame of a mapped file, in place
+ * @param[in]   ROBOT_HTS_FILE_T *pstFile
+ * @param[in]   int iSeq     1 ~ iFrameNum
+ * @param[out]  None
+ * @retval:     ROBOT_HTS_FRAME_LEN bytes, NULL when iSeq is out of range
+ */
+const unsigned char *RobotHtsGetFrame(ROBOT_HTS_FILE_T *pstFile, int iSeq)
+{
+    if ((NULL == pstFile) || (NULL == pstFile->pucData) || (iSeq < 1) || (iSeq > pstFile->iFrameNum))
+    {
+        return NULL;
+    }
+
+    return pstFile->pucData + iSeq * ROBOT_HTS_FRAME_LEN;
+}
+
+/**
+ * @brief:      _RobotHtsCacheFileGet
+ * @details:    Get the file slot of pcPath, a free one if it has none.
+ *              Called with g_stHtsCacheMutex held.
+ * @param[in]   char *pcPath
+ * @param[out]  None
+ * @retval:     The slot, NULL when all are in use
+ */
+static ROBOT_HTS_CACHE_FILE_T *_RobotHtsCacheFileGet(const char *pcPath)
+{
+    ROBOT_HTS_CACHE_FILE_T *pstFree = NULL;
+    int i;
+
+    for (i = 0; i < ROBOT_HTS_CACHE_FILE_NUM; i++)
+    {
+        if ((g_astHtsCacheFile[i].iKeys > 0) || (g_astHtsCacheFile[i].iRefs > 0))
+        {
+            if (!strcmp(g_astHtsCacheFile[i].acPath, pcPath))
+            {
+                return &g_astHtsCacheFile[i];
+            }
+        }
+        else if (NULL == pstFree)
+        {
+            pstFree = &g_astHtsCacheFile[i];
+        }
+    }
+    if (NULL != pstFree)
+    {
+        strcpy(pstFree->acPath, pcPath);
+    }
+
+    return pstFree;
+}
+
+/**
+ * @brief:      _RobotHtsCacheFilePut
+ * @details:    Remove the file once neither a key nor a caller uses it.
+ *              Called with g_stHtsCacheMutex held.
+ * @param[in]   ROBOT_HTS_CACHE_FILE_T *pstFile
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _RobotHtsCacheFilePut(ROBOT_HTS_CACHE_FILE_T *pstFile)
+{
+    if ((0 == pstFile->iKeys) && (0 == pstFile->iRefs))
+    {
+        unlink(pstFile->acPath);
+    }
+}
+
+/**
+ * @brief:      _RobotHtsCacheDrop
+ * @details:    Forget a key. Called with g_stHtsCacheMutex held.
+ * @param[in]   ROBOT_HTS_CACHE_ENTRY_T *pstEntry
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _RobotHtsCacheDrop(ROBOT_HTS_CACHE_ENTRY_T *pstEntry)
+{
+    if (NULL == pstEntry->pstFile)
+    {
+        return;
+    }
+    pstEntry->pstFile->iKeys--;
+    _RobotHtsCacheFilePut(pstEntry->pstFile);
+    pstEntry->pstFile = NULL;
+}
+
+/**
+ * @brief:      RobotHtsCacheFind
+ * @details:    Get the file generated for pcKey, if it is still on disk.
+ *              The file is kept for the caller until RobotHtsCacheRelease().
+ * @param[in]   char *pcKey
+ * @param[out]  char *pcPath
+ * @param[in]   int iPathLen
+ * @retval:     UBTEDU_RC_T   UBTEDU_RC_NOT_FOUND when it has to be generated
+ */
+UBTEDU_RC_T RobotHtsCacheFind(const char *pcKey, char *pcPath, int iPathLen)
+{
+    ROBOT_HTS_CACHE_ENTRY_T *pstEntry;
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_NOT_FOUND;
+    int i;
+
+    if ((NULL == pcKey) || (NULL == pcPath) || (iPathLen <= 0))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pthread_mutex_lock(&g_stHtsCacheMutex);
+    for (i = 0; i < ROBOT_HTS_CACHE_SIZE; i++)
+    {
+        pstEntry = &g_astHtsCache[i];
+        if ((NULL != pstEntry->pstFile) && !strcmp(pstEntry->acKey, pcKey))
+        {
+            if (0 == access(pstEntry->pstFile->acPath, R_OK))
+            {
+                strncpy(pcPath, pstEntry->pstFile->acPath, iPathLen);
+                pcPath[iPathLen - 1] = '\0';
+                pstEntry->pstFile->iRefs++;
+                ubtRet = UBTEDU_RC_SUCCESS;
+            }
+            else
+            {
+                /* Removed behind our back, generate it again */
+                _RobotHtsCacheDrop(pstEntry);
+            }
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_stHtsCacheMutex);
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      RobotHtsCacheAdd
+ * @details:    Remember the file generated for pcKey and keep it for the
+ *              caller until RobotHtsCacheRelease(). The oldest entry is
+ *              replaced when the cache is full, its file is removed once no
+ *              other entry and no caller uses it.
+ * @param[in]   char *pcKey
+ * @param[in]   char *pcPath
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T   On failure the file is not cached, the caller
+ *                            removes it when done with it
+ */
+UBTEDU_RC_T RobotHtsCacheAdd(const char *pcKey, const char *pcPath)
+{
+    ROBOT_HTS_CACHE_ENTRY_T *pstEntry;
+    ROBOT_HTS_CACHE_FILE_T *pstFile;
+
+    if ((NULL == pcKey) || (NULL == pcPath)
+        || (strlen(pcKey) >= ROBOT_HTS_CACHE_KEY_LEN) || (strlen(pcPath) >= ROBOT_HTS_PATH_LEN))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pthread_mutex_lock(&g_stHtsCacheMutex);
+    pstFile = _RobotHtsCacheFileGet(pcPath);
+    if (NULL == pstFile)
+    {
+        pthread_mutex_unlock(&g_stHtsCacheMutex);
+        return UBTEDU_RC_NORESOURCE;
+    }
+    /* Before the eviction, which may be the last user of the same file */
+    pstFile->iKeys++;
+    pstFile->iRefs++;
+
+    pstEntry = &g_astHtsCache[g_iHtsCacheNext];
+    g_iHtsCacheNext = (g_iHtsCacheNext + 1) % ROBOT_HTS_CACHE_SIZE;
+    _RobotHtsCacheDrop(pstEntry);
+    strcpy(pstEntry->acKey, pcKey);
+    pstEntry->pstFile = pstFile;
+    pthread_mutex_unlock(&g_stHtsCacheMutex);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotHtsCacheRelease
+ * @details:    Give back a file got from RobotHtsCacheFind() or
+ *              RobotHtsCacheAdd(). It is removed now if it was evicted or
+ *              forgotten while the caller played it.
+ * @param[in]   char *pcPath
+ * @param[out]  None
+ * @retval:     void
+ */
+void RobotHtsCacheRelease(const char *pcPath)
+{
+    int i;
+
+    if (NULL == pcPath)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&g_stHtsCacheMutex);
+    for (i = 0; i < ROBOT_HTS_CACHE_FILE_NUM; i++)
+    {
+        if ((g_astHtsCacheFile[i].iRefs > 0) && !strcmp(g_astHtsCacheFile[i].acPath, pcPath))
+        {
+            g_astHtsCacheFile[i].iRefs--;
+            _RobotHtsCacheFilePut(&g_astHtsCacheFile[i]);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_stHtsCacheMutex);
+}
+
+/**
+ * @brief:      RobotHtsSetOffset
+ * @details:    Set the servo offsets added to the files finished from now
+ *              on. Cached motions built with other offsets are forgotten
+ *              and their files removed, the ones being played once they
+ *              are released.
+ * @param[in]   signed char *pcOffset   MAX_SERVO_NUM offsets in degree, NULL for none
+ * @param[out]  None
+ * @retval:     void
+ */
+void RobotHtsSetOffset(const signed char *pcOffset)
+{
+    signed char acOffset[ROBOT_HTS_ANGLE_NUM];
+    int i, iChanged;
+
+    memset(acOffset, 0, sizeof(acOffset));
+    if (NULL != pcOffset)
+    {
+        memcpy(acOffset, pcOffset, MAX_SERVO_NUM);
+    }
+
+    pthread_mutex_lock(&g_stHtsOffsetMutex);
+    iChanged = memcmp(acOffset, g_acHtsOffset, sizeof(acOffset));
+    memcpy(g_acHtsOffset, acOffset, sizeof(acOffset));
+    pthread_mutex_unlock(&g_stHtsOffsetMutex);
+    if (!iChanged)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&g_stHtsCacheMutex);
+    for (i = 0; i < ROBOT_HTS_CACHE_SIZE; i++)
+    {
+        _RobotHtsCacheDrop(&g_astHtsCache[i]);
+    }
+    pthread_mutex_unlock(&g_stHtsCacheMutex);
+}
+
+/**
+ * @brief:      RobotHtsGetOffset
+ * @details:    Get the servo offsets added by RobotHtsFinish()
+ * @param[in]   None
+ * @param[out]  signed char *pcOffset   ROBOT_HTS_ANGLE_NUM offsets
+ * @retval:     void
+ */
+void RobotHtsGetOffset(signed char *pcOffset)
+{
+    pthread_mutex_lock(&g_stHtsOffsetMutex);
+    memcpy(pcOffset, g_acHtsOffset, sizeof(g_acHtsOffset));
+    pthread_mutex_unlock(&g_stHtsOffsetMutex);
+}
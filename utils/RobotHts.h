@@ -0,0 +1,82 @@
+/**
+ * @file				RobotHts.h
+ * @brief			RobotHts.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTHTS_H__
+#define __ROBOTHTS_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Size of one HTS frame */
+#define ROBOT_HTS_FRAME_LEN            (33)
+/* Generated motions remembered by the cache */
+#define ROBOT_HTS_CACHE_SIZE           (32)
+#define ROBOT_HTS_CACHE_KEY_LEN        (64)
+#define ROBOT_HTS_PATH_LEN             (96)
+/* Files tracked by the cache, the cached ones and the evicted ones still played */
+#define ROBOT_HTS_CACHE_FILE_NUM       (ROBOT_HTS_CACHE_SIZE * 2)
+/* Angle bytes in a frame, one per servo bit */
+#define ROBOT_HTS_ANGLE_NUM            (20)
+/* Time units of a frame, in ms */
+#define ROBOT_HTS_TIME_UNIT            (20)
+
+
+typedef struct {
+    unsigned char *pucData;     /* Header frame, motion frames and end frame */
+    int iMaxFrame;              /* Motion frames which fit in pucData */
+    int iLen;                   /* Bytes of the finished file, 0 until RobotHtsFinish() */
+} ROBOT_HTS_T;
+
+typedef struct {
+    const unsigned char *pucData;   /* The mapped file */
+    int iLen;
+    int iFrameNum;                  /* Motion frames, without the header and end frame */
+    int iBadFrame;                  /* First frame which failed the validation, 0 if none */
+    int iTotalTime;                 /* Play time in the end frame, in ms */
+    int iFrameTime;                 /* Sum of the frame times, in ms */
+    unsigned int uiServoMask;       /* Servos moved by the file */
+    unsigned char aucMin[ROBOT_HTS_ANGLE_NUM];  /* Angle range of each servo in uiServoMask */
+    unsigned char aucMax[ROBOT_HTS_ANGLE_NUM];
+} ROBOT_HTS_FILE_T;
+
+
+extern UBTEDU_RC_T RobotHtsCreate(ROBOT_HTS_T *pstHts, int iMaxFrame);
+extern void RobotHtsDestroy(ROBOT_HTS_T *pstHts);
+extern UBTEDU_RC_T RobotHtsSetFrame(ROBOT_HTS_T *pstHts, int iSeq, const char *pcFrame);
+extern UBTEDU_RC_T RobotHtsFinish(ROBOT_HTS_T *pstHts, int iTotalFrame, int iTotalTime);
+extern UBTEDU_RC_T RobotHtsSetAngles(ROBOT_HTS_T *pstHts, int iSeq, int iTotalFrame,
+        const unsigned char *pucAngle, int iTime);
+extern UBTEDU_RC_T RobotHtsWrite(ROBOT_HTS_T *pstHts, const char *pcPath);
+extern UBTEDU_RC_T RobotHtsSave(ROBOT_HTS_T *pstHts, const char *pcDir, char *pcPath, int iPathLen);
+extern UBTEDU_RC_T RobotHtsOpen(ROBOT_HTS_FILE_T *pstFile, const char *pcPath);
+extern void RobotHtsClose(ROBOT_HTS_FILE_T *pstFile);
+extern const unsigned char *RobotHtsGetFrame(ROBOT_HTS_FILE_T *pstFile, int iSeq);
+extern UBTEDU_RC_T RobotHtsCacheFind(const char *pcKey, char *pcPath, int iPathLen);
+extern UBTEDU_RC_T RobotHtsCacheAdd(const char *pcKey, const char *pcPath);
+extern void RobotHtsCacheRelease(const char *pcPath);
+extern void RobotHtsSetOffset(const signed char *pcOffset);
+extern void RobotHtsGetOffset(signed char *pcOffset);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTHTS_H__ */
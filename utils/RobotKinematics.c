@@ -0,0 +1,481 @@
+/**
+ * @file				RobotKinematics.c
+ * @brief			Forward kinematics of the arms, legs and head
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * Each chain starts at a fixed point of the body and has one rotation per
+ * servo. At the zero of all its joints a limb hangs straight along -z. The
+ * link lengths are the nominal Yanshee ones.
+ *
+ * The sides, axes, signs and zeros of the joints are those of the robot,
+ * as its own actions (RobotMotionLib.c, which were the frames of the
+ * original SDK) move it. "raise right" and "bend right" drive servos 1 ~ 3
+ * and 7 ~ 11, so those are the right limbs. The legs are at their zero in
+ * the standing frame the crouch and the bow start from. Their pitch signs
+ * are the ones with which both soles stay level through the crouch and
+ * the walk, which bends the knees the way a knee bends; the hip and ankle
+ * rolls move together through the sway of the walk, and "walk left" rolls
+ * the right hip the way which pushes the body left. The shoulder pitches
+ * first and rolls next: "stretch" and "come on" swing the upper arm a
+ * quarter turn each way from 90, so at 90 it is held out sideways and it
+ * hangs at the end of its range, and both reach forward. The elbows then
+ * bend the forearms outward: "come on both" bends them by 80 degrees at
+ * once, which would cross them in front of the chest. "head left" turns
+ * servo 17 down to 40.
+ *
+ * Batches are computed ROBOT_KIN_LANES poses at once with the GCC vector
+ * extensions, one pose per lane. The inverse solver moves the end of a
+ * chain to a point with damped least squares steps, from the angles it
+ * is given, so a solver run in a control loop starts from its last answer.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+
+#include "RobotKinematics.h"
+
+
+/* Poses in one vector */
+#define ROBOT_KIN_LANES                (4)
+#define ROBOT_KIN_DEG2RAD              (3.14159265f / 180.0f)
+/* Damping of the solver steps, in mm per degree squared, and the largest step in degree */
+#define ROBOT_KIN_DAMPING              (0.5f)
+#define ROBOT_KIN_MAX_STEP             (20.0f)
+
+/* Nominal sizes, in mm */
+#define ROBOT_KIN_SHOULDER_Y           (75.0f)
+#define ROBOT_KIN_SHOULDER_Z           (150.0f)
+#define ROBOT_KIN_UPPER_ARM            (60.0f)
+#define ROBOT_KIN_FOREARM              (80.0f)
+#define ROBOT_KIN_HIP_Y                (30.0f)
+#define ROBOT_KIN_THIGH                (65.0f)
+#define ROBOT_KIN_SHIN                 (65.0f)
+#define ROBOT_KIN_FOOT                 (35.0f)
+#define ROBOT_KIN_NECK_Z               (185.0f)
+#define ROBOT_KIN_HEAD                 (40.0f)
+
+
+typedef float _KIN_VEC_T __attribute__((vector_size(ROBOT_KIN_LANES * sizeof(float))));
+
+
+/* The servos of the right side are mounted mirrored: the pitch joints
+   turn the other way on the left, the roll joints the same way */
+static const ROBOT_KIN_CHAIN_T g_astKinChain[ROBOT_KIN_CHAIN_INVALID] = {
+    /* ROBOT_KIN_CHAIN_LEFT_ARM: shoulder pitch, shoulder roll, elbow */
+    {{0.0f, ROBOT_KIN_SHOULDER_Y, ROBOT_KIN_SHOULDER_Z}, 3,
+     {{3, ROBOT_KIN_AXIS_Y, -1.0f, 90.0f, {0.0f, 0.0f, 0.0f}},
+      {4, ROBOT_KIN_AXIS_X, 1.0f, 0.0f, {0.0f, 0.0f, -ROBOT_KIN_UPPER_ARM}},
+      {5, ROBOT_KIN_AXIS_X, -1.0f, 90.0f, {0.0f, 0.0f, -ROBOT_KIN_FOREARM}}}},
+    /* ROBOT_KIN_CHAIN_RIGHT_ARM */
+    {{0.0f, -ROBOT_KIN_SHOULDER_Y, ROBOT_KIN_SHOULDER_Z}, 3,
+     {{0, ROBOT_KIN_AXIS_Y, 1.0f, 90.0f, {0.0f, 0.0f, 0.0f}},
+      {1, ROBOT_KIN_AXIS_X, 1.0f, 180.0f, {0.0f, 0.0f, -ROBOT_KIN_UPPER_ARM}},
+      {2, ROBOT_KIN_AXIS_X, -1.0f, 90.0f, {0.0f, 0.0f, -ROBOT_KIN_FOREARM}}}},
+    /* ROBOT_KIN_CHAIN_LEFT_LEG: hip roll, hip pitch, knee, ankle pitch, ankle roll */
+    {{0.0f, ROBOT_KIN_HIP_Y, 0.0f}, 5,
+     {{11, ROBOT_KIN_AXIS_X, 1.0f, 90.0f, {0.0f, 0.0f, 0.0f}},
+      {12, ROBOT_KIN_AXIS_Y, -1.0f, 120.0f, {0.0f, 0.0f, -ROBOT_KIN_THIGH}},
+      {13, ROBOT_KIN_AXIS_Y, 1.0f, 104.0f, {0.0f, 0.0f, -ROBOT_KIN_SHIN}},
+      {14, ROBOT_KIN_AXIS_Y, 1.0f, 69.0f, {0.0f, 0.0f, 0.0f}},
+      {15, ROBOT_KIN_AXIS_X, 1.0f, 89.0f, {0.0f, 0.0f, -ROBOT_KIN_FOOT}}}},
+    /* ROBOT_KIN_CHAIN_RIGHT_LEG */
+    {{0.0f, -ROBOT_KIN_HIP_Y, 0.0f}, 5,
+     {{6, ROBOT_KIN_AXIS_X, 1.0f, 90.0f, {0.0f, 0.0f, 0.0f}},
+      {7, ROBOT_KIN_AXIS_Y, 1.0f, 58.0f, {0.0f, 0.0f, -ROBOT_KIN_THIGH}},
+      {8, ROBOT_KIN_AXIS_Y, -1.0f, 74.0f, {0.0f, 0.0f, -ROBOT_KIN_SHIN}},
+      {9, ROBOT_KIN_AXIS_Y, -1.0f, 110.0f, {0.0f, 0.0f, 0.0f}},
+      {10, ROBOT_KIN_AXIS_X, 1.0f, 89.0f, {0.0f, 0.0f, -ROBOT_KIN_FOOT}}}},
+    /* ROBOT_KIN_CHAIN_HEAD: yaw */
+    {{0.0f, 0.0f, ROBOT_KIN_NECK_Z}, 1,
+     {{16, ROBOT_KIN_AXIS_Z, -1.0f, 90.0f, {0.0f, 0.0f, ROBOT_KIN_HEAD}}}},
+};
+
+
+/* Turn the columns iA and iB of the rotation by the angle */
+static void _RobotKinRotate(_KIN_VEC_T astRot[3][3], int iA, int iB, _KIN_VEC_T vCos, _KIN_VEC_T vSin)
+{
+    _KIN_VEC_T vA;
+    int i;
+
+    for (i = 0; i < 3; i++)
+    {
+        vA = astRot[i][iA];
+        astRot[i][iA] = vCos * vA + vSin * astRot[i][iB];
+        astRot[i][iB] = vCos * astRot[i][iB] - vSin * vA;
+    }
+}
+
+/* Points, axes and end of a chain at pfAngle */
+static void _RobotKinFrames(const ROBOT_KIN_CHAIN_T *pstChain, const float *pfAngle,
+        float afJoint[][3], float afAxis[][3], float *pfEnd)
+{
+    const ROBOT_KIN_JOINT_T *pstJoint;
+    float afRot[3][3], afCol[3], fRad, fCos, fSin;
+    int iA, iB, i, j, k;
+
+    memset(afRot, 0, sizeof(afRot));
+    for (i = 0; i < 3; i++)
+    {
+        afRot[i][i] = 1.0f;
+        pfEnd[i] = pstChain->afBase[i];
+    }
+
+    for (k = 0; k < pstChain->iJointNum; k++)
+    {
+        pstJoint = &pstChain->astJoint[k];
+        iA = (ROBOT_KIN_AXIS_X == pstJoint->eAxis) ? 1 : ((ROBOT_KIN_AXIS_Y == pstJoint->eAxis) ? 2 : 0);
+        iB = (ROBOT_KIN_AXIS_X == pstJoint->eAxis) ? 2 : ((ROBOT_KIN_AXIS_Y == pstJoint->eAxis) ? 0 : 1);
+        for (i = 0; i < 3; i++)
+        {
+            afJoint[k][i] = pfEnd[i];
+            afAxis[k][i] = pstJoint->fSign * afRot[i][pstJoint->eAxis];
+        }
+
+        fRad = pstJoint->fSign * (pfAngle[k] - pstJoint->fZero) * ROBOT_KIN_DEG2RAD;
+        fCos = cosf(fRad);
+        fSin = sinf(fRad);
+        for (i = 0; i < 3; i++)
+        {
+            afCol[i] = afRot[i][iA];
+            afRot[i][iA] = fCos * afCol[i] + fSin * afRot[i][iB];
+            afRot[i][iB] = fCos * afRot[i][iB] - fSin * afCol[i];
+        }
+
+        for (i = 0; i < 3; i++)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                pfEnd[i] += afRot[i][j] * pstJoint->afLink[j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief:      RobotKinGetChain
+ * @details:    Get the joints of a chain
+ * @param[in]   ROBOT_KIN_CHAIN_e eChain
+ * @param[out]  None
+ * @retval:     The chain, NULL for a wrong eChain
+ */
+const ROBOT_KIN_CHAIN_T *RobotKinGetChain(ROBOT_KIN_CHAIN_e eChain)
+{
+    if ((eChain < ROBOT_KIN_CHAIN_LEFT_ARM) || (eChain >= ROBOT_KIN_CHAIN_INVALID))
+    {
+        return NULL;
+    }
+
+    return &g_astKinChain[eChain];
+}
+
+/**
+ * @brief:      RobotKinForwardBatch
+ * @details:    Compute the end of a chain for many sets of servo angles
+ * @param[in]   ROBOT_KIN_CHAIN_e eChain
+ * @param[in]   unsigned char *pucAngle   iNum sets of MAX_SERVO_NUM angles, 0 is not read
+ * @param[in]   int iNum
+ * @param[out]  ROBOT_KIN_POSE_T *pstPose    iNum poses
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotKinForwardBatch(ROBOT_KIN_CHAIN_e eChain, const unsigned char *pucAngle,
+        int iNum, ROBOT_KIN_POSE_T *pstPose)
+{
+    const ROBOT_KIN_CHAIN_T *pstChain = RobotKinGetChain(eChain);
+    const ROBOT_KIN_JOINT_T *pstJoint;
+    _KIN_VEC_T astRot[3][3], avPos[3], vCos, vSin;
+    float fAngle;
+    float fRad;
+    int iFirst, iLanes, i, j, k, l;
+
+    if ((NULL == pstChain) || (NULL == pucAngle) || (iNum < 0) || (NULL == pstPose))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    for (iFirst = 0; iFirst < iNum; iFirst += ROBOT_KIN_LANES)
+    {
+        iLanes = (iNum - iFirst < ROBOT_KIN_LANES) ? iNum - iFirst : ROBOT_KIN_LANES;
+
+        for (i = 0; i < 3; i++)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                astRot[i][j] = (_KIN_VEC_T){0.0f} + ((i == j) ? 1.0f : 0.0f);
+            }
+            avPos[i] = (_KIN_VEC_T){0.0f} + pstChain->afBase[i];
+        }
+
+        for (k = 0; k < pstChain->iJointNum; k++)
+        {
+            pstJoint = &pstChain->astJoint[k];
+            for (l = 0; l < ROBOT_KIN_LANES; l++)
+            {
+                fAngle = (l < iLanes) ? pucAngle[(iFirst + l) * MAX_SERVO_NUM + pstJoint->iServo] : 0;
+                fAngle = (0.0f == fAngle) ? pstJoint->fZero : fAngle;
+                fRad = pstJoint->fSign * (fAngle - pstJoint->fZero) * ROBOT_KIN_DEG2RAD;
+                vCos[l] = cosf(fRad);
+                vSin[l] = sinf(fRad);
+            }
+
+            switch (pstJoint->eAxis)
+            {
+                case ROBOT_KIN_AXIS_X:
+                    _RobotKinRotate(astRot, 1, 2, vCos, vSin);
+                    break;
+                case ROBOT_KIN_AXIS_Y:
+                    _RobotKinRotate(astRot, 2, 0, vCos, vSin);
+                    break;
+                default:
+                    _RobotKinRotate(astRot, 0, 1, vCos, vSin);
+                    break;
+            }
+
+            for (i = 0; i < 3; i++)
+            {
+                avPos[i] += astRot[i][0] * pstJoint->afLink[0]
+                            + astRot[i][1] * pstJoint->afLink[1]
+                            + astRot[i][2] * pstJoint->afLink[2];
+            }
+        }
+
+        for (l = 0; l < iLanes; l++)
+        {
+            for (i = 0; i < 3; i++)
+            {
+                pstPose[iFirst + l].afPos[i] = avPos[i][l];
+                for (j = 0; j < 3; j++)
+                {
+                    pstPose[iFirst + l].afRot[i * 3 + j] = astRot[i][j][l];
+                }
+            }
+        }
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotKinInit
+ * @details:    Empty the pose cache
+ * @param[in]   None
+ * @param[out]  ROBOT_KIN_T *pstKin
+ * @retval:     void
+ */
+void RobotKinInit(ROBOT_KIN_T *pstKin)
+{
+    memset(pstKin, 0, sizeof(ROBOT_KIN_T));
+}
+
+/**
+ * @brief:      RobotKinUpdate
+ * @details:    Recompute the chains whose servos moved since the last update
+ * @param[in]   unsigned char *pucAngle   MAX_SERVO_NUM angles, 0 is not read
+ * @param[out]  ROBOT_KIN_T *pstKin
+ * @retval:     Bit per chain which was recomputed
+ */
+unsigned int RobotKinUpdate(ROBOT_KIN_T *pstKin, const unsigned char *pucAngle)
+{
+    const ROBOT_KIN_CHAIN_T *pstChain;
+    unsigned int uiDone = 0;
+    int iChain, k, iServo;
+
+    for (iChain = 0; iChain < ROBOT_KIN_CHAIN_INVALID; iChain++)
+    {
+        pstChain = &g_astKinChain[iChain];
+        for (k = 0; k < pstChain->iJointNum; k++)
+        {
+            iServo = pstChain->astJoint[k].iServo;
+            if (pstKin->aucAngle[iServo] != pucAngle[iServo])
+            {
+                pstKin->uiValid &= ~(1U << iChain);
+            }
+        }
+        if (pstKin->uiValid & (1U << iChain))
+        {
+            continue;
+        }
+
+        RobotKinForwardBatch(iChain, pucAngle, 1, &pstKin->astPose[iChain]);
+        pstKin->uiValid |= (1U << iChain);
+        uiDone |= (1U << iChain);
+    }
+    memcpy(pstKin->aucAngle, pucAngle, MAX_SERVO_NUM);
+
+    return uiDone;
+}
+
+/**
+ * @brief:      RobotKinGetPose
+ * @details:    Get the cached end of a chain
+ * @param[in]   ROBOT_KIN_T *pstKin
+ * @param[in]   ROBOT_KIN_CHAIN_e eChain
+ * @param[out]  None
+ * @retval:     The pose, NULL before the first RobotKinUpdate()
+ */
+const ROBOT_KIN_POSE_T *RobotKinGetPose(const ROBOT_KIN_T *pstKin, ROBOT_KIN_CHAIN_e eChain)
+{
+    if ((eChain < ROBOT_KIN_CHAIN_LEFT_ARM) || (eChain >= ROBOT_KIN_CHAIN_INVALID)
+        || !(pstKin->uiValid & (1U << eChain)))
+    {
+        return NULL;
+    }
+
+    return &pstKin->astPose[eChain];
+}
+
+/**
+ * @brief:      RobotKinGetPoints
+ * @details:    Get the joints and the end of a chain, e.g. to check the
+ *              links against each other
+ * @param[in]   ROBOT_KIN_CHAIN_e eChain
+ * @param[in]   unsigned char *pucAngle   MAX_SERVO_NUM angles, 0 is not read
+ * @param[out]  float afPoint[][3]   ROBOT_KIN_MAX_JOINT + 1 points
+ * @retval:     Points of the chain, 0 for a wrong eChain
+ */
+int RobotKinGetPoints(ROBOT_KIN_CHAIN_e eChain, const unsigned char *pucAngle, float afPoint[][3])
+{
+    const ROBOT_KIN_CHAIN_T *pstChain = RobotKinGetChain(eChain);
+    float afAngle[ROBOT_KIN_MAX_JOINT], afAxis[ROBOT_KIN_MAX_JOINT][3];
+    int k, iNum;
+
+    if (NULL == pstChain)
+    {
+        return 0;
+    }
+
+    iNum = pstChain->iJointNum;
+    for (k = 0; k < iNum; k++)
+    {
+        afAngle[k] = pucAngle[pstChain->astJoint[k].iServo];
+        afAngle[k] = (0.0f == afAngle[k]) ? pstChain->astJoint[k].fZero : afAngle[k];
+    }
+    _RobotKinFrames(pstChain, afAngle, afPoint, afAxis, afPoint[iNum]);
+
+    return iNum + 1;
+}
+
+/**
+ * @brief:      RobotKinSolve
+ * @details:    Find the servo angles which put the end of a chain at a
+ *              point, within ROBOT_KIN_MIN_ANGLE ~ ROBOT_KIN_MAX_ANGLE.
+ *              The search starts from the angles in pucAngle, a servo at 0
+ *              starts from the zero of its joint. Only the servos of the
+ *              chain are changed.
+ * @param[in]   ROBOT_KIN_CHAIN_e eChain
+ * @param[in]   float *pfTarget     x, y, z in the body frame
+ * @param[out]  unsigned char *pucAngle   MAX_SERVO_NUM angles
+ * @param[out]  float *pfError      Distance left to the target, may be NULL
+ * @retval:     UBTEDU_RC_T   UBTEDU_RC_FAILED when the target is out of reach,
+ *              pucAngle is then the closest pose found
+ */
+UBTEDU_RC_T RobotKinSolve(ROBOT_KIN_CHAIN_e eChain, const float *pfTarget,
+        unsigned char *pucAngle, float *pfError)
+{
+    const ROBOT_KIN_CHAIN_T *pstChain = RobotKinGetChain(eChain);
+    float afAngle[ROBOT_KIN_MAX_JOINT], afJoint[ROBOT_KIN_MAX_JOINT][3], afAxis[ROBOT_KIN_MAX_JOINT][3];
+    float afJac[ROBOT_KIN_MAX_JOINT][3], afEnd[3], afErr[3], afA[3][3], afInv[3][3], afW[3];
+    float fDist = 0.0f, fDet, fStep;
+    int iIter, iNum, i, j, k;
+
+    if ((NULL == pstChain) || (NULL == pfTarget) || (NULL == pucAngle))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    iNum = pstChain->iJointNum;
+    for (k = 0; k < iNum; k++)
+    {
+        afAngle[k] = pucAngle[pstChain->astJoint[k].iServo];
+        afAngle[k] = (0.0f == afAngle[k]) ? pstChain->astJoint[k].fZero : afAngle[k];
+    }
+
+    for (iIter = 0; ; iIter++)
+    {
+        _RobotKinFrames(pstChain, afAngle, afJoint, afAxis, afEnd);
+        for (i = 0; i < 3; i++)
+        {
+            afErr[i] = pfTarget[i] - afEnd[i];
+        }
+        fDist = sqrtf(afErr[0] * afErr[0] + afErr[1] * afErr[1] + afErr[2] * afErr[2]);
+        if ((fDist < ROBOT_KIN_TOLERANCE / 4) || (iIter >= ROBOT_KIN_MAX_ITER))
+        {
+            break;
+        }
+
+        /* Motion of the end per degree of each servo: axis x (end - joint) */
+        for (k = 0; k < iNum; k++)
+        {
+            afJac[k][0] = (afAxis[k][1] * (afEnd[2] - afJoint[k][2]) - afAxis[k][2] * (afEnd[1] - afJoint[k][1])) * ROBOT_KIN_DEG2RAD;
+            afJac[k][1] = (afAxis[k][2] * (afEnd[0] - afJoint[k][0]) - afAxis[k][0] * (afEnd[2] - afJoint[k][2])) * ROBOT_KIN_DEG2RAD;
+            afJac[k][2] = (afAxis[k][0] * (afEnd[1] - afJoint[k][1]) - afAxis[k][1] * (afEnd[0] - afJoint[k][0])) * ROBOT_KIN_DEG2RAD;
+        }
+
+        /* Step = J^T (J J^T + damping I)^-1 err */
+        for (i = 0; i < 3; i++)
+        {
+            for (j = 0; j < 3; j++)
+            {
+                afA[i][j] = (i == j) ? ROBOT_KIN_DAMPING : 0.0f;
+                for (k = 0; k < iNum; k++)
+                {
+                    afA[i][j] += afJac[k][i] * afJac[k][j];
+                }
+            }
+        }
+        afInv[0][0] = afA[1][1] * afA[2][2] - afA[1][2] * afA[2][1];
+        afInv[0][1] = afA[0][2] * afA[2][1] - afA[0][1] * afA[2][2];
+        afInv[0][2] = afA[0][1] * afA[1][2] - afA[0][2] * afA[1][1];
+        afInv[1][0] = afA[1][2] * afA[2][0] - afA[1][0] * afA[2][2];
+        afInv[1][1] = afA[0][0] * afA[2][2] - afA[0][2] * afA[2][0];
+        afInv[1][2] = afA[0][2] * afA[1][0] - afA[0][0] * afA[1][2];
+        afInv[2][0] = afA[1][0] * afA[2][1] - afA[1][1] * afA[2][0];
+        afInv[2][1] = afA[0][1] * afA[2][0] - afA[0][0] * afA[2][1];
+        afInv[2][2] = afA[0][0] * afA[1][1] - afA[0][1] * afA[1][0];
+        fDet = afA[0][0] * afInv[0][0] + afA[0][1] * afInv[1][0] + afA[0][2] * afInv[2][0];
+        for (i = 0; i < 3; i++)
+        {
+            afW[i] = (afInv[i][0] * afErr[0] + afInv[i][1] * afErr[1] + afInv[i][2] * afErr[2]) / fDet;
+        }
+
+        for (k = 0; k < iNum; k++)
+        {
+            fStep = afJac[k][0] * afW[0] + afJac[k][1] * afW[1] + afJac[k][2] * afW[2];
+            fStep = (fStep > ROBOT_KIN_MAX_STEP) ? ROBOT_KIN_MAX_STEP
+                    : ((fStep < -ROBOT_KIN_MAX_STEP) ? -ROBOT_KIN_MAX_STEP : fStep);
+            afAngle[k] += fStep;
+            afAngle[k] = (afAngle[k] < ROBOT_KIN_MIN_ANGLE) ? ROBOT_KIN_MIN_ANGLE
+                         : ((afAngle[k] > ROBOT_KIN_MAX_ANGLE) ? ROBOT_KIN_MAX_ANGLE : afAngle[k]);
+        }
+    }
+
+    /* The servos only take whole degrees */
+    for (k = 0; k < iNum; k++)
+    {
+        afAngle[k] = floorf(afAngle[k] + 0.5f);
+        pucAngle[pstChain->astJoint[k].iServo] = (unsigned char)afAngle[k];
+    }
+    _RobotKinFrames(pstChain, afAngle, afJoint, afAxis, afEnd);
+    for (i = 0; i < 3; i++)
+    {
+        afErr[i] = pfTarget[i] - afEnd[i];
+    }
+    fDist = sqrtf(afErr[0] * afErr[0] + afErr[1] * afErr[1] + afErr[2] * afErr[2]);
+    if (NULL != pfError)
+    {
+        *pfError = fDist;
+    }
+
+    return (fDist < ROBOT_KIN_TOLERANCE) ? UBTEDU_RC_SUCCESS : UBTEDU_RC_FAILED;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file				RobotKinematics.h
+ * @brief			RobotKinematics.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTKINEMATICS_H__
+#define __ROBOTKINEMATICS_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Max servos in one chain */
+#define ROBOT_KIN_MAX_JOINT            (5)
+/* Servo range reached by the solver */
+#define ROBOT_KIN_MIN_ANGLE            (1)
+#define ROBOT_KIN_MAX_ANGLE            (180)
+/* Solver iterations and distance to the target which is good enough, in mm.
+   One servo degree moves a hand about 2.5 mm. */
+#define ROBOT_KIN_MAX_ITER             (32)
+#define ROBOT_KIN_TOLERANCE            (3.0f)
+
+
+typedef enum {
+    ROBOT_KIN_CHAIN_LEFT_ARM = 0,
+    ROBOT_KIN_CHAIN_RIGHT_ARM,
+    ROBOT_KIN_CHAIN_LEFT_LEG,
+    ROBOT_KIN_CHAIN_RIGHT_LEG,
+    ROBOT_KIN_CHAIN_HEAD,
+    ROBOT_KIN_CHAIN_INVALID
+} ROBOT_KIN_CHAIN_e;
+
+typedef enum {
+    ROBOT_KIN_AXIS_X = 0,
+    ROBOT_KIN_AXIS_Y,
+    ROBOT_KIN_AXIS_Z
+} ROBOT_KIN_AXIS_e;
+
+/* Body frame: origin between the hips, x forward, y left, z up, in mm */
+typedef struct {
+    float afPos[3];
+    float afRot[9];                 /* Row major rotation from the end to the body frame */
+} ROBOT_KIN_POSE_T;
+
+typedef struct {
+    int iServo;                     /* 0 ~ MAX_SERVO_NUM-1 */
+    ROBOT_KIN_AXIS_e eAxis;
+    float fSign;                    /* Rotation of the axis when the servo angle grows */
+    float fZero;                    /* Servo angle at which the joint is at its zero */
+    float afLink[3];                /* From this joint to the next one, or to the end */
+} ROBOT_KIN_JOINT_T;
+
+typedef struct {
+    float afBase[3];                /* First joint in the body frame */
+    int iJointNum;
+    ROBOT_KIN_JOINT_T astJoint[ROBOT_KIN_MAX_JOINT];
+} ROBOT_KIN_CHAIN_T;
+
+/* Poses of all the chains for the last angles, a chain is only
+   recomputed when one of its servos moved */
+typedef struct {
+    unsigned char aucAngle[MAX_SERVO_NUM];
+    unsigned int uiValid;           /* Bit per chain */
+    ROBOT_KIN_POSE_T astPose[ROBOT_KIN_CHAIN_INVALID];
+} ROBOT_KIN_T;
+
+
+extern const ROBOT_KIN_CHAIN_T *RobotKinGetChain(ROBOT_KIN_CHAIN_e eChain);
+extern UBTEDU_RC_T RobotKinForwardBatch(ROBOT_KIN_CHAIN_e eChain, const unsigned char *pucAngle,
+        int iNum, ROBOT_KIN_POSE_T *pstPose);
+extern void RobotKinInit(ROBOT_KIN_T *pstKin);
+extern unsigned int RobotKinUpdate(ROBOT_KIN_T *pstKin, const unsigned char *pucAngle);
+extern const ROBOT_KIN_POSE_T *RobotKinGetPose(const ROBOT_KIN_T *pstKin, ROBOT_KIN_CHAIN_e eChain);
+extern int RobotKinGetPoints(ROBOT_KIN_CHAIN_e eChain, const unsigned char *pucAngle, float afPoint[][3]);
+extern UBTEDU_RC_T RobotKinSolve(ROBOT_KIN_CHAIN_e eChain, const float *pfTarget,
+        unsigned char *pucAngle, float *pfError);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTKINEMATICS_H__ */
@@ -0,0 +1,437 @@
+/**
+ * @file				RobotMotionLib.c
+ * @brief			Built in motions of ubtSetRobotMotion()
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * Every keyframe keeps the 20 angle bytes exactly as they go into the HTS
+ * frame, with their sum. A frame is then the fixed header, a memcpy() of
+ * the angles and a checksum made of the precomputed sum and the few header
+ * bytes which depend on the frame position.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "voice_datatypes.h"
+
+#include "RobotHts.h"
+#include "RobotMotionLib.h"
+
+
+#define ROBOT_MOTION_FRAMES(astKeyframe)   (sizeof(astKeyframe)/sizeof(astKeyframe[0])), (astKeyframe)
+
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionCrouch[] =
+{
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0x3a, 0x4a, 0x6e,
+      0x59, 0x5a, 0x78, 0x68, 0x45, 0x59, 0xff, 0xff, 0xff, 0xff}, 0x73},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5e, 0x2e, 0x00, 0xa5,
+      0x55, 0x5c, 0x86, 0xb4, 0x0e, 0x5a, 0xff, 0xff, 0xff, 0xff}, 0x7a},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0x3a, 0x4a, 0x6e,
+      0x59, 0x5a, 0x78, 0x68, 0x45, 0x59, 0xff, 0xff, 0xff, 0xff}, 0x73}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionRaiseLeft[] =
+{
+    {{0xff, 0xff, 0xff, 0x5b, 0x5a, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfe},
+    {{0xff, 0xff, 0xff, 0x5b, 0xad, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x51},
+    {{0xff, 0xff, 0xff, 0x5b, 0x5a, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfe}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionRaiseRight[] =
+{
+    {{0x5b, 0x5a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfe},
+    {{0x5b, 0x07, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xab},
+    {{0x5b, 0x5a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfe}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionRaiseBoth[] =
+{
+    {{0x5b, 0x5a, 0x5a, 0x5a, 0x58, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x0c},
+    {{0x5b, 0x07, 0x5a, 0x5a, 0xaf, 0x5e, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x15},
+    {{0x5b, 0x5a, 0x5a, 0x5a, 0x58, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x0c}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionStretchLeft[] =
+{
+    {{0xff, 0xff, 0xff, 0x59, 0x58, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfa},
+    {{0xff, 0xff, 0xff, 0xb3, 0x00, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfb},
+    {{0xff, 0xff, 0xff, 0x59, 0x58, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfa}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionStretchRight[] =
+{
+    {{0x5b, 0x5a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfe},
+    {{0x00, 0xb4, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfd},
+    {{0x5b, 0x5a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfe}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionStretchBoth[] =
+{
+    {{0x59, 0x5a, 0x5a, 0x5a, 0x59, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x0b},
+    {{0x00, 0xb4, 0x5a, 0xb3, 0x00, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x0c},
+    {{0x59, 0x5a, 0x5a, 0x5a, 0x59, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x0b}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionComeOnLeft[] =
+{
+    {{0xff, 0xff, 0xff, 0x59, 0x58, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfa},
+    {{0xff, 0xff, 0xff, 0xae, 0x00, 0x16, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xb3},
+    {{0xff, 0xff, 0xff, 0xae, 0x00, 0x5c, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xf9},
+    {{0xff, 0xff, 0xff, 0xad, 0x00, 0x0a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xa6},
+    {{0xff, 0xff, 0xff, 0xad, 0x00, 0x5e, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfa},
+    {{0xff, 0xff, 0xff, 0x59, 0x58, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfa}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionComeOnRight[] =
+{
+    {{0x58, 0x5a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfb},
+    {{0x00, 0xb4, 0xae, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x51},
+    {{0x00, 0xb4, 0x5e, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x01},
+    {{0x00, 0xb4, 0xa8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x4b},
+    {{0x00, 0xb4, 0x5c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xff},
+    {{0x58, 0x5a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfb}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionComeOnBoth[] =
+{
+    {{0x58, 0x5a, 0x5a, 0x59, 0x58, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x09},
+    {{0x00, 0xb4, 0xae, 0xae, 0x00, 0x16, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x18},
+    {{0x00, 0xb4, 0x5e, 0xae, 0x00, 0x5c, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x0e},
+    {{0x00, 0xb4, 0xa8, 0xad, 0x00, 0x0a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x05},
+    {{0x00, 0xb4, 0x5c, 0xad, 0x00, 0x5e, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x0d},
+    {{0x58, 0x5a, 0x5a, 0x59, 0x58, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x09}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionWaveLeft[] =
+{
+    {{0xff, 0xff, 0xff, 0x59, 0x58, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xf9},
+    {{0xff, 0xff, 0xff, 0x59, 0x1e, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xbf},
+    {{0xff, 0xff, 0xff, 0x59, 0x82, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x24},
+    {{0xff, 0xff, 0xff, 0x59, 0x1d, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xbe},
+    {{0xff, 0xff, 0xff, 0x59, 0x86, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x28},
+    {{0xff, 0xff, 0xff, 0x59, 0x58, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xf9}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionWaveRight[] =
+{
+    {{0x58, 0x5a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfb},
+    {{0x58, 0x98, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x39},
+    {{0x58, 0x31, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xd2},
+    {{0x58, 0x8f, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x30},
+    {{0x58, 0x33, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xd4},
+    {{0x58, 0x5a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0xfb}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionWaveBoth[] =
+{
+    {{0x58, 0x5a, 0x5a, 0x59, 0x58, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x08},
+    {{0x58, 0x98, 0x5a, 0x59, 0x1e, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x0c},
+    {{0x58, 0x31, 0x5a, 0x59, 0x82, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x0a},
+    {{0x58, 0x8f, 0x5a, 0x59, 0x1d, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x02},
+    {{0x58, 0x33, 0x5a, 0x59, 0x86, 0x5a, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x10},
+    {{0x58, 0x5a, 0x5a, 0x59, 0x58, 0x59, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x08}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionBendLeft[] =
+{
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0x59, 0x77, 0x69, 0x44, 0x5a, 0xff, 0xff, 0xff, 0xff}, 0xc8},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0x67, 0x88, 0x97, 0x36, 0x61, 0xff, 0xff, 0xff, 0xff}, 0x0e},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0x59, 0x77, 0x69, 0x44, 0x5a, 0xff, 0xff, 0xff, 0xff}, 0xc8}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionBendRight[] =
+{
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0x3a, 0x4a, 0x6e,
+      0x59, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x96},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x58, 0x30, 0x31, 0x72,
+      0x52, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x6e},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0x3a, 0x4a, 0x6e,
+      0x59, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, 0x96}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionWalkFront[] =
+{
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x60, 0x27, 0x24, 0x81,
+      0x55, 0x65, 0xa3, 0x90, 0x46, 0x50, 0xff, 0xff, 0xff, 0xff}, 0xa5},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x49, 0x32, 0x15, 0x9c,
+      0x66, 0x4f, 0x9a, 0x9d, 0x34, 0x60, 0xff, 0xff, 0xff, 0xff}, 0xa2},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x49, 0x16, 0x0c, 0x89,
+      0x62, 0x50, 0x8c, 0x8f, 0x33, 0x67, 0xff, 0xff, 0xff, 0xff}, 0x51},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4c, 0x11, 0x20, 0x74,
+      0x64, 0x52, 0x8c, 0x8f, 0x33, 0x64, 0xff, 0xff, 0xff, 0xff}, 0x4f},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x60, 0x1d, 0x24, 0x7a,
+      0x51, 0x66, 0x7c, 0x8e, 0x22, 0x4a, 0xff, 0xff, 0xff, 0xff}, 0x3e},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x60, 0x27, 0x24, 0x81,
+      0x4e, 0x69, 0x9a, 0xac, 0x26, 0x4f, 0xff, 0xff, 0xff, 0xff}, 0x94}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionWalkBack[] =
+{
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x60, 0x2a, 0x1d, 0x8d,
+      0x50, 0x64, 0x9a, 0x97, 0x3b, 0x4d, 0xff, 0xff, 0xff, 0xff}, 0x97},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x60, 0x2a, 0x1d, 0x8d,
+      0x50, 0x66, 0x83, 0xb1, 0x0f, 0x55, 0xff, 0xff, 0xff, 0xff}, 0x78},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x61, 0x2a, 0x1d, 0x8d,
+      0x50, 0x66, 0x77, 0x9a, 0x16, 0x4e, 0xff, 0xff, 0xff, 0xff}, 0x56},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4e, 0x1b, 0x1d, 0x7a,
+      0x67, 0x52, 0x8e, 0x96, 0x2d, 0x66, 0xff, 0xff, 0xff, 0xff}, 0x66},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4f, 0x23, 0x0c, 0x98,
+      0x61, 0x52, 0x8e, 0x96, 0x2d, 0x66, 0xff, 0xff, 0xff, 0xff}, 0x76},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4c, 0x37, 0x1c, 0x99,
+      0x67, 0x52, 0x8e, 0x96, 0x2d, 0x66, 0xff, 0xff, 0xff, 0xff}, 0x9e}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionWalkLeft[] =
+{
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0x27, 0x1b, 0x8c,
+      0x59, 0x5c, 0x8e, 0x9b, 0x28, 0x55, 0xff, 0xff, 0xff, 0xff}, 0x79},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x42, 0x27, 0x1b, 0x8e,
+      0x67, 0x59, 0x8e, 0x9b, 0x28, 0x55, 0xff, 0xff, 0xff, 0xff}, 0x6e}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionWalkRight[] =
+{
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0x27, 0x1d, 0x87,
+      0x5e, 0x5a, 0x8b, 0x97, 0x2b, 0x5d, 0xff, 0xff, 0xff, 0xff}, 0x7d},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5c, 0x27, 0x1d, 0x87,
+      0x5c, 0x70, 0x8b, 0x97, 0x2b, 0x51, 0xff, 0xff, 0xff, 0xff}, 0x87}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionTurnAroundLeft[] =
+{
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4f, 0x10, 0x30, 0x60,
+      0x68, 0x63, 0x6e, 0x8e, 0x14, 0x53, 0xff, 0xff, 0xff, 0xff}, 0x13},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5a, 0x28, 0x1d, 0x89,
+      0x5e, 0x5c, 0x8a, 0x97, 0x2a, 0x5a, 0xff, 0xff, 0xff, 0xff}, 0x7d}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionTurnAroundRight[] =
+{
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x54, 0x53, 0x2e, 0x9f,
+      0x63, 0x69, 0xa0, 0x8a, 0x55, 0x4d, 0xff, 0xff, 0xff, 0xff}, 0x02},
+    {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5b, 0x28, 0x1d, 0x87,
+      0x5a, 0x5a, 0x89, 0x97, 0x2a, 0x5a, 0xff, 0xff, 0xff, 0xff}, 0x75}
+};
+
+static const ROBOT_MOTION_KEYFRAME_T s_astMotionBow[] =
+{
+    {{0x59, 0x5a, 0x5b, 0x59, 0x58, 0x5b, 0x5a, 0x3a, 0x4a, 0x6e,
+      0x59, 0x59, 0x77, 0x67, 0x44, 0x59, 0xff, 0xff, 0xff, 0xff}, 0x8f},
+    {{0x59, 0xb4, 0x5b, 0x59, 0x00, 0x5b, 0x5a, 0x17, 0x9e, 0x31,
+      0x59, 0x58, 0x9d, 0x19, 0x84, 0x5b, 0xff, 0xff, 0xff, 0xff}, 0x9e},
+    {{0x59, 0xb4, 0x5b, 0x59, 0x00, 0x5a, 0x5a, 0x17, 0x9e, 0x32,
+      0x59, 0x58, 0x9d, 0x18, 0x82, 0x5a, 0xff, 0xff, 0xff, 0xff}, 0x9a},
+    {{0x59, 0xb4, 0x5b, 0x59, 0x00, 0x5a, 0x5c, 0x67, 0x9e, 0x48,
+      0x5a, 0x5b, 0x49, 0x18, 0x6b, 0x5a, 0xff, 0xff, 0xff, 0xff}, 0x9b},
+    {{0x59, 0x5a, 0x5b, 0x59, 0x58, 0x5b, 0x5a, 0x3a, 0x4a, 0x6e,
+      0x59, 0x59, 0x77, 0x67, 0x44, 0x59, 0xff, 0xff, 0xff, 0xff}, 0x8f}
+};
+
+static const ROBOT_MOTION_T s_astMotion[] =
+{
+    {"crouch", NULL, 0, ROBOT_MOTION_FRAMES(s_astMotionCrouch)},
+    {"raise", "left", 0, ROBOT_MOTION_FRAMES(s_astMotionRaiseLeft)},
+    {"raise", "right", 0, ROBOT_MOTION_FRAMES(s_astMotionRaiseRight)},
+    {"raise", "both", 0, ROBOT_MOTION_FRAMES(s_astMotionRaiseBoth)},
+    {"stretch", "left", 0, ROBOT_MOTION_FRAMES(s_astMotionStretchLeft)},
+    {"stretch", "right", 0, ROBOT_MOTION_FRAMES(s_astMotionStretchRight)},
+    {"stretch", "both", 0, ROBOT_MOTION_FRAMES(s_astMotionStretchBoth)},
+    {"come on", "left", 0, ROBOT_MOTION_FRAMES(s_astMotionComeOnLeft)},
+    {"come on", "right", 0, ROBOT_MOTION_FRAMES(s_astMotionComeOnRight)},
+    {"come on", "both", 0, ROBOT_MOTION_FRAMES(s_astMotionComeOnBoth)},
+    {"wave", "left", 0, ROBOT_MOTION_FRAMES(s_astMotionWaveLeft)},
+    {"wave", "right", 0, ROBOT_MOTION_FRAMES(s_astMotionWaveRight)},
+    {"wave", "both", 0, ROBOT_MOTION_FRAMES(s_astMotionWaveBoth)},
+    {"bend", "left", 0, ROBOT_MOTION_FRAMES(s_astMotionBendLeft)},
+    {"bend", "right", 0, ROBOT_MOTION_FRAMES(s_astMotionBendRight)},
+    {"walk", "front", 0, ROBOT_MOTION_FRAMES(s_astMotionWalkFront)},
+    {"walk", "back", 0, ROBOT_MOTION_FRAMES(s_astMotionWalkBack)},
+    {"walk", "left", 0, ROBOT_MOTION_FRAMES(s_astMotionWalkLeft)},
+    {"walk", "right", 0, ROBOT_MOTION_FRAMES(s_astMotionWalkRight)},
+    {"turn around", "left", 5, ROBOT_MOTION_FRAMES(s_astMotionTurnAroundLeft)},
+    {"turn around", "right", 5, ROBOT_MOTION_FRAMES(s_astMotionTurnAroundRight)},
+    {"bow", NULL, 0, ROBOT_MOTION_FRAMES(s_astMotionBow)}
+};
+
+
+/**
+ * @brief:      RobotMotionFind
+ * @details:    Look up a built in motion
+ * @param[in]   char *pcType
+ * @param[in]   char *pcDirect    Ignored by the motions without direction
+ * @param[out]  None
+ * @retval:     The motion, NULL when it does not exist
+ */
+const ROBOT_MOTION_T *RobotMotionFind(const char *pcType, const char *pcDirect)
+{
+    int i;
+
+    if (NULL == pcType)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < sizeof(s_astMotion)/sizeof(s_astMotion[0]); i++)
+    {
+        if (strcmp(s_astMotion[i].pcType, pcType))
+        {
+            continue;
+        }
+        if ((NULL == s_astMotion[i].pcDirect)
+            || ((NULL != pcDirect) && !strcmp(s_astMotion[i].pcDirect, pcDirect)))
+        {
+            return &s_astMotion[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief:      RobotMotionBuild
+ * @details:    Build the HTS file of a motion played iRepeat times
+ * @param[in]   ROBOT_MOTION_T *pstMotion
+ * @param[in]   int iRepeat
+ * @param[in]   int iSpeed       Servo run time of each frame
+ * @param[out]  ROBOT_HTS_T *pstHts   Created here, released by the caller
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotMotionBuild(const ROBOT_MOTION_T *pstMotion, int iRepeat, int iSpeed, ROBOT_HTS_T *pstHts)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    const ROBOT_MOTION_KEYFRAME_T *pstKeyframe;
+    unsigned char aucFrame[ROBOT_HTS_FRAME_LEN];
+    unsigned int uiSum;
+    int i, iSeq, iTotalFrame;
+
+    if ((NULL == pstMotion) || (NULL == pstHts) || (iRepeat <= 0) || (iRepeat > 0xffff/pstMotion->iLoop))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    iSpeed += pstMotion->iSpeedOffset;
+    iTotalFrame = iRepeat * pstMotion->iLoop;
+
+    ubtRet = RobotHtsCreate(pstHts, iTotalFrame);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    memset(aucFrame, 0, sizeof(aucFrame));
+    aucFrame[0] = 0xFB;         //LEAD1
+    aucFrame[1] = 0xBF;         //LEAD2
+    aucFrame[2] = 0x01;         //reserve
+    aucFrame[4] = iTotalFrame&0xff;
+    aucFrame[5] = (iTotalFrame>>8)&0xff;
+    aucFrame[28] = iSpeed;      //run time
+    aucFrame[29] = 0x00;        //time high byte
+    aucFrame[30] = iSpeed;      //time low byte
+    aucFrame[32] = 0xED;        //END
+
+    for (iSeq = 1; (iSeq <= iTotalFrame) && (UBTEDU_RC_SUCCESS == ubtRet); iSeq++)
+    {
+        pstKeyframe = &pstMotion->pstKeyframe[(iSeq - 1) % pstMotion->iLoop];
+        if (1 == iSeq)
+        {
+            aucFrame[3] = 0x01;     //start frame
+        }
+        else if (iTotalFrame > iSeq)
+        {
+            aucFrame[3] = 0x02;     //middle frame
+        }
+        else
+        {
+            aucFrame[3] = 0x03;     //end frame
+        }
+        aucFrame[6] = iSeq&0xff;
+        aucFrame[7] = (iSeq>>8)&0xff;
+        memcpy(&aucFrame[8], pstKeyframe->aucAngle, ROBOT_MOTION_ANGLE_LEN);
+
+        uiSum = pstKeyframe->ucSum;
+        for (i = 2; i <= 7; i++)
+        {
+            uiSum += aucFrame[i];
+        }
+        uiSum += aucFrame[28] + aucFrame[29] + aucFrame[30];
+        aucFrame[31] = uiSum&0xff;
+
+        ubtRet = RobotHtsSetFrame(pstHts, iSeq, (char *)aucFrame);
+    }
+
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = RobotHtsFinish(pstHts, iTotalFrame, iTotalFrame*iSpeed*20);
+    }
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        RobotHtsDestroy(pstHts);
+    }
+
+    return ubtRet;
+}
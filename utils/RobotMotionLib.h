@@ -0,0 +1,53 @@
+/**
+ * @file				RobotMotionLib.h
+ * @brief			RobotMotionLib.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTMOTIONLIB_H__
+#define __ROBOTMOTIONLIB_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Angle bytes in an HTS frame, one per servo bit */
+#define ROBOT_MOTION_ANGLE_LEN         (20)
+
+
+typedef struct {
+    unsigned char aucAngle[ROBOT_MOTION_ANGLE_LEN];     /* Frame bytes 8 ~ 27, 0xFF for servos not moved */
+    unsigned char ucSum;                                /* Sum of aucAngle, part of the frame checksum */
+} ROBOT_MOTION_KEYFRAME_T;
+
+typedef struct {
+    const char *pcType;
+    const char *pcDirect;                       /* NULL when the motion has no direction */
+    int iSpeedOffset;                           /* Added to the servo run time */
+    int iLoop;                                  /* Keyframes in one repeat */
+    const ROBOT_MOTION_KEYFRAME_T *pstKeyframe;
+} ROBOT_MOTION_T;
+
+
+extern const ROBOT_MOTION_T *RobotMotionFind(const char *pcType, const char *pcDirect);
+extern UBTEDU_RC_T RobotMotionBuild(const ROBOT_MOTION_T *pstMotion, int iRepeat, int iSpeed, ROBOT_HTS_T *pstHts);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTMOTIONLIB_H__ */
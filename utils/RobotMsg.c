@@ -12,6 +12,7 @@
 */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <unistd.h>
 #include <string.h>
 #include <pthread.h>
@@ -30,6 +31,8 @@
 #include "cJSON.h"
 #include "robotlogstr.h"
 #include "RobotMsg.h"
+#include "RobotMsgScan.h"
+#include "RobotMsgTemplate.h"
 
 #ifdef __DEBUG_PRINT__                                            // 对于DEBUG版本，增加打印信息
 #define DebugTrace(...)\
@@ -41,6 +44,23 @@
 #endif
 
 
+/**
+ * @brief:      _ubtRobot_Msg_CopyString
+ * @details:    Copy a decoded string into a local buffer. Unlike strncpy()
+ *              the result is always terminated, so a long or hostile reply
+ *              cannot make the following strcmp() run off the buffer.
+ * @param[out]  char *pcDst
+ * @param[in]   char *pcSrc
+ * @param[in]   int iDstLen
+ * @retval:     void
+ */
+static void _ubtRobot_Msg_CopyString(char *pcDst, char *pcSrc, int iDstLen)
+{
+    strncpy(pcDst, pcSrc, iDstLen - 1);
+    pcDst[iDstLen - 1] = '\0';
+}
+
+
 UBTEDU_RC_T ubtRobot_Msg_Encode_SWVersion(char *pcParam, int iPort,
         char *pcSendBuf, int iBufLen)
 {
@@ -115,7 +135,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SWVersion(char *pcRecvBuf, char *pcVersion, int
         {
             if (pNode->type == cJSON_String)
             {
-                strcpy(acType, pNode->valuestring) ;
+                _ubtRobot_Msg_CopyString(acType, pNode->valuestring, sizeof(acType));
             }
         }
 
@@ -124,7 +144,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SWVersion(char *pcRecvBuf, char *pcVersion, int
         {
             if (pNode->type == cJSON_String)
             {
-                strcpy(acRet, pNode->valuestring) ;
+                _ubtRobot_Msg_CopyString(acRet, pNode->valuestring, sizeof(acRet));
             }
         }
 
@@ -242,7 +262,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_RobotStatus(char *pcType, char *pcRecvBuf, void
                     ret = UBTEDU_RC_SOCKET_DECODE_ERROR;
                     break;
                 }
-                strncpy(acType, pNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pNode->valuestring, sizeof(acType));
             }
         }
 
@@ -254,7 +274,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_RobotStatus(char *pcType, char *pcRecvBuf, void
             {
                 if (pNode->type == cJSON_String)
                 {
-                    strncpy(acParam, pNode->valuestring, sizeof(acParam));
+                    _ubtRobot_Msg_CopyString(acParam, pNode->valuestring, sizeof(acParam));
                 }
                 piValue = (int *)pStatus;
                 if (!strcmp(acParam, pcStr_Msg_Param_Query_Play_Playing))
@@ -397,7 +417,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_CheckAPPStatus(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -499,7 +519,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_DetectVoiceMsg(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -561,6 +581,193 @@ UBTEDU_RC_T ubtRobot_Msg_Encode_ReadRobotServoHold(int iPort, char *pcSendBuf, i
     return UBTEDU_RC_SUCCESS;
 }
 
+UBTEDU_RC_T ubtRobot_Msg_Encode_ReadServoOffset(int iPort, char *pcSendBuf, int iBufLen)
+{
+    cJSON *pJsonRoot = NULL;
+
+    pJsonRoot = cJSON_CreateObject();
+    if (pJsonRoot == NULL)
+    {
+        printf("Failed to create json message!\r\n");
+        return UBTEDU_RC_NORESOURCE;
+    }
+
+    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Cmd, pcStr_Msg_Cmd_Servo_Offset);
+    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Type, pcStr_Msg_Type_Servo_Read);
+    cJSON_AddNumberToObject(pJsonRoot, pcStr_Msg_Port,  iPort);
+    strncpy(pcSendBuf, cJSON_Print(pJsonRoot), iBufLen);
+    cJSON_Delete(pJsonRoot);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/* A number member of a sensor structure filled from the structural index */
+typedef struct
+{
+    char **ppcKey;
+    int iOffset;
+    int iIsDouble;
+} ROBOT_MSG_SCAN_FIELD_T;
+
+static const ROBOT_MSG_SCAN_FIELD_T s_astScanGyroField[] =
+{
+    {&pcStr_Msg_Param_Query_Sensor_GYRO_X, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dGyroxValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_GYRO_Y, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dGyroyValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_GYRO_Z, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dGyrozValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_ACCEL_X, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dAccexValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_ACCEL_Y, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dAcceyValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_ACCEL_Z, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dAccezValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_COMPASS_X, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dCompassxValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_COMPASS_Y, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dCompassyValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_COMPASS_Z, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dCompasszValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_EULER_X, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dEulerxValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_EULER_Y, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dEuleryValue), 1},
+    {&pcStr_Msg_Param_Query_Sensor_EULER_Z, offsetof(UBTEDU_ROBOTGYRO_SENSOR_T, dEulerzValue), 1},
+};
+
+static const ROBOT_MSG_SCAN_FIELD_T s_astScanEnvField[] =
+{
+    {&pcStr_Msg_Param_Query_Sensor_ENV_Temperature, offsetof(UBTEDU_ROBOTENV_SENSOR_T, iTempValue), 0},
+    {&pcStr_Msg_Param_Query_Sensor_ENV_Humidity, offsetof(UBTEDU_ROBOTENV_SENSOR_T, iHumiValue), 0},
+    {&pcStr_Msg_Param_Query_Sensor_ENV_Pressure, offsetof(UBTEDU_ROBOTENV_SENSOR_T, iPresValue), 0},
+};
+
+static const ROBOT_MSG_SCAN_FIELD_T s_astScanBoardField[] =
+{
+    {&pcStr_Msg_Param_Query_Sensor_Board_Temperature, offsetof(UBTEDU_ROBOTRASPBOARD_SENSOR_T, iValue), 0},
+};
+
+/**
+ * @brief:      _ubtRobot_Msg_Scan_ReadRobotServo
+ * @details:    Decode the servo angles from the structural index
+ * @param[in]   char *pcRecvBuf
+ * @param[out]  char *pcAllAngle
+ * @param[in]   int iAngleLen
+ * @retval:     UBTEDU_RC_SOCKET_DECODE_FAILED when the reply has to be
+ *              decoded by cJSON
+ */
+static UBTEDU_RC_T _ubtRobot_Msg_Scan_ReadRobotServo(char *pcRecvBuf, char *pcAllAngle, int iAngleLen)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    UBTEDU_RC_T scanRet;
+    ROBOT_MSG_SCAN_T stScan;
+    char acCmd[MSG_CMD_STR_MAX_LEN];
+
+    if (UBTEDU_RC_SUCCESS != RobotMessageScanBuild(&stScan, pcRecvBuf))
+    {
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+    acCmd[0] = '\0';
+
+    scanRet = RobotMessageScanGetString(&stScan, RobotMessageScanFind(&stScan, ROBOT_MSG_SCAN_ROOT, pcStr_Msg_Cmd),
+                                        acCmd, sizeof(acCmd));
+    if (UBTEDU_RC_SOCKET_DECODE_FAILED == scanRet)
+    {
+        return scanRet;
+    }
+
+    scanRet = RobotMessageScanGetString(&stScan, RobotMessageScanFind(&stScan, ROBOT_MSG_SCAN_ROOT, pcStr_Msg_Type_Servo_Angle),
+                                        pcAllAngle, iAngleLen);
+    if (UBTEDU_RC_SOCKET_DECODE_FAILED == scanRet)
+    {
+        return scanRet;
+    }
+    if (UBTEDU_RC_SUCCESS == scanRet)
+    {
+        ubtRet = UBTEDU_RC_SUCCESS;
+    }
+
+    if (strcmp(acCmd, pcStr_Msg_Cmd_Servo_Ack))
+    {
+        ubtRet = UBTEDU_RC_SOCKET_DECODE_ERROR;
+    }
+
+    return ubtRet;
+}
+
+/**
+ * @brief:      _ubtRobot_Msg_Scan_ReadSensorValue
+ * @details:    Decode the gyro, environment and board sensors from the
+ *              structural index. These are flat objects of numbers and make
+ *              up the high rate polling, the array based sensors are left
+ *              to cJSON, as are replies missing one of the members.
+ * @param[in]   char *pcRecvBuf
+ * @param[out]  void *pValue
+ * @param[in]   int iValueLen
+ * @retval:     UBTEDU_RC_SOCKET_DECODE_FAILED when the reply has to be
+ *              decoded by cJSON
+ */
+static UBTEDU_RC_T _ubtRobot_Msg_Scan_ReadSensorValue(char *pcRecvBuf, void *pValue, int iValueLen)
+{
+    ROBOT_MSG_SCAN_T stScan;
+    const ROBOT_MSG_SCAN_FIELD_T *pstField = NULL;
+    int iFieldNum = 0;
+    int iSize = 0;
+    int iValue, iObject, i;
+    double adValue[sizeof(s_astScanGyroField)/sizeof(s_astScanGyroField[0])];
+
+    if (UBTEDU_RC_SUCCESS != RobotMessageScanBuild(&stScan, pcRecvBuf))
+    {
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+
+    if ((iValue = RobotMessageScanFind(&stScan, ROBOT_MSG_SCAN_ROOT, pcStr_Msg_Param_Query_Sensor_GYRO)) >= 0)
+    {
+        pstField = s_astScanGyroField;
+        iFieldNum = sizeof(s_astScanGyroField)/sizeof(s_astScanGyroField[0]);
+        iSize = sizeof(UBTEDU_ROBOTGYRO_SENSOR_T);
+    }
+    else if ((iValue = RobotMessageScanFind(&stScan, ROBOT_MSG_SCAN_ROOT, pcStr_Msg_Param_Query_Sensor_ENV)) >= 0)
+    {
+        pstField = s_astScanEnvField;
+        iFieldNum = sizeof(s_astScanEnvField)/sizeof(s_astScanEnvField[0]);
+        iSize = sizeof(UBTEDU_ROBOTENV_SENSOR_T);
+    }
+    else if ((iValue = RobotMessageScanFind(&stScan, ROBOT_MSG_SCAN_ROOT, pcStr_Msg_Param_Query_Sensor_Board)) >= 0)
+    {
+        pstField = s_astScanBoardField;
+        iFieldNum = sizeof(s_astScanBoardField)/sizeof(s_astScanBoardField[0]);
+        iSize = sizeof(UBTEDU_ROBOTRASPBOARD_SENSOR_T);
+    }
+    else
+    {
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+
+    if (iValueLen != iSize)
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    /* Nothing is written unless every member is there */
+    iObject = RobotMessageScanObject(&stScan, iValue);
+    if (iObject < 0)
+    {
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+    for (i = 0; i < iFieldNum; i++)
+    {
+        if (UBTEDU_RC_SUCCESS != RobotMessageScanGetNumber(&stScan,
+                RobotMessageScanFind(&stScan, iObject, *pstField[i].ppcKey), &adValue[i]))
+        {
+            return UBTEDU_RC_SOCKET_DECODE_FAILED;
+        }
+    }
+    for (i = 0; i < iFieldNum; i++)
+    {
+        if (pstField[i].iIsDouble)
+        {
+            *(double *)((char *)pValue + pstField[i].iOffset) = adValue[i];
+        }
+        else
+        {
+            *(int *)((char *)pValue + pstField[i].iOffset) = (int)adValue[i];
+        }
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
 UBTEDU_RC_T ubtRobot_Msg_Decode_ReadRobotServo(char *pcRecvBuf, char *pcAllAngle, int iAngleLen)
 {
     UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
@@ -572,6 +779,13 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadRobotServo(char *pcRecvBuf, char *pcAllAngle
     {
         return UBTEDU_RC_WRONG_PARAM;
     }
+
+    ubtRet = _ubtRobot_Msg_Scan_ReadRobotServo(pcRecvBuf, pcAllAngle, iAngleLen);
+    if (UBTEDU_RC_SOCKET_DECODE_FAILED != ubtRet)
+    {
+        return ubtRet;
+    }
+    ubtRet = UBTEDU_RC_FAILED;
     acCmd[0] = '\0';
 
     pJson = cJSON_Parse(pcRecvBuf);
@@ -589,7 +803,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadRobotServo(char *pcRecvBuf, char *pcAllAngle
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -614,13 +828,146 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadRobotServo(char *pcRecvBuf, char *pcAllAngle
     return ubtRet;
 }
 
+/**
+ * @brief:      ubtRobot_Msg_Decode_ReadServoOffset
+ * @details:    Decode the calibration offsets. They come like the servo
+ *              angles, two hex digits per servo, each a signed byte.
+ * @param[in]   char *pcRecvBuf
+ * @param[out]  char *pcAllOffset
+ * @param[in]   int iOffsetLen
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtRobot_Msg_Decode_ReadServoOffset(char *pcRecvBuf, char *pcAllOffset, int iOffsetLen)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    cJSON *pJson = NULL, *pNode = NULL;
+    char acCmd[MSG_CMD_STR_MAX_LEN];
+
+    /* Check parameters */
+    if ((NULL == pcRecvBuf) || (NULL == pcAllOffset) || (iOffsetLen <= 0))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    acCmd[0] = '\0';
+
+    pJson = cJSON_Parse(pcRecvBuf);
+    if (pJson == NULL)
+    {
+        printf("Parse json message filed!\r\n");
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+
+    do
+    {
+        pNode = cJSON_GetObjectItem(pJson, pcStr_Msg_Cmd);
+        if ((pNode != NULL) && (pNode->type == cJSON_String))
+        {
+            _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
+        }
+        if (strcmp(acCmd, pcStr_Msg_Cmd_Servo_Offset_Ack))
+        {
+            ubtRet = UBTEDU_RC_SOCKET_DECODE_ERROR;
+            break;
+        }
+
+        pNode = cJSON_GetObjectItem(pJson, pcStr_Msg_Type_Servo_Angle);
+        if ((pNode != NULL) && (pNode->type == cJSON_String))
+        {
+            _ubtRobot_Msg_CopyString(pcAllOffset, pNode->valuestring, iOffsetLen);
+            ubtRet = UBTEDU_RC_SUCCESS;
+        }
+    }
+    while (0);
+    cJSON_Delete(pJson);
+    return ubtRet;
+}
+
+
+
+/* Width of the port slot, enough for any UDP port */
+#define ROBOT_MSG_PORT_WIDTH        (5)
+
+static pthread_once_t s_stMsgTemplateOnce = PTHREAD_ONCE_INIT;
+static ROBOT_MSG_TEMPLATE_T s_stServoWriteTemplate;
+static int s_iServoWriteSlotPort = -1;
+static int s_iServoWriteSlotTime = -1;
+static int s_iServoWriteSlotAngle = -1;
+
+/**
+ * @brief:      _ubtRobot_Msg_TemplateInit
+ * @details:    Pre-render the servo write once. A template which cannot be
+ *              built is simply not used and the encoder falls back to cJSON.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+static void _ubtRobot_Msg_TemplateInit(void)
+{
+    cJSON *pJsonRoot = NULL;
+    char acAngle[MAX_SERVO_NUM*2 + 1];
+
+    memset(acAngle, 'F', sizeof(acAngle));
+    acAngle[MAX_SERVO_NUM*2] = '\0';
+
+    pJsonRoot = cJSON_CreateObject();
+    if (pJsonRoot != NULL)
+    {
+        cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Cmd, pcStr_Msg_Cmd_Servo);
+        cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Type, pcStr_Msg_Type_Servo_Write);
+        cJSON_AddNumberToObject(pJsonRoot, pcStr_Msg_Port, 0);
+        cJSON_AddNumberToObject(pJsonRoot, pcStr_Msg_Type_Servo_Time, 0);
+        cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Type_Servo_Angle, acAngle);
+        if (UBTEDU_RC_SUCCESS == RobotMessageTemplateCreate(&s_stServoWriteTemplate, pJsonRoot))
+        {
+            s_iServoWriteSlotPort = RobotMessageTemplateAddSlot(&s_stServoWriteTemplate, pcStr_Msg_Port,
+                                    ROBOT_MSG_PORT_WIDTH);
+            s_iServoWriteSlotTime = RobotMessageTemplateAddSlot(&s_stServoWriteTemplate, pcStr_Msg_Type_Servo_Time,
+                                    ROBOT_MSG_TEMPLATE_INT_WIDTH);
+            s_iServoWriteSlotAngle = RobotMessageTemplateAddSlot(&s_stServoWriteTemplate, pcStr_Msg_Type_Servo_Angle,
+                                     MAX_SERVO_NUM*2);
+        }
+        cJSON_Delete(pJsonRoot);
+    }
+}
+
+UBTEDU_RC_T ubtRobot_Msg_Encode_Heartbeat(char *pcSendBuf, int iBufLen)
+{
+    cJSON *pJsonRoot = NULL;
 
+    pJsonRoot = cJSON_CreateObject();
+    if (pJsonRoot == NULL)
+    {
+        printf("Failed to create json message!\r\n");
+        return UBTEDU_RC_NORESOURCE;
+    }
+
+    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Cmd, pcStr_Msg_Cmd_Heartbeat);
+    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Account, "sdk");
+    strncpy(pcSendBuf, cJSON_Print(pJsonRoot), iBufLen);
+    cJSON_Delete(pJsonRoot);
+
+    return UBTEDU_RC_SUCCESS;
+}
 
 UBTEDU_RC_T ubtRobot_Msg_Encode_SetRobotServo(int iPort, char *pcAllAngle, int iTime,
         char *pcSendBuf, int iBufLen)
 {
     cJSON *pJsonRoot = NULL;
 
+    /* The servo write only changes in port, time and angle, patch them into the template */
+    pthread_once(&s_stMsgTemplateOnce, _ubtRobot_Msg_TemplateInit);
+    if ((s_iServoWriteSlotAngle >= 0)
+        && (UBTEDU_RC_SUCCESS == RobotMessageTemplateRender(&s_stServoWriteTemplate, pcSendBuf, iBufLen))
+        && (UBTEDU_RC_SUCCESS == RobotMessageTemplateSetNumber(&s_stServoWriteTemplate, pcSendBuf,
+                s_iServoWriteSlotPort, iPort))
+        && (UBTEDU_RC_SUCCESS == RobotMessageTemplateSetNumber(&s_stServoWriteTemplate, pcSendBuf,
+                s_iServoWriteSlotTime, iTime))
+        && (UBTEDU_RC_SUCCESS == RobotMessageTemplateSetString(&s_stServoWriteTemplate, pcSendBuf,
+                s_iServoWriteSlotAngle, pcAllAngle)))
+    {
+        return UBTEDU_RC_SUCCESS;
+    }
+
     pJsonRoot = cJSON_CreateObject();
     if (pJsonRoot == NULL)
     {
@@ -642,7 +989,6 @@ UBTEDU_RC_T ubtRobot_Msg_Encode_SetRobotServo(int iPort, char *pcAllAngle, int i
 
 UBTEDU_RC_T ubtRobot_Msg_Decode_SetRobotServo(char *pcRecvBuf)
 {
-    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
     cJSON *pJson = NULL;
     cJSON *pNode = NULL;
     char acCmd[MSG_CMD_STR_MAX_LEN];
@@ -672,7 +1018,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SetRobotServo(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -691,7 +1037,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SetRobotServo(char *pcRecvBuf)
     }
     while (0);
     cJSON_Delete(pJson);
-    return ubtRet;
+    return ret;
 }
 
 UBTEDU_RC_T ubtRobot_Msg_Encode_SetRobotVolume_Plus(int iPort, char *pcSendBuf, int iBufLen)
@@ -789,7 +1135,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SetRobotVolume(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -838,7 +1184,6 @@ UBTEDU_RC_T ubtRobot_Msg_Encode_SetRobotMotion(char *pcCmd, char *pcType,
 
 UBTEDU_RC_T ubtRobot_Msg_Decode_SetRobotMotion(char *pcRecvBuf)
 {
-    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
     cJSON *pJson = NULL;
     cJSON *pNode = NULL;
     char acCmd[MSG_CMD_STR_MAX_LEN];
@@ -868,7 +1213,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SetRobotMotion(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -886,7 +1231,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SetRobotMotion(char *pcRecvBuf)
     }
     while (0);
     cJSON_Delete(pJson);
-    return ubtRet;
+    return ret;
 }
 
 
@@ -964,6 +1309,13 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
     {
         return UBTEDU_RC_WRONG_PARAM;
     }
+
+    ubtRet = _ubtRobot_Msg_Scan_ReadSensorValue(pcRecvBuf, pValue, iValueLen);
+    if (UBTEDU_RC_SOCKET_DECODE_FAILED != ubtRet)
+    {
+        return ubtRet;
+    }
+    ubtRet = UBTEDU_RC_FAILED;
     acCmd[0] = '\0';
     acType[0] = '\0';
 
@@ -982,7 +1334,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -991,7 +1343,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
         {
             if (pNode->type == cJSON_String)
             {
-                strcpy(acType, pNode->valuestring);
+                _ubtRobot_Msg_CopyString(acType, pNode->valuestring, sizeof(acType));
             }
         }
 
@@ -1000,7 +1352,8 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
             pstRobotGyro = (UBTEDU_ROBOTGYRO_SENSOR_T *)pValue;
             if (iValueLen != sizeof(UBTEDU_ROBOTGYRO_SENSOR_T))
             {
-                return UBTEDU_RC_WRONG_PARAM;
+                ubtRet = UBTEDU_RC_WRONG_PARAM;
+                break;
             }
             if ((pSubNode = cJSON_GetObjectItem(pNode, pcStr_Msg_Param_Query_Sensor_GYRO_X)) != NULL)
             {
@@ -1094,7 +1447,8 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
             pstRobotEnv = (UBTEDU_ROBOTENV_SENSOR_T *)pValue;
             if (iValueLen != sizeof(UBTEDU_ROBOTENV_SENSOR_T))
             {
-                return UBTEDU_RC_WRONG_PARAM;
+                ubtRet = UBTEDU_RC_WRONG_PARAM;
+                break;
             }
             if ((pSubNode = cJSON_GetObjectItem(pNode, pcStr_Msg_Param_Query_Sensor_ENV_Temperature)) != NULL)
             {
@@ -1125,7 +1479,8 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
             pstRobotBrdTemp = (UBTEDU_ROBOTRASPBOARD_SENSOR_T *)pValue;
             if (iValueLen != sizeof(UBTEDU_ROBOTRASPBOARD_SENSOR_T))
             {
-                return UBTEDU_RC_WRONG_PARAM;
+                ubtRet = UBTEDU_RC_WRONG_PARAM;
+                break;
             }
             pSubNode = cJSON_GetObjectItem(pNode, pcStr_Msg_Param_Query_Sensor_Board_Temperature);
             if (pSubNode != NULL)
@@ -1143,7 +1498,8 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
             pstRobotUltrasnic = (UBTEDU_ROBOTULTRASONIC_SENSOR_T *)pValue;
             if (iValueLen != sizeof(UBTEDU_ROBOTULTRASONIC_SENSOR_T))
             {
-                return UBTEDU_RC_WRONG_PARAM;
+                ubtRet = UBTEDU_RC_WRONG_PARAM;
+                break;
             }
             iCount = cJSON_GetArraySize(pNode);
             DebugTrace("Ultrasonic Array Number:%d\r\n", iCount);
@@ -1168,7 +1524,8 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
             pstRobotUltrasnic = (UBTEDU_ROBOTULTRASONIC_SENSOR_T *)pValue;
             if (iValueLen != sizeof(UBTEDU_ROBOTULTRASONIC_SENSOR_T))
             {
-                return UBTEDU_RC_WRONG_PARAM;
+                ubtRet = UBTEDU_RC_WRONG_PARAM;
+                break;
             }
             iCount = cJSON_GetArraySize(pNode);
             DebugTrace("Infrared Array Number:%d\r\n", iCount);
@@ -1193,13 +1550,15 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
             pstRobotTouch= (UBTEDU_ROBOTTOUCH_SENSOR_T *)pValue;
             if (iValueLen != sizeof(UBTEDU_ROBOTTOUCH_SENSOR_T))
             {
-                return UBTEDU_RC_WRONG_PARAM;
+                ubtRet = UBTEDU_RC_WRONG_PARAM;
+                break;
             }
             iCount = cJSON_GetArraySize(pNode);
             if(iCount < 1)
             {
                 DebugTrace("Touch Array is NULL");
-                return UBTEDU_RC_NOT_FOUND;
+                ubtRet = UBTEDU_RC_NOT_FOUND;
+                break;
             }
             pSubArray = cJSON_GetArrayItem(pNode, 0);
             pSubNode = cJSON_GetObjectItem(pSubArray, pcStr_Msg_Param_Query_Sensor_Value);
@@ -1217,13 +1576,15 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
             pstRobotColor= (UBTEDU_ROBOTCOLOR_SENSOR_T *)pValue;
             if (iValueLen != sizeof(UBTEDU_ROBOTCOLOR_SENSOR_T))
             {
-                return UBTEDU_RC_WRONG_PARAM;
+                ubtRet = UBTEDU_RC_WRONG_PARAM;
+                break;
             }
             iCount = cJSON_GetArraySize(pNode);
             if(iCount < 1)
             {
                 DebugTrace("Color Array is NULL");
-                return UBTEDU_RC_NOT_FOUND;
+                ubtRet = UBTEDU_RC_NOT_FOUND;
+                break;
             }
             pSubArray = cJSON_GetArrayItem(pNode, 0);
             pSubNode = cJSON_GetObjectItem(pSubArray, pcStr_Msg_Param_Query_Sensor_Value);
@@ -1244,13 +1605,15 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
             pstRobotPressure= (UBTEDU_ROBOTPRESSURE_SENSOR_T *)pValue;
             if (iValueLen != sizeof(UBTEDU_ROBOTPRESSURE_SENSOR_T))
             {
-                return UBTEDU_RC_WRONG_PARAM;
+                ubtRet = UBTEDU_RC_WRONG_PARAM;
+                break;
             }
             iCount = cJSON_GetArraySize(pNode);
             if(iCount < 1)
             {
                 DebugTrace("Pressure Array is NULL");
-                return UBTEDU_RC_NOT_FOUND;
+                ubtRet = UBTEDU_RC_NOT_FOUND;
+                break;
             }
             pSubArray = cJSON_GetArrayItem(pNode, 0);
             pSubNode = cJSON_GetObjectItem(pSubArray, pcStr_Msg_Param_Query_Sensor_Value);
@@ -1269,6 +1632,110 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorT
     return ubtRet;
 }
 
+/**
+ * @brief:      ubtRobot_Msg_Encode_ReadSensors
+ * @details:    Query several sensors in one message
+ * @param[in]   char *apcSensorType[]
+ * @param[in]   int iNum
+ * @param[in]   int iPort
+ * @param[out]  char *pcSendBuf
+ * @param[in]   int iBufLen
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtRobot_Msg_Encode_ReadSensors(char *apcSensorType[], int iNum, int iPort,
+        char *pcSendBuf, int iBufLen)
+{
+    cJSON   *pJsonRoot = NULL;
+    cJSON   *pArray = NULL;
+
+    pJsonRoot = cJSON_CreateObject();
+    pArray = cJSON_CreateStringArray((const char **)apcSensorType, iNum);
+    if ((pJsonRoot == NULL) || (pArray == NULL))
+    {
+        cJSON_Delete(pJsonRoot);
+        cJSON_Delete(pArray);
+        printf("Failed to create json message!\r\n");
+        return UBTEDU_RC_NORESOURCE;
+    }
+
+    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Cmd, pcStr_Msg_Cmd_Query);
+    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Type, pcStr_Msg_Type_Sensor);
+    cJSON_AddItemToObject(pJsonRoot, pcStr_Msg_Para, pArray);
+    cJSON_AddNumberToObject(pJsonRoot, pcStr_Msg_Port, iPort);
+
+    strncpy(pcSendBuf, cJSON_Print(pJsonRoot), iBufLen);
+    cJSON_Delete(pJsonRoot);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtRobot_Msg_Decode_ReadSensors
+ * @details:    Decode the answer to ubtRobot_Msg_Encode_ReadSensors(). It
+ *              holds the value of each sensor under its name, like the
+ *              answer to a single query. Each value is taken out into a
+ *              message of its own for ubtRobot_Msg_Decode_ReadSensorValue().
+ * @param[in]   char *pcRecvBuf
+ * @param[in]   char *apcSensorType[]
+ * @param[in]   int aiValueLen[]
+ * @param[in]   int iNum
+ * @param[out]  void *apValue[]
+ * @param[out]  UBTEDU_RC_T aeResult[]   Result of each sensor,
+ *                                       UBTEDU_RC_NOT_FOUND when the answer
+ *                                       has no value for it
+ * @retval:     UBTEDU_RC_T  The message could be decoded
+ */
+UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensors(char *pcRecvBuf, char *apcSensorType[], void *apValue[],
+        int aiValueLen[], UBTEDU_RC_T aeResult[], int iNum)
+{
+    cJSON *pJson = NULL, *pNode = NULL, *pOne = NULL;
+    char *pcOne;
+    int i;
+
+    /* Check parameters */
+    if ((NULL == pcRecvBuf) || (NULL == apcSensorType) || (NULL == apValue)
+        || (NULL == aiValueLen) || (NULL == aeResult))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pJson = cJSON_Parse(pcRecvBuf);
+    if ((pJson == NULL) || (pJson->type != cJSON_Object))
+    {
+        printf("Parse json message filed!\r\n");
+        cJSON_Delete(pJson);
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+
+    for (i = 0; i < iNum; i++)
+    {
+        aeResult[i] = UBTEDU_RC_NOT_FOUND;
+        pNode = cJSON_GetObjectItem(pJson, apcSensorType[i]);
+        if (pNode == NULL)
+        {
+            continue;
+        }
+        pOne = cJSON_CreateObject();
+        if (pOne == NULL)
+        {
+            aeResult[i] = UBTEDU_RC_NORESOURCE;
+            continue;
+        }
+        cJSON_AddItemReferenceToObject(pOne, apcSensorType[i], pNode);
+        pcOne = cJSON_PrintUnformatted(pOne);
+        cJSON_Delete(pOne);
+        if (pcOne == NULL)
+        {
+            aeResult[i] = UBTEDU_RC_NORESOURCE;
+            continue;
+        }
+        aeResult[i] = ubtRobot_Msg_Decode_ReadSensorValue(pcOne, apcSensorType[i], apValue[i], aiValueLen[i]);
+    }
+    cJSON_Delete(pJson);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
 UBTEDU_RC_T ubtRobot_Msg_Encode_SetRobotLED(int iPort, char *pcType,
         char *pcColor, char *pcMode,
         char *pcSendBuf, int iBufLen)
@@ -1340,7 +1807,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SetRobotLED(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -1439,7 +1906,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_StartRobotAction(char *pcRecvBuf, int *piTime)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -1525,7 +1992,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_StopRobotAction(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -1549,6 +2016,75 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_StopRobotAction(char *pcRecvBuf)
 }
 
 
+UBTEDU_RC_T ubtRobot_Msg_Encode_ControlRobotAction(int iPort, char *pcType,
+        char *pcSendBuf, int iBufLen)
+{
+    cJSON   *pJsonRoot = NULL;
+
+    if ((NULL == pcType) || (NULL == pcSendBuf))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pJsonRoot = cJSON_CreateObject();
+    if (pJsonRoot == NULL)
+    {
+        printf("Failed to create json message!\r\n");
+        return UBTEDU_RC_NORESOURCE;
+    }
+
+    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Cmd, pcStr_Msg_Cmd_Action);
+    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Type, pcType);
+    cJSON_AddNumberToObject(pJsonRoot, pcStr_Msg_Port,  iPort);
+
+    strncpy(pcSendBuf, cJSON_Print(pJsonRoot), iBufLen);
+    cJSON_Delete(pJsonRoot);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+UBTEDU_RC_T ubtRobot_Msg_Decode_ControlRobotAction(char *pcRecvBuf)
+{
+    cJSON *pJson = NULL;
+    cJSON *pNode = NULL;
+    char acCmd[MSG_CMD_STR_MAX_LEN];
+
+    UBTEDU_RC_T ret = UBTEDU_RC_FAILED;
+
+    /* Check parameters */
+    if (NULL == pcRecvBuf)
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    acCmd[0] = '\0';
+
+    pJson   = cJSON_Parse(pcRecvBuf);
+    if (pJson == NULL)
+    {
+        printf("Parse json message filed!\r\n");
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+
+    pNode   = cJSON_GetObjectItem(pJson, pcStr_Msg_Cmd);
+    if ((pNode != NULL) && (pNode->type == cJSON_String))
+    {
+        _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
+    }
+
+    pNode   = cJSON_GetObjectItem(pJson, pcStr_Ret_Msg_Status);
+    if ((pNode != NULL) && (pNode->type == cJSON_String))
+    {
+        if (!strcmp(pNode->valuestring, "ok") && !strcmp(acCmd, pcStr_Msg_Cmd_Action_Ack))
+        {
+            ret = UBTEDU_RC_SUCCESS;
+        }
+    }
+    cJSON_Delete(pJson);
+
+    return ret;
+}
+
+
 UBTEDU_RC_T ubtRobot_Msg_Encode_VoiceStart(int iPort,
         char *pcSendBuf, int iBufLen)
 {
@@ -1603,7 +2139,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_VoiceStart(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -1680,7 +2216,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_VoiceStop(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -1761,7 +2297,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_VoiceTTS(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -1839,7 +2375,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_PlayMusic(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -1925,7 +2461,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_GetMusic(char *pcRecvBuf,
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -2005,7 +2541,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_TakePhotos(char *pcRecvBuf, int iPhotoNameLen)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -2085,7 +2621,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_EventDetect(char *pcRecvBuf, char *pcValue)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
         pNode   = cJSON_GetObjectItem(pJson, pcStr_Msg_Type);
@@ -2093,7 +2629,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_EventDetect(char *pcRecvBuf, char *pcValue)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(type, pNode->valuestring, sizeof(type));
+                _ubtRobot_Msg_CopyString(type, pNode->valuestring, sizeof(type));
             }
         }
 
@@ -2193,7 +2729,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_VisionDetect(char *pcRecvBuf, char *pcValue)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
         pNode   = cJSON_GetObjectItem(pJson, pcStr_Msg_Type);
@@ -2201,7 +2737,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_VisionDetect(char *pcRecvBuf, char *pcValue)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(type, pNode->valuestring, sizeof(type));
+                _ubtRobot_Msg_CopyString(type, pNode->valuestring, sizeof(type));
             }
         }
 
@@ -2323,7 +2859,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_TransmitCMD(char *pcRecvBuf, char *pcRemoteCmdRe
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -2477,7 +3013,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_RobotDiscovery(char *pcRecvBuf, UBTEDU_ROBOTINFO
         {
             if (pNode->type == cJSON_String)
             {
-                strcpy(acStatus, pNode->valuestring);
+                _ubtRobot_Msg_CopyString(acStatus, pNode->valuestring, sizeof(acStatus));
             }
         }
 
@@ -2566,7 +3102,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ConnectRobot(char *pcRecvBuf, char *pcRobotName,
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acStatus, pNode->valuestring, sizeof(acStatus));
+                _ubtRobot_Msg_CopyString(acStatus, pNode->valuestring, sizeof(acStatus));
             }
         }
         ubtRet = UBTEDU_RC_SUCCESS;
@@ -2644,7 +3180,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_DisconnectRobot(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acName, pNode->valuestring, sizeof(acName));
+                _ubtRobot_Msg_CopyString(acName, pNode->valuestring, sizeof(acName));
             }
         }
 
@@ -2653,7 +3189,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_DisconnectRobot(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acStatus, pNode->valuestring, sizeof(acStatus));
+                _ubtRobot_Msg_CopyString(acStatus, pNode->valuestring, sizeof(acStatus));
             }
         }
         ubtRet = UBTEDU_RC_SUCCESS;
@@ -2715,7 +3251,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmInit(char *pcRecvBuf, int *piSeq, char *pcT
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -2852,7 +3388,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmAllocID(char *pcRecvBuf, int *piSeq,
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -2866,7 +3402,16 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmAllocID(char *pcRecvBuf, int *piSeq,
         }
 
         pcNode   = cJSON_GetObjectItem(pcJson, pcStr_Msg_Param_Swarm_RobotList);
+        if ((pcNode == NULL) || (pcNode->type != cJSON_Array))
+        {
+            break;
+        }
+        /* The list is as long as the swarm, not as the room of the caller */
         iCount = cJSON_GetArraySize(pcNode);
+        if (iCount > iMacLen)
+        {
+            iCount = iMacLen;
+        }
         *piCount = iCount;
         for(i=0; i<iCount; i++)
         {
@@ -2885,7 +3430,8 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmAllocID(char *pcRecvBuf, int *piSeq,
             {
                 if (pSubNode->type == cJSON_String)
                 {
-                    strncpy((char *)(&(pcMacAddr[i])), pSubNode->valuestring, sizeof(ROBOTAGENT_MAC_T));
+                    _ubtRobot_Msg_CopyString((char *)(&(pcMacAddr[i])), pSubNode->valuestring,
+                            sizeof(ROBOTAGENT_MAC_T));
                 }
             }
         }
@@ -2986,7 +3532,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmActionStart(char *pcRecvBuf,
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -3135,7 +3681,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmActionEnd(char *pcRecvBuf,
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -3230,11 +3776,11 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmActionEndAck(char *pcRecvBuf, int *piSeq, i
         {
             if (pcNode->type == cJSON_String)
             {
-                if ( 0 != strcmp(pcNode->valuestring, pcStr_Msg_Type_SwarmActionEnd))
+                if ( 0 != strcmp(pcNode->valuestring, pcStr_Msg_Type_SwarmActionEndAck))
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -3318,7 +3864,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmActionCancel(char *pcRecvBuf, int *piSeq)
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -3386,7 +3932,6 @@ UBTEDU_RC_T ubtRobot_Msg_Encode_SwarmGotoXYZ(char *pcAccount, int iPort, int iSe
     cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_X, pstXYZ->iX);
     cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_Y, pstXYZ->iY);
     cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_Z, pstXYZ->iZ);
-    cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_Z, pstXYZ->iZ);
     cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_Order, pstXYZ->iOrder);
     cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_SEQ, iSeq);
 
@@ -3444,7 +3989,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmGotoXYZ(char *pcRecvBuf, int *piId,
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -3613,7 +4158,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmReachXYZ(char *pcRecvBuf,
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -3713,7 +4258,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmReachXYZAck(char *pcRecvBuf,
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -3814,7 +4359,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmQueryXYZ(char *pcRecvBuf,
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -3863,7 +4408,6 @@ UBTEDU_RC_T ubtRobot_Msg_Encode_SwarmQueryXYZAck(char *pcAccount, int iPort, int
     cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_X, pstXYZ->iX);
     cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_Y, pstXYZ->iY);
     cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_Z, pstXYZ->iZ);
-    cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_Z, pstXYZ->iZ);
     cJSON_AddNumberToObject(pcJsonRoot, pcStr_Msg_Param_Swarm_Order, pstXYZ->iOrder);
     cJSON_AddStringToObject(pcJsonRoot, pcStr_Ret_Msg_Status, pcStatus);
 
@@ -3919,11 +4463,11 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SwarmQueryXYZAck(char *pcRecvBuf,
         {
             if (pcNode->type == cJSON_String)
             {
-                if ( 0 != strcmp(pcNode->valuestring, pcStr_Msg_Type_SwarmActionReachXYZAck))
+                if ( 0 != strcmp(pcNode->valuestring, pcStr_Msg_Type_SwarmActionQueryXYZAck))
                 {
                     break;
                 }
-                strncpy(acType, pcNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pcNode->valuestring, sizeof(acType));
             }
         }
 
@@ -4048,7 +4592,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SearchSensor(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -4057,7 +4601,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_SearchSensor(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acType, pNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pNode->valuestring, sizeof(acType));
             }
         }
 
@@ -4146,7 +4690,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ModifySensorID(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acCmd, pNode->valuestring, sizeof(acCmd));
+                _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
             }
         }
 
@@ -4155,7 +4699,7 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ModifySensorID(char *pcRecvBuf)
         {
             if (pNode->type == cJSON_String)
             {
-                strncpy(acType, pNode->valuestring, sizeof(acType));
+                _ubtRobot_Msg_CopyString(acType, pNode->valuestring, sizeof(acType));
             }
         }
 
@@ -4178,4 +4722,191 @@ UBTEDU_RC_T ubtRobot_Msg_Decode_ModifySensorID(char *pcRecvBuf)
     return ubtRet;
 }
 
+/**
+ * @brief:      _ubtRobot_Msg_Encode_SensorConfig
+ * @details:    Configure the pushed sampling of one sensor
+ * @param[in]   int iPort
+ * @param[in]   char *pcConfigType   mode or frequency
+ * @param[in]   char *pcSensorType
+ * @param[in]   cJSON *pValue        Taken over by the message
+ * @param[out]  char *pcSendBuf
+ * @param[in]   int iBufLen
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _ubtRobot_Msg_Encode_SensorConfig(int iPort, char *pcConfigType, char *pcSensorType,
+        cJSON *pValue, char *pcSendBuf, int iBufLen)
+{
+    cJSON   *pJsonRoot = NULL;
+    cJSON   *pSubJson = NULL;
+
+    pJsonRoot = cJSON_CreateObject();
+    pSubJson = cJSON_CreateObject();
+    if ((pJsonRoot == NULL) || (pSubJson == NULL) || (pValue == NULL))
+    {
+        cJSON_Delete(pJsonRoot);
+        cJSON_Delete(pSubJson);
+        cJSON_Delete(pValue);
+        printf("Failed to create json message!\r\n");
+        return UBTEDU_RC_NORESOURCE;
+    }
+
+    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Cmd, pcStr_Msg_Cmd_Sensor_Config);
+    cJSON_AddStringToObject(pJsonRoot, pcStr_Msg_Type, pcConfigType);
+    cJSON_AddNumberToObject(pJsonRoot, pcStr_Msg_Port,  iPort);
+
+    cJSON_AddStringToObject(pSubJson, pcStr_Msg_Type, pcSensorType);
+    cJSON_AddItemToObject(pSubJson, pcStr_Msg_Value, pValue);
+    cJSON_AddItemToObject(pJsonRoot, pcStr_Msg_Para, pSubJson);
+
+    strncpy(pcSendBuf, cJSON_Print(pJsonRoot), iBufLen);
+    cJSON_Delete(pJsonRoot);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      ubtRobot_Msg_Encode_SensorFrequency
+ * @details:    Set the rate the robot pushes a sensor's samples at
+ * @param[in]   int iPort           Port the samples are pushed to
+ * @param[in]   char *pcSensorType
+ * @param[in]   int iFrequency      In Hz
+ * @param[out]  char *pcSendBuf
+ * @param[in]   int iBufLen
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtRobot_Msg_Encode_SensorFrequency(int iPort, char *pcSensorType, int iFrequency,
+        char *pcSendBuf, int iBufLen)
+{
+    return _ubtRobot_Msg_Encode_SensorConfig(iPort, pcStr_Msg_Type_Sensor_FREQ, pcSensorType,
+            cJSON_CreateNumber(iFrequency), pcSendBuf, iBufLen);
+}
+
+/**
+ * @brief:      ubtRobot_Msg_Encode_SensorMode
+ * @details:    Start or stop pushing a sensor's samples
+ * @param[in]   int iPort           Port the samples are pushed to
+ * @param[in]   char *pcSensorType
+ * @param[in]   char *pcMode        start or stop
+ * @param[out]  char *pcSendBuf
+ * @param[in]   int iBufLen
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T ubtRobot_Msg_Encode_SensorMode(int iPort, char *pcSensorType, char *pcMode,
+        char *pcSendBuf, int iBufLen)
+{
+    return _ubtRobot_Msg_Encode_SensorConfig(iPort, pcStr_Msg_Type_Sensor_MODE, pcSensorType,
+            cJSON_CreateString(pcMode), pcSendBuf, iBufLen);
+}
+
+/**
+ * @brief:      ubtRobot_Msg_Decode_SensorConfig
+ * @details:    Check the answer to a mode or frequency configuration
+ * @param[in]   char *pcRecvBuf
+ * @param[in]   char *pcConfigType   mode or frequency
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_SOCKET_DECODE_ERROR when it is not that answer
+ */
+UBTEDU_RC_T ubtRobot_Msg_Decode_SensorConfig(char *pcRecvBuf, char *pcConfigType)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    cJSON *pJson = NULL;
+    cJSON *pNode = NULL;
+    char acCmd[MSG_CMD_STR_MAX_LEN],acType[MSG_CMD_STR_MAX_LEN];
+
+    /* Check parameters */
+    if ((NULL == pcRecvBuf) || (NULL == pcConfigType))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    acCmd[0] = '\0';
+    acType[0] = '\0';
+
+    pJson   = cJSON_Parse(pcRecvBuf);
+    if (pJson == NULL)
+    {
+        printf("Parse json message filed!\r\n");
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+
+    do
+    {
+        pNode = cJSON_GetObjectItem(pJson, pcStr_Msg_Cmd);
+        if ((pNode != NULL) && (pNode->type == cJSON_String))
+        {
+            _ubtRobot_Msg_CopyString(acCmd, pNode->valuestring, sizeof(acCmd));
+        }
+        pNode = cJSON_GetObjectItem(pJson, pcStr_Msg_Type);
+        if ((pNode != NULL) && (pNode->type == cJSON_String))
+        {
+            _ubtRobot_Msg_CopyString(acType, pNode->valuestring, sizeof(acType));
+        }
+        if (strcmp(acCmd, pcStr_Msg_Cmd_Sensor_Config_Ack) || strcmp(acType, pcConfigType))
+        {
+            ubtRet = UBTEDU_RC_SOCKET_DECODE_ERROR;
+            break;
+        }
+
+        pNode = cJSON_GetObjectItem(pJson, pcStr_Ret_Msg_Status);
+        if ((pNode != NULL) && (pNode->type == cJSON_String) && !strcmp(pNode->valuestring, "ok"))
+        {
+            ubtRet = UBTEDU_RC_SUCCESS;
+        }
+    }
+    while (0);
+    cJSON_Delete(pJson);
+    return ubtRet;
+}
+
+/**
+ * @brief:      ubtRobot_Msg_Decode_SensorType
+ * @details:    Find which of the sensors a sample is of. Pushed samples
+ *              look like the answers to ubtRobot_Msg_Encode_ReadSensorValue().
+ * @param[in]   char *pcRecvBuf
+ * @param[in]   char **ppcSensorType   Sensor names to look for
+ * @param[in]   int iTypeNum
+ * @param[out]  int *piType            Index of the sensor in ppcSensorType
+ * @retval:     UBTEDU_RC_NOT_FOUND when it is none of them
+ */
+UBTEDU_RC_T ubtRobot_Msg_Decode_SensorType(char *pcRecvBuf, char **ppcSensorType, int iTypeNum, int *piType)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_NOT_FOUND;
+    ROBOT_MSG_SCAN_T stScan;
+    cJSON *pJson = NULL;
+    int i;
+
+    if ((NULL == pcRecvBuf) || (NULL == ppcSensorType) || (NULL == piType))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    if (UBTEDU_RC_SUCCESS == RobotMessageScanBuild(&stScan, pcRecvBuf))
+    {
+        for (i = 0; i < iTypeNum; i++)
+        {
+            if (RobotMessageScanFind(&stScan, ROBOT_MSG_SCAN_ROOT, ppcSensorType[i]) >= 0)
+            {
+                *piType = i;
+                return UBTEDU_RC_SUCCESS;
+            }
+        }
+        return UBTEDU_RC_NOT_FOUND;
+    }
+
+    pJson = cJSON_Parse(pcRecvBuf);
+    if (pJson == NULL)
+    {
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+    for (i = 0; i < iTypeNum; i++)
+    {
+        if (cJSON_GetObjectItem(pJson, ppcSensorType[i]) != NULL)
+        {
+            *piType = i;
+            ubtRet = UBTEDU_RC_SUCCESS;
+            break;
+        }
+    }
+    cJSON_Delete(pJson);
+    return ubtRet;
+}
 
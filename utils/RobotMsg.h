@@ -36,6 +36,7 @@ typedef struct robotagent_sc_coordinates_t
 
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_CheckAPPStatus(char *pcRecvBuf);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_ConnectRobot(char *pcRecvBuf, char *pcRobotName, int iRobotNameLen);
+extern UBTEDU_RC_T ubtRobot_Msg_Decode_ControlRobotAction(char *pcRecvBuf);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_DiscoveryRobot(char *pcRecvBuf, char *pcRobotName, int iRobotNameLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_DetectVoiceMsg(char *pcRecvBuf);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_DisconnectRobot(char *pcRecvBuf);
@@ -44,7 +45,12 @@ extern UBTEDU_RC_T ubtRobot_Msg_Decode_GetMusic(char *pcRecvBuf,
         int iMusicNameNum, int *piIndex);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_PlayMusic(char *pcRecvBuf);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_ReadRobotServo(char *pcRecvBuf, char *pcAllAngle, int iAngleLen);
+extern UBTEDU_RC_T ubtRobot_Msg_Decode_ReadServoOffset(char *pcRecvBuf, char *pcAllOffset, int iOffsetLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensorValue(char *pcRecvBuf, char *pcSensorType, void *pValue, int iValueLen);
+extern UBTEDU_RC_T ubtRobot_Msg_Encode_ReadSensors(char *apcSensorType[], int iNum, int iPort,
+        char *pcSendBuf, int iBufLen);
+extern UBTEDU_RC_T ubtRobot_Msg_Decode_ReadSensors(char *pcRecvBuf, char *apcSensorType[], void *apValue[],
+        int aiValueLen[], UBTEDU_RC_T aeResult[], int iNum);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_ReportStatusToApp(char *pcRecvBuf);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_RobotStatus(char *pcType, char *pcRecvBuf, void *pStatus);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_RobotDiscovery(char *pcRecvBuf, UBTEDU_ROBOTINFO_T  *pstRobotInfo);
@@ -116,18 +122,22 @@ extern UBTEDU_RC_T ubtRobot_Msg_Encode_CheckAPPStatus(char *pcCmd, char *pcType,
         char *pcBuf, char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Encode_ConnectRobot(char *pcAccount, int iPort,
         char *pcSendBuf, int iBufLen);
+extern UBTEDU_RC_T ubtRobot_Msg_Encode_ControlRobotAction(int iPort, char *pcType,
+        char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Encode_DetectVoiceMsg(int iPort,
         char *pcBuf, char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Encode_StopVoiceRecognition(int iPort,
         char *pcBuf, char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Encode_DisconnectRobot(char *pcAccount, int iPort,
         char *pcSendBuf, int iBufLen);
+extern UBTEDU_RC_T ubtRobot_Msg_Encode_Heartbeat(char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Encode_GetMusic(int iPort, int iIndex,
         char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Encode_PlayMusic(char *pcPlayMusicType, int iPort, char *pcName,
         char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Encode_ReadRobotServo(int iPort, char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Encode_ReadRobotServoHold(int iPort, char *pcSendBuf, int iBufLen);
+extern UBTEDU_RC_T ubtRobot_Msg_Encode_ReadServoOffset(int iPort, char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Encode_ReadSensorValue(char *pcSensorType, int iPort,
         char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Encode_ReadSensorValueByAddr(char *pcSensorType, int iAddr, int iPort,
@@ -198,6 +208,12 @@ extern UBTEDU_RC_T ubtRobot_Msg_Encode_ModifySensorID(int iPort,
         char *pcType, int iCurrID,int iDstID,
         char *pcSendBuf, int iBufLen);
 extern UBTEDU_RC_T ubtRobot_Msg_Decode_ModifySensorID(char *pcRecvBuf);
+extern UBTEDU_RC_T ubtRobot_Msg_Encode_SensorFrequency(int iPort, char *pcSensorType, int iFrequency,
+        char *pcSendBuf, int iBufLen);
+extern UBTEDU_RC_T ubtRobot_Msg_Encode_SensorMode(int iPort, char *pcSensorType, char *pcMode,
+        char *pcSendBuf, int iBufLen);
+extern UBTEDU_RC_T ubtRobot_Msg_Decode_SensorConfig(char *pcRecvBuf, char *pcConfigType);
+extern UBTEDU_RC_T ubtRobot_Msg_Decode_SensorType(char *pcRecvBuf, char **ppcSensorType, int iTypeNum, int *piType);
 
 #ifdef __cplusplus
 #if __cplusplus
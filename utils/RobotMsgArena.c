@@ -0,0 +1,268 @@
+/**
+ * @file				RobotMsgArena.c
+ * @brief			Per request arena allocator for the cJSON message codec
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * Every encode and decode in RobotMsg.c builds a cJSON tree node by node.
+ * Between RobotMessageArenaBegin() and RobotMessageArenaEnd() those nodes are
+ * bumped out of a thread local arena instead of the system heap, and the
+ * whole cycle is released by RobotMessageArenaEnd() in one step. Cycles
+ * nest: a helper may open its own, the memory is only released when the
+ * outermost one ends. Threads which never call RobotMessageArenaBegin()
+ * keep using malloc()/free(), so an encoder called outside a cycle leaks
+ * its printed buffer: every encode in RobotApi.c is inside one.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "cJSON.h"
+
+#include "RobotMsgArena.h"
+
+
+typedef struct robot_msg_arena_block_t {
+    struct robot_msg_arena_block_t *pstNext;
+    size_t szSize;              /* Usable bytes in acData */
+    size_t szUsed;              /* Bytes already handed out */
+    char acData[];
+} ROBOT_MSG_ARENA_BLOCK_T;
+
+typedef struct {
+    ROBOT_MSG_ARENA_BLOCK_T *pstHead;   /* First block, kept across cycles */
+    ROBOT_MSG_ARENA_BLOCK_T *pstCurr;   /* Block used for the next allocation */
+    int iDepth;                         /* Cycles open, 0 outside of a cycle */
+    ROBOT_MSG_ARENA_STATS_T stStats;
+} ROBOT_MSG_ARENA_T;
+
+
+static __thread ROBOT_MSG_ARENA_T *g_pstArena = NULL;
+static pthread_key_t g_stArenaKey;
+static pthread_once_t g_stArenaOnce = PTHREAD_ONCE_INIT;
+
+
+static ROBOT_MSG_ARENA_BLOCK_T *_RobotArenaBlockNew(size_t szSize)
+{
+    ROBOT_MSG_ARENA_BLOCK_T *pstBlock;
+
+    if (szSize > SIZE_MAX - sizeof(ROBOT_MSG_ARENA_BLOCK_T))
+    {
+        return NULL;
+    }
+    pstBlock = malloc(sizeof(ROBOT_MSG_ARENA_BLOCK_T) + szSize);
+    if (NULL == pstBlock)
+    {
+        return NULL;
+    }
+    pstBlock->pstNext = NULL;
+    pstBlock->szSize = szSize;
+    pstBlock->szUsed = 0;
+
+    return pstBlock;
+}
+
+static int _RobotArenaOwns(ROBOT_MSG_ARENA_T *pstArena, void *ptr)
+{
+    ROBOT_MSG_ARENA_BLOCK_T *pstBlock;
+
+    if (NULL == pstArena)
+    {
+        return 0;
+    }
+    for (pstBlock = pstArena->pstHead; pstBlock != NULL; pstBlock = pstBlock->pstNext)
+    {
+        if (((char *)ptr >= pstBlock->acData) && ((char *)ptr < pstBlock->acData + pstBlock->szSize))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void *_RobotArenaMalloc(size_t sz)
+{
+    ROBOT_MSG_ARENA_T *pstArena = g_pstArena;
+    ROBOT_MSG_ARENA_BLOCK_T *pstBlock;
+    size_t szSize;
+    void *ptr;
+
+    if ((NULL == pstArena) || (0 == pstArena->iDepth))
+    {
+        if (NULL != pstArena)
+        {
+            pstArena->stStats.ulSystemAllocs++;
+        }
+        return malloc(sz);
+    }
+
+    if (sz > SIZE_MAX - ROBOT_MSG_ARENA_ALIGN)
+    {
+        return NULL;
+    }
+    szSize = (sz + ROBOT_MSG_ARENA_ALIGN - 1) & ~((size_t)ROBOT_MSG_ARENA_ALIGN - 1);
+    pstBlock = pstArena->pstCurr;
+    while (szSize > pstBlock->szSize - pstBlock->szUsed)
+    {
+        if (NULL == pstBlock->pstNext)
+        {
+            /* Grow by doubling, big single allocations get their own block */
+            pstBlock->pstNext = _RobotArenaBlockNew((szSize > pstBlock->szSize*2) ? szSize : pstBlock->szSize*2);
+            if (NULL == pstBlock->pstNext)
+            {
+                return NULL;
+            }
+            pstArena->stStats.szBlockBytes += pstBlock->pstNext->szSize;
+        }
+        pstBlock = pstBlock->pstNext;
+    }
+
+    ptr = pstBlock->acData + pstBlock->szUsed;
+    pstBlock->szUsed += szSize;
+    pstArena->pstCurr = pstBlock;
+    pstArena->stStats.ulArenaAllocs++;
+
+    return ptr;
+}
+
+static void _RobotArenaFree(void *ptr)
+{
+    /* Arena memory is only given back by RobotMessageArenaEnd() */
+    if ((NULL == ptr) || _RobotArenaOwns(g_pstArena, ptr))
+    {
+        return;
+    }
+    free(ptr);
+}
+
+static void _RobotArenaDestroy(void *pArena)
+{
+    ROBOT_MSG_ARENA_T *pstArena = pArena;
+    ROBOT_MSG_ARENA_BLOCK_T *pstBlock, *pstNext;
+
+    for (pstBlock = pstArena->pstHead; pstBlock != NULL; pstBlock = pstNext)
+    {
+        pstNext = pstBlock->pstNext;
+        free(pstBlock);
+    }
+    free(pstArena);
+}
+
+static void _RobotArenaOnce(void)
+{
+    cJSON_Hooks stHooks;
+
+    pthread_key_create(&g_stArenaKey, _RobotArenaDestroy);
+
+    stHooks.malloc_fn = _RobotArenaMalloc;
+    stHooks.free_fn = _RobotArenaFree;
+    cJSON_InitHooks(&stHooks);
+}
+
+/**
+ * @brief:      RobotMessageArenaBegin
+ * @details:    Start a request/response cycle on the calling thread. All the
+ *              cJSON memory is taken from the thread's arena until the
+ *              matching RobotMessageArenaEnd(). A cycle started inside
+ *              another one is part of it.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+void RobotMessageArenaBegin(void)
+{
+    ROBOT_MSG_ARENA_T *pstArena;
+
+    pthread_once(&g_stArenaOnce, _RobotArenaOnce);
+
+    pstArena = g_pstArena;
+    if (NULL == pstArena)
+    {
+        pstArena = malloc(sizeof(ROBOT_MSG_ARENA_T));
+        if (NULL == pstArena)
+        {
+            return;
+        }
+        memset(pstArena, 0, sizeof(ROBOT_MSG_ARENA_T));
+        pstArena->pstHead = _RobotArenaBlockNew(ROBOT_MSG_ARENA_BLOCK_SIZE);
+        if (NULL == pstArena->pstHead)
+        {
+            free(pstArena);
+            return;
+        }
+        pstArena->pstCurr = pstArena->pstHead;
+        pstArena->stStats.szBlockBytes = ROBOT_MSG_ARENA_BLOCK_SIZE;
+        pthread_setspecific(g_stArenaKey, pstArena);
+        g_pstArena = pstArena;
+    }
+
+    pstArena->iDepth++;
+}
+
+/**
+ * @brief:      RobotMessageArenaEnd
+ * @details:    Finish the cycle. Ending the outermost one releases
+ *              everything allocated since it began, the blocks are kept for
+ *              the next cycle. No cJSON item or printed buffer of the cycle
+ *              may be used after that.
+ * @param[in]   None
+ * @param[out]  None
+ * @retval:     void
+ */
+void RobotMessageArenaEnd(void)
+{
+    ROBOT_MSG_ARENA_T *pstArena = g_pstArena;
+    ROBOT_MSG_ARENA_BLOCK_T *pstBlock;
+    size_t szUsed = 0;
+
+    if ((NULL == pstArena) || (0 == pstArena->iDepth))
+    {
+        return;
+    }
+
+    if (0 == --pstArena->iDepth)
+    {
+        for (pstBlock = pstArena->pstHead; pstBlock != NULL; pstBlock = pstBlock->pstNext)
+        {
+            szUsed += pstBlock->szUsed;
+            pstBlock->szUsed = 0;
+        }
+        if (szUsed > pstArena->stStats.szHighWater)
+        {
+            pstArena->stStats.szHighWater = szUsed;
+        }
+        pstArena->stStats.ulResets++;
+        pstArena->pstCurr = pstArena->pstHead;
+    }
+}
+
+/**
+ * @brief:      RobotMessageArenaGetStats
+ * @details:    Get the allocation counters of the calling thread's arena
+ * @param[out]  pstStats
+ * @retval:     void
+ */
+void RobotMessageArenaGetStats(ROBOT_MSG_ARENA_STATS_T *pstStats)
+{
+    if (NULL == pstStats)
+    {
+        return;
+    }
+
+    if (NULL == g_pstArena)
+    {
+        memset(pstStats, 0, sizeof(ROBOT_MSG_ARENA_STATS_T));
+        return;
+    }
+    memcpy(pstStats, &g_pstArena->stStats, sizeof(ROBOT_MSG_ARENA_STATS_T));
+}
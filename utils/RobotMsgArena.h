@@ -0,0 +1,53 @@
+/**
+ * @file				RobotMsgArena.h
+ * @brief			RobotMsgArena.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTMSGARENA_H__
+#define __ROBOTMSGARENA_H__
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Size of the first block of each thread's arena */
+#define ROBOT_MSG_ARENA_BLOCK_SIZE     (16*1024)
+/* Every allocation is rounded up to this alignment */
+#define ROBOT_MSG_ARENA_ALIGN          (8)
+
+
+typedef struct {
+    unsigned long ulArenaAllocs;    /* Allocations served from the arena */
+    unsigned long ulSystemAllocs;   /* Allocations which went to the system malloc */
+    unsigned long ulResets;         /* Number of request/response cycles */
+    size_t        szHighWater;      /* Max bytes used in one cycle */
+    size_t        szBlockBytes;     /* Bytes reserved by the arena blocks */
+} ROBOT_MSG_ARENA_STATS_T;
+
+
+extern void RobotMessageArenaBegin(void);
+extern void RobotMessageArenaEnd(void);
+extern void RobotMessageArenaGetStats(ROBOT_MSG_ARENA_STATS_T *pstStats);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTMSGARENA_H__ */
@@ -0,0 +1,418 @@
+/**
+ * @file				RobotMsgScan.c
+ * @brief			Structural index of the robot JSON replies
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * RobotMessageScanBuild() records the offset of every structural character
+ * of a reply, { } [ ] : , and the quotes around strings, in one pass. The
+ * candidate bytes are found 16 (NEON, SSE2) or 32 (AVX2) at a time and only
+ * the hits are looked at one by one to follow strings and escapes. The
+ * decoders then read the few values they need straight from the buffer
+ * instead of building a cJSON tree.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <limits.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ROBOT_MSG_SCAN_NEON
+#define ROBOT_MSG_SCAN_BLOCK        (16)
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define ROBOT_MSG_SCAN_AVX2
+#define ROBOT_MSG_SCAN_BLOCK        (32)
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define ROBOT_MSG_SCAN_SSE2
+#define ROBOT_MSG_SCAN_BLOCK        (16)
+#endif
+
+#include "voice_datatypes.h"
+#include "cJSON.h"
+
+#include "RobotMsgScan.h"
+
+
+/* Max nesting of objects and arrays in one reply */
+#define ROBOT_MSG_SCAN_MAX_DEPTH    (32)
+
+typedef struct {
+    int iInString;
+    int iSkip;          /* Escaped position inside a string */
+    int iDepth;
+    char acStack[ROBOT_MSG_SCAN_MAX_DEPTH];
+} ROBOT_MSG_SCAN_STATE_T;
+
+
+#if defined(ROBOT_MSG_SCAN_NEON)
+static unsigned int _RobotScanMask(const char *pcBlock)
+{
+    static const uint8_t aucBit[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t v = vld1q_u8((const uint8_t *)pcBlock);
+    uint8x16_t l = vorrq_u8(v, vdupq_n_u8(0x20));
+    uint8x16_t m;
+    uint8x8_t  s;
+
+    m = vceqq_u8(v, vdupq_n_u8('"'));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\\')));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8(':')));
+    m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8(',')));
+    /* '[' and ']' are '{' and '}' without 0x20 */
+    m = vorrq_u8(m, vceqq_u8(l, vdupq_n_u8('{')));
+    m = vorrq_u8(m, vceqq_u8(l, vdupq_n_u8('}')));
+
+    m = vandq_u8(m, vld1q_u8(aucBit));
+    s = vpadd_u8(vget_low_u8(m), vget_high_u8(m));
+    s = vpadd_u8(s, s);
+    s = vpadd_u8(s, s);
+
+    return vget_lane_u8(s, 0) | (vget_lane_u8(s, 1) << 8);
+}
+#elif defined(ROBOT_MSG_SCAN_AVX2)
+static unsigned int _RobotScanMask(const char *pcBlock)
+{
+    __m256i v = _mm256_loadu_si256((const __m256i *)pcBlock);
+    __m256i l = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+    __m256i m;
+
+    m = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(l, _mm256_set1_epi8('{')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(l, _mm256_set1_epi8('}')));
+
+    return (unsigned int)_mm256_movemask_epi8(m);
+}
+#elif defined(ROBOT_MSG_SCAN_SSE2)
+static unsigned int _RobotScanMask(const char *pcBlock)
+{
+    __m128i v = _mm_loadu_si128((const __m128i *)pcBlock);
+    __m128i l = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    __m128i m;
+
+    m = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(':')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(',')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(l, _mm_set1_epi8('{')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(l, _mm_set1_epi8('}')));
+
+    return (unsigned int)_mm_movemask_epi8(m);
+}
+#endif
+
+static int _RobotScanIsCandidate(char c)
+{
+    switch (c)
+    {
+        case '"':
+        case '\\':
+        case ':':
+        case ',':
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int _RobotScanStep(ROBOT_MSG_SCAN_T *pstScan, ROBOT_MSG_SCAN_STATE_T *pstState, int iPos)
+{
+    char c = pstScan->pcBuf[iPos];
+
+    if (pstState->iInString)
+    {
+        if ((iPos == pstState->iSkip) || (c != '"' && c != '\\'))
+        {
+            return 0;
+        }
+        if (c == '\\')
+        {
+            pstState->iSkip = iPos + 1;
+            return 0;
+        }
+        pstState->iInString = 0;
+    }
+    else if (c == '"')
+    {
+        pstState->iInString = 1;
+    }
+    else if ((c == '{') || (c == '['))
+    {
+        if (pstState->iDepth >= ROBOT_MSG_SCAN_MAX_DEPTH)
+        {
+            return -1;
+        }
+        pstState->acStack[pstState->iDepth++] = c;
+    }
+    else if ((c == '}') || (c == ']'))
+    {
+        /* The closing bracket must match the open one, '{'+2 is '}' */
+        if ((pstState->iDepth <= 0) || (pstState->acStack[pstState->iDepth - 1] + 2 != c))
+        {
+            return -1;
+        }
+        pstState->iDepth--;
+    }
+    else if (c == '\\')
+    {
+        return -1;
+    }
+
+    if (pstScan->iCount >= ROBOT_MSG_SCAN_MAX_INDEX)
+    {
+        return -1;
+    }
+    pstScan->ausIndex[pstScan->iCount++] = iPos;
+
+    return 0;
+}
+
+static const char *_RobotScanSkipSpace(const char *pc)
+{
+    while ((*pc != '\0') && ((unsigned char)*pc <= 32))
+    {
+        pc++;
+    }
+    return pc;
+}
+
+/**
+ * @brief:      RobotMessageScanBuild
+ * @details:    Build the structural index of a JSON reply
+ * @param[in]   const char *pcBuf  The reply, it must stay valid while the index is used
+ * @param[out]  ROBOT_MSG_SCAN_T *pstScan
+ * @retval:     UBTEDU_RC_SOCKET_DECODE_FAILED when the reply is not a well
+ *              formed object or is too large, the caller should fall back to
+ *              cJSON_Parse() in that case. The index holds 16 bit offsets,
+ *              so longer replies are too large.
+ */
+UBTEDU_RC_T RobotMessageScanBuild(ROBOT_MSG_SCAN_T *pstScan, const char *pcBuf)
+{
+    ROBOT_MSG_SCAN_STATE_T stState;
+    int iPos = 0;
+#ifdef ROBOT_MSG_SCAN_BLOCK
+    unsigned int uiMask;
+#endif
+
+    if ((NULL == pstScan) || (NULL == pcBuf))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pstScan->pcBuf = pcBuf;
+    pstScan->iLen = strlen(pcBuf);
+    pstScan->iCount = 0;
+    if (pstScan->iLen > USHRT_MAX)
+    {
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+    memset(&stState, 0, sizeof(stState));
+    stState.iSkip = -1;
+
+#ifdef ROBOT_MSG_SCAN_BLOCK
+    for (; iPos + ROBOT_MSG_SCAN_BLOCK <= pstScan->iLen; iPos += ROBOT_MSG_SCAN_BLOCK)
+    {
+        uiMask = _RobotScanMask(pcBuf + iPos);
+        while (uiMask)
+        {
+            if (_RobotScanStep(pstScan, &stState, iPos + __builtin_ctz(uiMask)) < 0)
+            {
+                return UBTEDU_RC_SOCKET_DECODE_FAILED;
+            }
+            uiMask &= uiMask - 1;
+        }
+    }
+#endif
+    for (; iPos < pstScan->iLen; iPos++)
+    {
+        if (_RobotScanIsCandidate(pcBuf[iPos]))
+        {
+            if (_RobotScanStep(pstScan, &stState, iPos) < 0)
+            {
+                return UBTEDU_RC_SOCKET_DECODE_FAILED;
+            }
+        }
+    }
+
+    if ((stState.iInString) || (stState.iDepth != 0) || (pstScan->iCount == 0)
+        || (_RobotScanSkipSpace(pcBuf) != pcBuf + pstScan->ausIndex[0])
+        || (pcBuf[pstScan->ausIndex[0]] != '{'))
+    {
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotMessageScanFind
+ * @details:    Find a member of an object. The key is compared without case
+ *              like cJSON_GetObjectItem().
+ * @param[in]   ROBOT_MSG_SCAN_T *pstScan
+ * @param[in]   int iObject         Slot of the object's '{'
+ * @param[in]   const char *pcKey   The member name
+ * @param[out]  None
+ * @retval:     Slot of the ':' after the key, -1 when not found
+ */
+int RobotMessageScanFind(ROBOT_MSG_SCAN_T *pstScan, int iObject, const char *pcKey)
+{
+    const char *pcBuf = pstScan->pcBuf;
+    unsigned short *pusIndex = pstScan->ausIndex;
+    int iKeyLen = strlen(pcKey);
+    int iDepth = 0;
+    int i;
+
+    if ((iObject < 0) || (iObject >= pstScan->iCount) || (pcBuf[pusIndex[iObject]] != '{'))
+    {
+        return -1;
+    }
+
+    for (i = iObject + 1; i < pstScan->iCount; i++)
+    {
+        switch (pcBuf[pusIndex[i]])
+        {
+            case '"':
+                /* Slot i is the open quote and slot i+1 the close one */
+                if ((iDepth == 0) && (i + 2 < pstScan->iCount) && (pcBuf[pusIndex[i + 2]] == ':')
+                    && (pusIndex[i + 1] - pusIndex[i] - 1 == iKeyLen)
+                    && (0 == strncasecmp(pcBuf + pusIndex[i] + 1, pcKey, iKeyLen)))
+                {
+                    return i + 2;
+                }
+                i++;
+                break;
+            case '{':
+            case '[':
+                iDepth++;
+                break;
+            case '}':
+            case ']':
+                if (iDepth-- == 0)
+                {
+                    return -1;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief:      RobotMessageScanObject
+ * @details:    Get the object held by a member
+ * @param[in]   int iValue  Slot returned by RobotMessageScanFind()
+ * @retval:     Slot of the object's '{', -1 when the value is not an object
+ */
+int RobotMessageScanObject(ROBOT_MSG_SCAN_T *pstScan, int iValue)
+{
+    const char *pc;
+
+    if ((iValue < 0) || (iValue + 1 >= pstScan->iCount))
+    {
+        return -1;
+    }
+    pc = _RobotScanSkipSpace(pstScan->pcBuf + pstScan->ausIndex[iValue] + 1);
+    if ((pc != pstScan->pcBuf + pstScan->ausIndex[iValue + 1]) || (*pc != '{'))
+    {
+        return -1;
+    }
+
+    return iValue + 1;
+}
+
+/**
+ * @brief:      RobotMessageScanGetString
+ * @details:    Copy a string member, the result is always terminated
+ * @param[in]   int iValue  Slot returned by RobotMessageScanFind()
+ * @param[out]  char *pcOut
+ * @param[in]   int iOutLen
+ * @retval:     UBTEDU_RC_NOT_FOUND when the value is not a string,
+ *              UBTEDU_RC_SOCKET_DECODE_FAILED when it holds escapes which
+ *              are left to cJSON.
+ */
+UBTEDU_RC_T RobotMessageScanGetString(ROBOT_MSG_SCAN_T *pstScan, int iValue, char *pcOut, int iOutLen)
+{
+    const char *pc;
+    int iLen;
+
+    if ((iValue < 0) || (NULL == pcOut) || (iOutLen <= 0))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    if (iValue + 2 >= pstScan->iCount)
+    {
+        return UBTEDU_RC_NOT_FOUND;
+    }
+    pc = _RobotScanSkipSpace(pstScan->pcBuf + pstScan->ausIndex[iValue] + 1);
+    if ((pc != pstScan->pcBuf + pstScan->ausIndex[iValue + 1]) || (*pc != '"'))
+    {
+        return UBTEDU_RC_NOT_FOUND;
+    }
+
+    pc++;
+    iLen = pstScan->ausIndex[iValue + 2] - pstScan->ausIndex[iValue + 1] - 1;
+    if (NULL != memchr(pc, '\\', iLen))
+    {
+        return UBTEDU_RC_SOCKET_DECODE_FAILED;
+    }
+    if (iLen >= iOutLen)
+    {
+        iLen = iOutLen - 1;
+    }
+    memcpy(pcOut, pc, iLen);
+    pcOut[iLen] = '\0';
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotMessageScanGetNumber
+ * @details:    Read a number member
+ * @param[in]   int iValue  Slot returned by RobotMessageScanFind()
+ * @param[out]  double *pdValue
+ * @retval:     UBTEDU_RC_NOT_FOUND when the value is not a number
+ */
+UBTEDU_RC_T RobotMessageScanGetNumber(ROBOT_MSG_SCAN_T *pstScan, int iValue, double *pdValue)
+{
+    const char *pc;
+    double dValue;
+
+    if ((iValue < 0) || (NULL == pdValue))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    pc = _RobotScanSkipSpace(pstScan->pcBuf + pstScan->ausIndex[iValue] + 1);
+    if ((*pc != '-') && !isdigit((unsigned char)*pc))
+    {
+        return UBTEDU_RC_NOT_FOUND;
+    }
+
+    /* The parser of the cJSON fallback, so both decode a number alike
+       whatever the locale */
+    if (NULL == cJSON_ParseNumber(pc, &dValue))
+    {
+        return UBTEDU_RC_NOT_FOUND;
+    }
+    *pdValue = dValue;
+
+    return UBTEDU_RC_SUCCESS;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file				RobotMsgScan.h
+ * @brief			RobotMsgScan.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTMSGSCAN_H__
+#define __ROBOTMSGSCAN_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Max structural characters recorded for one reply */
+#define ROBOT_MSG_SCAN_MAX_INDEX       (512)
+/* Slot of the root object */
+#define ROBOT_MSG_SCAN_ROOT            (0)
+
+
+typedef struct {
+    const char *pcBuf;
+    int iLen;
+    int iCount;                         /* Used slots in ausIndex */
+    unsigned short ausIndex[ROBOT_MSG_SCAN_MAX_INDEX];  /* Offsets of { } [ ] : , and string quotes */
+} ROBOT_MSG_SCAN_T;
+
+
+extern UBTEDU_RC_T RobotMessageScanBuild(ROBOT_MSG_SCAN_T *pstScan, const char *pcBuf);
+extern int RobotMessageScanFind(ROBOT_MSG_SCAN_T *pstScan, int iObject, const char *pcKey);
+extern int RobotMessageScanObject(ROBOT_MSG_SCAN_T *pstScan, int iValue);
+extern UBTEDU_RC_T RobotMessageScanGetString(ROBOT_MSG_SCAN_T *pstScan, int iValue, char *pcOut, int iOutLen);
+extern UBTEDU_RC_T RobotMessageScanGetNumber(ROBOT_MSG_SCAN_T *pstScan, int iValue, double *pdValue);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTMSGSCAN_H__ */
@@ -0,0 +1,238 @@
+/**
+ * @file				RobotMsgTemplate.c
+ * @brief			Pre-rendered messages with patchable slots
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * A template is printed by cJSON once, so it keeps exactly the layout the
+ * robot and _ubtCommWithRobot() expect. Each value which changes per
+ * message gets a fixed width slot: numbers are written left aligned and
+ * padded with blanks, strings must have the width of the slot. Sending a
+ * message is then a memcpy() and a few writes into the slots.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "voice_datatypes.h"
+#include "cJSON.h"
+
+#include "RobotMsgTemplate.h"
+
+
+/**
+ * @brief:      RobotMessageTemplateCreate
+ * @details:    Render the message which the slots are added to
+ * @param[in]   cJSON *pJsonRoot  The message, with a placeholder in every slot
+ * @param[out]  ROBOT_MSG_TEMPLATE_T *pstTemplate
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotMessageTemplateCreate(ROBOT_MSG_TEMPLATE_T *pstTemplate, cJSON *pJsonRoot)
+{
+    char *pcText;
+
+    if ((NULL == pstTemplate) || (NULL == pJsonRoot))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    memset(pstTemplate, 0, sizeof(ROBOT_MSG_TEMPLATE_T));
+    pcText = cJSON_Print(pJsonRoot);
+    if (NULL == pcText)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+    if (strlen(pcText) >= sizeof(pstTemplate->acText))
+    {
+        cJSON_FreeBuffer(pcText);
+        return UBTEDU_RC_NORESOURCE;
+    }
+    strcpy(pstTemplate->acText, pcText);
+    pstTemplate->iLen = strlen(pcText);
+    cJSON_FreeBuffer(pcText);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotMessageTemplateAddSlot
+ * @details:    Turn the value of a top level member into a slot. A string
+ *              placeholder must already be iWidth long, a number is widened
+ *              to iWidth with blanks.
+ * @param[in]   char *pcKey   The member name
+ * @param[in]   int iWidth    The slot width
+ * @param[out]  ROBOT_MSG_TEMPLATE_T *pstTemplate
+ * @retval:     The slot index, -1 when failed
+ */
+int RobotMessageTemplateAddSlot(ROBOT_MSG_TEMPLATE_T *pstTemplate, char *pcKey, int iWidth)
+{
+    char acPattern[64];
+    char *pcValue;
+    int iOffset, iOldWidth, iDelta, i;
+
+    if ((NULL == pstTemplate) || (NULL == pcKey) || (iWidth <= 0)
+        || (pstTemplate->iSlotNum >= ROBOT_MSG_TEMPLATE_MAX_SLOT))
+    {
+        return -1;
+    }
+
+    snprintf(acPattern, sizeof(acPattern), "\"%s\":", pcKey);
+    pcValue = strstr(pstTemplate->acText, acPattern);
+    if (NULL == pcValue)
+    {
+        return -1;
+    }
+    pcValue += strlen(acPattern);
+    while ((*pcValue == ' ') || (*pcValue == '\t'))
+    {
+        pcValue++;
+    }
+    iOffset = pcValue - pstTemplate->acText;
+
+    if (*pcValue == '"')
+    {
+        iOffset++;
+        if ((iOffset + iWidth >= pstTemplate->iLen) || (pstTemplate->acText[iOffset + iWidth] != '"'))
+        {
+            return -1;
+        }
+    }
+    else
+    {
+        for (iOldWidth = 0; strchr("-+.eE0123456789", pcValue[iOldWidth]) && pcValue[iOldWidth]; iOldWidth++);
+        iDelta = iWidth - iOldWidth;
+        if ((iOldWidth == 0) || (iDelta < 0) || (pstTemplate->iLen + iDelta >= sizeof(pstTemplate->acText)))
+        {
+            return -1;
+        }
+        memmove(pcValue + iWidth, pcValue + iOldWidth, pstTemplate->iLen - iOffset - iOldWidth + 1);
+        memset(pcValue + iOldWidth, ' ', iDelta);
+        pstTemplate->iLen += iDelta;
+        for (i = 0; i < pstTemplate->iSlotNum; i++)
+        {
+            if (pstTemplate->aiOffset[i] > iOffset)
+            {
+                pstTemplate->aiOffset[i] += iDelta;
+            }
+        }
+    }
+
+    pstTemplate->aiOffset[pstTemplate->iSlotNum] = iOffset;
+    pstTemplate->aiWidth[pstTemplate->iSlotNum] = iWidth;
+
+    return pstTemplate->iSlotNum++;
+}
+
+/**
+ * @brief:      RobotMessageTemplateRender
+ * @details:    Copy the template into the send buffer
+ * @param[in]   ROBOT_MSG_TEMPLATE_T *pstTemplate
+ * @param[out]  char *pcSendBuf
+ * @param[in]   int iBufLen
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotMessageTemplateRender(ROBOT_MSG_TEMPLATE_T *pstTemplate, char *pcSendBuf, int iBufLen)
+{
+    if ((NULL == pstTemplate) || (NULL == pcSendBuf) || (pstTemplate->iLen <= 0))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    if (pstTemplate->iLen >= iBufLen)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+    memcpy(pcSendBuf, pstTemplate->acText, pstTemplate->iLen + 1);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotMessageTemplateSetNumber
+ * @details:    Write a number into a slot of a rendered message
+ * @param[in]   ROBOT_MSG_TEMPLATE_T *pstTemplate
+ * @param[in]   char *pcSendBuf   Buffer filled by RobotMessageTemplateRender()
+ * @param[in]   int iSlot
+ * @param[in]   int iValue
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotMessageTemplateSetNumber(ROBOT_MSG_TEMPLATE_T *pstTemplate, char *pcSendBuf,
+        int iSlot, int iValue)
+{
+    char acDigit[ROBOT_MSG_TEMPLATE_INT_WIDTH];
+    unsigned int uiValue = (iValue < 0) ? 0u - (unsigned int)iValue : (unsigned int)iValue;
+    char *pcSlot;
+    int iLen = 0;
+
+    if ((NULL == pstTemplate) || (NULL == pcSendBuf) || (iSlot < 0) || (iSlot >= pstTemplate->iSlotNum))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    do
+    {
+        acDigit[iLen++] = '0' + uiValue % 10;
+        uiValue /= 10;
+    }
+    while (uiValue);
+    if (iLen + (iValue < 0) > pstTemplate->aiWidth[iSlot])
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pcSlot = pcSendBuf + pstTemplate->aiOffset[iSlot];
+    memset(pcSlot, ' ', pstTemplate->aiWidth[iSlot]);
+    if (iValue < 0)
+    {
+        *pcSlot++ = '-';
+    }
+    while (iLen)
+    {
+        *pcSlot++ = acDigit[--iLen];
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotMessageTemplateSetString
+ * @details:    Write a string into a slot of a rendered message. It must be
+ *              exactly as long as the slot and need no escaping.
+ * @param[in]   ROBOT_MSG_TEMPLATE_T *pstTemplate
+ * @param[in]   char *pcSendBuf   Buffer filled by RobotMessageTemplateRender()
+ * @param[in]   int iSlot
+ * @param[in]   char *pcValue
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotMessageTemplateSetString(ROBOT_MSG_TEMPLATE_T *pstTemplate, char *pcSendBuf,
+        int iSlot, char *pcValue)
+{
+    int i;
+
+    if ((NULL == pstTemplate) || (NULL == pcSendBuf) || (NULL == pcValue)
+        || (iSlot < 0) || (iSlot >= pstTemplate->iSlotNum))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    for (i = 0; i < pstTemplate->aiWidth[iSlot]; i++)
+    {
+        if (((unsigned char)pcValue[i] < 32) || (pcValue[i] == '"') || (pcValue[i] == '\\'))
+        {
+            return UBTEDU_RC_WRONG_PARAM;
+        }
+    }
+    if (pcValue[i] != '\0')
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    memcpy(pcSendBuf + pstTemplate->aiOffset[iSlot], pcValue, pstTemplate->aiWidth[iSlot]);
+
+    return UBTEDU_RC_SUCCESS;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file				RobotMsgTemplate.h
+ * @brief			RobotMsgTemplate.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTMSGTEMPLATE_H__
+#define __ROBOTMSGTEMPLATE_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+#define ROBOT_MSG_TEMPLATE_MAX_LEN      (256)
+#define ROBOT_MSG_TEMPLATE_MAX_SLOT     (4)
+/* Width of a number slot, enough for any int */
+#define ROBOT_MSG_TEMPLATE_INT_WIDTH    (11)
+
+
+typedef struct {
+    char acText[ROBOT_MSG_TEMPLATE_MAX_LEN];    /* Rendered message */
+    int iLen;                                   /* strlen(acText) */
+    int iSlotNum;
+    int aiOffset[ROBOT_MSG_TEMPLATE_MAX_SLOT];  /* Slot position in acText */
+    int aiWidth[ROBOT_MSG_TEMPLATE_MAX_SLOT];   /* Slot width in bytes */
+} ROBOT_MSG_TEMPLATE_T;
+
+
+extern UBTEDU_RC_T RobotMessageTemplateCreate(ROBOT_MSG_TEMPLATE_T *pstTemplate, cJSON *pJsonRoot);
+extern int RobotMessageTemplateAddSlot(ROBOT_MSG_TEMPLATE_T *pstTemplate, char *pcKey, int iWidth);
+extern UBTEDU_RC_T RobotMessageTemplateRender(ROBOT_MSG_TEMPLATE_T *pstTemplate, char *pcSendBuf, int iBufLen);
+extern UBTEDU_RC_T RobotMessageTemplateSetNumber(ROBOT_MSG_TEMPLATE_T *pstTemplate, char *pcSendBuf,
+        int iSlot, int iValue);
+extern UBTEDU_RC_T RobotMessageTemplateSetString(ROBOT_MSG_TEMPLATE_T *pstTemplate, char *pcSendBuf,
+        int iSlot, char *pcValue);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTMSGTEMPLATE_H__ */
@@ -0,0 +1,330 @@
+/**
+ * @file				RobotProfile.c
+ * @brief			Speed and acceleration limited servo motion profiles
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * A profile moves all the servos from one pose to another in the same time,
+ * which is stretched until no servo goes past its speed or acceleration
+ * limit. The servos are kept as a struct of arrays, so sampling works on
+ * ROBOT_PROFILE_LANES servos at once with the GCC vector extensions. They
+ * become NEON or SSE instructions where the target has them.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+
+#include "RobotHts.h"
+#include "RobotProfile.h"
+
+
+/* Peak speed and acceleration of a minimum jerk move, times distance/T and distance/T^2 */
+#define _PROFILE_MINJERK_VEL           (1.875f)
+#define _PROFILE_MINJERK_ACC           (5.7735f)
+
+
+typedef int _PROFILE_MASK_T __attribute__((vector_size(ROBOT_PROFILE_LANES * sizeof(int))));
+
+
+static inline ROBOT_PROFILE_VEC_T _RobotProfileMin(ROBOT_PROFILE_VEC_T a, ROBOT_PROFILE_VEC_T b)
+{
+    _PROFILE_MASK_T m = (a < b);
+
+    return (ROBOT_PROFILE_VEC_T)((m & (_PROFILE_MASK_T)a) | (~m & (_PROFILE_MASK_T)b));
+}
+
+static inline ROBOT_PROFILE_VEC_T _RobotProfileMax(ROBOT_PROFILE_VEC_T a, ROBOT_PROFILE_VEC_T b)
+{
+    _PROFILE_MASK_T m = (a > b);
+
+    return (ROBOT_PROFILE_VEC_T)((m & (_PROFILE_MASK_T)a) | (~m & (_PROFILE_MASK_T)b));
+}
+
+/* A servo which is not driven at either end has nothing to move */
+static int _RobotProfileDriven(const unsigned char *pucFrom, const unsigned char *pucTo, int i)
+{
+    return (0 != pucFrom[i]) && (0 != pucTo[i]) && (pucFrom[i] != pucTo[i]);
+}
+
+/**
+ * @brief:      RobotProfileLimitInit
+ * @details:    Set all the servos to the default limits
+ * @param[in]   None
+ * @param[out]  ROBOT_PROFILE_LIMIT_T *pstLimit
+ * @retval:     void
+ */
+void RobotProfileLimitInit(ROBOT_PROFILE_LIMIT_T *pstLimit)
+{
+    int i;
+
+    for (i = 0; i < ROBOT_PROFILE_JOINT_NUM; i++)
+    {
+        pstLimit->stVel.af[i] = ROBOT_PROFILE_DEF_VEL / 1000.0f;
+        pstLimit->stAcc.af[i] = ROBOT_PROFILE_DEF_ACC / 1000000.0f;
+    }
+}
+
+/**
+ * @brief:      RobotProfileSetLimit
+ * @details:    Set the limits of one servo
+ * @param[in]   int iServo       0 ~ MAX_SERVO_NUM-1
+ * @param[in]   float fMaxVel    In degree/s
+ * @param[in]   float fMaxAcc    In degree/s^2
+ * @param[out]  ROBOT_PROFILE_LIMIT_T *pstLimit
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotProfileSetLimit(ROBOT_PROFILE_LIMIT_T *pstLimit, int iServo, float fMaxVel, float fMaxAcc)
+{
+    if ((NULL == pstLimit) || (iServo < 0) || (iServo >= MAX_SERVO_NUM)
+        || !(fMaxVel > 0.0f) || !(fMaxAcc > 0.0f))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pstLimit->stVel.af[iServo] = fMaxVel / 1000.0f;
+    pstLimit->stAcc.af[iServo] = fMaxAcc / 1000000.0f;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotProfileMinTime
+ * @details:    Get the shortest time of a move which keeps every servo
+ *              within its limits
+ * @param[in]   ROBOT_PROFILE_TYPE_e eType
+ * @param[in]   ROBOT_PROFILE_LIMIT_T *pstLimit
+ * @param[in]   unsigned char *pucFrom    MAX_SERVO_NUM angles, 0 is not driven
+ * @param[in]   unsigned char *pucTo      MAX_SERVO_NUM angles, 0 is not driven
+ * @param[out]  None
+ * @retval:     The time in ms
+ */
+float RobotProfileMinTime(ROBOT_PROFILE_TYPE_e eType, const ROBOT_PROFILE_LIMIT_T *pstLimit,
+        const unsigned char *pucFrom, const unsigned char *pucTo)
+{
+    float fDist, fVel, fAcc, fTime, fMax = 0.0f;
+    int i;
+
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        if (!_RobotProfileDriven(pucFrom, pucTo, i))
+        {
+            continue;
+        }
+        fDist = fabsf((float)pucTo[i] - pucFrom[i]);
+        fVel = pstLimit->stVel.af[i];
+        fAcc = pstLimit->stAcc.af[i];
+
+        if (ROBOT_PROFILE_MINJERK == eType)
+        {
+            fTime = fmaxf(_PROFILE_MINJERK_VEL * fDist / fVel, sqrtf(_PROFILE_MINJERK_ACC * fDist / fAcc));
+        }
+        else if (fDist * fAcc >= fVel * fVel)
+        {
+            /* Reaches the max speed */
+            fTime = fDist / fVel + fVel / fAcc;
+        }
+        else
+        {
+            fTime = 2.0f * sqrtf(fDist / fAcc);
+        }
+        fMax = fmaxf(fMax, fTime);
+    }
+
+    return fMax;
+}
+
+/**
+ * @brief:      RobotProfilePlan
+ * @details:    Plan a move of all the servos. fDuration is stretched to
+ *              RobotProfileMinTime() when it is shorter. A servo which is not
+ *              driven at either end goes straight to pucTo.
+ * @param[in]   ROBOT_PROFILE_TYPE_e eType
+ * @param[in]   ROBOT_PROFILE_LIMIT_T *pstLimit
+ * @param[in]   unsigned char *pucFrom    MAX_SERVO_NUM angles(range:0~180)
+ * @param[in]   unsigned char *pucTo      MAX_SERVO_NUM angles(range:0~180)
+ * @param[in]   float fDuration           In ms
+ * @param[out]  ROBOT_PROFILE_T *pstProfile
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotProfilePlan(ROBOT_PROFILE_T *pstProfile, ROBOT_PROFILE_TYPE_e eType,
+        const ROBOT_PROFILE_LIMIT_T *pstLimit, const unsigned char *pucFrom,
+        const unsigned char *pucTo, float fDuration)
+{
+    float fDist, fAcc, fDisc, fVel, fT;
+    int i;
+
+    if ((NULL == pstProfile) || (NULL == pstLimit) || (NULL == pucFrom) || (NULL == pucTo)
+        || (eType < ROBOT_PROFILE_MINJERK) || (eType >= ROBOT_PROFILE_INVALID) || (fDuration < 0.0f))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    memset(pstProfile, 0, sizeof(ROBOT_PROFILE_T));
+    pstProfile->eType = eType;
+    fT = fmaxf(fDuration, RobotProfileMinTime(eType, pstLimit, pucFrom, pucTo));
+    pstProfile->fDuration = fT;
+
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        if (!_RobotProfileDriven(pucFrom, pucTo, i))
+        {
+            pstProfile->stStart.af[i] = pucTo[i];
+            continue;
+        }
+        pstProfile->stStart.af[i] = pucFrom[i];
+        pstProfile->stDelta.af[i] = (float)pucTo[i] - pucFrom[i];
+        if ((ROBOT_PROFILE_TRAPEZOID != eType) || (fT <= 0.0f))
+        {
+            continue;
+        }
+
+        /* Full acceleration, then the cruise speed which ends the move at fT */
+        fDist = fabsf(pstProfile->stDelta.af[i]);
+        fAcc = pstLimit->stAcc.af[i];
+        fDisc = fAcc * fAcc * fT * fT - 4.0f * fAcc * fDist;
+        fVel = (fAcc * fT - sqrtf(fmaxf(fDisc, 0.0f))) / 2.0f;
+        pstProfile->stAccTime.af[i] = fVel / fAcc;
+        pstProfile->stVel.af[i] = copysignf(fVel, pstProfile->stDelta.af[i]);
+        pstProfile->stAcc.af[i] = copysignf(fAcc, pstProfile->stDelta.af[i]);
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotProfileSample
+ * @details:    Get the servo angles fTimeMs after the start of the move
+ * @param[in]   ROBOT_PROFILE_T *pstProfile
+ * @param[in]   float fTimeMs
+ * @param[out]  unsigned char *pucAngle   MAX_SERVO_NUM angles
+ * @retval:     void
+ */
+void RobotProfileSample(const ROBOT_PROFILE_T *pstProfile, float fTimeMs, unsigned char *pucAngle)
+{
+    ROBOT_PROFILE_LANE_T stPos;
+    ROBOT_PROFILE_VEC_T vT, vZero, vAccTime, vUp, vCruise, vDown;
+    float fT = pstProfile->fDuration;
+    float fS, fK, fValue;
+    int i;
+
+    fTimeMs = (fTimeMs < 0.0f) ? 0.0f : ((fTimeMs > fT) ? fT : fTimeMs);
+
+    if (ROBOT_PROFILE_MINJERK == pstProfile->eType)
+    {
+        /* The same shape for every servo, scaled by its distance */
+        fS = (fT > 0.0f) ? fTimeMs / fT : 1.0f;
+        fK = fS * fS * fS * (10.0f + fS * (-15.0f + 6.0f * fS));
+        for (i = 0; i < ROBOT_PROFILE_VEC_NUM; i++)
+        {
+            stPos.av[i] = pstProfile->stStart.av[i] + pstProfile->stDelta.av[i] * fK;
+        }
+    }
+    else
+    {
+        vZero = (ROBOT_PROFILE_VEC_T){0.0f};
+        vT = vZero + fTimeMs;
+        for (i = 0; i < ROBOT_PROFILE_VEC_NUM; i++)
+        {
+            vAccTime = pstProfile->stAccTime.av[i];
+            vUp = _RobotProfileMin(vT, vAccTime);
+            vCruise = _RobotProfileMin(_RobotProfileMax(vT - vAccTime, vZero), fT - 2.0f * vAccTime);
+            vDown = _RobotProfileMax(vT - (fT - vAccTime), vZero);
+            stPos.av[i] = pstProfile->stStart.av[i]
+                          + 0.5f * pstProfile->stAcc.av[i] * (vUp * vUp - vDown * vDown)
+                          + pstProfile->stVel.av[i] * (vCruise + vDown);
+        }
+        if (fTimeMs >= fT)
+        {
+            /* No rounding left at the end of the move */
+            for (i = 0; i < ROBOT_PROFILE_VEC_NUM; i++)
+            {
+                stPos.av[i] = pstProfile->stStart.av[i] + pstProfile->stDelta.av[i];
+            }
+        }
+    }
+
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        fValue = stPos.af[i];
+        fValue = (fValue < 0.0f) ? 0.0f : ((fValue > 180.0f) ? 180.0f : fValue);
+        pucAngle[i] = (unsigned char)(fValue + 0.5f);
+    }
+}
+
+/**
+ * @brief:      RobotProfileBuildHts
+ * @details:    Sample a move into an HTS action, one frame about every
+ *              iFrameMs. The HTS is created here and must be destroyed by
+ *              the caller.
+ * @param[in]   ROBOT_PROFILE_T *pstProfile
+ * @param[in]   int iFrameMs     ROBOT_HTS_TIME_UNIT or more
+ * @param[out]  ROBOT_HTS_T *pstHts
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotProfileBuildHts(const ROBOT_PROFILE_T *pstProfile, int iFrameMs, ROBOT_HTS_T *pstHts)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    unsigned char aucSample[MAX_SERVO_NUM];
+    unsigned char aucAngle[ROBOT_HTS_ANGLE_NUM];
+    int i, j, iNum, iUnitTotal, iUnit, iLastUnit;
+
+    if ((NULL == pstProfile) || (NULL == pstHts) || (iFrameMs < ROBOT_HTS_TIME_UNIT))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    iUnitTotal = (int)ceilf(pstProfile->fDuration / ROBOT_HTS_TIME_UNIT);
+    iUnitTotal = (iUnitTotal < 1) ? 1 : iUnitTotal;
+    iNum = (iUnitTotal * ROBOT_HTS_TIME_UNIT + iFrameMs / 2) / iFrameMs;
+    iNum = (iNum < 1) ? 1 : ((iNum > iUnitTotal) ? iUnitTotal : iNum);
+    if (iNum > 0xffff)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+
+    ubtRet = RobotHtsCreate(pstHts, iNum);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+
+    /* Spread the frames evenly over whole time units */
+    iLastUnit = 0;
+    for (i = 1; (i <= iNum) && (UBTEDU_RC_SUCCESS == ubtRet); i++)
+    {
+        iUnit = (iUnitTotal * i + iNum / 2) / iNum;
+        RobotProfileSample(pstProfile, (float)(iUnit * ROBOT_HTS_TIME_UNIT), aucSample);
+        memset(aucAngle, 0xff, sizeof(aucAngle));
+        for (j = 0; j < MAX_SERVO_NUM; j++)
+        {
+            if (0 != aucSample[j])
+            {
+                aucAngle[j] = aucSample[j];
+            }
+        }
+        ubtRet = RobotHtsSetAngles(pstHts, i, iNum, aucAngle, iUnit - iLastUnit);
+        iLastUnit = iUnit;
+    }
+
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = RobotHtsFinish(pstHts, iNum, iUnitTotal * ROBOT_HTS_TIME_UNIT);
+    }
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        RobotHtsDestroy(pstHts);
+    }
+
+    return ubtRet;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file				RobotProfile.h
+ * @brief			RobotProfile.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTPROFILE_H__
+#define __ROBOTPROFILE_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Floats in one vector */
+#define ROBOT_PROFILE_LANES            (4)
+/* Vectors holding all the servos, the last one is padded */
+#define ROBOT_PROFILE_VEC_NUM          ((MAX_SERVO_NUM + ROBOT_PROFILE_LANES - 1) / ROBOT_PROFILE_LANES)
+#define ROBOT_PROFILE_JOINT_NUM        (ROBOT_PROFILE_VEC_NUM * ROBOT_PROFILE_LANES)
+/* Default servo limits, in degree/s and degree/s^2 */
+#define ROBOT_PROFILE_DEF_VEL          (240)
+#define ROBOT_PROFILE_DEF_ACC          (1200)
+
+
+typedef float ROBOT_PROFILE_VEC_T __attribute__((vector_size(ROBOT_PROFILE_LANES * sizeof(float))));
+
+/* One value per servo, as vectors or as floats */
+typedef union {
+    ROBOT_PROFILE_VEC_T av[ROBOT_PROFILE_VEC_NUM];
+    float af[ROBOT_PROFILE_JOINT_NUM];
+} ROBOT_PROFILE_LANE_T;
+
+typedef enum {
+    ROBOT_PROFILE_MINJERK = 0,      /* Minimum jerk, 5th order polynomial */
+    ROBOT_PROFILE_TRAPEZOID,        /* Constant acceleration, cruise, constant deceleration */
+    ROBOT_PROFILE_INVALID
+} ROBOT_PROFILE_TYPE_e;
+
+typedef struct {
+    ROBOT_PROFILE_LANE_T stVel;     /* Max speed, in degree/ms */
+    ROBOT_PROFILE_LANE_T stAcc;     /* Max acceleration, in degree/ms^2 */
+} ROBOT_PROFILE_LIMIT_T;
+
+/* All the servos start and stop together, each one has its own lane */
+typedef struct {
+    ROBOT_PROFILE_TYPE_e eType;
+    float fDuration;                /* In ms */
+    ROBOT_PROFILE_LANE_T stStart;
+    ROBOT_PROFILE_LANE_T stDelta;
+    ROBOT_PROFILE_LANE_T stVel;     /* Trapezoid cruise speed, signed */
+    ROBOT_PROFILE_LANE_T stAcc;     /* Trapezoid acceleration, signed */
+    ROBOT_PROFILE_LANE_T stAccTime; /* Trapezoid acceleration time */
+} ROBOT_PROFILE_T;
+
+
+extern void RobotProfileLimitInit(ROBOT_PROFILE_LIMIT_T *pstLimit);
+extern UBTEDU_RC_T RobotProfileSetLimit(ROBOT_PROFILE_LIMIT_T *pstLimit, int iServo, float fMaxVel, float fMaxAcc);
+extern float RobotProfileMinTime(ROBOT_PROFILE_TYPE_e eType, const ROBOT_PROFILE_LIMIT_T *pstLimit,
+        const unsigned char *pucFrom, const unsigned char *pucTo);
+extern UBTEDU_RC_T RobotProfilePlan(ROBOT_PROFILE_T *pstProfile, ROBOT_PROFILE_TYPE_e eType,
+        const ROBOT_PROFILE_LIMIT_T *pstLimit, const unsigned char *pucFrom,
+        const unsigned char *pucTo, float fDuration);
+extern void RobotProfileSample(const ROBOT_PROFILE_T *pstProfile, float fTimeMs, unsigned char *pucAngle);
+extern UBTEDU_RC_T RobotProfileBuildHts(const ROBOT_PROFILE_T *pstProfile, int iFrameMs, ROBOT_HTS_T *pstHts);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTPROFILE_H__ */
@@ -0,0 +1,297 @@
+/**
+ * @file				RobotSafety.c
+ * @brief			Joint range and self collision check of servo poses
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * Every pose sent to the servos goes through RobotSafetyCheck(). Angles out
+ * of their servo's range are clamped. The links of the arms and legs are
+ * then taken as capsules around the segments of RobotKinematics, with one
+ * more capsule for the torso and head, and a pose in which two of them
+ * overlap is rejected. Links which always touch, like a limb and the body
+ * it hangs from, are not checked against each other.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+
+#include "RobotKinematics.h"
+#include "RobotSafety.h"
+
+
+/* Capsule sizes, in mm */
+#define ROBOT_SAFETY_LIMB_RADIUS       (15.0f)
+#define ROBOT_SAFETY_TORSO_RADIUS      (40.0f)
+#define ROBOT_SAFETY_TORSO_BOTTOM      (20.0f)
+#define ROBOT_SAFETY_TORSO_TOP         (215.0f)
+/* Chains checked for collisions, the head only turns */
+#define ROBOT_SAFETY_CHAIN_NUM         (ROBOT_KIN_CHAIN_RIGHT_LEG + 1)
+#define ROBOT_SAFETY_TORSO             (ROBOT_SAFETY_CHAIN_NUM)
+
+
+typedef struct {
+    int iPart;                      /* ROBOT_KIN_CHAIN_e or ROBOT_SAFETY_TORSO */
+    float afFrom[3];
+    float afTo[3];
+    float fRadius;
+} _SAFETY_CAPSULE_T;
+
+
+static unsigned char g_aucSafetyMin[MAX_SERVO_NUM];
+static unsigned char g_aucSafetyMax[MAX_SERVO_NUM] = {[0 ... MAX_SERVO_NUM - 1] = 180};
+static int g_iSafetyCollision = 1;
+static ROBOT_SAFETY_STATS_T g_stSafetyStats;
+
+
+static int _RobotSafetyIsArm(int iPart)
+{
+    return (ROBOT_KIN_CHAIN_LEFT_ARM == iPart) || (ROBOT_KIN_CHAIN_RIGHT_ARM == iPart);
+}
+
+/* Parts which are checked against each other */
+static int _RobotSafetyPair(int iPartA, int iPartB)
+{
+    if (iPartA == iPartB)
+    {
+        return 0;
+    }
+    if (_RobotSafetyIsArm(iPartA) || _RobotSafetyIsArm(iPartB))
+    {
+        /* An arm against anything else */
+        return 1;
+    }
+
+    /* The two legs, both hang from the torso */
+    return (ROBOT_SAFETY_TORSO != iPartA) && (ROBOT_SAFETY_TORSO != iPartB);
+}
+
+static float _RobotSafetyDot(const float *pfA, const float *pfB)
+{
+    return pfA[0] * pfB[0] + pfA[1] * pfB[1] + pfA[2] * pfB[2];
+}
+
+static float _RobotSafetyClamp01(float fValue)
+{
+    return (fValue < 0.0f) ? 0.0f : ((fValue > 1.0f) ? 1.0f : fValue);
+}
+
+/* Squared distance between the segments P1-Q1 and P2-Q2 */
+static float _RobotSafetySegmentDist2(const float *pfP1, const float *pfQ1, const float *pfP2, const float *pfQ2)
+{
+    float afD1[3], afD2[3], afR[3], afC[3];
+    float fA, fE, fF, fB, fC, fDenom, fS, fT;
+    int i;
+
+    for (i = 0; i < 3; i++)
+    {
+        afD1[i] = pfQ1[i] - pfP1[i];
+        afD2[i] = pfQ2[i] - pfP2[i];
+        afR[i] = pfP1[i] - pfP2[i];
+    }
+    fA = _RobotSafetyDot(afD1, afD1);
+    fE = _RobotSafetyDot(afD2, afD2);
+    fF = _RobotSafetyDot(afD2, afR);
+    fC = _RobotSafetyDot(afD1, afR);
+    fB = _RobotSafetyDot(afD1, afD2);
+
+    /* Closest points of the lines, then pulled back onto the segments */
+    fDenom = fA * fE - fB * fB;
+    fS = (fDenom > 1e-6f) ? _RobotSafetyClamp01((fB * fF - fC * fE) / fDenom) : 0.0f;
+    fT = (fB * fS + fF) / fE;
+    if (fT < 0.0f)
+    {
+        fT = 0.0f;
+        fS = _RobotSafetyClamp01(-fC / fA);
+    }
+    else if (fT > 1.0f)
+    {
+        fT = 1.0f;
+        fS = _RobotSafetyClamp01((fB - fC) / fA);
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        afC[i] = (pfP1[i] + afD1[i] * fS) - (pfP2[i] + afD2[i] * fT);
+    }
+
+    return _RobotSafetyDot(afC, afC);
+}
+
+/* Capsules of a chain, none when one of its servos is unknown */
+static int _RobotSafetyChainCapsules(ROBOT_KIN_CHAIN_e eChain, const unsigned char *pucPose,
+        _SAFETY_CAPSULE_T *pstCapsule)
+{
+    const ROBOT_KIN_CHAIN_T *pstChain = RobotKinGetChain(eChain);
+    float afPoint[ROBOT_KIN_MAX_JOINT + 1][3], afLink[3];
+    int i, iPoint, iNum = 0;
+
+    for (i = 0; i < pstChain->iJointNum; i++)
+    {
+        if (0 == pucPose[pstChain->astJoint[i].iServo])
+        {
+            return 0;
+        }
+    }
+
+    iPoint = RobotKinGetPoints(eChain, pucPose, afPoint);
+    for (i = 1; i < iPoint; i++)
+    {
+        afLink[0] = afPoint[i][0] - afPoint[i - 1][0];
+        afLink[1] = afPoint[i][1] - afPoint[i - 1][1];
+        afLink[2] = afPoint[i][2] - afPoint[i - 1][2];
+        if (_RobotSafetyDot(afLink, afLink) < 1.0f)
+        {
+            /* Two servos at the same joint */
+            continue;
+        }
+        pstCapsule[iNum].iPart = eChain;
+        memcpy(pstCapsule[iNum].afFrom, afPoint[i - 1], sizeof(afLink));
+        memcpy(pstCapsule[iNum].afTo, afPoint[i], sizeof(afLink));
+        pstCapsule[iNum].fRadius = ROBOT_SAFETY_LIMB_RADIUS;
+        iNum++;
+    }
+
+    return iNum;
+}
+
+/**
+ * @brief:      RobotSafetySetRange
+ * @details:    Set the angles a servo may be sent to
+ * @param[in]   int iServo    0 ~ MAX_SERVO_NUM-1
+ * @param[in]   int iMin      0 ~ iMax
+ * @param[in]   int iMax      iMin ~ 180
+ * @param[out]  None
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotSafetySetRange(int iServo, int iMin, int iMax)
+{
+    if ((iServo < 0) || (iServo >= MAX_SERVO_NUM) || (iMin < 0) || (iMax > 180) || (iMin > iMax))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    g_aucSafetyMin[iServo] = iMin;
+    g_aucSafetyMax[iServo] = iMax;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotSafetySetCollision
+ * @details:    Turn the self collision check on or off, the ranges are
+ *              always checked
+ * @param[in]   int iEnable
+ * @param[out]  None
+ * @retval:     void
+ */
+void RobotSafetySetCollision(int iEnable)
+{
+    g_iSafetyCollision = iEnable ? 1 : 0;
+}
+
+/**
+ * @brief:      RobotSafetyCheck
+ * @details:    Check a pose before it is sent. The angles out of range are
+ *              clamped in place. A servo at 0 is not moved by the pose, the
+ *              collision check takes it from pucCurrent, and skips the
+ *              chains with a servo known in neither.
+ * @param[in]   unsigned char *pucCurrent  MAX_SERVO_NUM angles the servos are at, may be NULL
+ * @param[out]  unsigned char *pucAngle    MAX_SERVO_NUM angles, 0 is not moved
+ * @retval:     ROBOT_SAFETY_RESULT_e
+ */
+ROBOT_SAFETY_RESULT_e RobotSafetyCheck(unsigned char *pucAngle, const unsigned char *pucCurrent)
+{
+    ROBOT_SAFETY_RESULT_e eResult = ROBOT_SAFETY_OK;
+    _SAFETY_CAPSULE_T astCapsule[ROBOT_SAFETY_CHAIN_NUM * ROBOT_KIN_MAX_JOINT + 1];
+    unsigned char aucPose[MAX_SERVO_NUM];
+    float fReach;
+    int i, j, iNum;
+
+    __atomic_add_fetch(&g_stSafetyStats.uiChecked, 1, __ATOMIC_RELAXED);
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        if (0 == pucAngle[i])
+        {
+            aucPose[i] = (NULL == pucCurrent) ? 0 : pucCurrent[i];
+            continue;
+        }
+        if (pucAngle[i] < g_aucSafetyMin[i])
+        {
+            pucAngle[i] = g_aucSafetyMin[i];
+            eResult = ROBOT_SAFETY_CLAMPED;
+        }
+        else if (pucAngle[i] > g_aucSafetyMax[i])
+        {
+            pucAngle[i] = g_aucSafetyMax[i];
+            eResult = ROBOT_SAFETY_CLAMPED;
+        }
+        aucPose[i] = pucAngle[i];
+    }
+
+    if (g_iSafetyCollision)
+    {
+        iNum = 0;
+        astCapsule[iNum].iPart = ROBOT_SAFETY_TORSO;
+        astCapsule[iNum].afFrom[0] = 0.0f;
+        astCapsule[iNum].afFrom[1] = 0.0f;
+        astCapsule[iNum].afFrom[2] = ROBOT_SAFETY_TORSO_BOTTOM;
+        astCapsule[iNum].afTo[0] = 0.0f;
+        astCapsule[iNum].afTo[1] = 0.0f;
+        astCapsule[iNum].afTo[2] = ROBOT_SAFETY_TORSO_TOP;
+        astCapsule[iNum].fRadius = ROBOT_SAFETY_TORSO_RADIUS;
+        iNum++;
+        for (i = 0; i < ROBOT_SAFETY_CHAIN_NUM; i++)
+        {
+            iNum += _RobotSafetyChainCapsules(i, aucPose, &astCapsule[iNum]);
+        }
+
+        for (i = 0; i < iNum; i++)
+        {
+            for (j = i + 1; j < iNum; j++)
+            {
+                if (!_RobotSafetyPair(astCapsule[i].iPart, astCapsule[j].iPart))
+                {
+                    continue;
+                }
+                fReach = astCapsule[i].fRadius + astCapsule[j].fRadius;
+                if (_RobotSafetySegmentDist2(astCapsule[i].afFrom, astCapsule[i].afTo,
+                                             astCapsule[j].afFrom, astCapsule[j].afTo) < fReach * fReach)
+                {
+                    __atomic_add_fetch(&g_stSafetyStats.uiRejected, 1, __ATOMIC_RELAXED);
+                    return ROBOT_SAFETY_COLLISION;
+                }
+            }
+        }
+    }
+
+    if (ROBOT_SAFETY_CLAMPED == eResult)
+    {
+        __atomic_add_fetch(&g_stSafetyStats.uiClamped, 1, __ATOMIC_RELAXED);
+    }
+
+    return eResult;
+}
+
+/**
+ * @brief:      RobotSafetyGetStats
+ * @details:    Get the poses checked, clamped and rejected
+ * @param[in]   None
+ * @param[out]  ROBOT_SAFETY_STATS_T *pstStats
+ * @retval:     void
+ */
+void RobotSafetyGetStats(ROBOT_SAFETY_STATS_T *pstStats)
+{
+    pstStats->uiChecked = __atomic_load_n(&g_stSafetyStats.uiChecked, __ATOMIC_RELAXED);
+    pstStats->uiClamped = __atomic_load_n(&g_stSafetyStats.uiClamped, __ATOMIC_RELAXED);
+    pstStats->uiRejected = __atomic_load_n(&g_stSafetyStats.uiRejected, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,50 @@
+/**
+ * @file				RobotSafety.h
+ * @brief			RobotSafety.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTSAFETY_H__
+#define __ROBOTSAFETY_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+typedef enum {
+    ROBOT_SAFETY_OK = 0,
+    ROBOT_SAFETY_CLAMPED,           /* Some angles were moved into their range */
+    ROBOT_SAFETY_COLLISION          /* Two links would touch, the pose must not be sent */
+} ROBOT_SAFETY_RESULT_e;
+
+typedef struct {
+    unsigned int uiChecked;
+    unsigned int uiClamped;
+    unsigned int uiRejected;
+} ROBOT_SAFETY_STATS_T;
+
+
+extern UBTEDU_RC_T RobotSafetySetRange(int iServo, int iMin, int iMax);
+extern void RobotSafetySetCollision(int iEnable);
+extern ROBOT_SAFETY_RESULT_e RobotSafetyCheck(unsigned char *pucAngle, const unsigned char *pucCurrent);
+extern void RobotSafetyGetStats(ROBOT_SAFETY_STATS_T *pstStats);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTSAFETY_H__ */
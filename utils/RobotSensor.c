@@ -0,0 +1,407 @@
+/**
+ * @file				RobotSensor.c
+ * @brief			Sensor samples of a subscription and their ring
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * The robot pushes each sample in the same message as the answer to a
+ * sensor query, so pushed and polled samples are decoded alike. The ring
+ * works like the capture ring: one producer, the subscription thread, and
+ * one consumer, each only writing its own index. A full ring drops the
+ * new sample.
+ *
+ * Each sensor also keeps a history of its last samples, from any reader
+ * thread and any writer thread, without a lock. A writer claims the next
+ * slot, and each slot is a seqlock: odd while written, then the index the
+ * sample has. A reader copies a slot and checks that it still holds the
+ * index it wanted, so the oldest slots can be overwritten under it. Two
+ * writers only share a slot when one of them is held up for a whole
+ * history of samples.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "voice_datatypes.h"
+#include "robotlogstr.h"
+
+#include "RobotMsg.h"
+#include "RobotSensor.h"
+
+
+/* Sensor names, in the order of UBTEDU_SENSOR_TYPE_e */
+static char **s_appcSensorName[UBTEDU_SENSOR_INVALID] =
+{
+    &pcStr_Msg_Param_Query_Sensor_GYRO,
+    &pcStr_Msg_Param_Query_Sensor_ENV,
+    &pcStr_Msg_Param_Query_Sensor_Board,
+    &pcStr_Msg_Param_Query_Sensor_Ultrasonic,
+    &pcStr_Msg_Param_Query_Sensor_Infrared,
+    &pcStr_Msg_Param_Query_Sensor_Touch,
+    &pcStr_Msg_Param_Query_Sensor_Color,
+    &pcStr_Msg_Param_Query_Sensor_Pressure,
+};
+
+static const int s_aiSensorSize[UBTEDU_SENSOR_INVALID] =
+{
+    sizeof(UBTEDU_ROBOTGYRO_SENSOR_T),
+    sizeof(UBTEDU_ROBOTENV_SENSOR_T),
+    sizeof(UBTEDU_ROBOTRASPBOARD_SENSOR_T),
+    sizeof(UBTEDU_ROBOTULTRASONIC_SENSOR_T),
+    sizeof(UBTEDU_ROBOTINFRARED_SENSOR_T),
+    sizeof(UBTEDU_ROBOTTOUCH_SENSOR_T),
+    sizeof(UBTEDU_ROBOTCOLOR_SENSOR_T),
+    sizeof(UBTEDU_ROBOTPRESSURE_SENSOR_T),
+};
+
+
+/**
+ * @brief:      RobotSensorGetType
+ * @details:    Get the sensor of a name used by ubtReadSensorValue()
+ * @param[in]   char *pcName
+ * @param[out]  None
+ * @retval:     UBTEDU_SENSOR_INVALID when the name is unknown
+ */
+UBTEDU_SENSOR_TYPE_e RobotSensorGetType(const char *pcName)
+{
+    int i;
+
+    if (NULL == pcName)
+    {
+        return UBTEDU_SENSOR_INVALID;
+    }
+    for (i = 0; i < UBTEDU_SENSOR_INVALID; i++)
+    {
+        if (!strcmp(pcName, *s_appcSensorName[i]))
+        {
+            return (UBTEDU_SENSOR_TYPE_e)i;
+        }
+    }
+
+    return UBTEDU_SENSOR_INVALID;
+}
+
+/**
+ * @brief:      RobotSensorGetName
+ * @details:    Get the name of a sensor in the messages
+ * @param[in]   UBTEDU_SENSOR_TYPE_e eType
+ * @param[out]  None
+ * @retval:     char *  NULL for an invalid sensor
+ */
+char *RobotSensorGetName(UBTEDU_SENSOR_TYPE_e eType)
+{
+    if ((eType < 0) || (eType >= UBTEDU_SENSOR_INVALID))
+    {
+        return NULL;
+    }
+
+    return *s_appcSensorName[eType];
+}
+
+/**
+ * @brief:      RobotSensorGetSize
+ * @details:    Get the size of a sensor's value structure
+ * @param[in]   UBTEDU_SENSOR_TYPE_e eType
+ * @param[out]  None
+ * @retval:     int  0 for an invalid sensor
+ */
+int RobotSensorGetSize(UBTEDU_SENSOR_TYPE_e eType)
+{
+    if ((eType < 0) || (eType >= UBTEDU_SENSOR_INVALID))
+    {
+        return 0;
+    }
+
+    return s_aiSensorSize[eType];
+}
+
+/**
+ * @brief:      RobotSensorDecode
+ * @details:    Decode a sample of one of the sensors in uiTypeMask. The
+ *              time is left to the caller.
+ * @param[in]   char *pcRecvBuf
+ * @param[in]   unsigned int uiTypeMask   Bit per UBTEDU_SENSOR_TYPE_e
+ * @param[out]  UBTEDU_SENSOR_SAMPLE_T *pstSample
+ * @retval:     UBTEDU_RC_NOT_FOUND when it is not a sample of those sensors
+ */
+UBTEDU_RC_T RobotSensorDecode(char *pcRecvBuf, unsigned int uiTypeMask, UBTEDU_SENSOR_SAMPLE_T *pstSample)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    char *apcName[UBTEDU_SENSOR_INVALID];
+    int aiType[UBTEDU_SENSOR_INVALID];
+    int i, iNum = 0, iFound;
+
+    if ((NULL == pcRecvBuf) || (NULL == pstSample))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    for (i = 0; i < UBTEDU_SENSOR_INVALID; i++)
+    {
+        if (uiTypeMask & (1u << i))
+        {
+            apcName[iNum] = *s_appcSensorName[i];
+            aiType[iNum++] = i;
+        }
+    }
+
+    ubtRet = ubtRobot_Msg_Decode_SensorType(pcRecvBuf, apcName, iNum, &iFound);
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        return ubtRet;
+    }
+    pstSample->eType = (UBTEDU_SENSOR_TYPE_e)aiType[iFound];
+
+    return ubtRobot_Msg_Decode_ReadSensorValue(pcRecvBuf, apcName[iFound], &pstSample->uValue,
+            s_aiSensorSize[aiType[iFound]]);
+}
+
+/**
+ * @brief:      RobotSensorRingCreate
+ * @details:    Allocate a ring of at least uiMinSize samples
+ * @param[in]   unsigned int uiMinSize
+ * @param[out]  ROBOT_SENSOR_RING_T *pstRing
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotSensorRingCreate(ROBOT_SENSOR_RING_T *pstRing, unsigned int uiMinSize)
+{
+    unsigned int uiSize = 1;
+
+    if ((NULL == pstRing) || (0 == uiMinSize) || (uiMinSize > 0x100000))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    while (uiSize < uiMinSize)
+    {
+        uiSize <<= 1;
+    }
+
+    memset(pstRing, 0, sizeof(ROBOT_SENSOR_RING_T));
+    pstRing->pstSample = calloc(uiSize, sizeof(UBTEDU_SENSOR_SAMPLE_T));
+    if (NULL == pstRing->pstSample)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+    pstRing->uiSize = uiSize;
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotSensorRingDestroy
+ * @details:    Release the ring
+ * @param[in]   ROBOT_SENSOR_RING_T *pstRing
+ * @param[out]  None
+ * @retval:     void
+ */
+void RobotSensorRingDestroy(ROBOT_SENSOR_RING_T *pstRing)
+{
+    if (NULL == pstRing)
+    {
+        return;
+    }
+    free(pstRing->pstSample);
+    memset(pstRing, 0, sizeof(ROBOT_SENSOR_RING_T));
+}
+
+/**
+ * @brief:      RobotSensorRingPush
+ * @details:    Add a sample, from the producer only
+ * @param[in]   UBTEDU_SENSOR_SAMPLE_T *pstSample
+ * @param[out]  ROBOT_SENSOR_RING_T *pstRing
+ * @retval:     1 when it was added, 0 when the ring is full
+ */
+int RobotSensorRingPush(ROBOT_SENSOR_RING_T *pstRing, const UBTEDU_SENSOR_SAMPLE_T *pstSample)
+{
+    unsigned int uiHead = pstRing->uiHead;
+
+    if (uiHead - __atomic_load_n(&pstRing->uiTail, __ATOMIC_ACQUIRE) >= pstRing->uiSize)
+    {
+        __atomic_add_fetch(&pstRing->uiDropped, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    pstRing->pstSample[uiHead & (pstRing->uiSize - 1)] = *pstSample;
+    __atomic_store_n(&pstRing->uiHead, uiHead + 1, __ATOMIC_RELEASE);
+
+    return 1;
+}
+
+/**
+ * @brief:      RobotSensorRingRead
+ * @details:    Take the oldest samples, from the consumer only
+ * @param[in]   int iMax
+ * @param[out]  UBTEDU_SENSOR_SAMPLE_T *pstSample
+ * @param[out]  ROBOT_SENSOR_RING_T *pstRing
+ * @retval:     Number of samples taken
+ */
+int RobotSensorRingRead(ROBOT_SENSOR_RING_T *pstRing, UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax)
+{
+    unsigned int uiTail = pstRing->uiTail;
+    unsigned int uiHead = __atomic_load_n(&pstRing->uiHead, __ATOMIC_ACQUIRE);
+    int iNum = 0;
+
+    while ((uiTail != uiHead) && (iNum < iMax))
+    {
+        pstSample[iNum++] = pstRing->pstSample[uiTail & (pstRing->uiSize - 1)];
+        uiTail++;
+    }
+    __atomic_store_n(&pstRing->uiTail, uiTail, __ATOMIC_RELEASE);
+
+    return iNum;
+}
+
+/**
+ * @brief:      _RobotSensorSlotRead
+ * @details:    Copy the sample of an index from its slot
+ * @param[in]   ROBOT_SENSOR_HISTORY_T *pstHistory
+ * @param[in]   unsigned int uiIndex
+ * @param[out]  UBTEDU_SENSOR_SAMPLE_T *pstSample
+ * @retval:     1 when copied, 0 when it is not written yet, -1 when it was
+ *              overwritten by a newer sample
+ */
+static int _RobotSensorSlotRead(ROBOT_SENSOR_HISTORY_T *pstHistory, unsigned int uiIndex,
+        UBTEDU_SENSOR_SAMPLE_T *pstSample)
+{
+    ROBOT_SENSOR_SLOT_T *pstSlot = &pstHistory->astSlot[uiIndex & (ROBOT_SENSOR_HISTORY_LEN - 1)];
+    const unsigned int *puiFrom = (const unsigned int *)&pstSlot->stSample;
+    unsigned int *puiTo = (unsigned int *)pstSample;
+    unsigned int uiWant = 2 * uiIndex + 2;
+    unsigned int uiSeq;
+    int i;
+
+    uiSeq = __atomic_load_n(&pstSlot->uiSeq, __ATOMIC_ACQUIRE);
+    if (uiSeq != uiWant)
+    {
+        return ((int)(uiSeq - uiWant) > 0) ? -1 : 0;
+    }
+    for (i = 0; i < (int)(sizeof(UBTEDU_SENSOR_SAMPLE_T) / sizeof(unsigned int)); i++)
+    {
+        puiTo[i] = __atomic_load_n(&puiFrom[i], __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    return (__atomic_load_n(&pstSlot->uiSeq, __ATOMIC_RELAXED) == uiWant) ? 1 : -1;
+}
+
+/**
+ * @brief:      RobotSensorHistoryPush
+ * @details:    Add a sample, from any thread
+ * @param[in]   UBTEDU_SENSOR_SAMPLE_T *pstSample
+ * @param[out]  ROBOT_SENSOR_HISTORY_T *pstHistory
+ * @retval:     void
+ */
+void RobotSensorHistoryPush(ROBOT_SENSOR_HISTORY_T *pstHistory, const UBTEDU_SENSOR_SAMPLE_T *pstSample)
+{
+    unsigned int uiIndex = __atomic_fetch_add(&pstHistory->uiHead, 1, __ATOMIC_RELAXED);
+    ROBOT_SENSOR_SLOT_T *pstSlot = &pstHistory->astSlot[uiIndex & (ROBOT_SENSOR_HISTORY_LEN - 1)];
+    const unsigned int *puiFrom = (const unsigned int *)pstSample;
+    unsigned int *puiTo = (unsigned int *)&pstSlot->stSample;
+    int i;
+
+    __atomic_store_n(&pstSlot->uiSeq, 2 * uiIndex + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (i = 0; i < (int)(sizeof(UBTEDU_SENSOR_SAMPLE_T) / sizeof(unsigned int)); i++)
+    {
+        __atomic_store_n(&puiTo[i], puiFrom[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&pstSlot->uiSeq, 2 * uiIndex + 2, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief:      RobotSensorHistoryLatest
+ * @details:    Get the newest sample written, from any thread
+ * @param[in]   ROBOT_SENSOR_HISTORY_T *pstHistory
+ * @param[out]  UBTEDU_SENSOR_SAMPLE_T *pstSample
+ * @retval:     1 when there is one, 0 otherwise
+ */
+int RobotSensorHistoryLatest(ROBOT_SENSOR_HISTORY_T *pstHistory, UBTEDU_SENSOR_SAMPLE_T *pstSample)
+{
+    unsigned int uiHead = __atomic_load_n(&pstHistory->uiHead, __ATOMIC_ACQUIRE);
+    unsigned int uiBack = 1;
+    int i, iRet;
+
+    /* A sample still written is passed for the one before it, a sample
+       overwritten meanwhile means newer ones are there */
+    for (i = 0; (i < ROBOT_SENSOR_HISTORY_LEN) && (uiBack <= uiHead) && (uiBack <= ROBOT_SENSOR_HISTORY_LEN); i++)
+    {
+        iRet = _RobotSensorSlotRead(pstHistory, uiHead - uiBack, pstSample);
+        if (iRet > 0)
+        {
+            return 1;
+        }
+        if (0 == iRet)
+        {
+            uiBack++;
+        }
+        else
+        {
+            uiHead = __atomic_load_n(&pstHistory->uiHead, __ATOMIC_ACQUIRE);
+            uiBack = 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief:      RobotSensorHistoryWindow
+ * @details:    Get the samples received from ullFromUs to ullToUs, from
+ *              any thread. The newest iMax of them are given, oldest first.
+ *              Writers on several threads take the time before claiming
+ *              their slot, so slots are only roughly in time order: the
+ *              whole history is searched, then the samples are sorted.
+ * @param[in]   ROBOT_SENSOR_HISTORY_T *pstHistory
+ * @param[in]   unsigned long long ullFromUs
+ * @param[in]   unsigned long long ullToUs
+ * @param[in]   int iMax
+ * @param[out]  UBTEDU_SENSOR_SAMPLE_T *pstSample   iMax samples
+ * @retval:     Number of samples given
+ */
+int RobotSensorHistoryWindow(ROBOT_SENSOR_HISTORY_T *pstHistory, unsigned long long ullFromUs,
+        unsigned long long ullToUs, UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax)
+{
+    UBTEDU_SENSOR_SAMPLE_T stSwap;
+    unsigned int uiHead = __atomic_load_n(&pstHistory->uiHead, __ATOMIC_ACQUIRE);
+    unsigned int uiBack;
+    int i, j, iRet, iNum = 0;
+
+    for (uiBack = 1; (uiBack <= uiHead) && (uiBack <= ROBOT_SENSOR_HISTORY_LEN) && (iNum < iMax); uiBack++)
+    {
+        iRet = _RobotSensorSlotRead(pstHistory, uiHead - uiBack, &pstSample[iNum]);
+        /* The older ones are overwritten as well */
+        if (iRet < 0)
+        {
+            break;
+        }
+        if ((0 != iRet) && (pstSample[iNum].ullTimeUs >= ullFromUs) && (pstSample[iNum].ullTimeUs <= ullToUs))
+        {
+            iNum++;
+        }
+    }
+
+    for (i = 0; i < iNum / 2; i++)
+    {
+        stSwap = pstSample[i];
+        pstSample[i] = pstSample[iNum - 1 - i];
+        pstSample[iNum - 1 - i] = stSwap;
+    }
+    /* Nearly in order already, only the samples of racing writers move */
+    for (i = 1; i < iNum; i++)
+    {
+        stSwap = pstSample[i];
+        for (j = i; (j > 0) && (pstSample[j - 1].ullTimeUs > stSwap.ullTimeUs); j--)
+        {
+            pstSample[j] = pstSample[j - 1];
+        }
+        pstSample[j] = stSwap;
+    }
+
+    return iNum;
+}
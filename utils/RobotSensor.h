@@ -0,0 +1,67 @@
+/**
+ * @file				RobotSensor.h
+ * @brief			RobotSensor.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTSENSOR_H__
+#define __ROBOTSENSOR_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+typedef struct {
+    UBTEDU_SENSOR_SAMPLE_T *pstSample;
+    unsigned int uiSize;                        /* Power of 2 */
+    unsigned int uiHead;                        /* Samples written, only by the producer */
+    unsigned int uiTail;                        /* Samples read, only by the consumer */
+    unsigned int uiDropped;                     /* Samples lost because the ring was full */
+} ROBOT_SENSOR_RING_T;
+
+/* Samples kept per sensor, power of 2 */
+#define ROBOT_SENSOR_HISTORY_LEN        (256)
+
+typedef struct {
+    unsigned int uiSeq;                         /* 2 * index + 2 once written, odd while written */
+    UBTEDU_SENSOR_SAMPLE_T stSample;
+} ROBOT_SENSOR_SLOT_T;
+
+typedef struct {
+    unsigned int uiHead;                        /* Samples claimed by the writers */
+    ROBOT_SENSOR_SLOT_T astSlot[ROBOT_SENSOR_HISTORY_LEN];
+} ROBOT_SENSOR_HISTORY_T;
+
+
+extern UBTEDU_SENSOR_TYPE_e RobotSensorGetType(const char *pcName);
+extern char *RobotSensorGetName(UBTEDU_SENSOR_TYPE_e eType);
+extern int RobotSensorGetSize(UBTEDU_SENSOR_TYPE_e eType);
+extern UBTEDU_RC_T RobotSensorDecode(char *pcRecvBuf, unsigned int uiTypeMask, UBTEDU_SENSOR_SAMPLE_T *pstSample);
+extern UBTEDU_RC_T RobotSensorRingCreate(ROBOT_SENSOR_RING_T *pstRing, unsigned int uiMinSize);
+extern void RobotSensorRingDestroy(ROBOT_SENSOR_RING_T *pstRing);
+extern int RobotSensorRingPush(ROBOT_SENSOR_RING_T *pstRing, const UBTEDU_SENSOR_SAMPLE_T *pstSample);
+extern int RobotSensorRingRead(ROBOT_SENSOR_RING_T *pstRing, UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax);
+extern void RobotSensorHistoryPush(ROBOT_SENSOR_HISTORY_T *pstHistory, const UBTEDU_SENSOR_SAMPLE_T *pstSample);
+extern int RobotSensorHistoryLatest(ROBOT_SENSOR_HISTORY_T *pstHistory, UBTEDU_SENSOR_SAMPLE_T *pstSample);
+extern int RobotSensorHistoryWindow(ROBOT_SENSOR_HISTORY_T *pstHistory, unsigned long long ullFromUs,
+        unsigned long long ullToUs, UBTEDU_SENSOR_SAMPLE_T *pstSample, int iMax);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTSENSOR_H__ */
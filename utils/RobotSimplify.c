@@ -0,0 +1,315 @@
+/**
+ * @file				RobotSimplify.c
+ * @brief			Drop the frames of a motion which the servos would pass anyway
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * The servos glide in a straight line from one frame to the next, so a
+ * frame can go when every servo is close enough to the line between the
+ * frames kept around it. The frames are kept Ramer-Douglas-Peucker style:
+ * a span is split at the frame where some servo strays the furthest from
+ * its line, until no servo strays more than the allowed error. All the
+ * servos share the frames of an HTS file, so one split serves them all.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+
+#include "RobotHts.h"
+#include "RobotSimplify.h"
+
+
+/* Error taken as nothing, for angles right on the line up to rounding */
+#define ROBOT_SIMPLIFY_EPSILON         (0.001f)
+
+
+/**
+ * @brief:      _RobotSimplifyHold
+ * @details:    Give the servos not moved by a frame the angle they hold.
+ *              Servos stay 0xFF until their first angle.
+ * @param[in]   int iNum
+ * @param[out]  ROBOT_SIMPLIFY_FRAME_T *pstFrame
+ * @retval:     void
+ */
+static void _RobotSimplifyHold(ROBOT_SIMPLIFY_FRAME_T *pstFrame, int iNum)
+{
+    int i, j;
+
+    for (i = 1; i < iNum; i++)
+    {
+        for (j = 0; j < ROBOT_HTS_ANGLE_NUM; j++)
+        {
+            if (0xff == pstFrame[i].aucAngle[j])
+            {
+                pstFrame[i].aucAngle[j] = pstFrame[i - 1].aucAngle[j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief:      _RobotSimplifyError
+ * @details:    Largest distance of a servo in frame i to its line from
+ *              frame iFrom to frame iTo
+ * @param[in]   ROBOT_SIMPLIFY_FRAME_T *pstFrame
+ * @param[in]   int iFrom
+ * @param[in]   int iTo
+ * @param[in]   int i
+ * @param[out]  None
+ * @retval:     float  In degree
+ */
+static float _RobotSimplifyError(const ROBOT_SIMPLIFY_FRAME_T *pstFrame, int iFrom, int iTo, int i)
+{
+    const unsigned char *pucFrom = pstFrame[iFrom].aucAngle;
+    const unsigned char *pucTo = pstFrame[iTo].aucAngle;
+    float fSpan = pstFrame[iTo].fTimeMs - pstFrame[iFrom].fTimeMs;
+    float fRatio, fError, fMax = 0.0f;
+    int j;
+
+    fRatio = (fSpan > 0.0f) ? (pstFrame[i].fTimeMs - pstFrame[iFrom].fTimeMs) / fSpan : 0.0f;
+    for (j = 0; j < ROBOT_HTS_ANGLE_NUM; j++)
+    {
+        /* Held from iFrom on, so set in the whole span */
+        if (0xff == pucFrom[j])
+        {
+            continue;
+        }
+        fError = fabsf(pstFrame[i].aucAngle[j] - (pucFrom[j] + (pucTo[j] - pucFrom[j]) * fRatio));
+        if (fError > fMax)
+        {
+            fMax = fError;
+        }
+    }
+
+    return fMax;
+}
+
+/**
+ * @brief:      _RobotSimplifyMark
+ * @details:    Mark the frames to keep. The first and last frame and the
+ *              first angle of each servo are always kept.
+ * @param[in]   ROBOT_SIMPLIFY_FRAME_T *pstFrame   Held by _RobotSimplifyHold()
+ * @param[in]   int iNum
+ * @param[in]   float fMaxError
+ * @param[out]  unsigned char *pucKeep   iNum flags
+ * @param[out]  int *piKeepNum
+ * @param[out]  float *pfError           Largest error of the dropped frames
+ * @retval:     UBTEDU_RC_T
+ */
+static UBTEDU_RC_T _RobotSimplifyMark(const ROBOT_SIMPLIFY_FRAME_T *pstFrame, int iNum, float fMaxError,
+        unsigned char *pucKeep, int *piKeepNum, float *pfError)
+{
+    float fError, fMax;
+    int *piStack;
+    int i, j, iFrom, iTo, iSplit, iTop = 0;
+
+    /* Each pending span lies between kept frames and holds a frame, so
+       there are fewer of them than frames */
+    piStack = malloc(2 * iNum * sizeof(int));
+    if (NULL == piStack)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+
+    memset(pucKeep, 0, iNum);
+    pucKeep[0] = 1;
+    pucKeep[iNum - 1] = 1;
+    for (j = 0; j < ROBOT_HTS_ANGLE_NUM; j++)
+    {
+        for (i = 0; (i < iNum) && (0xff == pstFrame[i].aucAngle[j]); i++)
+        {
+        }
+        if (i < iNum)
+        {
+            pucKeep[i] = 1;
+        }
+    }
+    for (iFrom = 0, i = 1; i < iNum; i++)
+    {
+        if (pucKeep[i])
+        {
+            if (i - iFrom > 1)
+            {
+                piStack[iTop++] = iFrom;
+                piStack[iTop++] = i;
+            }
+            iFrom = i;
+        }
+    }
+
+    *pfError = 0.0f;
+    while (iTop > 0)
+    {
+        iTo = piStack[--iTop];
+        iFrom = piStack[--iTop];
+        fMax = 0.0f;
+        iSplit = iFrom + 1;
+        for (i = iFrom + 1; i < iTo; i++)
+        {
+            fError = _RobotSimplifyError(pstFrame, iFrom, iTo, i);
+            if (fError > fMax)
+            {
+                fMax = fError;
+                iSplit = i;
+            }
+        }
+
+        if (fMax <= fMaxError + ROBOT_SIMPLIFY_EPSILON)
+        {
+            *pfError = (fMax > *pfError) ? fMax : *pfError;
+            continue;
+        }
+        pucKeep[iSplit] = 1;
+        if (iSplit - iFrom > 1)
+        {
+            piStack[iTop++] = iFrom;
+            piStack[iTop++] = iSplit;
+        }
+        if (iTo - iSplit > 1)
+        {
+            piStack[iTop++] = iSplit;
+            piStack[iTop++] = iTo;
+        }
+    }
+    free(piStack);
+
+    for (*piKeepNum = 0, i = 0; i < iNum; i++)
+    {
+        *piKeepNum += pucKeep[i];
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotSimplifyFromHts
+ * @details:    Get the frames of an HTS file, without the servo offsets
+ *              RobotHtsFinish() adds again
+ * @param[in]   ROBOT_HTS_FILE_T *pstFile   Opened and validated by RobotHtsOpen()
+ * @param[out]  ROBOT_SIMPLIFY_FRAME_T *pstFrame   iFrameNum frames
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotSimplifyFromHts(ROBOT_HTS_FILE_T *pstFile, ROBOT_SIMPLIFY_FRAME_T *pstFrame)
+{
+    signed char acOffset[ROBOT_HTS_ANGLE_NUM];
+    const unsigned char *pucFrame;
+    unsigned char *pucAngle;
+    int i, iSeq, iAngle, iTime = 0;
+
+    if ((NULL == pstFile) || (NULL == pstFrame) || (0 != pstFile->iBadFrame))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    RobotHtsGetOffset(acOffset);
+    for (iSeq = 1; iSeq <= pstFile->iFrameNum; iSeq++)
+    {
+        pucFrame = RobotHtsGetFrame(pstFile, iSeq);
+        iTime += (pucFrame[29] << 8) | pucFrame[30];
+        pstFrame[iSeq - 1].fTimeMs = (float)iTime * ROBOT_HTS_TIME_UNIT;
+        pucAngle = pstFrame[iSeq - 1].aucAngle;
+        memcpy(pucAngle, &pucFrame[8], ROBOT_HTS_ANGLE_NUM);
+        for (i = 0; i < ROBOT_HTS_ANGLE_NUM; i++)
+        {
+            if (0xff != pucAngle[i])
+            {
+                iAngle = pucAngle[i] - acOffset[i];
+                pucAngle[i] = (iAngle < 0) ? 0 : ((iAngle > 180) ? 180 : iAngle);
+            }
+        }
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotSimplifyBuildHts
+ * @details:    Build the HTS file of the frames kept within fMaxError. Each
+ *              kept frame lasts until the next one, rounded on the motion's
+ *              clock so the rounding does not add up.
+ * @param[in]   ROBOT_SIMPLIFY_FRAME_T *pstFrame   Changed: held angles are filled in
+ * @param[in]   int iNum
+ * @param[in]   float fMaxError   In degree, negative keeps every frame
+ * @param[out]  ROBOT_HTS_T *pstHts   Created here, released by the caller
+ * @param[out]  ROBOT_SIMPLIFY_STATS_T *pstStats   May be NULL
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotSimplifyBuildHts(ROBOT_SIMPLIFY_FRAME_T *pstFrame, int iNum, float fMaxError,
+        ROBOT_HTS_T *pstHts, ROBOT_SIMPLIFY_STATS_T *pstStats)
+{
+    UBTEDU_RC_T ubtRet = UBTEDU_RC_FAILED;
+    unsigned char *pucKeep;
+    float fError;
+    int i, iSeq, iKeepNum, iUnit, iLastUnit, iTime;
+
+    if ((NULL == pstFrame) || (iNum <= 0) || (NULL == pstHts))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+
+    pucKeep = malloc(iNum);
+    if (NULL == pucKeep)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+    _RobotSimplifyHold(pstFrame, iNum);
+    ubtRet = _RobotSimplifyMark(pstFrame, iNum, fMaxError, pucKeep, &iKeepNum, &fError);
+    if ((UBTEDU_RC_SUCCESS == ubtRet) && (iKeepNum > 0xffff))
+    {
+        ubtRet = UBTEDU_RC_NORESOURCE;
+    }
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = RobotHtsCreate(pstHts, iKeepNum);
+    }
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        free(pucKeep);
+        return ubtRet;
+    }
+
+    iLastUnit = 0;
+    for (i = 0, iSeq = 1; (i < iNum) && (UBTEDU_RC_SUCCESS == ubtRet); i++)
+    {
+        if (!pucKeep[i])
+        {
+            continue;
+        }
+        iUnit = (int)(pstFrame[i].fTimeMs / ROBOT_HTS_TIME_UNIT + 0.5f);
+        iTime = iUnit - iLastUnit;
+        iTime = (iTime < 1) ? 1 : ((iTime > 0xffff) ? 0xffff : iTime);
+        iLastUnit += iTime;
+        ubtRet = RobotHtsSetAngles(pstHts, iSeq++, iKeepNum, pstFrame[i].aucAngle, iTime);
+    }
+    free(pucKeep);
+
+    if (UBTEDU_RC_SUCCESS == ubtRet)
+    {
+        ubtRet = RobotHtsFinish(pstHts, iKeepNum, iLastUnit * ROBOT_HTS_TIME_UNIT);
+    }
+    if (UBTEDU_RC_SUCCESS != ubtRet)
+    {
+        RobotHtsDestroy(pstHts);
+        return ubtRet;
+    }
+
+    if (NULL != pstStats)
+    {
+        pstStats->iFramesIn = iNum;
+        pstStats->iFramesOut = iKeepNum;
+        pstStats->fMaxError = fError;
+    }
+
+    return UBTEDU_RC_SUCCESS;
+}
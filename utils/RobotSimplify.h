@@ -0,0 +1,48 @@
+/**
+ * @file				RobotSimplify.h
+ * @brief			RobotSimplify.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTSIMPLIFY_H__
+#define __ROBOTSIMPLIFY_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+typedef struct {
+    float fTimeMs;                              /* Time the pose is reached, from the motion start */
+    unsigned char aucAngle[ROBOT_HTS_ANGLE_NUM];/* 0xFF for servos not moved */
+} ROBOT_SIMPLIFY_FRAME_T;
+
+typedef struct {
+    int iFramesIn;
+    int iFramesOut;
+    float fMaxError;                            /* Largest angle error of a dropped frame, in degree */
+} ROBOT_SIMPLIFY_STATS_T;
+
+
+extern UBTEDU_RC_T RobotSimplifyFromHts(ROBOT_HTS_FILE_T *pstFile, ROBOT_SIMPLIFY_FRAME_T *pstFrame);
+extern UBTEDU_RC_T RobotSimplifyBuildHts(ROBOT_SIMPLIFY_FRAME_T *pstFrame, int iNum, float fMaxError,
+        ROBOT_HTS_T *pstHts, ROBOT_SIMPLIFY_STATS_T *pstStats);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTSIMPLIFY_H__ */
@@ -0,0 +1,256 @@
+/**
+ * @file				RobotTrajectory.c
+ * @brief			Keyframe queue and interpolation for servo streaming
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+ *
+ * Keyframes are queued with the time they must be reached on a millisecond
+ * clock owned by the caller. Sampling the queue at any time gives the servo
+ * angles between the two surrounding keyframes. When a keyframe is pushed
+ * to an idle queue, the last sampled pose is queued first, so the motion
+ * starts from where the servos are. The profiled interpolations stop at
+ * each keyframe and stretch the time to it to keep the servo limits.
+ * No locking is done here.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "voice_datatypes.h"
+#include "robotspecdef.h"
+
+#include "RobotHts.h"
+#include "RobotProfile.h"
+#include "RobotTrajectory.h"
+
+
+#define _TRAJ_KEYFRAME(pstTraj, i) \
+    (&(pstTraj)->astKeyframe[((pstTraj)->iHead + (i)) % ROBOT_TRAJ_MAX_KEYFRAME])
+
+
+static void _RobotTrajectoryAppend(ROBOT_TRAJ_T *pstTraj, unsigned int uiTimeMs, const unsigned char *pucAngle)
+{
+    ROBOT_TRAJ_KEYFRAME_T *pstKeyframe = _TRAJ_KEYFRAME(pstTraj, pstTraj->iCount);
+
+    pstKeyframe->uiTimeMs = uiTimeMs;
+    memcpy(pstKeyframe->aucAngle, pucAngle, MAX_SERVO_NUM);
+    pstTraj->iCount++;
+}
+
+/* Profile used by an interpolation, ROBOT_PROFILE_INVALID for the plain ones */
+static ROBOT_PROFILE_TYPE_e _RobotTrajectoryProfile(ROBOT_TRAJ_INTERP_e eInterp)
+{
+    switch (eInterp)
+    {
+        case ROBOT_TRAJ_INTERP_MINJERK:
+            return ROBOT_PROFILE_MINJERK;
+        case ROBOT_TRAJ_INTERP_TRAPEZOID:
+            return ROBOT_PROFILE_TRAPEZOID;
+        default:
+            return ROBOT_PROFILE_INVALID;
+    }
+}
+
+/* Tangent of one servo at keyframe i, in degrees per ms. 0 at both ends of the queue. */
+static double _RobotTrajectoryTangent(ROBOT_TRAJ_T *pstTraj, int i, int iServo)
+{
+    ROBOT_TRAJ_KEYFRAME_T *pstPrev, *pstNext;
+
+    if ((i <= 0) || (i >= pstTraj->iCount - 1))
+    {
+        return 0.0;
+    }
+    pstPrev = _TRAJ_KEYFRAME(pstTraj, i - 1);
+    pstNext = _TRAJ_KEYFRAME(pstTraj, i + 1);
+    if ((0 == pstPrev->aucAngle[iServo]) || (0 == pstNext->aucAngle[iServo]))
+    {
+        return 0.0;
+    }
+
+    return ((double)pstNext->aucAngle[iServo] - pstPrev->aucAngle[iServo])
+           / (double)(pstNext->uiTimeMs - pstPrev->uiTimeMs);
+}
+
+/**
+ * @brief:      RobotTrajectoryInit
+ * @details:    Empty the keyframe queue
+ * @param[in]   ROBOT_TRAJ_INTERP_e eInterp
+ * @param[out]  ROBOT_TRAJ_T *pstTraj
+ * @retval:     void
+ */
+void RobotTrajectoryInit(ROBOT_TRAJ_T *pstTraj, ROBOT_TRAJ_INTERP_e eInterp)
+{
+    memset(pstTraj, 0, sizeof(ROBOT_TRAJ_T));
+    pstTraj->eInterp = eInterp;
+    RobotProfileLimitInit(&pstTraj->stLimit);
+}
+
+/**
+ * @brief:      RobotTrajectoryPush
+ * @details:    Queue a keyframe which is reached uiDurationMs after the
+ *              previous one, or after uiNowMs when the queue is idle. The
+ *              profiled interpolations make uiDurationMs longer when a
+ *              servo would go past its limits.
+ * @param[in]   unsigned int uiNowMs         Current time on the trajectory clock
+ * @param[in]   unsigned char *pucAngle      MAX_SERVO_NUM angles(range:0~180)
+ * @param[in]   unsigned int uiDurationMs
+ * @param[out]  ROBOT_TRAJ_T *pstTraj
+ * @retval:     UBTEDU_RC_T
+ */
+UBTEDU_RC_T RobotTrajectoryPush(ROBOT_TRAJ_T *pstTraj, unsigned int uiNowMs,
+        const unsigned char *pucAngle, unsigned int uiDurationMs)
+{
+    ROBOT_TRAJ_KEYFRAME_T *pstTail;
+    ROBOT_PROFILE_TYPE_e eProfile;
+    float fMinMs;
+    int iIdle, i;
+
+    if ((NULL == pstTraj) || (NULL == pucAngle) || (0 == uiDurationMs))
+    {
+        return UBTEDU_RC_WRONG_PARAM;
+    }
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        if (pucAngle[i] > 180)
+        {
+            return UBTEDU_RC_WRONG_PARAM;
+        }
+    }
+
+    pstTail = (pstTraj->iCount > 0) ? _TRAJ_KEYFRAME(pstTraj, pstTraj->iCount - 1) : NULL;
+    iIdle = (NULL == pstTail) || (pstTail->uiTimeMs <= uiNowMs);
+
+    eProfile = _RobotTrajectoryProfile(pstTraj->eInterp);
+    if (ROBOT_PROFILE_INVALID != eProfile)
+    {
+        fMinMs = RobotProfileMinTime(eProfile, &pstTraj->stLimit,
+                                     iIdle ? pstTraj->aucLast : pstTail->aucAngle, pucAngle);
+        if (fMinMs > (float)uiDurationMs)
+        {
+            uiDurationMs = (unsigned int)ceilf(fMinMs);
+        }
+    }
+
+    if (iIdle)
+    {
+        /* Idle, start over from the current pose */
+        pstTraj->iHead = 0;
+        pstTraj->iCount = 0;
+        pstTraj->iProfileValid = 0;
+        _RobotTrajectoryAppend(pstTraj, uiNowMs, pstTraj->aucLast);
+        _RobotTrajectoryAppend(pstTraj, uiNowMs + uiDurationMs, pucAngle);
+        return UBTEDU_RC_SUCCESS;
+    }
+
+    if (pstTraj->iCount >= ROBOT_TRAJ_MAX_KEYFRAME)
+    {
+        return UBTEDU_RC_NORESOURCE;
+    }
+    _RobotTrajectoryAppend(pstTraj, pstTail->uiTimeMs + uiDurationMs, pucAngle);
+
+    return UBTEDU_RC_SUCCESS;
+}
+
+/**
+ * @brief:      RobotTrajectorySample
+ * @details:    Get the servo angles at uiNowMs. Keyframes which are no
+ *              longer needed are dropped. A servo which is not driven at
+ *              either end of the segment reads 0.
+ * @param[in]   ROBOT_TRAJ_T *pstTraj
+ * @param[in]   unsigned int uiNowMs
+ * @param[out]  unsigned char *pucAngle  MAX_SERVO_NUM angles
+ * @retval:     1 while the trajectory is moving, 0 when it is idle
+ */
+int RobotTrajectorySample(ROBOT_TRAJ_T *pstTraj, unsigned int uiNowMs, unsigned char *pucAngle)
+{
+    ROBOT_TRAJ_KEYFRAME_T *pstFrom, *pstTo;
+    ROBOT_PROFILE_TYPE_e eProfile;
+    double dT, dS, dValue, dM0, dM1;
+    int i, iSeg;
+
+    /* Keep one keyframe before the current segment for the cubic tangent */
+    while ((pstTraj->iCount >= 3) && (_TRAJ_KEYFRAME(pstTraj, 2)->uiTimeMs <= uiNowMs))
+    {
+        pstTraj->iHead = (pstTraj->iHead + 1) % ROBOT_TRAJ_MAX_KEYFRAME;
+        pstTraj->iCount--;
+    }
+
+    if ((pstTraj->iCount < 2) || (_TRAJ_KEYFRAME(pstTraj, pstTraj->iCount - 1)->uiTimeMs <= uiNowMs))
+    {
+        if (pstTraj->iCount > 0)
+        {
+            memcpy(pstTraj->aucLast, _TRAJ_KEYFRAME(pstTraj, pstTraj->iCount - 1)->aucAngle, MAX_SERVO_NUM);
+        }
+        memcpy(pucAngle, pstTraj->aucLast, MAX_SERVO_NUM);
+        return 0;
+    }
+
+    /* The segment is [0, 1] unless a keyframe before it was kept */
+    iSeg = (_TRAJ_KEYFRAME(pstTraj, 1)->uiTimeMs <= uiNowMs) ? 1 : 0;
+    pstFrom = _TRAJ_KEYFRAME(pstTraj, iSeg);
+    pstTo = _TRAJ_KEYFRAME(pstTraj, iSeg + 1);
+    dT = (double)(pstTo->uiTimeMs - pstFrom->uiTimeMs);
+
+    eProfile = _RobotTrajectoryProfile(pstTraj->eInterp);
+    if (ROBOT_PROFILE_INVALID != eProfile)
+    {
+        if (!pstTraj->iProfileValid || (pstTraj->uiProfileMs != pstFrom->uiTimeMs))
+        {
+            RobotProfilePlan(&pstTraj->stProfile, eProfile, &pstTraj->stLimit,
+                             pstFrom->aucAngle, pstTo->aucAngle, (float)dT);
+            pstTraj->uiProfileMs = pstFrom->uiTimeMs;
+            pstTraj->iProfileValid = 1;
+        }
+        RobotProfileSample(&pstTraj->stProfile,
+                           (uiNowMs <= pstFrom->uiTimeMs) ? 0.0f : (float)(uiNowMs - pstFrom->uiTimeMs),
+                           pucAngle);
+        memcpy(pstTraj->aucLast, pucAngle, MAX_SERVO_NUM);
+        return 1;
+    }
+    dS = (uiNowMs <= pstFrom->uiTimeMs) ? 0.0 : (double)(uiNowMs - pstFrom->uiTimeMs) / dT;
+
+    for (i = 0; i < MAX_SERVO_NUM; i++)
+    {
+        if ((0 == pstFrom->aucAngle[i]) || (0 == pstTo->aucAngle[i]))
+        {
+            /* Nothing to interpolate from, go straight to the target */
+            pucAngle[i] = pstTo->aucAngle[i];
+            continue;
+        }
+
+        if (ROBOT_TRAJ_INTERP_CUBIC == pstTraj->eInterp)
+        {
+            dM0 = _RobotTrajectoryTangent(pstTraj, iSeg, i) * dT;
+            dM1 = _RobotTrajectoryTangent(pstTraj, iSeg + 1, i) * dT;
+            dValue = (2*dS*dS*dS - 3*dS*dS + 1) * pstFrom->aucAngle[i]
+                     + (dS*dS*dS - 2*dS*dS + dS) * dM0
+                     + (-2*dS*dS*dS + 3*dS*dS) * pstTo->aucAngle[i]
+                     + (dS*dS*dS - dS*dS) * dM1;
+        }
+        else
+        {
+            dValue = pstFrom->aucAngle[i] + dS * ((double)pstTo->aucAngle[i] - pstFrom->aucAngle[i]);
+        }
+
+        if (dValue < 1.0)
+        {
+            dValue = 1.0;
+        }
+        else if (dValue > 180.0)
+        {
+            dValue = 180.0;
+        }
+        pucAngle[i] = (unsigned char)(dValue + 0.5);
+    }
+    memcpy(pstTraj->aucLast, pucAngle, MAX_SERVO_NUM);
+
+    return 1;
+}
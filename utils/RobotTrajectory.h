@@ -0,0 +1,67 @@
+/**
+ * @file				RobotTrajectory.h
+ * @brief			RobotTrajectory.c header file
+ * @author			UBTEDU
+ * @date			Monday, October 19, 2026
+ * @version			Initial Draft
+ * @par				Copyright (C),  2017-2026, UBT Education
+ * @par History:
+ * 1.Date: 			Monday, October 19, 2026
+ *   Author: 			UBTEDU
+ *   Modification: 		Created file
+*/
+#ifndef __ROBOTTRAJECTORY_H__
+#define __ROBOTTRAJECTORY_H__
+
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C"{
+#endif
+#endif /* __cplusplus */
+
+
+/* Max keyframes waiting to be played */
+#define ROBOT_TRAJ_MAX_KEYFRAME        (64)
+
+
+typedef enum {
+    ROBOT_TRAJ_INTERP_LINEAR = 0,   /* Straight line between keyframes */
+    ROBOT_TRAJ_INTERP_CUBIC,        /* Cubic Hermite spline, Catmull-Rom tangents */
+    ROBOT_TRAJ_INTERP_MINJERK,      /* Minimum jerk stop at each keyframe, within the limits */
+    ROBOT_TRAJ_INTERP_TRAPEZOID,    /* Trapezoidal speed stop at each keyframe, within the limits */
+    ROBOT_TRAJ_INTERP_INVALID
+} ROBOT_TRAJ_INTERP_e;
+
+typedef struct {
+    unsigned int uiTimeMs;                      /* Time on the trajectory clock */
+    unsigned char aucAngle[MAX_SERVO_NUM];      /* 0 means the servo is not driven */
+} ROBOT_TRAJ_KEYFRAME_T;
+
+typedef struct {
+    ROBOT_TRAJ_INTERP_e eInterp;
+    int iHead;                                  /* Oldest keyframe in astKeyframe */
+    int iCount;
+    ROBOT_TRAJ_KEYFRAME_T astKeyframe[ROBOT_TRAJ_MAX_KEYFRAME];
+    unsigned char aucLast[MAX_SERVO_NUM];       /* Last sampled angles */
+    ROBOT_PROFILE_LIMIT_T stLimit;              /* Servo limits of the profiled interpolations */
+    ROBOT_PROFILE_T stProfile;                  /* Plan of the current segment */
+    unsigned int uiProfileMs;                   /* Start of the planned segment */
+    int iProfileValid;
+} ROBOT_TRAJ_T;
+
+
+extern void RobotTrajectoryInit(ROBOT_TRAJ_T *pstTraj, ROBOT_TRAJ_INTERP_e eInterp);
+extern UBTEDU_RC_T RobotTrajectoryPush(ROBOT_TRAJ_T *pstTraj, unsigned int uiNowMs,
+        const unsigned char *pucAngle, unsigned int uiDurationMs);
+extern int RobotTrajectorySample(ROBOT_TRAJ_T *pstTraj, unsigned int uiNowMs, unsigned char *pucAngle);
+
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif /* __cplusplus */
+
+
+#endif /* __ROBOTTRAJECTORY_H__ */